@@ -1,19 +1,78 @@
+-- Reference schema (user_version 5).
+-- The application builds and upgrades this through the ordered migrations in
+-- src/schemamigrator.cpp - change it there, then mirror the result here.
+-- All timestamps are INTEGER epoch milliseconds.
+
 CREATE TABLE IF NOT EXISTS trips (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
-    start_time INTEGER,
-    end_time INTEGER,
+    start_time INTEGER NOT NULL,
+    end_time INTEGER NOT NULL,
     distance_km REAL,
     energy_kwh REAL,
-    avg_speed_kmh REAL
+    avg_efficiency REAL,
+    avg_speed_kmh REAL,
+    start_soc REAL,
+    end_soc REAL,
+    regen_kwh REAL NOT NULL DEFAULT 0,
+    min_lat REAL,
+    min_lon REAL,
+    max_lat REAL,
+    max_lon REAL,
+    route BLOB              -- Big-endian int32 microdegree pairs (latitude, longitude)
 );
 
+CREATE INDEX IF NOT EXISTS idx_trips_end_time ON trips (end_time);
+
+CREATE TABLE IF NOT EXISTS settings (
+    key TEXT PRIMARY KEY,
+    value TEXT
+);
+
+-- Lifetime totals, maintained by trips_totals_insert
+CREATE TABLE IF NOT EXISTS trip_totals (
+    id INTEGER PRIMARY KEY CHECK (id = 1),
+    total_distance_km REAL NOT NULL DEFAULT 0,
+    total_energy_kwh REAL NOT NULL DEFAULT 0,
+    trip_count INTEGER NOT NULL DEFAULT 0
+);
+
+CREATE TRIGGER IF NOT EXISTS trips_totals_insert AFTER INSERT ON trips
+BEGIN
+    UPDATE trip_totals
+    SET total_distance_km = total_distance_km + COALESCE(NEW.distance_km, 0),
+        total_energy_kwh = total_energy_kwh + COALESCE(NEW.energy_kwh, 0),
+        trip_count = trip_count + 1
+    WHERE id = 1;
+END;
+
 CREATE TABLE IF NOT EXISTS charging_logs (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
-    timestamp INTEGER,
+    start_time INTEGER NOT NULL,
+    end_time INTEGER NOT NULL,
     plug_in_soc REAL,
     unplug_soc REAL,
     energy_added_kwh REAL,
     max_power_kw REAL,
+    avg_power_kw REAL,
     location_lat REAL,
     location_lon REAL
 );
+
+CREATE INDEX IF NOT EXISTS idx_charging_logs_end_time ON charging_logs (end_time);
+
+-- Time-bucketed aggregates (bucket: 0 = hour, 1 = day, 2 = month, local time).
+-- Maintained incrementally as trips and charge sessions complete; survives
+-- the raw-data retention job. efficiency_histogram holds 21 big-endian
+-- uint32 bins of 20 Wh/km for per-trip efficiency percentiles.
+CREATE TABLE IF NOT EXISTS trip_rollups (
+    bucket INTEGER NOT NULL,
+    bucket_start INTEGER NOT NULL,
+    distance_km REAL NOT NULL DEFAULT 0,
+    energy_kwh REAL NOT NULL DEFAULT 0,
+    regen_kwh REAL NOT NULL DEFAULT 0,
+    trip_count INTEGER NOT NULL DEFAULT 0,
+    charge_kwh REAL NOT NULL DEFAULT 0,
+    charge_sessions INTEGER NOT NULL DEFAULT 0,
+    efficiency_histogram BLOB,
+    PRIMARY KEY (bucket, bucket_start)
+) WITHOUT ROWID;
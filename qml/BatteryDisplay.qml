@@ -16,6 +16,7 @@ Item {
     
     // Smooth SoC animation
     Behavior on animatedSoc {
+        enabled: !RenderScheduler.idle
         NumberAnimation {
             duration: 800
             easing.type: Easing.OutCubic
@@ -75,7 +76,7 @@ Item {
             }
         }
         
-        // Charging bolt overlay with pulse
+        // Charging bolt overlay
         Text {
             visible: charging
             text: "⚡"
@@ -83,20 +84,8 @@ Item {
             anchors.centerIn: parent
             font.pixelSize: 20
             
-            // Pulse animation when charging
-            SequentialAnimation on scale {
-                running: charging
-                loops: Animation.Infinite
-                NumberAnimation { to: 1.3; duration: 600; easing.type: Easing.InOutSine }
-                NumberAnimation { to: 1.0; duration: 600; easing.type: Easing.InOutSine }
-            }
-            
-            SequentialAnimation on opacity {
-                running: charging
-                loops: Animation.Infinite
-                NumberAnimation { to: 0.5; duration: 600 }
-                NumberAnimation { to: 1.0; duration: 600 }
-            }
+            // Flashes with the shared telltale clock while charging
+            opacity: BlinkClock.on ? 1.0 : 0.5
         }
     }
 
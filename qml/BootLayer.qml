@@ -0,0 +1,48 @@
+import QtQuick
+import EVComponents 1.0
+import "."
+
+// Boot Layer - the first thing rendered at startup.
+// Kept deliberately small (telltales + digital speed only) so it compiles and
+// renders well inside the time-to-first-telltale budget while the full
+// cluster streams in behind it.
+Item {
+    id: root
+    
+    // A readout only needs ~10 Hz, whatever the bus rate
+    SignalSubscription { id: speedReadout; signalName: "speed"; rate: 10 }
+    
+    // Telltales
+    WarningLights {
+        id: telltales
+        anchors.top: parent.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        width: parent.width * 0.8
+    }
+    
+    // Digital Speed (no gauge arcs until the cluster is loaded)
+    Column {
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.bottom: parent.bottom
+        anchors.bottomMargin: Style.spacing48
+        
+        Text {
+            text: InputStatus.speedStale
+                  ? "--" : Math.round(speedReadout.value)
+            color: Style.textPrimary
+            font.pixelSize: Style.fontSizePrimary
+            font.bold: true
+            font.family: Style.monoFont
+            anchors.horizontalCenter: parent.horizontalCenter
+        }
+        
+        Text {
+            text: "km/h"
+            color: Style.textSecondary
+            font.pixelSize: Style.fontSizeMedium
+            anchors.horizontalCenter: parent.horizontalCenter
+        }
+    }
+    
+    Component.onCompleted: BootTimer.mark("boot-layer-created")
+}
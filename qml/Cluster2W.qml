@@ -1,12 +1,17 @@
 import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
+import EVComponents 1.0
 import "."
 
 Item {
     id: root
     anchors.fill: parent
     
+    // Text readouts at glance rate, averaged so the digits do not flicker
+    SignalSubscription { id: speedReadout; signalName: "speed"; rate: 8; filter: SignalSubscription.Mean }
+    SignalSubscription { id: powerReadout; signalName: "powerOutput"; rate: 4; filter: SignalSubscription.Mean }
+    
     // 2-Wheeler: SIMPLIFIED LAYOUT (Template 3)
     // Structure: Top Bar | Speed Hero | Battery Bar | Bottom Info
     
@@ -39,11 +44,7 @@ Item {
                 }
                 
                 Text {
-                    text: {
-                        if (VehicleData.driveMode === 0) return "ECO";
-                        else if (VehicleData.driveMode === 1) return "NORMAL";
-                        else return "SPORT";
-                    }
+                    text: VehicleData.driveModeName
                     color: {
                         if (VehicleData.driveMode === 0) return Style.accent;
                         else if (VehicleData.driveMode === 1) return Style.primary;
@@ -105,7 +106,8 @@ Item {
             
             // MASSIVE Speed Number for Rider Glance
             Text {
-                text: Math.round(VehicleData.speed)
+                text: InputStatus.speedStale
+                      ? "--" : Math.round(speedReadout.value)
                 color: Style.textPrimary
                 font.pixelSize: Style.fontSizeHero2W
                 font.bold: true
@@ -205,8 +207,9 @@ Item {
                 spacing: 4
                 
                 Text {
-                    text: VehicleData.powerOutput.toFixed(1)
-                    color: VehicleData.powerOutput < 0 ? Style.accent : Style.textPrimary
+                    text: InputStatus.powerStale
+                          ? "--" : powerReadout.value.toFixed(1)
+                    color: powerReadout.value < 0 ? Style.accent : Style.textPrimary
                     font.pixelSize: Style.fontSizeSecondary
                     font.bold: true
                     anchors.horizontalCenter: parent.horizontalCenter
@@ -1,12 +1,17 @@
 import QtQuick
 import QtQuick.Layouts
 import QtQuick.Controls
+import EVComponents 1.0
 import "."
 
 Item {
     id: root
     anchors.fill: parent
     
+    // Power text at glance rate; the bar marker low-passed at 20 Hz
+    SignalSubscription { id: powerReadout; signalName: "powerOutput"; rate: 4; filter: SignalSubscription.Mean }
+    SignalSubscription { id: powerMarker; signalName: "powerOutput"; rate: 20; filter: SignalSubscription.LowPass; cutoff: 3 }
+    
     // 4-Wheeler: DUAL GAUGE LAYOUT (Template 1)
     // Structure: Top Bar | Left Gauge | Center Battery | Right Gauge | Bottom Bar
     
@@ -38,11 +43,7 @@ Item {
                 }
                 
                 Text {
-                    text: {
-                        if (VehicleData.driveMode === 0) return "ECO";
-                        else if (VehicleData.driveMode === 1) return "NORMAL";
-                        else return "SPORT";
-                    }
+                    text: VehicleData.driveModeName
                     color: {
                         if (VehicleData.driveMode === 0) return Style.accent;
                         else if (VehicleData.driveMode === 1) return Style.primary;
@@ -96,7 +97,7 @@ Item {
                     Text {
                         text: "⚠️"
                         font.pixelSize: Style.iconSmall
-                        visible: VehicleData.batterySoc < 20
+                        visible: VehicleData.lowBattery
                     }
                     
                     Text {
@@ -131,7 +132,7 @@ Item {
                     anchors.centerIn: parent
                     width: Style.gaugeWidth
                     height: Style.gaugeWidth
-                    speed: VehicleData.speed
+                    stale: InputStatus.speedStale
                 }
             }
             
@@ -221,10 +222,11 @@ Item {
                         spacing: Style.spacing8
                         
                         Text {
-                            text: VehicleData.powerOutput.toFixed(1)
-                            color: VehicleData.powerOutput < 0 ? Style.accent : 
-                                   VehicleData.powerOutput < 20 ? Style.primary :
-                                   VehicleData.powerOutput < 50 ? Style.warning : Style.critical
+                            text: InputStatus.powerStale
+                                  ? "--" : powerReadout.value.toFixed(1)
+                            color: powerReadout.value < 0 ? Style.accent : 
+                                   powerReadout.value < 20 ? Style.primary :
+                                   powerReadout.value < 50 ? Style.warning : Style.critical
                             font.pixelSize: Style.fontSizeHero
                             font.bold: true
                             anchors.horizontalCenter: parent.horizontalCenter
@@ -238,7 +240,7 @@ Item {
                         }
                         
                         Text {
-                            text: VehicleData.powerOutput < 0 ? "(Regen)" : ""
+                            text: VehicleData.powerDirection === EVVehicleData.Regen ? "(Regen)" : ""
                             color: Style.accent
                             font.pixelSize: Style.fontSizeLabel
                             anchors.horizontalCenter: parent.horizontalCenter
@@ -266,17 +268,15 @@ Item {
                         Rectangle {
                             anchors.verticalCenter: parent.verticalCenter
                             x: {
-                                var maxPower = 150; // Max power output
-                                var maxRegen = 50;  // Max regen
-                                var normalized = VehicleData.powerOutput >= 0 ? 
-                                    (VehicleData.powerOutput / maxPower) : 
-                                    (VehicleData.powerOutput / maxRegen);
+                                var normalized = powerMarker.value >= 0 ? 
+                                    (powerMarker.value / VehicleProfile.maxMotorPowerKw) : 
+                                    (powerMarker.value / VehicleProfile.maxRegenPowerKw);
                                 return parent.width/2 + (normalized * parent.width/2) - width/2;
                             }
                             width: 12
                             height: 12
                             radius: 6
-                            color: VehicleData.powerOutput < 0 ? Style.accent : Style.critical
+                            color: powerMarker.value < 0 ? Style.accent : Style.critical
                         }
                     }
                 }
@@ -1,13 +1,13 @@
 import QtQuick
-import QtQuick.Shapes
+import EVComponents 1.0
 
 Item {
     id: root
     width: 300
     height: 150
     
-    property var historyData: [15, 18, 14, 16, 20, 15, 12, 18, 22, 19] // Wh/km or kWh/100km
-    property real maxVal: 30
+    property ConsumptionSeries series: VehicleData.consumptionSeries
+    property real maxVal: 300 // Wh/km
     property real minVal: 0
 
     Rectangle {
@@ -18,7 +18,7 @@ Item {
     }
 
     Text {
-        text: "Consumption (last 10km)"
+        text: "Consumption (last " + (root.series ? root.series.count : 0) + " km)"
         color: "#888888"
         font.pixelSize: 12
         anchors.top: parent.top
@@ -26,25 +26,14 @@ Item {
         anchors.margins: 10
     }
 
-    Shape {
+    // Native scene-graph line: one bucket per pixel, O(1) vertex update per km
+    EfficiencyGraphItem {
         anchors.fill: parent
         anchors.margins: 15
         anchors.topMargin: 30
-
-        ShapePath {
-            strokeColor: "#00E676"
-            strokeWidth: 2
-            fillColor: "#3300E676"
-            startX: 0
-            startY: root.height - 45 // Bottom
-            
-            // Path logic would go here dynamically based on historyData
-            // For now, let's just draw a Mockup curve
-            PathLine { x: 0; y: 50 }
-            PathCubic { control1X: 50; control1Y: 10; control2X: 100; control2Y: 80; x: 150; y: 40 }
-            PathCubic { control1X: 200; control1Y: 0; control2X: 250; control2Y: 60; x: 270; y: 30 }
-            PathLine { x: 270; y: root.height - 45 }
-            PathLine { x: 0; y: root.height - 45 }
-        }
+        series: root.series
+        minValue: root.minVal
+        maxValue: root.maxVal
+        lineColor: "#00E676"
     }
 }
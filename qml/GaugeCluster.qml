@@ -17,6 +17,8 @@ Item {
             Layout.alignment: Qt.AlignVCenter
             Layout.fillHeight: true
             Layout.preferredWidth: parent.width * 0.25
+            maxPower: VehicleProfile.maxMotorPowerKw
+            maxRegen: VehicleProfile.maxRegenPowerKw
         }
         
         // Speedometer
@@ -24,7 +26,6 @@ Item {
             Layout.alignment: Qt.AlignVCenter
             Layout.fillHeight: true
             Layout.preferredWidth: parent.width * 0.4
-            speed: root.speed
         }
     }
 }
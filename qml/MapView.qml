@@ -57,7 +57,7 @@ Item {
                 id: markerImage
                 width: 32
                 height: 32
-                source: "qrc:/assets/icons/navigation_arrow.svg" // We need to create this later or use a shape
+                source: "image://icons/navigation_arrow"
                 
                 // Fallback shape if icon missing
                 Rectangle {
@@ -90,16 +90,21 @@ Item {
             opacity: 0.5
         }
         
-        // Mock Route (Energy Optimized)
+        // Energy-optimal route from the on-board planner
         MapPolyline {
+            visible: Navigation.active
             line.width: 5
             line.color: "#2979FF"
-            path: [
-                { latitude: 28.6139, longitude: 77.2090 },
-                { latitude: 28.6150, longitude: 77.2095 },
-                { latitude: 28.6200, longitude: 77.2100 },
-                { latitude: 28.6250, longitude: 77.2150 }
-            ]
+            path: Navigation.path
+        }
+
+        // Long press anywhere to route there
+        TapHandler {
+            enabled: Navigation.available
+            onLongPressed: {
+                var destination = map.toCoordinate(point.position)
+                Navigation.routeTo(destination.latitude, destination.longitude)
+            }
         }
         
         // Dynamic Charging Stations from Model
@@ -120,6 +125,11 @@ Item {
                 sourceItem: ChargingStationMarker {
                     verified: ver
                     power: pwr
+
+                    TapHandler {
+                        enabled: Navigation.available
+                        onTapped: Navigation.routeTo(lat, lon)
+                    }
                 }
             }
         }
@@ -159,6 +169,57 @@ Item {
         }
     }
     
+    // Turn-by-turn banner
+    Rectangle {
+        visible: VehicleData.navigationActive
+        anchors.top: parent.top
+        anchors.horizontalCenter: parent.horizontalCenter
+        anchors.topMargin: 10
+        width: turnRow.width + 24
+        height: 56
+        radius: 8
+        color: "#CC1a1a1a"
+
+        Row {
+            id: turnRow
+            anchors.centerIn: parent
+            spacing: 12
+
+            Image {
+                width: 36
+                height: 36
+                anchors.verticalCenter: parent.verticalCenter
+                source: VehicleData.nextTurnIcon !== "" ? "image://icons/" + VehicleData.nextTurnIcon : ""
+            }
+
+            Column {
+                anchors.verticalCenter: parent.verticalCenter
+                Text {
+                    text: VehicleData.nextTurnDistance + (Navigation.nextStreet !== "" ? "  " + Navigation.nextStreet : "")
+                    color: "white"
+                    font.pixelSize: 18
+                    font.bold: true
+                }
+                Text {
+                    text: VehicleData.distToDestination.toFixed(1) + " km · ETA " + VehicleData.destinationEta
+                          + " · " + Navigation.energyKwh.toFixed(1) + " kWh"
+                    color: "#888"
+                    font.pixelSize: 12
+                }
+            }
+
+            Button {
+                text: "✕"
+                width: 30
+                height: 30
+                anchors.verticalCenter: parent.verticalCenter
+                onClicked: Navigation.cancel()
+                background: Rectangle { color: "#333"; radius: 4 }
+                contentItem: Text { text: parent.text; color: "white"; anchors.centerIn: parent }
+            }
+        }
+    }
+
     // Efficiency Overlay used to be here, but now it's part of the route logic implicitly visually
     
     // Zoom Controls
@@ -1,16 +1,15 @@
 import QtQuick
 import QtQuick.Shapes
+import EVComponents 1.0
 import "."
 
 Item {
     id: root
-    property real power: 0 // +kW consumption, -kW regen
-    property real animatedPower: 0
+    property string signalName: "powerOutput"
     
-    Behavior on animatedPower {
-        SmoothedAnimation { velocity: 100; duration: 300 }
-    }
-    onPowerChanged: animatedPower = power
+    // +kW consumption, -kW regen, interpolated to each frame's presentation time
+    InterpolatedSignal { id: powerTrack; signalName: root.signalName }
+    property real animatedPower: powerTrack.value
     property real maxPower: 150
     property real maxRegen: 50
 
@@ -119,9 +118,12 @@ Item {
         }
     }
 
-    Text {
+    NumericReadout {
         anchors.centerIn: parent
-        text: Math.abs(animatedPower).toFixed(0) + " kW"
+        value: animatedPower
+        absolute: true
+        unit: "kW"
+        showUnit: true
         color: animatedPower < 0 ? Style.regenColor : Style.textPrimary
         font.pixelSize: 32
         font.bold: true
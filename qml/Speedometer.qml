@@ -1,20 +1,19 @@
 import QtQuick
 import QtQuick.Shapes
+import EVComponents 1.0
 import "."
 
 Item {
     id: root
-    property real speed: 0
-    property real animatedSpeed: 0
+    property string signalName: "speed"
     
-    Behavior on animatedSpeed {
-        SmoothedAnimation { velocity: 150; duration: 400 }
-    }
+    // Interpolated to each frame's presentation time from timestamped samples
+    InterpolatedSignal { id: speedTrack; signalName: root.signalName }
+    property real animatedSpeed: Math.max(0, speedTrack.value)
     
-    // Update animatedSpeed when speed changes, but we use animatedSpeed for display
-    onSpeedChanged: animatedSpeed = speed
     property real maxSpeed: 150
     property bool metric: true
+    property bool stale: false  // No fresh speed source - blank the readout
 
     width: 300
     height: 300
@@ -78,17 +77,21 @@ Item {
     Column {
         anchors.centerIn: parent
         
-        Text {
-            text: animatedSpeed.toFixed(0)
+        NumericReadout {
+            id: speedText
+            value: animatedSpeed
+            quantity: NumericReadout.Speed
+            imperial: !metric
+            stale: root.stale
             color: Style.textPrimary
             font.pixelSize: Style.fontSizeHuge
             font.bold: true
-            font.family: Style.monoFont  // Monospace to prevent jitter
+            font.family: Style.monoFont
             anchors.horizontalCenter: parent.horizontalCenter
         }
         
         Text {
-            text: metric ? "km/h" : "mph"
+            text: speedText.unitLabel
             color: Style.textSecondary
             font.pixelSize: Style.fontSizeMedium
             font.family: Style.fontFamily
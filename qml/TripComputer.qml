@@ -1,5 +1,6 @@
 import QtQuick
 import QtQuick.Layouts
+import EVComponents 1.0
 import "."
 
 Item {
@@ -31,8 +32,11 @@ Item {
             font.bold: true
         }
 
-        Text {
-            text: odometer.toFixed(1) + " km"
+        NumericReadout {
+            value: odometer
+            decimals: 1
+            quantity: NumericReadout.Distance
+            showUnit: true
             color: "white"
             font.pixelSize: 18
             font.family: Style.monoFont
@@ -47,8 +51,11 @@ Item {
             ColumnLayout {
                 Layout.preferredWidth: 80  // Fixed width
                 Text { text: "TRIP A"; color: "#888888"; font.pixelSize: 10 }
-                Text { 
-                    text: tripA.toFixed(1) + " km"
+                NumericReadout {
+                    value: tripA
+                    decimals: 1
+                    quantity: NumericReadout.Distance
+                    showUnit: true
                     color: "white"
                     font.pixelSize: 14
                     font.family: Style.monoFont
@@ -9,8 +9,8 @@ Item {
     // Bindings
     property bool ready: VehicleData.readyToDrive
     property bool bmsWarning: VehicleData.bmsWarning
-    property bool tempWarning: VehicleData.tempWarning || VehicleData.motorTemp > 80
-    property bool lowBattery: VehicleData.batterySoc < 20
+    property bool tempWarning: VehicleData.thermalWarning
+    property bool lowBattery: VehicleData.lowBattery
     property bool hvWarning: VehicleData.hvWarning
     property bool motorFault: VehicleData.motorFault
     property bool reducedPower: VehicleData.reducedPower
@@ -27,6 +27,16 @@ Item {
     property bool door: VehicleData.doorAjar
     property bool low12v: VehicleData.low12V
 
+    // Icons come pre-rasterized from the build-time atlas (assets/icons) and
+    // share one texture, so the row can batch into a single draw call
+    component Telltale: Image {
+        property string icon
+        property int size: 28
+        source: "image://icons/" + icon
+        Layout.preferredWidth: size
+        Layout.preferredHeight: size
+    }
+
     // Status Bar Layout
     RowLayout {
         anchors.fill: parent
@@ -34,81 +44,48 @@ Item {
         spacing: 20
         
         // --- TURN SIGNALS ---
-        Text {
-            text: "⬅️"
-            font.pixelSize: 32
-            color: root.leftTurn ? "#00E676" : "#222"
-            opacity: root.leftTurn ? 1.0 : 0.1
-            
-            SequentialAnimation on opacity {
-                running: root.leftTurn
-                loops: Animation.Infinite
-                NumberAnimation { to: 0.1; duration: 400 }
-                NumberAnimation { to: 1.0; duration: 400 }
-            }
+        Telltale {
+            icon: "turn_left"
+            size: 32
+            // Shared clock keeps both indicators (hazards) in phase
+            opacity: root.leftTurn && BlinkClock.on ? 1.0 : 0.1
         }
         
         // --- CRITICAL WARNINGS ---
         
-        // HV Warning with pulse
-        Text {
-            text: "⚡HV"
-            font.pixelSize: 24
-            color: "red"
+        // HV Warning, flashing
+        Telltale {
+            icon: "hv_warning"
             visible: root.hvWarning
-            
-            SequentialAnimation on opacity {
-                running: root.hvWarning
-                loops: Animation.Infinite
-                NumberAnimation { to: 0.3; duration: 500 }
-                NumberAnimation { to: 1.0; duration: 500 }
-            }
+            opacity: BlinkClock.on ? 1.0 : 0.3
         }
         
-        // BMS Warning with pulse
+        // BMS Warning, flashing
         Rectangle {
             visible: root.bmsWarning
             width: 50; height: 26
             color: "red"
             radius: 4
             Text { anchors.centerIn: parent; text: "BMS"; color: "white"; font.bold: true }
-            
-            SequentialAnimation on scale {
-                running: root.bmsWarning
-                loops: Animation.Infinite
-                NumberAnimation { to: 1.1; duration: 600 }
-                NumberAnimation { to: 1.0; duration: 600 }
-            }
+            opacity: BlinkClock.on ? 1.0 : 0.6
         }
         
-        // Motor Fault with pulse
-        Text {
-            text: "⚠️ MOTOR"
-            font.pixelSize: 20
-            color: "red"
+        // Motor Fault, flashing
+        Telltale {
+            icon: "motor_fault"
             visible: root.motorFault
-            
-            SequentialAnimation on opacity {
-                running: root.motorFault
-                loops: Animation.Infinite
-                NumberAnimation { to: 0.3; duration: 500 }
-                NumberAnimation { to: 1.0; duration: 500 }
-            }
+            opacity: BlinkClock.on ? 1.0 : 0.3
         }
         
         // Thermal
-        Text {
-            text: "🌡️"
-            font.pixelSize: 24
-            color: root.tempWarning ? "orange" : "#222"
+        Telltale {
+            icon: "temperature"
             visible: root.tempWarning
         }
         
         // Turtle (Reduced Power)
-        Text {
-            text: "🐢"
-            font.pixelSize: 24
-            color: "orange"
+        Telltale {
+            icon: "reduced_power"
             visible: root.reducedPower
         }
 
@@ -116,9 +93,9 @@ Item {
         Text { text: "ABS"; color: "orange"; font.bold: true; visible: root.abs }
         Text { text: "TC"; color: "orange"; font.bold: true; visible: root.tc }
         Text { text: "BRAKE"; color: "red"; font.bold: true; visible: root.park }
-        Text { text: "💺"; color: "red"; font.pixelSize: 24; visible: root.seatbelt }
-        Text { text: "🚪"; color: "red"; font.pixelSize: 24; visible: root.door }
-        Text { text: "🔋12V"; color: "red"; font.pixelSize: 18; font.bold: true; visible: root.low12v }
+        Telltale { icon: "seatbelt"; visible: root.seatbelt }
+        Telltale { icon: "door_ajar"; visible: root.door }
+        Telltale { icon: "battery_12v"; visible: root.low12v }
 
         Item { Layout.fillWidth: true } // Spacer
 
@@ -134,10 +111,8 @@ Item {
         }
         
         // High Beam
-        Text {
-            text: "EO" // Glyph
-            color: root.highBeam ? "#2979FF" : "#222"
-            font.pixelSize: 24
+        Telltale {
+            icon: "high_beam"
             visible: root.highBeam
         }
         
@@ -150,18 +125,11 @@ Item {
         }
 
         // --- RIGHT TURN ---
-        Text {
-            text: "➡️"
-            font.pixelSize: 32
-            color: root.rightTurn ? "#00E676" : "#222"
-            opacity: root.rightTurn ? 1.0 : 0.1
-            
-            SequentialAnimation on opacity {
-                running: root.rightTurn
-                loops: Animation.Infinite
-                NumberAnimation { to: 0.1; duration: 400 }
-                NumberAnimation { to: 1.0; duration: 400 }
-            }
+        Telltale {
+            icon: "turn_right"
+            size: 32
+            // Shared clock keeps both indicators (hazards) in phase
+            opacity: root.rightTurn && BlinkClock.on ? 1.0 : 0.1
         }
     }
 }
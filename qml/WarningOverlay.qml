@@ -1,14 +1,17 @@
 import QtQuick
 import QtQuick.Layouts
+import EVComponents 1.0
 import "."
 
 Item {
     id: root
     anchors.fill: parent
     
+    SignalSubscription { id: speedReadout; signalName: "speed"; rate: 4; filter: SignalSubscription.Mean }
+    
     // Overspeed Warning (Subtle - top right corner)
     Rectangle {
-        visible: VehicleData.speed > 120
+        visible: VehicleData.overspeed
         width: 200
         height: 60
         radius: 30
@@ -28,13 +31,7 @@ Item {
                 text: "⚠️"
                 font.pixelSize: 28
                 color: Style.warning
-                
-                SequentialAnimation on opacity {
-                    running: parent.parent.parent.visible
-                    loops: Animation.Infinite
-                    NumberAnimation { to: 0.4; duration: 600 }
-                    NumberAnimation { to: 1.0; duration: 600 }
-                }
+                opacity: BlinkClock.on ? 1.0 : 0.4
             }
             
             Column {
@@ -47,22 +44,16 @@ Item {
                     color: Style.warning
                 }
                 
-                Text {
-                    text: Math.round(VehicleData.speed) + " km/h"
+                NumericReadout {
+                    value: speedReadout.value
+                    quantity: NumericReadout.Speed
+                    showUnit: true
                     font.pixelSize: 20
                     font.bold: true
                     color: Style.textPrimary
                 }
             }
         }
-        
-        // Subtle pulse
-        SequentialAnimation on scale {
-            running: visible
-            loops: Animation.Infinite
-            NumberAnimation { to: 1.05; duration: 800 }
-            NumberAnimation { to: 1.0; duration: 800 }
-        }
     }
     
     // High Temperature Warning (Critical - center overlay)
@@ -81,20 +72,12 @@ Item {
             anchors.centerIn: parent
             spacing: Style.spacing24
             
-            // Warning icon with shake
+            // Warning icon, rocking with the fast flash
             Text {
                 text: "🌡️"
                 font.pixelSize: 100
                 anchors.horizontalCenter: parent.horizontalCenter
-                
-                SequentialAnimation on rotation {
-                    running: parent.parent.parent.visible
-                    loops: Animation.Infinite
-                    NumberAnimation { to: -15; duration: 150 }
-                    NumberAnimation { to: 15; duration: 150 }
-                    NumberAnimation { to: 0; duration: 150 }
-                    PauseAnimation { duration: 1000 }
-                }
+                rotation: BlinkClock.fast ? -10 : 10
             }
             
             Text {
@@ -103,13 +86,7 @@ Item {
                 font.bold: true
                 color: Style.critical
                 anchors.horizontalCenter: parent.horizontalCenter
-                
-                SequentialAnimation on opacity {
-                    running: parent.parent.parent.visible
-                    loops: Animation.Infinite
-                    NumberAnimation { to: 0.5; duration: 500 }
-                    NumberAnimation { to: 1.0; duration: 500 }
-                }
+                opacity: BlinkClock.on ? 1.0 : 0.5
             }
             
             Row {
@@ -171,13 +148,8 @@ Item {
             }
         }
         
-        // Red pulsing edge glow
-        SequentialAnimation on opacity {
-            running: visible
-            loops: Animation.Infinite
-            NumberAnimation { to: 0.8; duration: 700 }
-            NumberAnimation { to: 1.0; duration: 700 }
-        }
+        // Red flashing edge
+        opacity: BlinkClock.on ? 1.0 : 0.8
     }
     
     // Low Battery Health Warning (Center overlay)
@@ -187,7 +159,8 @@ Item {
         height: 280
         radius: 20
         color: "#DD000000"
-        border.color: Style.warning
+        // Degraded pack: border flashes red
+        border.color: VehicleData.batterySoh < 70 && BlinkClock.on ? Style.critical : Style.warning
         border.width: 4
         anchors.centerIn: parent
         z: 190
@@ -251,14 +224,6 @@ Item {
                 anchors.horizontalCenter: parent.horizontalCenter
             }
         }
-        
-        // Pulse animation
-        SequentialAnimation on scale {
-            running: visible && VehicleData.batterySoh < 70
-            loops: Animation.Infinite
-            NumberAnimation { to: 1.03; duration: 800 }
-            NumberAnimation { to: 1.0; duration: 800 }
-        }
     }
     
     // Critical Battery Low + Speed Warning Combo (if both)
@@ -268,7 +233,8 @@ Item {
         height: 200
         radius: 20
         color: "#EE000000"
-        border.color: Style.critical
+        // Fast flash for the critical combo
+        border.color: BlinkClock.fast ? Style.critical : "#550000"
         border.width: 5
         anchors.top: parent.top
         anchors.horizontalCenter: parent.horizontalCenter
@@ -285,13 +251,7 @@ Item {
                 font.bold: true
                 color: Style.critical
                 anchors.horizontalCenter: parent.horizontalCenter
-                
-                SequentialAnimation on opacity {
-                    running: parent.parent.parent.visible
-                    loops: Animation.Infinite
-                    NumberAnimation { to: 0.3; duration: 400 }
-                    NumberAnimation { to: 1.0; duration: 400 }
-                }
+                opacity: BlinkClock.on ? 1.0 : 0.3
             }
             
             Row {
@@ -323,8 +283,10 @@ Item {
                         color: Style.textSecondary
                         anchors.horizontalCenter: parent.horizontalCenter
                     }
-                    Text {
-                        text: Math.round(VehicleData.speed) + " km/h"
+                    NumericReadout {
+                        value: speedReadout.value
+                        quantity: NumericReadout.Speed
+                        showUnit: true
                         font.pixelSize: 48
                         font.bold: true
                         color: Style.critical
@@ -341,13 +303,5 @@ Item {
                 anchors.horizontalCenter: parent.horizontalCenter
             }
         }
-        
-        // Aggressive pulse for critical combo
-        SequentialAnimation on scale {
-            running: visible
-            loops: Animation.Infinite
-            NumberAnimation { to: 1.08; duration: 500 }
-            NumberAnimation { to: 1.0; duration: 500 }
-        }
     }
 }
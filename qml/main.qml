@@ -17,36 +17,59 @@ Window {
         color: Style.background
     }
 
-    property bool isBike: false // Default to Car (4W)
+    property bool isBike: VehicleProfile.isBike // From config/vehicle.json
 
     // Root Item to handle state switching
     Item {
         anchors.fill: parent
         
         // Loader for 2W vs 4W Cluster
+        // Staged boot: streamed in behind the boot layer once the first frame is on screen
         Loader {
             id: clusterLoader
             anchors.fill: parent
+            asynchronous: StagedBoot
+            active: !StagedBoot || BootTimer.firstFrameMs >= 0
             source: isBike ? "Cluster2W.qml" : "Cluster4W.qml"
+            onLoaded: BootTimer.mark("cluster-loaded")
         }
     }
 
     
     // Charging Overlay (Visible when charging)
-    ChargingScreen {
+    Loader {
+        id: chargingLoader
         anchors.fill: parent
+        asynchronous: StagedBoot
+        active: clusterLoader.status === Loader.Ready
         visible: VehicleData.chargingActive
         z: 10
+        source: "ChargingScreen.qml"
     }
     
     // Settings Screen Overlay (Hidden by Default)
-    Settings {
-        id: settingsScreen
+    Loader {
+        id: settingsLoader
         anchors.centerIn: parent
         width: parent.width * 0.8
         height: parent.height * 0.8
-        visible: false
+        asynchronous: StagedBoot
+        active: clusterLoader.status === Loader.Ready
         z: 50
+        sourceComponent: Settings {
+            visible: false
+        }
+    }
+    
+    // Boot Layer - minimal telltales & speed, first thing on screen
+    BootLayer {
+        id: bootLayer
+        anchors.fill: parent
+        z: 150
+        visible: opacity > 0
+        opacity: StagedBoot ? 1.0 : 0.0
+        
+        Behavior on opacity { NumberAnimation { duration: 300 } }
     }
     
     // Start Overlay (logo etc)
@@ -70,7 +93,7 @@ Window {
         
         SequentialAnimation {
             id: startupSequence
-            running: true
+            running: clusterLoader.status === Loader.Ready
             
             // 1. Logo Fade In
             NumberAnimation { target: logoText; property: "opacity"; to: 1.0; duration: 1000; easing.type: Easing.InOutQuad }
@@ -89,7 +112,10 @@ Window {
             ScriptAction {
                 script: {
                     // Optional: Signal backend to do a sweep if supported
-                    // console.log("Startup complete")
+                    // Cluster is fully up - hand telltales over to it
+                    bootLayer.opacity = 0.0
+                    BootTimer.mark("startup-complete")
+                    BootTimer.report()
                 }
             }
         }
@@ -101,7 +127,10 @@ Window {
     
     Shortcut {
         sequence: "S"
-        onActivated: settingsScreen.visible = !settingsScreen.visible
+        onActivated: {
+            if (settingsLoader.item)
+                settingsLoader.item.visible = !settingsLoader.item.visible
+        }
     }
     
     Shortcut {
@@ -112,7 +141,8 @@ Window {
     Shortcut {
         sequence: "Esc"
         onActivated: {
-            settingsScreen.visible = false
+            if (settingsLoader.item)
+                settingsLoader.item.visible = false
         }
     }
 }
@@ -0,0 +1,91 @@
+#version 440
+
+layout(location = 0) in vec2 vLocal;
+layout(location = 1) in vec2 vPos;
+layout(location = 2) in float vAlpha;
+layout(location = 3) flat in int vKind;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float time;
+    float level;
+    float intensity;
+    vec4 color;
+    vec4 fillRect;
+    vec4 flowRect;
+    vec2 size;
+};
+
+const int KindOrb = 0;
+const int KindBubble = 3;
+const int KindFill = 2;
+const int KindHalo = 4;
+
+const float TwoPi = 6.2831853;
+const vec3 InteriorColor = vec3(0.067);   // #111
+
+// Signed distance to a rounded box centred on the origin
+float roundedBox(vec2 p, vec2 halfSize, float radius)
+{
+    vec2 q = abs(p) - halfSize + radius;
+    return length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+}
+
+vec4 batteryFill()
+{
+    vec2 p = vPos - fillRect.xy;
+    float w = fillRect.z;
+    float h = fillRect.w;
+
+    float inside = clamp(0.5 - roundedBox(p - 0.5 * vec2(w, h), 0.5 * vec2(w, h), 12.0), 0.0, 1.0);
+
+    // Two counter-moving waves on the liquid surface
+    float wave = 2.0 * sin(TwoPi * (p.x / w - time / 3.0))
+               + 1.5 * sin(TwoPi * (1.5 * p.x / w + time / 2.4));
+    float surface = h * (1.0 - level) + (level > 0.0 && level < 1.0 ? wave : 0.0);
+    float liquid = clamp(p.y - surface + 0.5, 0.0, 1.0) * step(0.001, level);
+
+    float depth = clamp((p.y - surface) / max(1.0, h - surface), 0.0, 1.0);
+    vec3 lit = min(color.rgb * 1.4, vec3(1.0));
+    vec3 liquidColor = depth < 0.5 ? mix(lit, color.rgb, depth * 2.0)
+                                   : mix(color.rgb, color.rgb / 1.3, depth * 2.0 - 1.0);
+
+    // Bright band just under the surface
+    liquidColor = mix(liquidColor, min(color.rgb * 1.7, vec3(1.0)),
+                      0.3 * (1.0 - smoothstep(0.0, 8.0, p.y - surface)));
+
+    // Shimmer: 2 s sweep, 1.5 s rest
+    float sweep = clamp(mod(time, 3.5) / 2.0, 0.0, 1.0);
+    sweep = sweep < 0.5 ? 2.0 * sweep * sweep : 1.0 - 2.0 * (1.0 - sweep) * (1.0 - sweep);
+    float shimmerX = mix(-60.0, w + 60.0, sweep);
+    float shimmer = 0.25 * (1.0 - smoothstep(0.0, 30.0, abs(p.x - shimmerX)));
+    liquidColor = mix(liquidColor, vec3(1.0), shimmer);
+
+    vec3 rgb = mix(InteriorColor, liquidColor, liquid);
+    return vec4(rgb, 1.0) * inside;
+}
+
+void main()
+{
+    vec4 result;
+    if (vKind == KindFill) {
+        result = batteryFill();
+    } else {
+        float d = length(vLocal);
+        float coverage;
+        if (vKind == KindOrb || vKind == KindHalo) {
+            coverage = 1.0 - smoothstep(0.0, 1.0, d);     // Soft glow
+        } else {
+            float aa = max(fwidth(d), 0.001);
+            coverage = 1.0 - smoothstep(1.0 - aa, 1.0, d);
+        }
+        vec3 rgb = vKind == KindBubble ? vec3(1.0)
+                 : vKind == KindHalo ? mix(color.rgb, vec3(1.0), 0.5)
+                 : color.rgb;
+        result = vec4(rgb, 1.0) * coverage * vAlpha;
+    }
+    fragColor = result * qt_Opacity;   // Premultiplied
+}
@@ -0,0 +1,108 @@
+#version 440
+
+// Every primitive of the charging effect is a quad whose corners are fixed
+// at build time; placement, size and fade are computed here from the time
+// uniform, so the CPU never touches the vertex buffer while animating.
+
+layout(location = 0) in vec2 corner;    // Quad corner, -1..1
+layout(location = 1) in vec4 params;    // kind, index, seedA, seedB
+
+layout(location = 0) out vec2 vLocal;   // Corner, interpolated across the quad
+layout(location = 1) out vec2 vPos;     // Item coordinates
+layout(location = 2) out float vAlpha;
+layout(location = 3) flat out int vKind;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float time;
+    float level;
+    float intensity;
+    vec4 color;
+    vec4 fillRect;
+    vec4 flowRect;
+    vec2 size;
+};
+
+out gl_PerVertex { vec4 gl_Position; };
+
+const int KindOrb = 0;
+const int KindParticle = 1;
+const int KindFill = 2;
+const int KindBubble = 3;
+const int KindHalo = 4;
+const int KindFlowDot = 5;
+
+const float TwoPi = 6.2831853;
+
+// Piecewise-linear fade: rise to peak, decay to tail, drop to zero, rest
+float envelope(float p, float rise, float hold, float fall, float peak, float tail)
+{
+    if (p < rise) return peak * p / rise;
+    if (p < hold) return mix(peak, tail, (p - rise) / (hold - rise));
+    if (p < fall) return mix(tail, 0.0, (p - hold) / (fall - hold));
+    return 0.0;
+}
+
+void main()
+{
+    int kind = int(params.x + 0.5);
+    float index = params.y;
+    float seedA = params.z;
+    float seedB = params.w;
+
+    vec2 center = vec2(0.0);
+    vec2 extent = vec2(0.0);
+    float alpha = 0.0;
+
+    if (kind == KindOrb) {
+        // Large dim glows breathing in place
+        float phase = time / 6.0 - index * 0.5 / 6.0;
+        float scale = 1.3 - 0.5 * cos(TwoPi * phase);
+        center = vec2(seedA, seedB) * size;
+        extent = vec2((15.0 + 15.0 * seedA) * scale);
+        alpha = 0.05 - 0.03 * cos(TwoPi * time / 5.0 - index * 0.5);
+    } else if (kind == KindParticle) {
+        // Rising motes with an ease-out climb, staggered by index
+        float period = 4.0 + 2.0 * seedA;
+        float p = fract((time - index * 0.4) / period);
+        float climb = 1.0 - (1.0 - p) * (1.0 - p);
+        center = vec2(size.x * (0.2 + 0.6 * seedB), mix(size.y, -20.0, climb));
+        extent = vec2(3.0 + 5.0 * seedA);
+        alpha = envelope(p, 0.15, 0.65, 0.75, 0.4, 0.15) * (0.6 + 0.4 * intensity);
+    } else if (kind == KindFill) {
+        // Battery interior; the fragment stage draws liquid, waves and shimmer
+        center = fillRect.xy + 0.5 * fillRect.zw;
+        extent = 0.5 * fillRect.zw;
+        alpha = 1.0;
+    } else if (kind == KindBubble) {
+        float period = 2.5 + 1.0 * seedA;
+        float p = fract((time - index * 0.6) / period);
+        float surface = fillRect.y + fillRect.w * (1.0 - level);
+        float bottom = fillRect.y + fillRect.w;
+        center = vec2(fillRect.x + 20.0 + seedB * max(0.0, fillRect.z - 40.0), mix(bottom, surface, p));
+        extent = vec2(2.0 + 3.0 * seedA);
+        alpha = envelope(p, 0.15, 0.1501, 0.75, 0.5, 0.5) * step(0.05, level);
+    } else if (kind == KindHalo) {
+        // Glow behind the bolt, pulsing with the charge
+        center = fillRect.xy + 0.5 * fillRect.zw;
+        float pulse = 0.5 - 0.5 * cos(TwoPi * time / 1.2);
+        extent = vec2(fillRect.w * (0.35 + 0.08 * pulse));
+        alpha = (0.15 + 0.2 * pulse) * (0.5 + 0.5 * intensity);
+    } else if (kind == KindFlowDot) {
+        // Chase of dots: grow and brighten, shrink and fade, rest
+        float p = fract(time - index * 0.18);
+        float swell = p < 0.3 ? p / 0.3 : p < 0.8 ? 1.0 - (p - 0.3) / 0.5 : 0.0;
+        float spacing = flowRect.z / 5.0;
+        center = vec2(flowRect.x + spacing * (index + 0.5), flowRect.y + 0.5 * flowRect.w);
+        extent = vec2(5.0 * (0.6 + 0.8 * swell));
+        alpha = (0.15 + 0.85 * swell) * (0.6 + 0.4 * intensity);
+    }
+
+    vec2 pos = center + corner * extent;
+    vLocal = corner;
+    vPos = pos;
+    vAlpha = alpha;
+    vKind = kind;
+    gl_Position = qt_Matrix * vec4(pos, 0.0, 1.0);
+}
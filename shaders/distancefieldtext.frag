@@ -0,0 +1,22 @@
+#version 440
+
+layout(location = 0) in vec2 vTexCoord;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    vec4 color;         // Premultiplied
+};
+
+layout(binding = 1) uniform sampler2D atlas;
+
+void main()
+{
+    // 0.5 is the outline; the smoothing width follows the on-screen scale
+    float field = texture(atlas, vTexCoord).r;
+    float width = max(fwidth(field) * 0.75, 0.001);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, field);
+    fragColor = color * (alpha * qt_Opacity);
+}
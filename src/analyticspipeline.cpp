@@ -0,0 +1,194 @@
+#include "analyticspipeline.h"
+#include "chargingmanager.h"
+#include "energycalculator.h"
+#include "evvehicledata.h"
+#include "rangepredictor.h"
+#include <QDebug>
+#include <QTimer>
+
+static const int kSampleIntervalMs = 50;     // 20 Hz snapshots
+static const int kBatchSize = 4;             // Processed every 200 ms
+static const int kPostIntervalMs = 500;      // Results to the GUI thread at most 2 Hz
+
+AnalyticsWorker::AnalyticsWorker(const EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent),
+      m_vehicleData(vehicleData),
+      m_sampleTimer(new QTimer(this)),
+      m_energy(new EnergyCalculator(this)),
+      m_range(new RangePredictor(this)),
+      m_charging(new ChargingManager(this))
+{
+    m_batch.reserve(kBatchSize);
+    m_charging->setTargetSoc(100.0f);   // The charging screen shows time to full
+    m_sampleTimer->setTimerType(Qt::PreciseTimer);
+    m_sampleTimer->setInterval(kSampleIntervalMs);
+    connect(m_sampleTimer, &QTimer::timeout, this, &AnalyticsWorker::sample);
+    connect(m_charging, &ChargingManager::chargingCompleted, this, [this](const ChargingSession &session) {
+        emit chargingSessionCompleted(session, m_latitude, m_longitude);
+    });
+}
+
+void AnalyticsWorker::start()
+{
+    m_clock.start();
+    m_previousSampleMs = -1;
+    m_lastPostMs = -1;
+    m_sampleTimer->start();
+}
+
+void AnalyticsWorker::stop()
+{
+    m_sampleTimer->stop();
+    m_batch.clear();
+}
+
+void AnalyticsWorker::resetTrip()
+{
+    m_energy->resetTrip();
+    storeMemory();
+}
+
+void AnalyticsWorker::setBatteryCapacity(float capacityKwh)
+{
+    // A different pack invalidates the learnt range; start over
+    m_range->setBatteryCapacity(capacityKwh);
+    m_range->reset();
+    m_charging->setBatteryCapacity(capacityKwh);
+    m_rangeSoc = -1.0f;
+}
+
+bool AnalyticsWorker::memory(AnalyticsMemory *memory) const
+{
+    return m_memory.load(memory) != 0;
+}
+
+void AnalyticsWorker::restoreMemory(const AnalyticsMemory &memory)
+{
+    m_energy->restoreTotals(memory.totalEnergyKwh, memory.totalDistanceKm, memory.regenEnergyKwh,
+                            memory.tripEnergyKwh, memory.tripDistanceKm);
+    m_range->restoreSmoothing(memory.previousRange, memory.smoothedEfficiency);
+    m_rangeSoc = -1.0f;     // Next batch re-smooths from the restored range
+    storeMemory();
+}
+
+void AnalyticsWorker::storeMemory()
+{
+    AnalyticsMemory memory;
+    memory.totalEnergyKwh = m_energy->getTotalConsumption();
+    memory.totalDistanceKm = m_energy->getTotalDistance();
+    memory.regenEnergyKwh = m_energy->getRegenEnergy();
+    memory.tripEnergyKwh = m_energy->getTripConsumption();
+    memory.tripDistanceKm = m_energy->getTripDistance();
+    memory.previousRange = m_range->previousRange();
+    memory.smoothedEfficiency = m_range->smoothedEfficiency();
+    m_memory.store(memory);
+}
+
+void AnalyticsWorker::sample()
+{
+    Sample sample;
+    sample.state = m_vehicleData->snapshot();
+    sample.elapsedMs = m_clock.elapsed();
+    m_batch.append(sample);
+
+    if (m_batch.size() >= kBatchSize) processBatch();
+}
+
+void AnalyticsWorker::processBatch()
+{
+    // Energy is integrated per sample with the measured interval
+    float powerSum = 0.0f;
+    float speedSum = 0.0f;
+    qint64 batchStartMs = m_previousSampleMs;
+    for (const Sample &sample : m_batch) {
+        const VehicleState &state = sample.state;
+        if (m_previousSampleMs >= 0) {
+            const float deltaSec = (sample.elapsedMs - m_previousSampleMs) / 1000.0f;
+            m_energy->updateConsumption(state.powerOutput, state.speed, deltaSec);
+        }
+        m_previousSampleMs = sample.elapsedMs;
+        powerSum += state.powerOutput;
+        speedSum += state.speed;
+    }
+
+    // Slow models see one averaged update per batch
+    const VehicleState &latest = m_batch.last().state;
+    const float meanPower = powerSum / m_batch.size();
+    const float meanSpeed = speedSum / m_batch.size();
+    const float batchSec = batchStartMs >= 0 ? (m_previousSampleMs - batchStartMs) / 1000.0f : 0.0f;
+    m_latitude = latest.gpsLatitude;
+    m_longitude = latest.gpsLongitude;
+    m_batch.clear();
+
+    m_range->updateState(latest.batterySoc, meanPower, meanSpeed, latest.batteryTempAvg);
+    m_charging->updateChargingState(latest.chargingActive, latest.batterySoc, qAbs(meanPower), batchSec);
+
+    // Range is re-smoothed per SoC step, as the display has always done
+    if (latest.batterySoc != m_rangeSoc) {
+        m_rangeSoc = latest.batterySoc;
+        m_rangeKm = m_range->updateRange(latest.batterySoc, latest.batteryTempAvg,
+                                         latest.averageConsumption);
+    }
+
+    storeMemory();
+
+    AnalyticsResult result;
+    result.estimatedRange = m_rangeKm;
+    result.tripEnergy = m_energy->getTripConsumption();
+    result.tripEfficiency = m_energy->getTripEfficiency();
+    result.timeToFull = m_charging->isChargingActive() ? m_charging->getTimeToFull() : -1;
+
+    const qint64 now = m_previousSampleMs;
+    if (m_lastPostMs >= 0 && now - m_lastPostMs < kPostIntervalMs) return;
+    if (result == m_lastPosted) return;
+
+    m_lastPosted = result;
+    m_lastPostMs = now;
+    emit resultsReady(result);
+}
+
+AnalyticsPipeline::AnalyticsPipeline(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_worker(new AnalyticsWorker(vehicleData))
+{
+    m_thread.setObjectName("analytics");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &AnalyticsWorker::resultsReady,
+            vehicleData, &EVVehicleData::applyAnalytics);
+    connect(m_worker, &AnalyticsWorker::chargingSessionCompleted,
+            this, &AnalyticsPipeline::chargingSessionCompleted);
+}
+
+AnalyticsPipeline::~AnalyticsPipeline()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void AnalyticsPipeline::start()
+{
+    m_thread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_worker, &AnalyticsWorker::start, Qt::QueuedConnection);
+    qDebug() << "Analytics pipeline started";
+}
+
+void AnalyticsPipeline::resetTrip()
+{
+    QMetaObject::invokeMethod(m_worker, &AnalyticsWorker::resetTrip, Qt::QueuedConnection);
+}
+
+void AnalyticsPipeline::restore(const AnalyticsMemory &memory)
+{
+    // Queued after any setProfile(), whose capacity change would reset the smoothing
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, memory] {
+        worker->restoreMemory(memory);
+    }, Qt::QueuedConnection);
+}
+
+void AnalyticsPipeline::setProfile(const VehicleProfile &profile)
+{
+    const float capacityKwh = profile.batteryCapacityKwh;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, capacityKwh] {
+        worker->setBatteryCapacity(capacityKwh);
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,100 @@
+#ifndef ANALYTICSPIPELINE_H
+#define ANALYTICSPIPELINE_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QVector>
+#include "analyticsresult.h"
+#include "chargingmanager.h"
+#include "seqlock.h"
+#include "vehicleprofile.h"
+#include "vehiclestate.h"
+
+class EnergyCalculator;
+class EVVehicleData;
+class RangePredictor;
+class QTimer;
+
+// Runs EnergyCalculator, RangePredictor and ChargingManager on its own thread.
+// Samples EVVehicleData::snapshot() (lock-free) at 20 Hz, processes them in
+// 200 ms batches and posts an AnalyticsResult back at most twice a second,
+// so the GUI thread only ever assigns finished values.
+class AnalyticsWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AnalyticsWorker(const EVVehicleData *vehicleData, QObject *parent = nullptr);
+
+    // Latest accumulated totals and range smoothing; lock-free, any thread.
+    // False until the worker has stored any.
+    bool memory(AnalyticsMemory *memory) const;
+
+public slots:
+    void start();
+    void stop();
+    void resetTrip();
+    void setBatteryCapacity(float capacityKwh);
+    void restoreMemory(const AnalyticsMemory &memory);
+
+signals:
+    void resultsReady(const AnalyticsResult &result);
+    // Where the vehicle stood when charging stopped; 0,0 without a fix
+    void chargingSessionCompleted(const ChargingSession &session, double latitude, double longitude);
+
+private slots:
+    void sample();
+
+private:
+    struct Sample {
+        VehicleState state;
+        qint64 elapsedMs;
+    };
+
+    void processBatch();
+    void storeMemory();
+
+    const EVVehicleData *m_vehicleData;
+    QTimer *m_sampleTimer;
+    QElapsedTimer m_clock;
+    QVector<Sample> m_batch;
+    qint64 m_previousSampleMs = -1;
+    qint64 m_lastPostMs = -1;
+    AnalyticsResult m_lastPosted;
+    float m_rangeSoc = -1.0f;
+    float m_rangeKm = 0.0f;
+    double m_latitude = 0.0;
+    double m_longitude = 0.0;
+    SeqLock<AnalyticsMemory> m_memory;
+
+    EnergyCalculator *m_energy;
+    RangePredictor *m_range;
+    ChargingManager *m_charging;
+};
+
+// Owns the worker thread; results land on EVVehicleData::applyAnalytics()
+class AnalyticsPipeline : public QObject
+{
+    Q_OBJECT
+public:
+    explicit AnalyticsPipeline(EVVehicleData *vehicleData, QObject *parent = nullptr);
+    ~AnalyticsPipeline();
+
+    void start();
+    void resetTrip();
+    void setProfile(const VehicleProfile &profile);
+
+    // Carry totals and range smoothing across restarts (see StateKeeper)
+    bool memory(AnalyticsMemory *memory) const { return m_worker->memory(memory); }
+    void restore(const AnalyticsMemory &memory);
+
+signals:
+    // Queued from the worker; DatabaseService logs it
+    void chargingSessionCompleted(const ChargingSession &session, double latitude, double longitude);
+
+private:
+    QThread m_thread;
+    AnalyticsWorker *m_worker;
+};
+
+#endif // ANALYTICSPIPELINE_H
@@ -0,0 +1,36 @@
+#ifndef ANALYTICSRESULT_H
+#define ANALYTICSRESULT_H
+
+#include <QMetaType>
+
+// Derived values computed off the GUI thread by AnalyticsPipeline
+struct AnalyticsResult {
+    float estimatedRange = 0.0f;    // km
+    float tripEnergy = 0.0f;        // kWh, net of regen
+    float tripEfficiency = 0.0f;    // Wh/km
+    int timeToFull = -1;            // Minutes to target SoC, -1 = not charging
+
+    bool operator==(const AnalyticsResult &other) const
+    {
+        return estimatedRange == other.estimatedRange && tripEnergy == other.tripEnergy
+            && tripEfficiency == other.tripEfficiency && timeToFull == other.timeToFull;
+    }
+    bool operator!=(const AnalyticsResult &other) const { return !(*this == other); }
+};
+
+// What the analytics models have accumulated and learnt, carried across
+// restarts by StateKeeper. Trivially copyable: it goes through a SeqLock and
+// straight into the snapshot file.
+struct AnalyticsMemory {
+    float totalEnergyKwh = 0.0f;
+    float totalDistanceKm = 0.0f;
+    float regenEnergyKwh = 0.0f;
+    float tripEnergyKwh = 0.0f;
+    float tripDistanceKm = 0.0f;
+    float previousRange = 0.0f;         // km, RangePredictor display smoothing
+    float smoothedEfficiency = 0.0f;    // Wh/km, 0 = not learnt yet
+};
+
+Q_DECLARE_METATYPE(AnalyticsResult)
+
+#endif // ANALYTICSRESULT_H
@@ -0,0 +1,38 @@
+#include "blinkclock.h"
+#include <QCoreApplication>
+#include <QPointer>
+
+// Half period of the fast cadence; "on" toggles every second tick
+static const int kTickMs = 200;
+
+BlinkClock::BlinkClock(QObject *parent) : QObject(parent)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(kTickMs);
+    connect(&m_timer, &QTimer::timeout, this, &BlinkClock::tick);
+    m_timer.start();
+}
+
+BlinkClock *BlinkClock::instance()
+{
+    // Owned by the application: the running timer must not outlive it
+    static QPointer<BlinkClock> clock;
+    if (!clock) {
+        Q_ASSERT(QCoreApplication::instance());
+        clock = new BlinkClock(QCoreApplication::instance());
+    }
+    return clock;
+}
+
+void BlinkClock::tick()
+{
+    m_ticks++;
+
+    m_fast = !m_fast;
+    emit fastChanged();
+
+    if (m_ticks % 2 == 0) {
+        m_on = !m_on;
+        emit onChanged();
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef BLINKCLOCK_H
+#define BLINKCLOCK_H
+
+#include <QObject>
+#include <QTimer>
+
+// One flash cadence for every telltale and warning.
+// Items bind their opacity or color to "on"/"fast" instead of running their
+// own infinite animations, so both indicators (and hazards) flash in phase and
+// a visible telltale costs one repaint per edge rather than a vsync-rate
+// animation. Exposed to QML as "BlinkClock".
+class BlinkClock : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool on READ on NOTIFY onChanged)        // 75 flashes/min (400 ms on, 400 ms off)
+    Q_PROPERTY(bool fast READ fast NOTIFY fastChanged)  // Twice that, for critical alerts
+
+public:
+    static BlinkClock *instance();      // Created on first use, owned by the application
+
+    bool on() const { return m_on; }
+    bool fast() const { return m_fast; }
+
+signals:
+    void onChanged();
+    void fastChanged();
+
+private:
+    explicit BlinkClock(QObject *parent = nullptr);
+    void tick();
+
+    QTimer m_timer;
+    int m_ticks = 0;
+    bool m_on = true;
+    bool m_fast = true;
+};
+
+#endif // BLINKCLOCK_H
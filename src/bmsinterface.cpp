@@ -1,5 +1,7 @@
 #include "bmsinterface.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QtEndian>
 
 BMSInterface::BMSInterface(QObject *parent) : QObject(parent),
     m_cellVoltageMin(3.2f), m_cellVoltageMax(3.2f),
@@ -7,10 +9,41 @@ BMSInterface::BMSInterface(QObject *parent) : QObject(parent),
 {
 }
 
-void BMSInterface::updateFromCAN(const QByteArray& payload)
+void BMSInterface::updateFromCAN(const QByteArray& payload, InputSource source)
 {
-    // Placeholder for CAN parsing logic
-    // In a real implementation, we would decode the byte array
-    // m_packVoltage = ...
+    // Pack status frame (0x200), little-endian. Placeholder layout until the
+    // BMS DBC is available:
+    //   0-1 pack voltage 0.1 V, 2-3 pack current 0.1 A (signed, + = discharge)
+    //   4 SoC 0.5 %, 5 SoH 0.5 %, 6 cell min 10 mV + 2.0 V, 7 cell max 10 mV + 2.0 V
+    if (payload.size() < 8) {
+        qWarning() << "BMS frame too short:" << payload.size();
+        return;
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(payload.constData());
+    const float soc = data[4] * 0.5f;
+
+    m_packVoltage = qFromLittleEndian<quint16>(data) * 0.1f;
+    m_packCurrent = qFromLittleEndian<qint16>(data + 2) * 0.1f;
+    m_stateOfHealth = data[5] * 0.5f;
+    m_cellVoltageMin = 2.0f + data[6] * 0.01f;
+    m_cellVoltageMax = 2.0f + data[7] * 0.01f;
     emit bmsDataChanged();
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    auto sample = [now, source](VehicleSignal signal, float value) {
+        SignalSample s;
+        s.signal = signal;
+        s.source = source;
+        s.timestampMs = now;
+        s.value = value;
+        return s;
+    };
+
+    emit samplesDecoded({
+        sample(VehicleSignal::BatteryVoltage, m_packVoltage),
+        sample(VehicleSignal::BatteryCurrent, m_packCurrent),
+        sample(VehicleSignal::BatterySoc, soc),
+        sample(VehicleSignal::BatterySoh, m_stateOfHealth)
+    });
 }
@@ -2,6 +2,7 @@
 #define BMSINTERFACE_H
 
 #include <QObject>
+#include "signalsample.h"
 
 class BMSInterface : public QObject
 {
@@ -23,10 +24,11 @@ public:
 
 signals:
     void bmsDataChanged();
+    void samplesDecoded(const QList<SignalSample> &samples);
     void criticalFault(const QString& code);
 
 public slots:
-    void updateFromCAN(const QByteArray& payload);
+    void updateFromCAN(const QByteArray& payload, InputSource source = InputSource::Can);
 
 private:
     float m_cellVoltageMin;
@@ -0,0 +1,77 @@
+#include "boottimer.h"
+#include <QQuickWindow>
+#include <QDebug>
+
+// Time-to-first-telltale budget (ms)
+static const qint64 kFirstFrameTargetMs = 500;
+
+BootTimer::BootTimer(QObject *parent) : QObject(parent)
+{
+}
+
+BootTimer *BootTimer::instance()
+{
+    static BootTimer timer;
+    return &timer;
+}
+
+void BootTimer::start()
+{
+    m_phases.clear();
+    m_firstFrameMs = -1;
+    m_timer.start();
+    mark("main");
+}
+
+qint64 BootTimer::elapsedMs() const
+{
+    return m_timer.isValid() ? m_timer.elapsed() : 0;
+}
+
+void BootTimer::mark(const QString &phase)
+{
+    BootPhase entry;
+    entry.name = phase;
+    entry.elapsedMs = elapsedMs();
+    m_phases.append(entry);
+
+    qDebug() << "[boot]" << qPrintable(phase) << "+" << entry.elapsedMs << "ms";
+    emit phaseMarked(phase, entry.elapsedMs);
+}
+
+void BootTimer::watchWindow(QQuickWindow *window)
+{
+    if (!window) return;
+
+    // frameSwapped comes from the render thread; queue it back to the GUI thread
+    m_frameConnection = connect(window, &QQuickWindow::frameSwapped,
+                                this, &BootTimer::markFirstFrame, Qt::QueuedConnection);
+}
+
+void BootTimer::markFirstFrame()
+{
+    // Only the very first swapped frame counts
+    disconnect(m_frameConnection);
+    if (m_firstFrameMs >= 0)
+        return;
+
+    mark("first-frame");
+    m_firstFrameMs = m_phases.last().elapsedMs;
+
+    if (m_firstFrameMs > kFirstFrameTargetMs) {
+        qWarning() << "[boot] First telltale frame took" << m_firstFrameMs
+                   << "ms (target" << kFirstFrameTargetMs << "ms)";
+    }
+    emit firstFrameShown();
+}
+
+void BootTimer::report() const
+{
+    qDebug() << "[boot] Phase summary:";
+    qint64 previous = 0;
+    for (const BootPhase &phase : m_phases) {
+        qDebug().nospace() << "[boot]   " << qPrintable(phase.name.leftJustified(20))
+                           << phase.elapsedMs << " ms (+" << (phase.elapsedMs - previous) << ")";
+        previous = phase.elapsedMs;
+    }
+}
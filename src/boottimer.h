@@ -0,0 +1,56 @@
+#ifndef BOOTTIMER_H
+#define BOOTTIMER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+#include <QMetaObject>
+
+class QQuickWindow;
+
+struct BootPhase {
+    QString name;
+    qint64 elapsedMs;    // milliseconds since main() entered
+};
+
+// Records boot-phase timestamps so the time-to-first-telltale target can be verified.
+// Exposed to QML as "BootTimer" so scene stages can mark themselves.
+class BootTimer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(qint64 firstFrameMs READ firstFrameMs NOTIFY firstFrameShown)
+
+public:
+    static BootTimer *instance();
+
+    // Call first thing in main() - all phases are relative to this point
+    void start();
+
+    Q_INVOKABLE void mark(const QString &phase);
+
+    // Marks "first-frame" when the window swaps its first frame
+    void watchWindow(QQuickWindow *window);
+
+    qint64 elapsedMs() const;
+    qint64 firstFrameMs() const { return m_firstFrameMs; }
+    QList<BootPhase> phases() const { return m_phases; }
+
+    // Dump all phases to the log as a single summary
+    Q_INVOKABLE void report() const;
+
+signals:
+    void phaseMarked(const QString &phase, qint64 elapsedMs);
+    void firstFrameShown();
+
+private:
+    explicit BootTimer(QObject *parent = nullptr);
+    void markFirstFrame();
+
+    QElapsedTimer m_timer;
+    QList<BootPhase> m_phases;
+    qint64 m_firstFrameMs = -1;
+    QMetaObject::Connection m_frameConnection;
+};
+
+#endif // BOOTTIMER_H
@@ -2,33 +2,92 @@
 #define CANINTERFACE_H
 
 #include <QObject>
-#include <QVariantMap>
+#include <QByteArray>
+#include <QPair>
+#include <QTimer>
+#include "canlog.h"
+#include "j1939.h"
+#include "signalsample.h"
 
 // Forward declaration
 class QCanBusDevice;
 
+// One scalar signal inside a CAN/CAN-FD frame or J1939 message (little-endian, byte aligned)
+struct CanSignalDef {
+    quint32 frameId;    // CAN identifier, or the PGN when j1939 is set
+    VehicleSignal signal;
+    quint8 startByte;   // Byte offset, up to 63 in a CAN-FD frame
+    quint8 length;      // Bytes: 1, 2 or 4
+    bool isSigned;
+    float scale;
+    float offset;
+    bool j1939 = false;
+};
+
 class CANInterface : public QObject
 {
     Q_OBJECT
 public:
+    static const quint32 MotorControllerFrameId = 0x100;
+    static const quint32 BmsFrameId = 0x200;
+    static const quint32 DriveStatusFdFrameId = 0x180;
+
     explicit CANInterface(QObject *parent = nullptr);
     ~CANInterface();
 
     bool connectDevice(const QString &plugin = "socketcan", const QString &interface = "can0");
     void disconnectDevice();
 
+    // Program kernel receive filters from the decode table (on by default)
+    void setReceiveFiltersEnabled(bool enabled);
+    // Extra IDs to let through, e.g. ISO-TP response IDs
+    void addReceiveId(quint32 frameId, bool extended);
+
+    // Log frame rates and process CPU usage every intervalMs (0 = off)
+    void setStatisticsInterval(int intervalMs);
+
+    // Source tag for decoded samples; a replay decoder uses InputSource::Replay
+    void setSource(InputSource source) { m_source = source; }
+    InputSource source() const { return m_source; }
+
+    // Raw frames from the device are logged before decoding
+    bool startRecording(const QString &path);
+    void stopRecording();
+    bool isRecording() const { return m_recorder && m_recorder->isOpen(); }
+
+    void processFrame(const QCanBusFrame &frame);
+    bool writeFrame(const QCanBusFrame &frame);
+
 signals:
-    void processedDataReceived(const QVariantMap &data);
+    void frameReceived(const QCanBusFrame &frame); // Every frame read from the device
+    void samplesDecoded(const QList<SignalSample> &samples);
+    void bmsFrameReceived(const QByteArray &payload, InputSource source);
+    void j1939MessageReceived(quint32 pgn, quint8 sourceAddress, const QByteArray &data);
     void rawFrameReceived(); // Debugging/Logging
 
 private slots:
     void onFramesReceived();
     void onErrorOccurred(int error);
+    void logStatistics();
 
 private:
+    void applyReceiveFilters();
+    void decodePayload(quint32 key, const QByteArray &payload, qint64 timestampMs);
+
     QCanBusDevice *m_device = nullptr;
-    
-    void processFrame(const struct QCanBusFrame &frame);
+    QString m_interfaceName = "can0";
+    InputSource m_source = InputSource::Can;
+    CanLogWriter *m_recorder = nullptr;
+
+    bool m_filtersEnabled = true;
+    QList<QPair<quint32, bool>> m_extraReceiveIds;
+    J1939BamReassembler m_bam;
+
+    QTimer m_statsTimer;
+    quint64 m_framesReceived = 0;
+    quint64 m_framesDecoded = 0;
+    qint64 m_lastStatsCpuTicks = 0;
+    qint64 m_lastStatsWallMs = 0;
 };
 
 #endif // CANINTERFACE_H
@@ -0,0 +1,359 @@
+#include "canlog.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QLocale>
+#include <cstdio>
+#include <cstring>
+
+// Grow the mapping in large steps so remapping stays rare
+static const qint64 kChunkBytes = 4 * 1024 * 1024;
+static const int kMaxLineBytes = 512;   // 64-byte FD payload in hex fits easily
+
+static qint64 frameTimestampUs(const QCanBusFrame &frame)
+{
+    const QCanBusFrame::TimeStamp ts = frame.timeStamp();
+    if (ts.seconds() == 0 && ts.microSeconds() == 0) {
+        // Plugin without hardware timestamps
+        return QDateTime::currentMSecsSinceEpoch() * 1000;
+    }
+    return ts.seconds() * 1000000 + ts.microSeconds();
+}
+
+CanLogWriter::CanLogWriter(Format format)
+    : m_format(format)
+{
+}
+
+CanLogWriter::~CanLogWriter()
+{
+    close();
+}
+
+CanLogWriter::Format CanLogWriter::formatForPath(const QString &path)
+{
+    return path.endsWith(".asc", Qt::CaseInsensitive) ? Asc : CandumpLog;
+}
+
+bool CanLogWriter::open(const QString &path, const QString &interfaceName)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qWarning() << "Failed to open CAN log:" << path << m_file.errorString();
+        return false;
+    }
+
+    m_interfaceName = interfaceName.toLatin1();
+    m_used = 0;
+    m_frames = 0;
+    m_firstTimestampUs = -1;
+
+    if (!reserve(kChunkBytes)) {
+        m_file.close();
+        return false;
+    }
+
+    if (m_format == Asc) {
+        // Vector tools expect a header; dates use the C locale
+        const QString date = QLocale::c().toString(QDateTime::currentDateTime(),
+                                                   "ddd MMM dd hh:mm:ss.zzz ap yyyy");
+        const QByteArray header = "date " + date.toLatin1() + "\n"
+                                  "base hex  timestamps absolute\n"
+                                  "no internal events logged\n"
+                                  "Begin Triggerblock " + date.toLatin1() + "\n"
+                                  "   0.000000 Start of measurement\n";
+        write(header.constData(), header.size());
+    }
+
+    qDebug() << "Recording CAN frames to" << path;
+    return true;
+}
+
+bool CanLogWriter::reserve(qint64 bytes)
+{
+    if (m_map && m_used + bytes <= m_mapSize) return true;
+
+    const qint64 newSize = m_mapSize + qMax(bytes, kChunkBytes);
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+
+    if (!m_file.resize(newSize)) {
+        qWarning() << "Failed to grow CAN log:" << m_file.errorString();
+        return false;
+    }
+
+    m_map = m_file.map(0, newSize);
+    if (!m_map) {
+        qWarning() << "Failed to map CAN log:" << m_file.errorString();
+        return false;
+    }
+    m_mapSize = newSize;
+    return true;
+}
+
+void CanLogWriter::write(const char *data, int length)
+{
+    if (!reserve(length)) {
+        close();
+        return;
+    }
+    memcpy(m_map + m_used, data, size_t(length));
+    m_used += length;
+}
+
+int CanLogWriter::formatFrame(char *out, int capacity, const QCanBusFrame &frame)
+{
+    static const char hex[] = "0123456789ABCDEF";
+
+    const qint64 timestampUs = frameTimestampUs(frame);
+    const QByteArray payload = frame.payload();
+    const bool extended = frame.hasExtendedFrameFormat();
+    int n = 0;
+
+    if (m_format == CandumpLog) {
+        n = snprintf(out, size_t(capacity), extended ? "(%lld.%06lld) %s %08X#" : "(%lld.%06lld) %s %03X#",
+                     timestampUs / 1000000, timestampUs % 1000000,
+                     m_interfaceName.constData(), frame.frameId());
+
+        if (frame.frameType() == QCanBusFrame::RemoteRequestFrame) {
+            out[n++] = 'R';
+        } else {
+            if (frame.hasFlexibleDataRateFormat()) {
+                const int flags = (frame.hasBitrateSwitch() ? 1 : 0) | (frame.hasErrorStateIndicator() ? 2 : 0);
+                out[n++] = '#';
+                out[n++] = hex[flags];
+            }
+            for (const char byte : payload) {
+                out[n++] = hex[(uchar(byte) >> 4) & 0xF];
+                out[n++] = hex[uchar(byte) & 0xF];
+            }
+        }
+    } else {
+        if (m_firstTimestampUs < 0) m_firstTimestampUs = timestampUs;
+        const qint64 relativeUs = timestampUs - m_firstTimestampUs;
+        const bool remote = frame.frameType() == QCanBusFrame::RemoteRequestFrame;
+
+        n = snprintf(out, size_t(capacity), "%4lld.%06lld 1  %X%s             Rx   %c %d",
+                     relativeUs / 1000000, relativeUs % 1000000,
+                     frame.frameId(), extended ? "x" : "",
+                     remote ? 'r' : 'd', int(payload.size()));
+        if (!remote) {
+            for (const char byte : payload) {
+                out[n++] = ' ';
+                out[n++] = hex[(uchar(byte) >> 4) & 0xF];
+                out[n++] = hex[uchar(byte) & 0xF];
+            }
+        }
+    }
+
+    out[n++] = '\n';
+    return n;
+}
+
+void CanLogWriter::append(const QCanBusFrame &frame)
+{
+    if (!m_map) return;
+
+    // Error frames have no portable text form in either format
+    const QCanBusFrame::FrameType type = frame.frameType();
+    if (type != QCanBusFrame::DataFrame && type != QCanBusFrame::RemoteRequestFrame) return;
+
+    if (m_format == Asc && frame.hasFlexibleDataRateFormat()) {
+        static bool warned = false;
+        if (!warned) {
+            qWarning() << "CAN FD frames are only recorded in candump format";
+            warned = true;
+        }
+        return;
+    }
+
+    char line[kMaxLineBytes];
+    const int length = formatFrame(line, kMaxLineBytes, frame);
+    write(line, length);
+    m_frames++;
+}
+
+void CanLogWriter::close()
+{
+    if (!m_file.isOpen()) return;
+
+    if (m_map && m_format == Asc) {
+        static const char footer[] = "End TriggerBlock\n";
+        write(footer, int(sizeof(footer) - 1));
+    }
+
+    if (m_map) {
+        m_file.unmap(m_map);
+        m_map = nullptr;
+    }
+
+    // Drop the unused tail of the last chunk
+    m_file.resize(m_used);
+    m_file.close();
+    m_mapSize = 0;
+
+    qDebug() << "CAN log closed:" << m_frames << "frames," << m_used << "bytes";
+}
+
+// ---------------------------------------------------------------------------
+
+static bool parseHexBytes(const QByteArray &text, QByteArray *out)
+{
+    if (text.size() % 2 != 0) return false;
+    *out = QByteArray::fromHex(text);
+    return out->size() * 2 == text.size();
+}
+
+static bool parseCandumpLine(const QByteArray &line, CanLogEntry *entry)
+{
+    // (1697712345.123456) can0 123#11223344
+    const int close = line.indexOf(')');
+    if (!line.startsWith('(') || close < 0) return false;
+
+    const QByteArray stamp = line.mid(1, close - 1);
+    const int dot = stamp.indexOf('.');
+    if (dot < 0) return false;
+    const qint64 seconds = stamp.left(dot).toLongLong();
+    const qint64 micros = stamp.mid(dot + 1).leftJustified(6, '0').left(6).toLongLong();
+
+    const QList<QByteArray> fields = line.mid(close + 1).simplified().split(' ');
+    if (fields.size() < 2) return false;
+
+    const QByteArray &token = fields[1];
+    const int hash = token.indexOf('#');
+    if (hash <= 0) return false;
+
+    bool ok = false;
+    const QByteArray idText = token.left(hash);
+    const quint32 frameId = idText.toUInt(&ok, 16);
+    if (!ok) return false;
+
+    QCanBusFrame frame;
+    frame.setFrameId(frameId);
+    frame.setExtendedFrameFormat(idText.size() > 3);
+
+    QByteArray rest = token.mid(hash + 1);
+    QByteArray payload;
+    if (rest.startsWith('R')) {
+        frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+    } else if (rest.startsWith('#')) {
+        // CAN FD: ##<flags><data>
+        if (rest.size() < 2) return false;
+        const int flags = QByteArray(1, rest[1]).toInt(&ok, 16);
+        if (!ok || !parseHexBytes(rest.mid(2), &payload)) return false;
+        frame.setFlexibleDataRateFormat(true);
+        frame.setBitrateSwitch(flags & 1);
+        frame.setErrorStateIndicator(flags & 2);
+        frame.setPayload(payload);
+    } else {
+        if (!parseHexBytes(rest, &payload)) return false;
+        frame.setPayload(payload);
+    }
+
+    frame.setTimeStamp(QCanBusFrame::TimeStamp(seconds, micros));
+    entry->timestampUs = seconds * 1000000 + micros;
+    entry->frame = frame;
+    return true;
+}
+
+static bool parseAscLine(const QByteArray &line, CanLogEntry *entry)
+{
+    //    0.001234 1  123x            Rx   d 8 11 22 33 44 55 66 77 88
+    const QList<QByteArray> fields = line.simplified().split(' ');
+    if (fields.size() < 6) return false;
+
+    bool ok = false;
+    const double seconds = fields[0].toDouble(&ok);
+    if (!ok) return false;
+    fields[1].toInt(&ok);
+    if (!ok) return false;   // "Start of measurement", CANFD lines, events
+
+    QByteArray idText = fields[2];
+    const bool extended = idText.endsWith('x');
+    if (extended) idText.chop(1);
+    const quint32 frameId = idText.toUInt(&ok, 16);
+    if (!ok) return false;
+
+    QCanBusFrame frame;
+    frame.setFrameId(frameId);
+    frame.setExtendedFrameFormat(extended);
+
+    if (fields[4] == "r") {
+        frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+    } else if (fields[4] == "d") {
+        const int length = fields[5].toInt(&ok);
+        if (!ok || fields.size() < 6 + length) return false;
+        QByteArray payload;
+        payload.reserve(length);
+        for (int i = 0; i < length; ++i) {
+            payload.append(char(fields[6 + i].toUInt(&ok, 16)));
+            if (!ok) return false;
+        }
+        frame.setPayload(payload);
+    } else {
+        return false;
+    }
+
+    const qint64 timestampUs = qint64(seconds * 1000000.0 + 0.5);
+    frame.setTimeStamp(QCanBusFrame::TimeStamp(timestampUs / 1000000, timestampUs % 1000000));
+    entry->timestampUs = timestampUs;
+    entry->frame = frame;
+    return true;
+}
+
+QVector<CanLogEntry> CanLogReader::load(const QString &path, QString *errorString)
+{
+    QVector<CanLogEntry> entries;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) *errorString = file.errorString();
+        return entries;
+    }
+
+    const qint64 size = file.size();
+    const uchar *map = size > 0 ? file.map(0, size) : nullptr;
+    if (!map) {
+        if (errorString) *errorString = size > 0 ? file.errorString() : QStringLiteral("empty log");
+        return entries;
+    }
+
+    // A log cut short by a crash ends in zero padding
+    const char *data = reinterpret_cast<const char *>(map);
+    const char *end = static_cast<const char *>(memchr(data, '\0', size_t(size)));
+    if (!end) end = data + size;
+
+    bool asc = false;
+    bool formatKnown = false;
+    int skipped = 0;
+
+    for (const char *p = data; p < end; ) {
+        const char *eol = static_cast<const char *>(memchr(p, '\n', size_t(end - p)));
+        if (!eol) eol = end;
+        const QByteArray line = QByteArray::fromRawData(p, int(eol - p)).trimmed();
+        p = eol + 1;
+
+        if (line.isEmpty()) continue;
+        if (!formatKnown) {
+            asc = !line.startsWith('(');
+            formatKnown = true;
+        }
+
+        CanLogEntry entry;
+        if (asc ? parseAscLine(line, &entry) : parseCandumpLine(line, &entry)) {
+            entries.append(entry);
+        } else if (!asc) {
+            skipped++;
+        }
+    }
+
+    if (skipped > 0) {
+        qWarning() << "Skipped" << skipped << "unparsable lines in" << path;
+    }
+
+    file.unmap(const_cast<uchar *>(map));
+    return entries;
+}
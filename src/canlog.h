@@ -0,0 +1,61 @@
+#ifndef CANLOG_H
+#define CANLOG_H
+
+#include <QCanBusFrame>
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+// One recorded frame. Timestamps are microseconds; their epoch depends on the
+// log (absolute for candump, measurement-relative for ASC).
+struct CanLogEntry {
+    qint64 timestampUs = 0;
+    QCanBusFrame frame;
+};
+
+// Append-only CAN log on a memory-mapped file.
+// The file grows in fixed chunks and is truncated to the written size on
+// close(); after a crash the tail is zero-filled, which CanLogReader ignores.
+// Output is text that candump/canplayer (-L format) or Vector tools (ASC) read.
+class CanLogWriter
+{
+public:
+    enum Format {
+        CandumpLog,     // (1697712345.123456) can0 123#11223344
+        Asc             // Vector ASCII, timestamps relative to the first frame
+    };
+
+    explicit CanLogWriter(Format format = CandumpLog);
+    ~CanLogWriter();
+
+    bool open(const QString &path, const QString &interfaceName = "can0");
+    void append(const QCanBusFrame &frame);
+    void close();
+
+    bool isOpen() const { return m_map != nullptr; }
+    qint64 framesWritten() const { return m_frames; }
+    qint64 bytesWritten() const { return m_used; }
+
+    static Format formatForPath(const QString &path);
+
+private:
+    bool reserve(qint64 bytes);
+    void write(const char *data, int length);
+    int formatFrame(char *out, int capacity, const QCanBusFrame &frame);
+
+    Format m_format;
+    QFile m_file;
+    QByteArray m_interfaceName;
+    uchar *m_map = nullptr;
+    qint64 m_mapSize = 0;
+    qint64 m_used = 0;
+    qint64 m_frames = 0;
+    qint64 m_firstTimestampUs = -1;
+};
+
+namespace CanLogReader {
+    // Parses a candump -L or ASC log; returns entries in file order
+    QVector<CanLogEntry> load(const QString &path, QString *errorString = nullptr);
+}
+
+#endif // CANLOG_H
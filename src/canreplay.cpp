@@ -0,0 +1,168 @@
+#include "canreplay.h"
+#include <QCanBus>
+#include <QCanBusDevice>
+#include <QDebug>
+
+// Upper bound per event loop pass so fast replays never starve the UI
+static const int kMaxFramesPerPass = 1000;
+
+CanReplayDevice::CanReplayDevice(QObject *parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &CanReplayDevice::playDue);
+}
+
+CanReplayDevice::~CanReplayDevice()
+{
+    stop();
+    if (m_target) {
+        m_target->disconnectDevice();
+        delete m_target;
+    }
+}
+
+bool CanReplayDevice::load(const QString &path)
+{
+    stop();
+
+    QString errorString;
+    m_entries = CanLogReader::load(path, &errorString);
+    m_position = 0;
+
+    if (m_entries.isEmpty()) {
+        qWarning() << "No CAN frames to replay in" << path << errorString;
+        return false;
+    }
+
+    const double durationS = (m_entries.last().timestampUs - m_entries.first().timestampUs) / 1e6;
+    qDebug() << "Loaded CAN replay:" << m_entries.size() << "frames," << durationS << "s";
+    return true;
+}
+
+void CanReplayDevice::setSpeed(double speed)
+{
+    speed = qMax(0.0, speed);
+    if (qFuzzyCompare(m_speed, speed))
+        return;
+
+    // Keep the current log position when the rate changes mid-replay
+    if (m_running && m_position < m_entries.size()) {
+        if (m_speed > 0.0) {
+            m_clockOffsetUs += qint64(m_clock.nsecsElapsed() / 1000 * m_speed);
+        } else {
+            m_clockOffsetUs = m_entries[m_position].timestampUs;
+        }
+        m_clock.restart();
+    }
+
+    m_speed = speed;
+    emit speedChanged();
+
+    if (m_running) m_timer.start(0);
+}
+
+bool CanReplayDevice::setTargetDevice(const QString &plugin, const QString &interface)
+{
+    QString errorString;
+    QCanBusDevice *device = QCanBus::instance()->createDevice(plugin, interface, &errorString);
+    if (!device) {
+        qWarning() << "Error creating CAN replay target:" << errorString;
+        return false;
+    }
+
+    if (!device->connectDevice()) {
+        qWarning() << "CAN replay target connection error:" << device->errorString();
+        delete device;
+        return false;
+    }
+
+    if (m_target) {
+        m_target->disconnectDevice();
+        delete m_target;
+    }
+    m_target = device;
+    qDebug() << "CAN replay writing to" << plugin << interface;
+    return true;
+}
+
+void CanReplayDevice::restartClock()
+{
+    m_clockOffsetUs = m_position < m_entries.size() ? m_entries[m_position].timestampUs : 0;
+    m_clock.restart();
+}
+
+void CanReplayDevice::start()
+{
+    if (m_running || m_entries.isEmpty()) return;
+
+    if (m_position >= m_entries.size()) m_position = 0;
+    restartClock();
+
+    m_running = true;
+    emit runningChanged();
+    m_timer.start(0);
+}
+
+void CanReplayDevice::stop()
+{
+    m_timer.stop();
+    if (!m_running) return;
+
+    m_running = false;
+    emit runningChanged();
+}
+
+void CanReplayDevice::emitFrame(const CanLogEntry &entry)
+{
+    if (m_target) {
+        m_target->writeFrame(entry.frame);
+    }
+    emit frameReplayed(entry.frame);
+}
+
+void CanReplayDevice::playDue()
+{
+    if (!m_running) return;
+
+    const int total = m_entries.size();
+    int emitted = 0;
+
+    if (m_speed <= 0.0) {
+        while (m_position < total && emitted < kMaxFramesPerPass) {
+            emitFrame(m_entries[m_position++]);
+            emitted++;
+        }
+    } else {
+        // Everything whose log time has been reached, in order
+        const qint64 logNowUs = m_clockOffsetUs + qint64(m_clock.nsecsElapsed() / 1000 * m_speed);
+        while (m_position < total && emitted < kMaxFramesPerPass
+               && m_entries[m_position].timestampUs <= logNowUs) {
+            emitFrame(m_entries[m_position++]);
+            emitted++;
+        }
+    }
+
+    if (m_position >= total) {
+        if (m_loop) {
+            m_position = 0;
+            restartClock();
+            m_timer.start(0);
+        } else {
+            qDebug() << "CAN replay finished";
+            stop();
+            emit finished();
+        }
+        return;
+    }
+
+    if (m_speed <= 0.0 || emitted == kMaxFramesPerPass) {
+        m_timer.start(0);
+        return;
+    }
+
+    // Sleep until the next frame is due
+    const qint64 logNowUs = m_clockOffsetUs + qint64(m_clock.nsecsElapsed() / 1000 * m_speed);
+    const qint64 waitUs = qint64((m_entries[m_position].timestampUs - logNowUs) / m_speed);
+    m_timer.start(int(qBound<qint64>(0, waitUs / 1000, 60000)));
+}
@@ -0,0 +1,68 @@
+#ifndef CANREPLAY_H
+#define CANREPLAY_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include "canlog.h"
+
+class QCanBusDevice;
+
+// Plays a recorded CAN log back with the original inter-frame timing.
+// Frames are emitted through frameReplayed() - normally into a CANInterface
+// so they take the same processFrame() path as live traffic - and can also be
+// written to a bus device (virtualcan or a vcan interface) to exercise the
+// whole stack without hardware.
+class CanReplayDevice : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(double speed READ speed WRITE setSpeed NOTIFY speedChanged)
+
+public:
+    explicit CanReplayDevice(QObject *parent = nullptr);
+    ~CanReplayDevice();
+
+    bool load(const QString &path);
+    int frameCount() const { return m_entries.size(); }
+
+    // 1.0 = recorded timing, N = N times faster, 0 = as fast as possible
+    double speed() const { return m_speed; }
+    void setSpeed(double speed);
+
+    void setLoop(bool loop) { m_loop = loop; }
+
+    // Optional: also write every frame to a bus, e.g. ("virtualcan", "can0")
+    bool setTargetDevice(const QString &plugin, const QString &interface);
+
+    bool isRunning() const { return m_running; }
+
+public slots:
+    void start();
+    void stop();
+
+signals:
+    void frameReplayed(const QCanBusFrame &frame);
+    void finished();
+    void runningChanged();
+    void speedChanged();
+
+private slots:
+    void playDue();
+
+private:
+    void emitFrame(const CanLogEntry &entry);
+    void restartClock();
+
+    QVector<CanLogEntry> m_entries;
+    QCanBusDevice *m_target = nullptr;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    qint64 m_clockOffsetUs = 0;      // Log time at which m_clock was started
+    int m_position = 0;
+    double m_speed = 1.0;
+    bool m_loop = false;
+    bool m_running = false;
+};
+
+#endif // CANREPLAY_H
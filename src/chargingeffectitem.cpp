@@ -0,0 +1,289 @@
+#include "chargingeffectitem.h"
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QRandomGenerator>
+#include <cstring>
+
+// Primitive kinds, drawn in this order (must match chargingeffect.vert)
+enum EffectKind { KindOrb, KindParticle, KindFill, KindBubble, KindHalo, KindFlowDot };
+
+struct EffectBatch {
+    EffectKind kind;
+    int count;
+};
+
+static const EffectBatch kBatches[] = {
+    { KindOrb, 6 },
+    { KindParticle, 12 },
+    { KindFill, 1 },
+    { KindBubble, 6 },
+    { KindHalo, 1 },
+    { KindFlowDot, 5 },
+};
+
+struct EffectVertex {
+    float cornerX, cornerY;              // Quad corner, -1..1
+    float kind, index, seedA, seedB;     // Per-primitive constants
+};
+
+static const float kCorners[4][2] = { { -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 } };
+static const int kQuadIndices[6] = { 0, 1, 2, 2, 1, 3 };
+
+static const QSGGeometry::AttributeSet &effectAttributes()
+{
+    static const QSGGeometry::Attribute attributes[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType,
+                                                        QSGGeometry::PositionAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 4, QSGGeometry::FloatType,
+                                                        QSGGeometry::UnknownAttribute),
+    };
+    static const QSGGeometry::AttributeSet set = { 2, sizeof(EffectVertex), attributes };
+    return set;
+}
+
+// ── Material ──
+
+class ChargingEffectMaterial : public QSGMaterial
+{
+public:
+    ChargingEffectMaterial()
+    {
+        // Positions are computed in the vertex shader; asking for the full
+        // matrix keeps the renderer from merging this node and pre-transforming
+        // its vertices on the CPU
+        setFlag(Blending | RequiresFullMatrix);
+    }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        return this == other ? 0 : (this < other ? -1 : 1);
+    }
+
+    float time = 0.0f;
+    float level = 0.0f;
+    float intensity = 0.0f;
+    QColor color;
+    QRectF fillRect;
+    QRectF flowRect;
+    QSizeF size;
+};
+
+class ChargingEffectShader : public QSGMaterialShader
+{
+public:
+    ChargingEffectShader()
+    {
+        setShaderFileName(VertexStage, QStringLiteral(":/shaders/chargingeffect.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/shaders/chargingeffect.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        // std140 layout of the shaders' uniform block after qt_Matrix
+        struct Uniforms {
+            float opacity;
+            float time;
+            float level;
+            float intensity;
+            float color[4];
+            float fillRect[4];
+            float flowRect[4];
+            float size[2];
+        };
+
+        QByteArray *buffer = state.uniformData();
+        Q_ASSERT(buffer->size() >= 64 + int(sizeof(Uniforms)));
+
+        if (state.isMatrixDirty()) {
+            const QMatrix4x4 matrix = state.combinedMatrix();
+            memcpy(buffer->data(), matrix.constData(), 64);
+        }
+
+        const auto *material = static_cast<ChargingEffectMaterial *>(newMaterial);
+        const QRectF &fill = material->fillRect;
+        const QRectF &flow = material->flowRect;
+        const Uniforms u = {
+            state.opacity(), material->time, material->level, material->intensity,
+            { float(material->color.redF()), float(material->color.greenF()),
+              float(material->color.blueF()), float(material->color.alphaF()) },
+            { float(fill.x()), float(fill.y()), float(fill.width()), float(fill.height()) },
+            { float(flow.x()), float(flow.y()), float(flow.width()), float(flow.height()) },
+            { float(material->size.width()), float(material->size.height()) },
+        };
+        memcpy(buffer->data() + 64, &u, sizeof(u));
+        return true;
+    }
+};
+
+QSGMaterialShader *ChargingEffectMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new ChargingEffectShader;
+}
+
+// ── Item ──
+
+ChargingEffectItem::ChargingEffectItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+}
+
+void ChargingEffectItem::setRunning(bool running)
+{
+    if (m_running == running)
+        return;
+
+    if (running) {
+        m_clock.start();
+    } else {
+        m_pausedTime = currentTime();
+    }
+    m_running = running;
+    emit runningChanged();
+    update();
+}
+
+void ChargingEffectItem::setLevel(qreal level)
+{
+    level = qBound(0.0, level, 1.0);
+    if (qFuzzyCompare(m_level, level))
+        return;
+    m_level = level;
+    emit levelChanged();
+    update();
+}
+
+void ChargingEffectItem::setIntensity(qreal intensity)
+{
+    intensity = qBound(0.0, intensity, 1.0);
+    if (qFuzzyCompare(m_intensity, intensity))
+        return;
+    m_intensity = intensity;
+    emit intensityChanged();
+    update();
+}
+
+void ChargingEffectItem::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+    update();
+}
+
+void ChargingEffectItem::setFillRect(const QRectF &rect)
+{
+    if (m_fillRect == rect)
+        return;
+    m_fillRect = rect;
+    emit fillRectChanged();
+    update();
+}
+
+void ChargingEffectItem::setFlowRect(const QRectF &rect)
+{
+    if (m_flowRect == rect)
+        return;
+    m_flowRect = rect;
+    emit flowRectChanged();
+    update();
+}
+
+float ChargingEffectItem::currentTime() const
+{
+    return m_running ? m_pausedTime + m_clock.elapsed() / 1000.0f : m_pausedTime;
+}
+
+void ChargingEffectItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        update();
+    }
+}
+
+void ChargingEffectItem::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        if (value.window) {
+            // Fires once per rendered frame on the GUI thread, before sync
+            m_frameConnection = connect(value.window, &QQuickWindow::afterAnimating,
+                                        this, &ChargingEffectItem::onAfterAnimating);
+        }
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void ChargingEffectItem::onAfterAnimating()
+{
+    // Keep frames coming only while the effect is running and on screen
+    if (m_running && isVisible()) {
+        update();
+    }
+}
+
+QSGNode *ChargingEffectItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QSGGeometryNode *node = static_cast<QSGGeometryNode *>(oldNode);
+
+    if (!node) {
+        int quads = 0;
+        for (const EffectBatch &batch : kBatches) {
+            quads += batch.count;
+        }
+
+        QSGGeometry *geometry = new QSGGeometry(effectAttributes(), quads * 4, quads * 6);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        geometry->setVertexDataPattern(QSGGeometry::StaticPattern);
+
+        // Fixed seed: the same layout on every start, no Math.random() per item
+        QRandomGenerator random(0x45564348);
+        EffectVertex *v = static_cast<EffectVertex *>(geometry->vertexData());
+        quint16 *indices = geometry->indexDataAsUShort();
+        int quad = 0;
+        for (const EffectBatch &batch : kBatches) {
+            for (int i = 0; i < batch.count; ++i, ++quad) {
+                const float seedA = float(random.generateDouble());
+                const float seedB = float(random.generateDouble());
+                for (int c = 0; c < 4; ++c) {
+                    v[quad * 4 + c] = { kCorners[c][0], kCorners[c][1],
+                                        float(batch.kind), float(i), seedA, seedB };
+                }
+                for (int k = 0; k < 6; ++k) {
+                    indices[quad * 6 + k] = quint16(quad * 4 + kQuadIndices[k]);
+                }
+            }
+        }
+
+        node = new QSGGeometryNode;
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new ChargingEffectMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        node->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    auto *material = static_cast<ChargingEffectMaterial *>(node->material());
+    material->time = currentTime();
+    material->level = float(m_level);
+    material->intensity = float(m_intensity);
+    material->color = m_color;
+    material->fillRect = m_fillRect;
+    material->flowRect = m_flowRect;
+    material->size = size();
+    node->markDirty(QSGNode::DirtyMaterial);
+
+    return node;
+}
@@ -0,0 +1,75 @@
+#ifndef CHARGINGEFFECTITEM_H
+#define CHARGINGEFFECTITEM_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QRectF>
+
+// Charging screen background effect: drifting particles, glow orbs, the
+// battery liquid (waves, shimmer, bubbles), the bolt halo and the energy-flow
+// dots, all in one geometry node drawn by one shader.
+// The vertex buffer is built once; every frame only the time uniform changes
+// and all motion is computed on the GPU, so an animating frame costs one draw
+// call and no QML property writes.
+class ChargingEffectItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(bool running READ running WRITE setRunning NOTIFY runningChanged)
+    Q_PROPERTY(qreal level READ level WRITE setLevel NOTIFY levelChanged)
+    Q_PROPERTY(qreal intensity READ intensity WRITE setIntensity NOTIFY intensityChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QRectF fillRect READ fillRect WRITE setFillRect NOTIFY fillRectChanged)
+    Q_PROPERTY(QRectF flowRect READ flowRect WRITE setFlowRect NOTIFY flowRectChanged)
+
+public:
+    explicit ChargingEffectItem(QQuickItem *parent = nullptr);
+
+    bool running() const { return m_running; }
+    qreal level() const { return m_level; }
+    qreal intensity() const { return m_intensity; }
+    QColor color() const { return m_color; }
+    QRectF fillRect() const { return m_fillRect; }
+    QRectF flowRect() const { return m_flowRect; }
+
+    void setRunning(bool running);
+    void setLevel(qreal level);            // Battery fill, 0..1
+    void setIntensity(qreal intensity);    // Charge power relative to the maximum, 0..1
+    void setColor(const QColor &color);
+    void setFillRect(const QRectF &rect);  // Battery interior, item coordinates
+    void setFlowRect(const QRectF &rect);  // Row of energy-flow dots, item coordinates
+
+signals:
+    void runningChanged();
+    void levelChanged();
+    void intensityChanged();
+    void colorChanged();
+    void fillRectChanged();
+    void flowRectChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private slots:
+    void onAfterAnimating();
+
+private:
+    float currentTime() const;
+
+    bool m_running = false;
+    qreal m_level = 0.0;
+    qreal m_intensity = 0.0;
+    QColor m_color = QColor("#00E676");
+    QRectF m_fillRect;
+    QRectF m_flowRect;
+
+    // Effect time only advances while running, so a stopped effect freezes
+    QElapsedTimer m_clock;
+    float m_pausedTime = 0.0f;
+    QMetaObject::Connection m_frameConnection;
+};
+
+#endif // CHARGINGEFFECTITEM_H
@@ -1,17 +1,19 @@
 #include "chargingmanager.h"
+#include "vehicleprofile.h"
 #include <QDebug>
 
 ChargingManager::ChargingManager(QObject *parent)
     : QObject(parent),
       m_isCharging(false),
-      m_batteryCapacity(77.4),
+      m_batteryCapacity(VehicleProfile().batteryCapacityKwh),
       m_targetSoc(80.0),
       m_energyAddedThisSession(0.0)
 {
     m_currentSession.isComplete = false;
+    m_currentSession.maxPower = 0.0;
 }
 
-void ChargingManager::updateChargingState(bool isCharging, float batterySoc, float chargePowerKw)
+void ChargingManager::updateChargingState(bool isCharging, float batterySoc, float chargePowerKw, float deltaTimeSec)
 {
     // Detect charging start
     if (isCharging && !m_isCharging) {
@@ -32,10 +34,10 @@ void ChargingManager::updateChargingState(bool isCharging, float batterySoc, flo
         }
         
         // Estimate energy added (power * time)
-        // Assuming updates every ~0.2 seconds
-        m_energyAddedThisSession += chargePowerKw * (0.2 / 3600.0);  // kW * hours
+        m_energyAddedThisSession += chargePowerKw * (deltaTimeSec / 3600.0f);  // kW * hours
         
         m_currentSession.energyAdded = m_energyAddedThisSession;
+        m_currentSession.maxPower = qMax(m_currentSession.maxPower, chargePowerKw);
         m_currentSession.endSoc = batterySoc;
         m_currentSession.durationSeconds = m_sessionStartTime.secsTo(QDateTime::currentDateTime());
     }
@@ -52,6 +54,7 @@ void ChargingManager::startChargingSession(float batterySoc)
     m_currentSession.endSoc = batterySoc;
     m_currentSession.energyAdded = 0.0;
     m_currentSession.averagePower = 0.0;
+    m_currentSession.maxPower = 0.0;
     m_currentSession.durationSeconds = 0;
     m_currentSession.isComplete = false;
     
@@ -75,7 +78,7 @@ void ChargingManager::endChargingSession(float batterySoc)
     qDebug() << "  Energy added:" << m_currentSession.energyAdded << "kWh";
     qDebug() << "  Average power:" << m_currentSession.averagePower << "kW";
     
-    emit chargingCompleted();
+    emit chargingCompleted(m_currentSession);
 }
 
 int ChargingManager::getTimeToFull() const
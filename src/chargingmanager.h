@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QDateTime>
+#include <QMetaType>
 
 struct ChargingSession {
     QDateTime startTime;
@@ -11,6 +12,7 @@ struct ChargingSession {
     float endSoc;
     float energyAdded;         // kWh
     float averagePower;        // kW
+    float maxPower;            // kW
     int durationSeconds;
     bool isComplete;
 };
@@ -22,8 +24,8 @@ class ChargingManager : public QObject
 public:
     explicit ChargingManager(QObject *parent = nullptr);
     
-    // Update charging state
-    void updateChargingState(bool isCharging, float batterySoc, float chargePowerKw);
+    // Update charging state; deltaTimeSec is the time since the previous update
+    void updateChargingState(bool isCharging, float batterySoc, float chargePowerKw, float deltaTimeSec);
     
     // Get current session info
     bool isChargingActive() const { return m_isCharging; }
@@ -42,7 +44,7 @@ public:
     
 signals:
     void chargingStarted();
-    void chargingCompleted();
+    void chargingCompleted(const ChargingSession &session);
 
 private:
     void startChargingSession(float batterySoc);
@@ -58,4 +60,6 @@ private:
     QDateTime m_sessionStartTime;
 };
 
+Q_DECLARE_METATYPE(ChargingSession)
+
 #endif // CHARGINGMANAGER_H
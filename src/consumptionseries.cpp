@@ -0,0 +1,40 @@
+#include "consumptionseries.h"
+
+ConsumptionSeries::ConsumptionSeries(int capacity, QObject *parent)
+    : QObject(parent),
+      m_values(qMax(1, capacity), 0.0f)
+{
+}
+
+void ConsumptionSeries::append(float value)
+{
+    const qint64 sequence = m_nextSequence++;
+    m_values[sequence % m_values.size()] = value;
+
+    if (m_count < m_values.size()) {
+        m_count++;
+        emit countChanged();
+    }
+    emit appended(sequence, value);
+}
+
+void ConsumptionSeries::clear()
+{
+    m_count = 0;
+    m_nextSequence = 0;
+    emit cleared();
+    emit countChanged();
+}
+
+float ConsumptionSeries::latest() const
+{
+    return m_count > 0 ? valueAt(m_nextSequence - 1) : 0.0f;
+}
+
+float ConsumptionSeries::valueAt(qint64 sequence) const
+{
+    if (sequence < firstSequence() || sequence >= m_nextSequence) {
+        return 0.0f;
+    }
+    return m_values[sequence % m_values.size()];
+}
@@ -0,0 +1,43 @@
+#ifndef CONSUMPTIONSERIES_H
+#define CONSUMPTIONSERIES_H
+
+#include <QObject>
+#include <QVector>
+
+// Fixed-capacity ring buffer of per-km consumption (Wh/km).
+// Appends are O(1) and nothing is copied out to QML; views such as
+// EfficiencyGraphItem read samples in place by sequence number.
+class ConsumptionSeries : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ capacity CONSTANT)
+    Q_PROPERTY(float latest READ latest NOTIFY appended)
+
+public:
+    explicit ConsumptionSeries(int capacity = 512, QObject *parent = nullptr);
+
+    void append(float value);
+    void clear();
+
+    int count() const { return m_count; }
+    int capacity() const { return m_values.size(); }
+    float latest() const;
+
+    // Sequence numbers grow forever; only the last capacity() are retained
+    qint64 firstSequence() const { return m_nextSequence - m_count; }
+    qint64 nextSequence() const { return m_nextSequence; }
+    float valueAt(qint64 sequence) const;
+
+signals:
+    void appended(qint64 sequence, float value);
+    void cleared();
+    void countChanged();
+
+private:
+    QVector<float> m_values;
+    int m_count = 0;
+    qint64 m_nextSequence = 0;
+};
+
+#endif // CONSUMPTIONSERIES_H
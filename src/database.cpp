@@ -1,26 +1,56 @@
 #include "database.h"
+#include "schemamigrator.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include <QVariant>
 #include <QStandardPaths>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
 
-DatabaseManager::DatabaseManager(QObject *parent) 
+// Named connection so the database can be owned by a worker thread
+static const QString kConnectionName = QStringLiteral("ev_cluster");
+
+DatabaseManager::DatabaseManager(QObject *parent)
     : QObject(parent),
       m_isInitialized(false)
 {
 }
 
-bool DatabaseManager::init()
+DatabaseManager::~DatabaseManager()
 {
-    // Use application data directory
-    QString dataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir().mkpath(dataPath);
+    clearStatementCache();
     
-    QString dbPath = dataPath + "/ev_cluster.db";
+    if (m_db.isValid()) {
+        m_db.close();
+        m_db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(kConnectionName);
+    }
+}
+
+QString DatabaseManager::defaultPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+        + "/ev-instrument-cluster/ev_cluster.db";
+}
+
+bool DatabaseManager::init(const QString &dbPath)
+{
+    QDir().mkpath(QFileInfo(dbPath).absolutePath());
+    
+    // Earlier builds kept the history in ev-cluster's own data directory
+    const QString legacyPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+        + "/ev_cluster.db";
+    if (!QFile::exists(dbPath) && legacyPath != dbPath && QFile::exists(legacyPath)) {
+        for (const char *suffix : { "", "-wal", "-shm" }) {
+            QFile::rename(legacyPath + suffix, dbPath + suffix);
+        }
+        qDebug() << "Moved trip history from" << legacyPath;
+    }
     
-    m_db = QSqlDatabase::addDatabase("QSQLITE");
+    m_db = QSqlDatabase::addDatabase("QSQLITE", kConnectionName);
     m_db.setDatabaseName(dbPath);
     
     if (!m_db.open()) {
@@ -30,76 +60,158 @@ bool DatabaseManager::init()
     
     qDebug() << "Database opened successfully at:" << dbPath;
     
+    // WAL keeps readers off the writer's back and cuts fsyncs per commit
+    QSqlQuery pragma(m_db);
+    pragma.exec("PRAGMA journal_mode=WAL");
+    pragma.exec("PRAGMA synchronous=NORMAL");
+    
     m_isInitialized = createTables();
     return m_isInitialized;
 }
 
 bool DatabaseManager::createTables()
 {
-    QSqlQuery query(m_db);
-    
-    // Create trips table
-    QString createTripsTable = R"(
-        CREATE TABLE IF NOT EXISTS trips (
-            id INTEGER PRIMARY KEY AUTOINCREMENT,
-            start_time DATETIME,
-            end_time DATETIME,
-            distance_km REAL,
-            energy_kwh REAL,
-            avg_efficiency REAL,
-            start_soc REAL,
-            end_soc REAL
-        )
-    )";
-    
-    if (!query.exec(createTripsTable)) {
-        qCritical() << "Error creating trips table:" << query.lastError().text();
+    // Schema is owned by the versioned migrations in schemamigrator.cpp
+    SchemaMigrator migrator(m_db);
+    if (!migrator.migrate()) {
+        qCritical() << "Error migrating database schema";
         return false;
     }
     
-    // Create settings table
-    QString createSettingsTable = R"(
-        CREATE TABLE IF NOT EXISTS settings (
-            key TEXT PRIMARY KEY,
-            value TEXT
-        )
-    )";
-    
-    if (!query.exec(createSettingsTable)) {
-        qCritical() << "Error creating settings table:" << query.lastError().text();
-        return false;
+    // Rollups came after the trip history - backfill them once. The pending
+    // mark is cleared in the rebuild's transaction, so an interrupted backfill
+    // runs again next boot.
+    QSqlQuery pending(m_db);
+    if (pending.exec("SELECT 1 FROM rollup_backfill LIMIT 1") && pending.next()) {
+        rebuildRollups();
     }
     
-    qDebug() << "Database tables created successfully";
+    qDebug() << "Database schema at version" << migrator.currentVersion();
     return true;
 }
 
+QSqlQuery &DatabaseManager::cachedQuery(const QString &sql)
+{
+    auto it = m_statements.find(sql);
+    if (it == m_statements.end()) {
+        QSqlQuery *query = new QSqlQuery(m_db);
+        if (!query->prepare(sql)) {
+            qCritical() << "Error preparing statement:" << query->lastError().text();
+        }
+        it = m_statements.insert(sql, query);
+    }
+    return *it.value();
+}
+
+void DatabaseManager::clearStatementCache()
+{
+    qDeleteAll(m_statements);
+    m_statements.clear();
+}
+
+// Route as big-endian microdegree pairs, ~8 bytes per point
+static QByteArray routeToBlob(const QVector<RoutePoint> &route)
+{
+    QByteArray blob;
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    for (const RoutePoint &point : route) {
+        stream << qint32(qRound(point.latitude * 1e6)) << qint32(qRound(point.longitude * 1e6));
+    }
+    return blob;
+}
+
+static QVector<RoutePoint> routeFromBlob(const QByteArray &blob)
+{
+    QVector<RoutePoint> route;
+    QDataStream stream(blob);
+    while (!stream.atEnd()) {
+        qint32 latitude = 0;
+        qint32 longitude = 0;
+        stream >> latitude >> longitude;
+        if (stream.status() != QDataStream::Ok) break;
+        route.append(RoutePoint { latitude / 1e6, longitude / 1e6 });
+    }
+    return route;
+}
+
+TripRecord DatabaseManager::tripFromQuery(const QSqlQuery &query) const
+{
+    TripRecord trip;
+    trip.id = query.value("id").toInt();
+    trip.startTime = QDateTime::fromMSecsSinceEpoch(query.value("start_time").toLongLong());
+    trip.endTime = QDateTime::fromMSecsSinceEpoch(query.value("end_time").toLongLong());
+    trip.distanceKm = query.value("distance_km").toFloat();
+    trip.energyKwh = query.value("energy_kwh").toFloat();
+    trip.averageEfficiency = query.value("avg_efficiency").toFloat();
+    trip.startSoc = query.value("start_soc").toFloat();
+    trip.endSoc = query.value("end_soc").toFloat();
+    trip.regenKwh = query.value("regen_kwh").toFloat();
+    trip.minLatitude = query.value("min_lat").toDouble();
+    trip.minLongitude = query.value("min_lon").toDouble();
+    trip.maxLatitude = query.value("max_lat").toDouble();
+    trip.maxLongitude = query.value("max_lon").toDouble();
+    trip.route = routeFromBlob(query.value("route").toByteArray());
+    return trip;
+}
+
 int DatabaseManager::saveTrip(const TripRecord &trip)
 {
     if (!m_isInitialized) return -1;
     
-    QSqlQuery query(m_db);
-    query.prepare(R"(
+    // Raw row and rollups commit together
+    if (!m_db.transaction()) {
+        qCritical() << "Error saving trip:" << m_db.lastError().text();
+        return -1;
+    }
+    
+    QSqlQuery &query = cachedQuery(R"(
         INSERT INTO trips (start_time, end_time, distance_km, energy_kwh, 
-                          avg_efficiency, start_soc, end_soc)
+                          avg_efficiency, avg_speed_kmh, start_soc, end_soc, regen_kwh,
+                          min_lat, min_lon, max_lat, max_lon, route)
         VALUES (:start_time, :end_time, :distance_km, :energy_kwh,
-                :avg_efficiency, :start_soc, :end_soc)
+                :avg_efficiency, :avg_speed_kmh, :start_soc, :end_soc, :regen_kwh,
+                :min_lat, :min_lon, :max_lat, :max_lon, :route)
     )");
     
-    query.bindValue(":start_time", trip.startTime);
-    query.bindValue(":end_time", trip.endTime);
+    // Timestamps are stored as epoch milliseconds for index-friendly range scans
+    qint64 startMs = trip.startTime.toMSecsSinceEpoch();
+    qint64 endMs = trip.endTime.toMSecsSinceEpoch();
+    float hours = (endMs - startMs) / 3600000.0f;
+    
+    query.bindValue(":start_time", startMs);
+    query.bindValue(":end_time", endMs);
     query.bindValue(":distance_km", trip.distanceKm);
     query.bindValue(":energy_kwh", trip.energyKwh);
     query.bindValue(":avg_efficiency", trip.averageEfficiency);
+    query.bindValue(":avg_speed_kmh", hours > 0 ? trip.distanceKm / hours : 0.0f);
     query.bindValue(":start_soc", trip.startSoc);
     query.bindValue(":end_soc", trip.endSoc);
+    query.bindValue(":regen_kwh", trip.regenKwh);
+    query.bindValue(":min_lat", trip.minLatitude);
+    query.bindValue(":min_lon", trip.minLongitude);
+    query.bindValue(":max_lat", trip.maxLatitude);
+    query.bindValue(":max_lon", trip.maxLongitude);
+    query.bindValue(":route", routeToBlob(trip.route));
     
     if (!query.exec()) {
         qCritical() << "Error saving trip:" << query.lastError().text();
+        m_db.rollback();
         return -1;
     }
     
     int tripId = query.lastInsertId().toInt();
+    query.finish();
+    
+    if (!addTripToRollups(trip)) {
+        m_db.rollback();
+        return -1;
+    }
+    
+    if (!m_db.commit()) {
+        qCritical() << "Error saving trip:" << m_db.lastError().text();
+        m_db.rollback();
+        return -1;
+    }
     qDebug() << "Trip saved with ID:" << tripId;
     return tripId;
 }
@@ -110,8 +222,7 @@ QList<TripRecord> DatabaseManager::getRecentTrips(int count)
     
     if (!m_isInitialized) return trips;
     
-    QSqlQuery query(m_db);
-    query.prepare("SELECT * FROM trips ORDER BY end_time DESC LIMIT :count");
+    QSqlQuery &query = cachedQuery("SELECT * FROM trips ORDER BY end_time DESC LIMIT :count");
     query.bindValue(":count", count);
     
     if (!query.exec()) {
@@ -120,17 +231,9 @@ QList<TripRecord> DatabaseManager::getRecentTrips(int count)
     }
     
     while (query.next()) {
-        TripRecord trip;
-        trip.id = query.value("id").toInt();
-        trip.startTime = query.value("start_time").toDateTime();
-        trip.endTime = query.value("end_time").toDateTime();
-        trip.distanceKm = query.value("distance_km").toFloat();
-        trip.energyKwh = query.value("energy_kwh").toFloat();
-        trip.averageEfficiency = query.value("avg_efficiency").toFloat();
-        trip.startSoc = query.value("start_soc").toFloat();
-        trip.endSoc = query.value("end_soc").toFloat();
-        trips.append(trip);
+        trips.append(tripFromQuery(query));
     }
+    query.finish();
     
     return trips;
 }
@@ -142,97 +245,310 @@ TripRecord DatabaseManager::getTrip(int tripId)
     
     if (!m_isInitialized) return trip;
     
-    QSqlQuery query(m_db);
-    query.prepare("SELECT * FROM trips WHERE id = :id");
+    QSqlQuery &query = cachedQuery("SELECT * FROM trips WHERE id = :id");
     query.bindValue(":id", tripId);
     
     if (query.exec() && query.next()) {
-        trip.id = query.value("id").toInt();
-        trip.startTime = query.value("start_time").toDateTime();
-        trip.endTime = query.value("end_time").toDateTime();
-        trip.distanceKm = query.value("distance_km").toFloat();
-        trip.energyKwh = query.value("energy_kwh").toFloat();
-        trip.averageEfficiency = query.value("avg_efficiency").toFloat();
-        trip.startSoc = query.value("start_soc").toFloat();
-        trip.endSoc = query.value("end_soc").toFloat();
+        trip = tripFromQuery(query);
     }
+    query.finish();
     
     return trip;
 }
 
-float DatabaseManager::getTotalDistance()
+int DatabaseManager::saveChargingSession(const ChargingSession &session, double latitude, double longitude)
+{
+    if (!m_isInitialized) return -1;
+    
+    if (!m_db.transaction()) {
+        qCritical() << "Error saving charging session:" << m_db.lastError().text();
+        return -1;
+    }
+    
+    QSqlQuery &query = cachedQuery(R"(
+        INSERT INTO charging_logs (start_time, end_time, plug_in_soc, unplug_soc, energy_added_kwh,
+                                   max_power_kw, avg_power_kw, location_lat, location_lon)
+        VALUES (:start_time, :end_time, :plug_in_soc, :unplug_soc, :energy_added_kwh,
+                :max_power_kw, :avg_power_kw, :location_lat, :location_lon)
+    )");
+    
+    query.bindValue(":start_time", session.startTime.toMSecsSinceEpoch());
+    query.bindValue(":end_time", session.endTime.toMSecsSinceEpoch());
+    query.bindValue(":plug_in_soc", session.startSoc);
+    query.bindValue(":unplug_soc", session.endSoc);
+    query.bindValue(":energy_added_kwh", session.energyAdded);
+    query.bindValue(":max_power_kw", session.maxPower);
+    query.bindValue(":avg_power_kw", session.averagePower);
+    query.bindValue(":location_lat", latitude);
+    query.bindValue(":location_lon", longitude);
+    
+    if (!query.exec()) {
+        qCritical() << "Error saving charging session:" << query.lastError().text();
+        m_db.rollback();
+        return -1;
+    }
+    
+    int sessionId = query.lastInsertId().toInt();
+    query.finish();
+    
+    if (!addChargeToRollups(session.endTime, session.energyAdded)) {
+        m_db.rollback();
+        return -1;
+    }
+    
+    if (!m_db.commit()) {
+        qCritical() << "Error saving charging session:" << m_db.lastError().text();
+        m_db.rollback();
+        return -1;
+    }
+    qDebug() << "Charging session saved with ID:" << sessionId;
+    return sessionId;
+}
+
+bool DatabaseManager::addTripToRollups(const TripRecord &trip)
 {
-    if (!m_isInitialized) return 0.0f;
+    QSqlQuery &read = cachedQuery(
+        "SELECT efficiency_histogram FROM trip_rollups WHERE bucket = :bucket AND bucket_start = :start");
+    QSqlQuery &upsert = cachedQuery(R"(
+        INSERT INTO trip_rollups (bucket, bucket_start, distance_km, energy_kwh, regen_kwh,
+                                  trip_count, efficiency_histogram)
+        VALUES (:bucket, :start, :distance_km, :energy_kwh, :regen_kwh, 1, :histogram)
+        ON CONFLICT (bucket, bucket_start) DO UPDATE SET
+            distance_km = distance_km + excluded.distance_km,
+            energy_kwh = energy_kwh + excluded.energy_kwh,
+            regen_kwh = regen_kwh + excluded.regen_kwh,
+            trip_count = trip_count + 1,
+            efficiency_histogram = excluded.efficiency_histogram
+    )");
     
-    QSqlQuery query("SELECT SUM(distance_km) FROM trips", m_db);
-    if (query.next()) {
-        return query.value(0).toFloat();
+    // Trips are attributed to the bucket they end in
+    for (RollupBucket bucket : TripRollup::allBuckets()) {
+        qint64 start = TripRollup::bucketStart(bucket, trip.endTime).toMSecsSinceEpoch();
+        
+        read.bindValue(":bucket", int(bucket));
+        read.bindValue(":start", start);
+        EfficiencyHistogram histogram;
+        if (read.exec() && read.next()) {
+            histogram = EfficiencyHistogram::fromBlob(read.value(0).toByteArray());
+        }
+        read.finish();
+        
+        if (trip.distanceKm > 0.1f) {
+            histogram.add(trip.averageEfficiency);
+        }
+        
+        upsert.bindValue(":bucket", int(bucket));
+        upsert.bindValue(":start", start);
+        upsert.bindValue(":distance_km", trip.distanceKm);
+        upsert.bindValue(":energy_kwh", trip.energyKwh);
+        upsert.bindValue(":regen_kwh", trip.regenKwh);
+        upsert.bindValue(":histogram", histogram.toBlob());
+        
+        if (!upsert.exec()) {
+            qCritical() << "Error updating trip rollups:" << upsert.lastError().text();
+            return false;
+        }
+        upsert.finish();
     }
-    return 0.0f;
+    return true;
 }
 
-float DatabaseManager::getTotalEnergy()
+bool DatabaseManager::addChargeToRollups(const QDateTime &endTime, float energyKwh)
 {
-    if (!m_isInitialized) return 0.0f;
+    QSqlQuery &upsert = cachedQuery(R"(
+        INSERT INTO trip_rollups (bucket, bucket_start, charge_kwh, charge_sessions)
+        VALUES (:bucket, :start, :charge_kwh, 1)
+        ON CONFLICT (bucket, bucket_start) DO UPDATE SET
+            charge_kwh = charge_kwh + excluded.charge_kwh,
+            charge_sessions = charge_sessions + 1
+    )");
     
-    QSqlQuery query("SELECT SUM(energy_kwh) FROM trips", m_db);
-    if (query.next()) {
-        return query.value(0).toFloat();
+    for (RollupBucket bucket : TripRollup::allBuckets()) {
+        upsert.bindValue(":bucket", int(bucket));
+        upsert.bindValue(":start", TripRollup::bucketStart(bucket, endTime).toMSecsSinceEpoch());
+        upsert.bindValue(":charge_kwh", energyKwh);
+        
+        if (!upsert.exec()) {
+            qCritical() << "Error updating charge rollups:" << upsert.lastError().text();
+            return false;
+        }
+        upsert.finish();
     }
-    return 0.0f;
+    return true;
 }
 
-int DatabaseManager::getTotalTrips()
+void DatabaseManager::rebuildRollups()
 {
-    if (!m_isInitialized) return 0;
+    if (!m_db.isOpen()) return;
+    
+    // Only history still present can be folded in; already-pruned rows are gone
+    if (!m_db.transaction()) {
+        qCritical() << "Error rebuilding rollups:" << m_db.lastError().text();
+        return;
+    }
+    
+    QSqlQuery query(m_db);
+    query.exec("DELETE FROM trip_rollups");
     
-    QSqlQuery query("SELECT COUNT(*) FROM trips", m_db);
-    if (query.next()) {
-        return query.value(0).toInt();
+    int trips = 0;
+    query.exec("SELECT * FROM trips ORDER BY end_time");
+    while (query.next()) {
+        if (!addTripToRollups(tripFromQuery(query))) {
+            m_db.rollback();
+            return;
+        }
+        trips++;
+    }
+    
+    int sessions = 0;
+    query.exec("SELECT end_time, energy_added_kwh FROM charging_logs ORDER BY end_time");
+    while (query.next()) {
+        QDateTime endTime = QDateTime::fromMSecsSinceEpoch(query.value(0).toLongLong());
+        if (!addChargeToRollups(endTime, query.value(1).toFloat())) {
+            m_db.rollback();
+            return;
+        }
+        sessions++;
     }
-    return 0;
+    
+    if (!query.exec("DELETE FROM rollup_backfill") || !m_db.commit()) {
+        qCritical() << "Error rebuilding rollups:" << m_db.lastError().text();
+        m_db.rollback();
+        return;
+    }
+    qDebug() << "Rollups rebuilt from" << trips << "trips and" << sessions << "charging sessions";
+}
+
+QList<RollupPoint> DatabaseManager::getRollupSeries(RollupBucket bucket, const QDateTime &from, const QDateTime &to)
+{
+    QList<RollupPoint> series;
+    
+    if (!m_isInitialized) return series;
+    
+    // Primary key (bucket, bucket_start) makes this a single range scan
+    QSqlQuery &query = cachedQuery(R"(
+        SELECT bucket_start, distance_km, energy_kwh, regen_kwh, trip_count,
+               charge_kwh, charge_sessions, efficiency_histogram
+        FROM trip_rollups
+        WHERE bucket = :bucket AND bucket_start >= :from AND bucket_start < :to
+        ORDER BY bucket_start
+    )");
+    query.bindValue(":bucket", int(bucket));
+    query.bindValue(":from", TripRollup::bucketStart(bucket, from).toMSecsSinceEpoch());
+    query.bindValue(":to", to.toMSecsSinceEpoch());
+    
+    if (!query.exec()) {
+        qCritical() << "Error retrieving rollups:" << query.lastError().text();
+        return series;
+    }
+    
+    while (query.next()) {
+        RollupPoint point;
+        point.bucketStart = QDateTime::fromMSecsSinceEpoch(query.value(0).toLongLong());
+        point.distanceKm = query.value(1).toFloat();
+        point.energyKwh = query.value(2).toFloat();
+        point.regenKwh = query.value(3).toFloat();
+        point.tripCount = query.value(4).toInt();
+        point.chargeKwh = query.value(5).toFloat();
+        point.chargeSessions = query.value(6).toInt();
+        point.efficiencyWhPerKm = point.distanceKm > 0.1f ? (point.energyKwh / point.distanceKm) * 1000.0f : 0.0f;
+        
+        EfficiencyHistogram histogram = EfficiencyHistogram::fromBlob(query.value(7).toByteArray());
+        point.efficiencyP10 = histogram.percentile(0.1f);
+        point.efficiencyP50 = histogram.percentile(0.5f);
+        point.efficiencyP90 = histogram.percentile(0.9f);
+        series.append(point);
+    }
+    query.finish();
+    
+    return series;
+}
+
+LifetimeStats DatabaseManager::getLifetimeStats()
+{
+    LifetimeStats stats;
+    
+    if (!m_isInitialized) return stats;
+    
+    QSqlQuery &query = cachedQuery(
+        "SELECT total_distance_km, total_energy_kwh, trip_count FROM trip_totals WHERE id = 1");
+    
+    if (query.exec() && query.next()) {
+        stats.totalDistanceKm = query.value(0).toFloat();
+        stats.totalEnergyKwh = query.value(1).toFloat();
+        stats.totalTrips = query.value(2).toInt();
+    }
+    query.finish();
+    
+    return stats;
+}
+
+float DatabaseManager::getTotalDistance()
+{
+    return getLifetimeStats().totalDistanceKm;
+}
+
+float DatabaseManager::getTotalEnergy()
+{
+    return getLifetimeStats().totalEnergyKwh;
+}
+
+int DatabaseManager::getTotalTrips()
+{
+    return getLifetimeStats().totalTrips;
 }
 
 void DatabaseManager::saveSetting(const QString &key, const QVariant &value)
 {
     if (!m_isInitialized) return;
     
-    QSqlQuery query(m_db);
-    query.prepare("INSERT OR REPLACE INTO settings (key, value) VALUES (:key, :value)");
+    QSqlQuery &query = cachedQuery("INSERT OR REPLACE INTO settings (key, value) VALUES (:key, :value)");
     query.bindValue(":key", key);
     query.bindValue(":value", value.toString());
     
     if (!query.exec()) {
         qCritical() << "Error saving setting:" << query.lastError().text();
     }
+    query.finish();
 }
 
 QVariant DatabaseManager::getSetting(const QString &key, const QVariant &defaultValue)
 {
     if (!m_isInitialized) return defaultValue;
     
-    QSqlQuery query(m_db);
-    query.prepare("SELECT value FROM settings WHERE key = :key");
+    QSqlQuery &query = cachedQuery("SELECT value FROM settings WHERE key = :key");
     query.bindValue(":key", key);
     
+    QVariant result = defaultValue;
     if (query.exec() && query.next()) {
-        return query.value(0);
+        result = query.value(0);
     }
+    query.finish();
     
-    return defaultValue;
+    return result;
 }
 
 void DatabaseManager::clearOldTrips(int daysToKeep)
 {
     if (!m_isInitialized) return;
     
-    QSqlQuery query(m_db);
-    query.prepare("DELETE FROM trips WHERE end_time < datetime('now', '-' || :days || ' days')");
-    query.bindValue(":days", daysToKeep);
+    qint64 cutoffMs = QDateTime::currentMSecsSinceEpoch() - qint64(daysToKeep) * 24 * 3600 * 1000;
+    
+    QSqlQuery &query = cachedQuery("DELETE FROM trips WHERE end_time < :cutoff");
+    query.bindValue(":cutoff", cutoffMs);
     
     if (query.exec()) {
         qDebug() << "Cleared trips older than" << daysToKeep << "days";
     } else {
         qCritical() << "Error clearing old trips:" << query.lastError().text();
     }
+    query.finish();
+    
+    QSqlQuery &charging = cachedQuery("DELETE FROM charging_logs WHERE end_time < :cutoff");
+    charging.bindValue(":cutoff", cutoffMs);
+    
+    if (!charging.exec()) {
+        qCritical() << "Error clearing old charging logs:" << charging.lastError().text();
+    }
+    charging.finish();
 }
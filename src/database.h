@@ -4,6 +4,17 @@
 #include <QObject>
 #include <QSqlDatabase>
 #include <QDateTime>
+#include <QHash>
+#include <QVector>
+#include "triprollup.h"
+#include "chargingmanager.h"
+
+class QSqlQuery;
+
+struct RoutePoint {
+    double latitude = 0.0;
+    double longitude = 0.0;
+};
 
 struct TripRecord {
     int id;
@@ -14,17 +25,38 @@ struct TripRecord {
     float averageEfficiency;  // Wh/km
     float startSoc;
     float endSoc;
+    float regenKwh = 0.0f;    // Energy recovered during the trip
+
+    // GPS extent and simplified path (TripDetector)
+    double minLatitude = 0.0;
+    double minLongitude = 0.0;
+    double maxLatitude = 0.0;
+    double maxLongitude = 0.0;
+    QVector<RoutePoint> route;
+};
+
+struct LifetimeStats {
+    float totalDistanceKm = 0.0f;
+    float totalEnergyKwh = 0.0f;
+    int totalTrips = 0;
 };
 
+// Synchronous SQLite access. Not thread-safe: use it from one thread only
+// (normally the DatabaseService worker, see databaseservice.h).
+
 class DatabaseManager : public QObject
 {
     Q_OBJECT
 
 public:
     explicit DatabaseManager(QObject *parent = nullptr);
+    ~DatabaseManager();
+    
+    // Shared by ev-cluster and ev-datad, like the state snapshot
+    static QString defaultPath();
     
     // Initialize database
-    bool init();
+    bool init(const QString &path = defaultPath());
     bool createTables();
     
     // Trip operations
@@ -32,21 +64,39 @@ public:
     QList<TripRecord> getRecentTrips(int count = 10);
     TripRecord getTrip(int tripId);
     
-    // Statistics
+    // Statistics (O(1) - read from the trip_totals summary row)
+    LifetimeStats getLifetimeStats();
     float getTotalDistance();
     float getTotalEnergy();
     int getTotalTrips();
     
+    // Charging sessions
+    int saveChargingSession(const ChargingSession &session, double latitude = 0.0, double longitude = 0.0);
+    
+    // Analytics - one indexed range read over the rollup table
+    QList<RollupPoint> getRollupSeries(RollupBucket bucket, const QDateTime &from, const QDateTime &to);
+    void rebuildRollups();
+    
     // Settings operations
     void saveSetting(const QString &key, const QVariant &value);
     QVariant getSetting(const QString &key, const QVariant &defaultValue = QVariant());
     
-    // Cleanup
+    // Cleanup - drops raw trips/charge logs only, rollups are kept
     void clearOldTrips(int daysToKeep = 30);
 
 private:
+    // Prepared once per connection, then re-bound and re-executed
+    QSqlQuery &cachedQuery(const QString &sql);
+    void clearStatementCache();
+    TripRecord tripFromQuery(const QSqlQuery &query) const;
+    
+    // Fold one completed trip / charge session into every rollup bucket
+    bool addTripToRollups(const TripRecord &trip);
+    bool addChargeToRollups(const QDateTime &endTime, float energyKwh);
+
     QSqlDatabase m_db;
     bool m_isInitialized;
+    QHash<QString, QSqlQuery *> m_statements;
 };
 
 #endif // DATABASE_H
@@ -0,0 +1,91 @@
+#include "databaseservice.h"
+#include <QDebug>
+
+static const int kRetentionIntervalMs = 24 * 3600 * 1000;
+
+DatabaseService::DatabaseService(QObject *parent)
+    : QObject(parent),
+      m_manager(new DatabaseManager)
+{
+    m_thread.setObjectName("DatabaseWorker");
+
+    // Manager (and its SQLite connection) lives and dies on the worker thread
+    m_manager->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_manager, &QObject::deleteLater);
+
+    m_thread.start(QThread::LowPriority);
+
+    m_retentionTimer.setInterval(kRetentionIntervalMs);
+    connect(&m_retentionTimer, &QTimer::timeout, this, [this] { clearOldTrips(m_daysToKeep); });
+}
+
+DatabaseService::~DatabaseService()
+{
+    // Quit from inside the queue so pending writes are flushed first
+    QThread *thread = &m_thread;
+    QMetaObject::invokeMethod(m_manager, [thread]() { thread->quit(); }, Qt::QueuedConnection);
+    m_thread.wait();
+}
+
+QFuture<bool> DatabaseService::init(const QString &path)
+{
+    return run<bool>([path](DatabaseManager *db) { return db->init(path); });
+}
+
+QFuture<int> DatabaseService::saveTrip(const TripRecord &trip)
+{
+    return run<int>([trip](DatabaseManager *db) { return db->saveTrip(trip); });
+}
+
+QFuture<QList<TripRecord>> DatabaseService::getRecentTrips(int count)
+{
+    return run<QList<TripRecord>>([count](DatabaseManager *db) { return db->getRecentTrips(count); });
+}
+
+QFuture<TripRecord> DatabaseService::getTrip(int tripId)
+{
+    return run<TripRecord>([tripId](DatabaseManager *db) { return db->getTrip(tripId); });
+}
+
+QFuture<LifetimeStats> DatabaseService::getLifetimeStats()
+{
+    return run<LifetimeStats>([](DatabaseManager *db) { return db->getLifetimeStats(); });
+}
+
+QFuture<int> DatabaseService::saveChargingSession(const ChargingSession &session, double latitude, double longitude)
+{
+    return run<int>([session, latitude, longitude](DatabaseManager *db) {
+        return db->saveChargingSession(session, latitude, longitude);
+    });
+}
+
+QFuture<QList<RollupPoint>> DatabaseService::getRollupSeries(RollupBucket bucket, const QDateTime &from, const QDateTime &to)
+{
+    return run<QList<RollupPoint>>([bucket, from, to](DatabaseManager *db) {
+        return db->getRollupSeries(bucket, from, to);
+    });
+}
+
+void DatabaseService::saveSetting(const QString &key, const QVariant &value)
+{
+    post([key, value](DatabaseManager *db) { db->saveSetting(key, value); });
+}
+
+QFuture<QVariant> DatabaseService::getSetting(const QString &key, const QVariant &defaultValue)
+{
+    return run<QVariant>([key, defaultValue](DatabaseManager *db) {
+        return db->getSetting(key, defaultValue);
+    });
+}
+
+void DatabaseService::clearOldTrips(int daysToKeep)
+{
+    post([daysToKeep](DatabaseManager *db) { db->clearOldTrips(daysToKeep); });
+}
+
+void DatabaseService::startRetention(int daysToKeep)
+{
+    m_daysToKeep = daysToKeep;
+    clearOldTrips(m_daysToKeep);
+    m_retentionTimer.start();
+}
@@ -0,0 +1,90 @@
+#ifndef DATABASESERVICE_H
+#define DATABASESERVICE_H
+
+#include <QObject>
+#include <QThread>
+#include <QFuture>
+#include <QPromise>
+#include <QTimer>
+#include <memory>
+#include "database.h"
+
+// Owns a DatabaseManager on a dedicated worker thread.
+// Every call is queued to the worker and returns a QFuture; attach a callback
+// on the caller's thread with future.then(this, [](T result) { ... }).
+class DatabaseService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DatabaseService(QObject *parent = nullptr);
+    ~DatabaseService();
+
+    // Opens the database on the worker thread
+    QFuture<bool> init(const QString &path = DatabaseManager::defaultPath());
+
+    // Trip operations
+    QFuture<int> saveTrip(const TripRecord &trip);
+    QFuture<QList<TripRecord>> getRecentTrips(int count = 10);
+    QFuture<TripRecord> getTrip(int tripId);
+
+    // Statistics
+    QFuture<LifetimeStats> getLifetimeStats();
+
+    // Charging sessions
+    QFuture<int> saveChargingSession(const ChargingSession &session, double latitude = 0.0, double longitude = 0.0);
+
+    // Analytics
+    QFuture<QList<RollupPoint>> getRollupSeries(RollupBucket bucket, const QDateTime &from, const QDateTime &to);
+
+    // Settings operations
+    void saveSetting(const QString &key, const QVariant &value);   // fire and forget
+    QFuture<QVariant> getSetting(const QString &key, const QVariant &defaultValue = QVariant());
+
+    // Cleanup
+    void clearOldTrips(int daysToKeep = 30);
+    // clearOldTrips() now and then once a day for as long as the service runs
+    void startRetention(int daysToKeep = 30);
+
+private:
+    // Queue fn(DatabaseManager*) on the worker and return its result as a future
+    template <typename T, typename Fn>
+    QFuture<T> run(Fn fn);
+
+    // Queue fn(DatabaseManager*) on the worker without a result
+    template <typename Fn>
+    void post(Fn fn);
+
+    QThread m_thread;
+    DatabaseManager *m_manager;
+    QTimer m_retentionTimer;
+    int m_daysToKeep = 30;
+};
+
+template <typename T, typename Fn>
+QFuture<T> DatabaseService::run(Fn fn)
+{
+    // QPromise is move-only; share it so the queued functor stays copyable
+    auto promise = std::make_shared<QPromise<T>>();
+    QFuture<T> future = promise->future();
+    promise->start();
+
+    DatabaseManager *manager = m_manager;
+    QMetaObject::invokeMethod(manager, [manager, promise, fn]() {
+        promise->addResult(fn(manager));
+        promise->finish();
+    }, Qt::QueuedConnection);
+
+    return future;
+}
+
+template <typename Fn>
+void DatabaseService::post(Fn fn)
+{
+    DatabaseManager *manager = m_manager;
+    QMetaObject::invokeMethod(manager, [manager, fn]() {
+        fn(manager);
+    }, Qt::QueuedConnection);
+}
+
+#endif // DATABASESERVICE_H
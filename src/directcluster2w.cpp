@@ -0,0 +1,572 @@
+#include "directcluster2w.h"
+#include "blinkclock.h"
+#include "evvehicledata.h"
+#include "signaldecimator.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QRasterWindow>
+#include <QTime>
+
+static const int kFrameIntervalMs = 50;     // Readouts are decimated to 4-8 Hz anyway
+
+// Style.qml values used by Cluster2W
+static const QColor kBackground("#050505");
+static const QColor kBarBackground("#010101");   // "#CC000000" over the background
+static const QColor kBackgroundSecondary("#1A1A1A");
+static const QColor kPrimary("#00F3FF");
+static const QColor kAccent("#00FF9D");
+static const QColor kWarning("#FFD600");
+static const QColor kCritical("#FF003C");
+static const QColor kTextPrimary("#FFFFFF");
+static const QColor kTextSecondary("#808080");
+static const QColor kTextMuted("#404040");
+static const int kTopBarHeight = 60;
+static const int kBottomBarHeight = 60;
+static const int kBatteryHeight = 60;
+static const int kMargin = 24;
+static const float kBatteryTempLimit = 45.0f;    // WarningOverlay.qml thresholds
+static const float kSohWarning = 80.0f;
+static const float kSohCritical = 70.0f;
+static const float kCriticalSoc = 10.0f;
+static const float kCriticalSpeed = 80.0f;
+
+namespace Direct2W {
+
+// Everything a frame can show, gathered once per frame
+struct Inputs {
+    VehicleState state;
+    double speed = 0.0;         // Decimated like the QML readouts
+    double power = 0.0;
+    bool speedStale = false;
+    bool powerStale = false;
+    bool overspeed = false;
+    bool thermalWarning = false;
+    bool blinkOn = true;
+    bool blinkFast = true;
+    QString clock;
+};
+
+// One independently repainted rectangle. refresh() works out what the panel
+// would show and reports whether that differs from what is on screen.
+class Panel
+{
+public:
+    Panel(const QRect &rect, const QColor &background) : m_rect(rect), m_background(background) {}
+    virtual ~Panel() = default;
+
+    QRect rect() const { return m_rect; }
+    // Overlays are drawn over other panels and show nothing while hidden
+    virtual bool isOverlay() const { return false; }
+    virtual bool isShown() const { return true; }
+    virtual bool refresh(const Inputs &in) = 0;
+    virtual void paint(QPainter &painter) const = 0;
+
+protected:
+    QRect m_rect;
+    QColor m_background;
+};
+
+class TextPanel : public Panel
+{
+public:
+    using Format = std::function<void(const Inputs &, QString *, QColor *)>;
+
+    TextPanel(const QRect &rect, const QColor &background, const QFont &font, int flags, const Format &format)
+        : Panel(rect, background), m_font(font), m_flags(flags), m_format(format) {}
+
+    bool refresh(const Inputs &in) override
+    {
+        QString text;
+        QColor color = kTextPrimary;
+        m_format(in, &text, &color);
+        if (text == m_text && color == m_color) return false;
+        m_text = text;
+        m_color = color;
+        return true;
+    }
+
+    void paint(QPainter &painter) const override
+    {
+        painter.fillRect(m_rect, m_background);
+        if (m_text.isEmpty()) return;
+        painter.setFont(m_font);
+        painter.setPen(m_color);
+        painter.drawText(m_rect, m_flags, m_text);
+    }
+
+private:
+    QFont m_font;
+    int m_flags;
+    Format m_format;
+    QString m_text;
+    QColor m_color;
+};
+
+// Battery bar: repainted when the fill moves by a whole pixel or changes color
+class BatteryBarPanel : public Panel
+{
+public:
+    using Panel::Panel;
+
+    bool refresh(const Inputs &in) override
+    {
+        const float soc = qBound(0.0f, in.state.batterySoc, 100.0f);
+        const int fill = int((m_rect.width() - 8) * soc / 100.0f);
+        const QColor color = soc > 50 ? kAccent : soc > 20 ? kWarning : kCritical;
+        if (fill == m_fill && color == m_color) return false;
+        m_fill = fill;
+        m_color = color;
+        return true;
+    }
+
+    void paint(QPainter &painter) const override
+    {
+        painter.fillRect(m_rect, m_background);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(kTextMuted, 2));
+        painter.setBrush(kBackgroundSecondary);
+        painter.drawRoundedRect(QRectF(m_rect).adjusted(1, 1, -1, -1), 20, 20);
+        if (m_fill > 0) {
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(m_color);
+            painter.drawRoundedRect(QRectF(m_rect.left() + 4, m_rect.top() + 4, m_fill, m_rect.height() - 8), 16, 16);
+        }
+        painter.setRenderHint(QPainter::Antialiasing, false);
+
+        QFont font(QStringLiteral("Inter"));
+        font.setPixelSize(12);
+        painter.setFont(font);
+        painter.setPen(QColor(128, 128, 128, 128));
+        painter.drawText(m_rect, Qt::AlignCenter, QStringLiteral("BATTERY"));
+    }
+
+private:
+    int m_fill = -1;
+    QColor m_color;
+};
+
+// A WarningOverlay.qml box: drawn over the readouts while its condition
+// holds. Blinking borders and titles change with the BlinkClock edges.
+class WarningPanel : public Panel
+{
+public:
+    struct Content {
+        QString title;          // Empty hides the warning
+        QString detail;         // Lines under the title
+        QColor titleColor;
+        QColor borderColor;
+        bool operator==(const Content &other) const
+        {
+            return title == other.title && detail == other.detail
+                && titleColor == other.titleColor && borderColor == other.borderColor;
+        }
+    };
+    using Format = std::function<void(const Inputs &, Content *)>;
+
+    WarningPanel(const QRect &rect, const Format &format) : Panel(rect, Qt::transparent), m_format(format) {}
+
+    bool isOverlay() const override { return true; }
+    bool isShown() const override { return !m_content.title.isEmpty(); }
+
+    bool refresh(const Inputs &in) override
+    {
+        Content content;
+        m_format(in, &content);
+        if (content == m_content) return false;
+        m_content = content;
+        return true;
+    }
+
+    void paint(QPainter &painter) const override
+    {
+        if (!isShown()) return;
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(m_content.borderColor, 4));
+        painter.setBrush(QColor(0, 0, 0, 0xDD));
+        painter.drawRoundedRect(QRectF(m_rect).adjusted(2, 2, -2, -2), 20, 20);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+
+        const int titleSize = qMin(28, m_rect.height() / 4);
+        QFont title(QStringLiteral("Inter"));
+        title.setPixelSize(titleSize);
+        title.setBold(true);
+        painter.setFont(title);
+        painter.setPen(m_content.titleColor);
+        const QRect inner = m_rect.adjusted(12, 8, -12, -8);
+        if (m_content.detail.isEmpty()) {
+            painter.drawText(inner, Qt::AlignCenter, m_content.title);
+            return;
+        }
+        painter.drawText(inner, Qt::AlignHCenter | Qt::AlignTop, m_content.title);
+
+        QFont detail(QStringLiteral("Inter"));
+        detail.setPixelSize(qMax(14, titleSize * 3 / 4));
+        painter.setFont(detail);
+        painter.setPen(kTextPrimary);
+        painter.drawText(inner.adjusted(0, titleSize + 8, 0, 0), Qt::AlignHCenter | Qt::AlignVCenter, m_content.detail);
+    }
+
+private:
+    Format m_format;
+    Content m_content;
+};
+
+} // namespace Direct2W
+
+using namespace Direct2W;
+
+// Development output: the backing store flushes only the region passed to update()
+class DirectCluster2W::Window : public QRasterWindow
+{
+public:
+    explicit Window(const QImage *image) : m_image(image) {}
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        QPainter painter(this);
+        for (const QRect &rect : event->region()) {
+            painter.drawImage(rect, *m_image, rect);
+        }
+    }
+
+private:
+    const QImage *m_image;
+};
+
+static QFont font(int pixelSize, bool bold)
+{
+    QFont font(QStringLiteral("Inter"));
+    font.setPixelSize(pixelSize);
+    font.setBold(bold);
+    return font;
+}
+
+DirectCluster2W::DirectCluster2W(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData), m_inputs(new Inputs)
+{
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(kFrameIntervalMs);
+    connect(&m_frameTimer, &QTimer::timeout, this, &DirectCluster2W::renderFrame);
+    connect(&m_statsTimer, &QTimer::timeout, this, &DirectCluster2W::logStatistics);
+
+    // Same readout rates and filters as Cluster2W.qml
+    SignalDecimator *decimator = SignalDecimator::instance();
+    m_speedSubscription = decimator->subscribe(VehicleSignal::Speed, 8, DecimationFilter::Mean,
+                                               [this](double value) { m_inputs->speed = value; });
+    m_powerSubscription = decimator->subscribe(VehicleSignal::PowerOutput, 4, DecimationFilter::Mean,
+                                               [this](double value) { m_inputs->power = value; });
+}
+
+DirectCluster2W::~DirectCluster2W()
+{
+    SignalDecimator::instance()->unsubscribe(m_speedSubscription);
+    SignalDecimator::instance()->unsubscribe(m_powerSubscription);
+}
+
+bool DirectCluster2W::openFramebuffer(const QString &device)
+{
+    if (!m_framebuffer.open(device)) return false;
+    m_image = QImage(m_framebuffer.size(), m_framebuffer.format());
+    createPanels(m_image.size());
+    return true;
+}
+
+void DirectCluster2W::openWindow(const QSize &size)
+{
+    m_image = QImage(size, QImage::Format_RGB32);
+    createPanels(size);
+    m_window.reset(new Window(&m_image));
+    m_window->setTitle(QStringLiteral("EV Instrument Cluster (2W direct)"));
+    m_window->resize(size);
+    m_window->show();
+}
+
+void DirectCluster2W::createPanels(const QSize &size)
+{
+    m_panels.clear();
+    const int width = size.width();
+    const int height = size.height();
+
+    // Cluster2W.qml geometry, with the speed section taking what the bars leave
+    const int bottomTop = height - kBottomBarHeight;
+    const int batteryTop = bottomTop - kMargin - kBatteryHeight;
+    const int speedTop = kTopBarHeight;
+    const int speedHeight = batteryTop - kMargin - speedTop;
+    const int topCenter = kTopBarHeight / 2;
+
+    auto text = [this](const QRect &rect, const QColor &background, const QFont &f, int flags,
+                       const TextPanel::Format &format) {
+        m_panels.emplace_back(new TextPanel(rect, background, f, flags, format));
+    };
+    const int left = Qt::AlignLeft | Qt::AlignVCenter;
+    const int right = Qt::AlignRight | Qt::AlignVCenter;
+
+    // Top bar: ready, drive mode, clock, warnings
+    text(QRect(kMargin, topCenter - 16, 32, 32), kBarBackground, font(24, false), left,
+         [](const Inputs &in, QString *t, QColor *c) {
+        *t = in.state.readyToDrive ? QStringLiteral("●") : QStringLiteral("○");
+        *c = in.state.readyToDrive ? kAccent : kTextMuted;
+    });
+    text(QRect(kMargin + 48, topCenter - 14, 120, 28), kBarBackground, font(18, true), left,
+         [](const Inputs &in, QString *t, QColor *c) {
+        switch (in.state.driveMode) {
+        case EVVehicleData::Eco: *t = QStringLiteral("ECO"); *c = kAccent; break;
+        case EVVehicleData::Normal: *t = QStringLiteral("NORMAL"); *c = kPrimary; break;
+        case EVVehicleData::Sport: *t = QStringLiteral("SPORT"); *c = kCritical; break;
+        case EVVehicleData::Custom: *t = QStringLiteral("CUSTOM"); *c = kWarning; break;
+        }
+    });
+    text(QRect(width / 2 - 60, topCenter - 16, 120, 32), kBarBackground, font(24, true), Qt::AlignCenter,
+         [](const Inputs &in, QString *t, QColor *) { *t = in.clock; });
+    const QString icons[] = { QStringLiteral("⚠️"), QStringLiteral("🔋"), QStringLiteral("🚪") };
+    for (int i = 0; i < 3; ++i) {
+        const QString icon = icons[i];
+        text(QRect(width - kMargin - (3 - i) * 56, topCenter - 26, 52, 52), kBarBackground, font(40, false),
+             Qt::AlignCenter, [i, icon](const Inputs &in, QString *t, QColor *) {
+            const bool visible = i == 0 ? in.state.batterySoc < 15
+                               : i == 1 ? bool(in.state.chargingActive) : bool(in.state.doorAjar);
+            *t = visible ? icon : QString();
+        });
+    }
+
+    // Speed hero; the unit below it is static
+    const int heroSize = qMin(200, (speedHeight - 60) * 9 / 10);
+    text(QRect(width / 2 - 300, speedTop, 600, speedHeight - 60), kBackground, font(heroSize, true),
+         Qt::AlignHCenter | Qt::AlignBottom, [](const Inputs &in, QString *t, QColor *) {
+        *t = in.speedStale ? QStringLiteral("--") : QString::number(qRound(in.speed));
+    });
+
+    // Battery row: percentage, bar, range
+    text(QRect(kMargin, batteryTop, 180, kBatteryHeight), kBackground, font(48, true), left,
+         [](const Inputs &in, QString *t, QColor *c) {
+        *t = QString::number(qRound(in.state.batterySoc)) + QLatin1Char('%');
+        *c = in.state.batterySoc > 20 ? kTextPrimary : kCritical;
+    });
+    m_panels.emplace_back(new BatteryBarPanel(QRect(kMargin + 196, batteryTop + 10, width - 2 * kMargin - 196 - 196, 40),
+                                              kBackground));
+    text(QRect(width - kMargin - 180, batteryTop, 180, kBatteryHeight), kBackground, font(36, true), right,
+         [](const Inputs &in, QString *t, QColor *) {
+        *t = QString::number(qRound(in.state.estimatedRange)) + QStringLiteral(" km");
+    });
+
+    // Bottom bar values; labels are static
+    const int column = width / 4;
+    const QRect valueRect(0, bottomTop + 4, column, 32);
+    text(valueRect.translated(0 * column, 0), kBarBackground, font(28, true), Qt::AlignCenter,
+         [](const Inputs &in, QString *t, QColor *c) {
+        *t = in.powerStale ? QStringLiteral("--") : QString::number(in.power, 'f', 1);
+        *c = in.power < 0 ? kAccent : kTextPrimary;
+    });
+    text(valueRect.translated(1 * column, 0), kBarBackground, font(28, true), Qt::AlignCenter,
+         [](const Inputs &in, QString *t, QColor *c) {
+        *t = QString::number(in.state.motorTemp, 'f', 0) + QStringLiteral("°");
+        *c = in.state.motorTemp > 70 ? kWarning : kTextPrimary;
+    });
+    text(valueRect.translated(2 * column, 0), kBarBackground, font(28, true), Qt::AlignCenter,
+         [](const Inputs &in, QString *t, QColor *) {
+        *t = QString::number(in.state.tripDistanceA, 'f', 1);
+    });
+    text(valueRect.translated(3 * column, 0), kBarBackground, font(28, true), Qt::AlignCenter,
+         [](const Inputs &in, QString *t, QColor *) {
+        *t = QString::number(in.state.averageConsumption, 'f', 0);
+    });
+
+    // WarningOverlay.qml, bottom to top
+    auto warning = [this](const QRect &rect, const WarningPanel::Format &format) {
+        m_panels.emplace_back(new WarningPanel(rect, format));
+    };
+    warning(QRect(width - kMargin - 200, kMargin, 200, 60), [](const Inputs &in, WarningPanel::Content *w) {
+        if (!in.overspeed) return;
+        w->title = QStringLiteral("⚠ OVERSPEED");
+        w->titleColor = in.blinkOn ? kWarning : kWarning.darker(250);
+        w->borderColor = kWarning;
+    });
+    const int boxHeight = qMin(300, height - 2 * kMargin);
+    warning(QRect(width / 2 - 250, (height - boxHeight) / 2, 500, boxHeight), [](const Inputs &in, WarningPanel::Content *w) {
+        const float soh = in.state.batterySoh;
+        if (soh >= kSohWarning) return;
+        w->title = QStringLiteral("BATTERY HEALTH LOW");
+        w->detail = QStringLiteral("State of Health %1%\n\n%2").arg(soh, 0, 'f', 1)
+            .arg(soh < kSohCritical ? QStringLiteral("SERVICE REQUIRED - BATTERY DEGRADED")
+                                    : QStringLiteral("Consider battery service check"));
+        w->titleColor = kWarning;
+        w->borderColor = soh < kSohCritical && in.blinkOn ? kCritical : kWarning;
+    });
+    warning(QRect(width / 2 - 250, (height - boxHeight) / 2, 500, boxHeight), [](const Inputs &in, WarningPanel::Content *w) {
+        if (!in.thermalWarning) return;
+        w->title = QStringLiteral("HIGH TEMPERATURE WARNING");
+        w->detail = QStringLiteral("Battery %1°C    Motor %2°C\n\nREDUCE LOAD & MONITOR")
+            .arg(in.state.batteryTempAvg, 0, 'f', 1).arg(in.state.motorTemp, 0, 'f', 1);
+        w->titleColor = in.blinkOn ? kCritical : kCritical.darker(200);
+        w->borderColor = kCritical;
+    });
+    warning(QRect(width / 2 - 300, qMin(100, height - 200), 600, 200), [](const Inputs &in, WarningPanel::Content *w) {
+        if (in.state.batterySoc >= kCriticalSoc || in.state.speed <= kCriticalSpeed) return;
+        w->title = QStringLiteral("CRITICAL: LOW BATTERY + HIGH SPEED");
+        w->detail = QStringLiteral("Battery %1%    Speed %2 km/h\nREDUCE SPEED IMMEDIATELY - RANGE LIMITED")
+            .arg(qRound(in.state.batterySoc)).arg(qRound(in.speed));
+        w->titleColor = in.blinkOn ? kCritical : kCritical.darker(300);
+        w->borderColor = in.blinkFast ? kCritical : QColor("#550000");
+    });
+}
+
+void DirectCluster2W::paintAll(QImage *image) const
+{
+    QPainter painter(image);
+    paintStatic(painter, image->size());
+    for (const auto &panel : m_panels) {
+        panel->paint(painter);
+    }
+}
+
+void DirectCluster2W::paintStatic(QPainter &painter, const QSize &size) const
+{
+    const int width = size.width();
+    const int height = size.height();
+    const int bottomTop = height - kBottomBarHeight;
+    const int speedBottom = bottomTop - kMargin - kBatteryHeight - kMargin;
+
+    painter.fillRect(QRect(QPoint(0, 0), size), kBackground);
+    painter.fillRect(QRect(0, 0, width, kTopBarHeight), kBarBackground);
+    painter.fillRect(QRect(0, bottomTop, width, kBottomBarHeight), kBarBackground);
+
+    painter.setPen(kTextSecondary);
+    painter.setFont(font(72, false));
+    painter.drawText(QRect(0, speedBottom - 60, width, 60), Qt::AlignCenter, QStringLiteral("km/h"));
+
+    painter.setFont(font(14, false));
+    const int column = width / 4;
+    const QString labels[] = { QStringLiteral("kW"), QStringLiteral("Motor"),
+                               QStringLiteral("Trip km"), QStringLiteral("Wh/km") };
+    for (int i = 0; i < 4; ++i) {
+        painter.drawText(QRect(i * column, bottomTop + 36, column, 20), Qt::AlignCenter, labels[i]);
+    }
+}
+
+void DirectCluster2W::start()
+{
+    if (m_image.isNull()) {
+        qWarning() << "DirectCluster2W: no output opened";
+        return;
+    }
+
+    // Fill every panel's cached content, then paint the whole screen once
+    updateInputs();
+    for (const auto &panel : m_panels) {
+        panel->refresh(*m_inputs);
+    }
+    m_backdrop = QImage(m_image.size(), m_image.format());
+    QPainter backdrop(&m_backdrop);
+    paintStatic(backdrop, m_backdrop.size());
+    backdrop.end();
+    paintAll(&m_image);
+    flush(m_image.rect());
+    m_frameTimer.start();
+}
+
+void DirectCluster2W::updateInputs()
+{
+    Inputs &in = *m_inputs;
+    in.state = m_vehicleData->snapshot();
+    in.speedStale = m_isStale && m_isStale(VehicleSignal::Speed);
+    in.powerStale = m_isStale && m_isStale(VehicleSignal::PowerOutput);
+    in.overspeed = m_vehicleData->overspeed();
+    // The overlay's battery threshold on top of the BMS flag and motor limit
+    in.thermalWarning = m_vehicleData->thermalWarning() || in.state.batteryTempAvg > kBatteryTempLimit;
+    in.blinkOn = BlinkClock::instance()->on();
+    in.blinkFast = BlinkClock::instance()->fast();
+    in.clock = QTime::currentTime().toString(QStringLiteral("hh:mm"));
+}
+
+void DirectCluster2W::renderFrame()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    updateInputs();
+    const Inputs &in = *m_inputs;
+    QRegion dirty;
+    bool stacked = false;
+    for (const auto &panel : m_panels) {
+        if (!panel->refresh(in)) continue;
+        dirty += panel->rect();
+        stacked = stacked || panel->isOverlay();
+    }
+    if (dirty.isEmpty()) return;
+
+    // A warning shown over a changed readout, or one that appeared or went
+    // away, needs what lies under it: repaint the backdrop and every panel
+    // touching the dirty area, bottom to top. Otherwise panels do not
+    // overlap and each changed one repaints only its own rectangle.
+    for (const auto &panel : m_panels) {
+        if (panel->isOverlay() && panel->isShown() && dirty.intersects(panel->rect())) stacked = true;
+    }
+    QPainter painter(&m_image);
+    if (stacked) {
+        for (const QRect &rect : dirty) {
+            painter.drawImage(rect, m_backdrop, rect);
+        }
+    }
+    for (const auto &panel : m_panels) {
+        if (!dirty.intersects(panel->rect()) || (panel->isOverlay() && !stacked)) continue;
+        painter.setClipRegion(dirty & panel->rect());
+        panel->paint(painter);
+    }
+    painter.end();
+
+    flush(dirty);
+
+    m_statsFrames++;
+    for (const QRect &rect : dirty) {
+        m_statsPixels += qint64(rect.width()) * rect.height();
+    }
+    m_statsNs += timer.nsecsElapsed();
+}
+
+void DirectCluster2W::flush(const QRegion &region)
+{
+    if (m_framebuffer.isOpen()) {
+        m_framebuffer.flush(m_image, region);
+    } else if (m_window) {
+        m_window->update(region);
+    }
+}
+
+void DirectCluster2W::setStatisticsInterval(int intervalMs)
+{
+    m_statsFrames = 0;
+    m_statsPixels = 0;
+    m_statsNs = 0;
+    if (intervalMs <= 0) {
+        m_statsTimer.stop();
+        return;
+    }
+    m_statsTimer.start(intervalMs);
+}
+
+void DirectCluster2W::logStatistics()
+{
+    // Baseline: what repainting and flushing the whole screen costs on this device
+    QImage scratch(m_image.size(), m_image.format());
+    QElapsedTimer timer;
+    timer.start();
+    paintAll(&scratch);
+    if (m_framebuffer.isOpen()) m_framebuffer.flush(scratch, scratch.rect());
+    const double fullMs = timer.nsecsElapsed() / 1.0e6;
+    if (m_framebuffer.isOpen()) m_framebuffer.flush(m_image, m_image.rect());
+
+    const qint64 screenPixels = qint64(m_image.width()) * m_image.height();
+    const double frames = qMax(1, m_statsFrames);
+    qDebug().noquote() << QStringLiteral("[2w] %1 frames, %2% of the screen per frame, %3 ms/frame (full repaint %4 ms)")
+        .arg(m_statsFrames)
+        .arg(100.0 * m_statsPixels / frames / qMax<qint64>(1, screenPixels), 0, 'f', 1)
+        .arg(m_statsNs / frames / 1.0e6, 0, 'f', 2)
+        .arg(fullMs, 0, 'f', 2);
+
+    m_statsFrames = 0;
+    m_statsPixels = 0;
+    m_statsNs = 0;
+}
@@ -0,0 +1,82 @@
+#ifndef DIRECTCLUSTER2W_H
+#define DIRECTCLUSTER2W_H
+
+#include <QObject>
+#include <QImage>
+#include <QRegion>
+#include <QTimer>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "framebufferoutput.h"
+#include "signalsample.h"
+
+class EVVehicleData;
+class QPainter;
+
+namespace Direct2W {
+struct Inputs;
+class Panel;
+}
+
+// Partial-update rendering of the two-wheeler layout (Cluster2W.qml) for
+// displays without a GPU.
+// The screen is split into panels - speed, battery, range, each bottom-bar
+// value, each status icon. Every frame a panel formats what it would show and
+// only panels whose text or fill changed are repainted, clipped to their own
+// rectangle, into a persistent image. Only those rectangles are flushed:
+// straight into /dev/fbN, or through a QRasterWindow whose backing store
+// flushes just the updated region. Labels and backgrounds are painted once.
+// The WarningOverlay boxes are panels too, drawn over the readouts; while one
+// is shown, what changes under it is repainted together with it.
+class DirectCluster2W : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DirectCluster2W(EVVehicleData *vehicleData, QObject *parent = nullptr);
+    ~DirectCluster2W();
+
+    // Pick one output before start()
+    bool openFramebuffer(const QString &device);
+    void openWindow(const QSize &size);
+
+    // Readouts show "--" while their signal is stale
+    void setStaleCheck(const std::function<bool(VehicleSignal)> &isStale) { m_isStale = isStale; }
+
+    void start();
+
+    // Log dirty area and frame time, against a full repaint, every intervalMs (0 = off)
+    void setStatisticsInterval(int intervalMs);
+
+private slots:
+    void renderFrame();
+    void logStatistics();
+
+private:
+    class Window;
+
+    void createPanels(const QSize &size);
+    void updateInputs();
+    void paintAll(QImage *image) const;
+    void paintStatic(QPainter &painter, const QSize &size) const;
+    void flush(const QRegion &region);
+
+    EVVehicleData *m_vehicleData;
+    std::function<bool(VehicleSignal)> m_isStale;
+    std::unique_ptr<Direct2W::Inputs> m_inputs;
+    std::vector<std::unique_ptr<Direct2W::Panel>> m_panels;
+    QImage m_image;                  // Persistent frame, panels update in place
+    QImage m_backdrop;               // Labels and bar backgrounds, shown where a warning went away
+    FramebufferOutput m_framebuffer;
+    std::unique_ptr<Window> m_window;
+    QTimer m_frameTimer;
+    int m_speedSubscription = 0;
+    int m_powerSubscription = 0;
+
+    QTimer m_statsTimer;
+    int m_statsFrames = 0;
+    qint64 m_statsPixels = 0;
+    qint64 m_statsNs = 0;
+};
+
+#endif // DIRECTCLUSTER2W_H
@@ -0,0 +1,231 @@
+#include "efficiencygraphitem.h"
+#include <QSGGeometryNode>
+#include <QSGTransformNode>
+#include <QSGFlatColorMaterial>
+#include <QtMath>
+#include <utility>
+
+// Vertices per bucket: connector segment + min/max segment
+static const int kVerticesPerBucket = 4;
+
+EfficiencyGraphItem::EfficiencyGraphItem(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents, true);
+    setClip(true);
+}
+
+void EfficiencyGraphItem::setSeries(ConsumptionSeries *series)
+{
+    if (m_series == series)
+        return;
+
+    if (m_series) {
+        disconnect(m_series, nullptr, this, nullptr);
+    }
+
+    m_series = series;
+    if (m_series) {
+        connect(m_series, &ConsumptionSeries::appended, this, &EfficiencyGraphItem::onAppended);
+        connect(m_series, &ConsumptionSeries::cleared, this, &EfficiencyGraphItem::requestRebuild);
+    }
+
+    relayout();
+    emit seriesChanged();
+}
+
+void EfficiencyGraphItem::setMinValue(float minValue)
+{
+    if (qFuzzyCompare(m_minValue, minValue))
+        return;
+    m_minValue = minValue;
+    emit rangeChanged();
+    update();
+}
+
+void EfficiencyGraphItem::setMaxValue(float maxValue)
+{
+    if (qFuzzyCompare(m_maxValue, maxValue))
+        return;
+    m_maxValue = maxValue;
+    emit rangeChanged();
+    update();
+}
+
+void EfficiencyGraphItem::setLineColor(const QColor &lineColor)
+{
+    if (m_lineColor == lineColor)
+        return;
+    m_lineColor = lineColor;
+    emit lineColorChanged();
+    update();
+}
+
+void EfficiencyGraphItem::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    // Bucket count follows the pixel width; height only changes the transform
+    if (int(newGeometry.width()) != int(oldGeometry.width())) {
+        relayout();
+    } else if (newGeometry.height() != oldGeometry.height()) {
+        update();
+    }
+}
+
+void EfficiencyGraphItem::relayout()
+{
+    const int capacity = m_series ? m_series->capacity() : 1;
+    const int pixels = qMax(1, int(width()));
+
+    // Decimate only when there are more samples than pixels
+    m_samplesPerBucket = qMax(1, int(qCeil(double(capacity) / pixels)));
+    const int bucketCount = int(qCeil(double(capacity) / m_samplesPerBucket)) + 1;
+
+    if (m_buckets.size() != bucketCount) {
+        m_buckets = QVector<Bucket>(bucketCount);
+    }
+    requestRebuild();
+}
+
+void EfficiencyGraphItem::requestRebuild()
+{
+    m_fullRebuild = true;
+    m_dirtySlots.clear();
+    update();
+}
+
+void EfficiencyGraphItem::onAppended(qint64 sequence, float value)
+{
+    // A pending rebuild reads the series directly
+    if (m_fullRebuild)
+        return;
+
+    addSample(sequence, value);
+    update();
+}
+
+void EfficiencyGraphItem::addSample(qint64 sequence, float value)
+{
+    const qint64 index = sequence / m_samplesPerBucket;
+    const int slot = int(index % m_buckets.size());
+    Bucket &bucket = m_buckets[slot];
+
+    if (bucket.index != index) {
+        // First sample of a new bucket - connect from where the previous one ended
+        const Bucket &before = m_buckets[int((index - 1 + m_buckets.size()) % m_buckets.size())];
+        bucket.index = index;
+        bucket.previous = before.index == index - 1 ? before.last : value;
+        bucket.first = bucket.last = bucket.min = bucket.max = value;
+    } else {
+        bucket.last = value;
+        bucket.min = qMin(bucket.min, value);
+        bucket.max = qMax(bucket.max, value);
+    }
+
+    if (m_dirtySlots.isEmpty() || m_dirtySlots.last() != slot) {
+        m_dirtySlots.append(slot);
+    }
+    m_lastBucket = index;
+}
+
+void EfficiencyGraphItem::rebuildBuckets()
+{
+    for (Bucket &bucket : m_buckets) {
+        bucket = Bucket();
+    }
+    m_lastBucket = -1;
+
+    if (m_series) {
+        for (qint64 seq = m_series->firstSequence(); seq < m_series->nextSequence(); ++seq) {
+            addSample(seq, m_series->valueAt(seq));
+        }
+    }
+}
+
+static void writeBucket(QSGGeometry::Point2D *v, qint64 index, float previous, float first,
+                        float min, float max)
+{
+    // Empty slots collapse far off-screen (clipped)
+    const float x = index >= 0 ? float(index) : -1.0e6f;
+    v[0].set(x - 1.0f, previous);
+    v[1].set(x, first);
+    v[2].set(x, min);
+    v[3].set(x, max);
+}
+
+QSGNode *EfficiencyGraphItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    QSGTransformNode *root = static_cast<QSGTransformNode *>(oldNode);
+    QSGGeometryNode *lineNode = nullptr;
+    const int vertexCount = m_buckets.size() * kVerticesPerBucket;
+
+    if (!root) {
+        root = new QSGTransformNode;
+        lineNode = new QSGGeometryNode;
+
+        QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), vertexCount);
+        geometry->setDrawingMode(QSGGeometry::DrawLines);
+        geometry->setLineWidth(2);
+        geometry->setVertexDataPattern(QSGGeometry::DynamicPattern);
+        lineNode->setGeometry(geometry);
+        lineNode->setFlag(QSGNode::OwnsGeometry);
+
+        QSGFlatColorMaterial *material = new QSGFlatColorMaterial;
+        lineNode->setMaterial(material);
+        lineNode->setFlag(QSGNode::OwnsMaterial);
+
+        root->appendChildNode(lineNode);
+        m_fullRebuild = true;
+    } else {
+        lineNode = static_cast<QSGGeometryNode *>(root->firstChild());
+    }
+
+    QSGFlatColorMaterial *material = static_cast<QSGFlatColorMaterial *>(lineNode->material());
+    if (material->color() != m_lineColor) {
+        material->setColor(m_lineColor);
+        lineNode->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    QSGGeometry *geometry = lineNode->geometry();
+    if (geometry->vertexCount() != vertexCount) {
+        geometry->allocate(vertexCount);
+        m_fullRebuild = true;
+    }
+
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    if (m_fullRebuild) {
+        rebuildBuckets();
+        for (int slot = 0; slot < m_buckets.size(); ++slot) {
+            const Bucket &b = m_buckets[slot];
+            writeBucket(vertices + slot * kVerticesPerBucket, b.index, b.previous, b.first, b.min, b.max);
+        }
+        m_fullRebuild = false;
+        m_dirtySlots.clear();
+        lineNode->markDirty(QSGNode::DirtyGeometry);
+    } else if (!m_dirtySlots.isEmpty()) {
+        for (int slot : std::as_const(m_dirtySlots)) {
+            const Bucket &b = m_buckets[slot];
+            writeBucket(vertices + slot * kVerticesPerBucket, b.index, b.previous, b.first, b.min, b.max);
+        }
+        m_dirtySlots.clear();
+        lineNode->markDirty(QSGNode::DirtyGeometry);
+    }
+
+    // Scroll and scale on the GPU: newest bucket sits on the right edge
+    const int visibleBuckets = qMax(1, m_buckets.size() - 2);
+    const float xScale = float(width()) / visibleBuckets;
+    const float range = qMax(0.001f, m_maxValue - m_minValue);
+    const float yScale = float(height()) / range;
+    const qint64 firstVisible = qMax<qint64>(0, m_lastBucket - visibleBuckets);
+
+    QMatrix4x4 matrix;
+    matrix.translate(-xScale * float(firstVisible), float(height()) + yScale * m_minValue);
+    matrix.scale(xScale, -yScale);
+    if (root->matrix() != matrix) {
+        root->setMatrix(matrix);
+        root->markDirty(QSGNode::DirtyMatrix);
+    }
+
+    return root;
+}
@@ -0,0 +1,75 @@
+#ifndef EFFICIENCYGRAPHITEM_H
+#define EFFICIENCYGRAPHITEM_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QVector>
+#include <QPointer>
+#include "consumptionseries.h"
+
+// Scene-graph line graph for a ConsumptionSeries.
+// Samples are min/max-decimated into roughly one bucket per horizontal pixel.
+// Every bucket owns a fixed slot of 4 vertices (connector + min/max bar) in a
+// ring-shaped vertex buffer, and scrolling/scaling is done by a transform node,
+// so appending a sample rewrites only the vertices of a single bucket.
+class EfficiencyGraphItem : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(ConsumptionSeries *series READ series WRITE setSeries NOTIFY seriesChanged)
+    Q_PROPERTY(float minValue READ minValue WRITE setMinValue NOTIFY rangeChanged)
+    Q_PROPERTY(float maxValue READ maxValue WRITE setMaxValue NOTIFY rangeChanged)
+    Q_PROPERTY(QColor lineColor READ lineColor WRITE setLineColor NOTIFY lineColorChanged)
+
+public:
+    explicit EfficiencyGraphItem(QQuickItem *parent = nullptr);
+
+    ConsumptionSeries *series() const { return m_series; }
+    float minValue() const { return m_minValue; }
+    float maxValue() const { return m_maxValue; }
+    QColor lineColor() const { return m_lineColor; }
+
+    void setSeries(ConsumptionSeries *series);
+    void setMinValue(float minValue);
+    void setMaxValue(float maxValue);
+    void setLineColor(const QColor &lineColor);
+
+signals:
+    void seriesChanged();
+    void rangeChanged();
+    void lineColorChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private slots:
+    void onAppended(qint64 sequence, float value);
+    void requestRebuild();
+
+private:
+    struct Bucket {
+        qint64 index = -1;     // Absolute bucket number, -1 = empty slot
+        float first = 0.0f;
+        float last = 0.0f;
+        float min = 0.0f;
+        float max = 0.0f;
+        float previous = 0.0f; // Last value of the bucket before (connector start)
+    };
+
+    void relayout();
+    void addSample(qint64 sequence, float value);
+    void rebuildBuckets();
+
+    QPointer<ConsumptionSeries> m_series;
+    float m_minValue = 0.0f;
+    float m_maxValue = 300.0f;
+    QColor m_lineColor = QColor("#00E676");
+
+    int m_samplesPerBucket = 1;
+    QVector<Bucket> m_buckets;         // Ring indexed by bucket index % size
+    QVector<int> m_dirtySlots;         // Slots to re-upload on next sync
+    qint64 m_lastBucket = -1;
+    bool m_fullRebuild = true;
+};
+
+#endif // EFFICIENCYGRAPHITEM_H
@@ -107,6 +107,16 @@ void EnergyCalculator::resetAll()
     qDebug() << "EnergyCalculator: All data reset";
 }
 
+void EnergyCalculator::restoreTotals(float totalEnergyKwh, float totalDistanceKm, float regenEnergyKwh,
+                                     float tripEnergyKwh, float tripDistanceKm)
+{
+    m_totalEnergyKwh = totalEnergyKwh;
+    m_totalDistanceKm = totalDistanceKm;
+    m_regenEnergyKwh = regenEnergyKwh;
+    m_tripEnergyKwh = tripEnergyKwh;
+    m_tripDistanceKm = tripDistanceKm;
+}
+
 float EnergyCalculator::getTripDistance() const
 {
     return m_tripDistanceKm;
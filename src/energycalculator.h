@@ -30,6 +30,10 @@ public:
     void resetTrip();                      // Reset trip counters
     void resetAll();                       // Reset all counters
 
+    // Counters saved by a previous run
+    void restoreTotals(float totalEnergyKwh, float totalDistanceKm, float regenEnergyKwh,
+                       float tripEnergyKwh, float tripDistanceKm);
+
 private:
     float m_totalEnergyKwh;               // Total energy consumed
     float m_totalDistanceKm;              // Total distance traveled
@@ -0,0 +1,168 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QTimer>
+#include <csignal>
+#include "analyticspipeline.h"
+#include "bmsinterface.h"
+#include "caninterface.h"
+#include "databaseservice.h"
+#include "evvehicledata.h"
+#include "inputarbiter.h"
+#include "positionreceiver.h"
+#include "simulationreceiver.h"
+#include "statekeeper.h"
+#include "statepublisher.h"
+#include "tripdetector.h"
+#include "vehicleprofile.h"
+
+// ev-datad: owns vehicle data ingest (CAN, simulator UDP, GNSS) and publishes
+// the arbitrated state in shared memory for ev-cluster, the center display
+// and the HUD. Trips are detected and saved here, once for all displays.
+
+static volatile std::sig_atomic_t s_stopRequested = 0;
+
+static void requestStop(int)
+{
+    s_stopRequested = 1;
+}
+
+// Seconds from a timeout option; malformed or non-positive values keep the default
+static int timeoutSeconds(const QCommandLineParser &parser, const QCommandLineOption &option, int fallback)
+{
+    bool ok = false;
+    const int seconds = parser.value(option).toInt(&ok);
+    if (ok && seconds > 0) return seconds;
+    qWarning().noquote() << QStringLiteral("Invalid --%1 value \"%2\", using %3 s")
+        .arg(option.names().constFirst(), parser.value(option)).arg(fallback);
+    return fallback;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("ev-datad");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption shmNameOption("shm-name",
+        "POSIX shared memory object to publish, default /ev-vehicle-state.", "name",
+        QString::fromLatin1(SharedVehicleState::DefaultName));
+    parser.addOption(shmNameOption);
+    QCommandLineOption canOption("can",
+        "Read live vehicle data from a CAN bus, e.g. socketcan:can0 or virtualcan:can0.",
+        "plugin:interface");
+    parser.addOption(canOption);
+    QCommandLineOption noCanFiltersOption("no-can-filters",
+        "Receive every frame on the bus instead of programming kernel receive filters.");
+    parser.addOption(noCanFiltersOption);
+    QCommandLineOption simPortOption("sim-port",
+        "UDP port of the simulator input (default 5555).", "port", "5555");
+    parser.addOption(simPortOption);
+    QCommandLineOption gpsOption("gps",
+        "Read position from the default QtPositioning source.");
+    parser.addOption(gpsOption);
+    QCommandLineOption gpsSourceOption("gps-source",
+        "QtPositioning plugin to use instead of the default, e.g. nmea.", "plugin");
+    parser.addOption(gpsSourceOption);
+    QCommandLineOption vehicleConfigOption("vehicle-config",
+        "Vehicle profiles file (default config/vehicle.json next to the executable).", "file");
+    parser.addOption(vehicleConfigOption);
+    QCommandLineOption profileOption("profile",
+        "Vehicle profile id to start with, overriding active_profile in the config.", "id");
+    parser.addOption(profileOption);
+    QCommandLineOption tripIdleTimeoutOption("trip-idle-timeout",
+        "End a trip after this long stopped while ready to drive (default 600).", "seconds",
+        QString::number(TripDetector::DefaultIdleTimeoutSec));
+    parser.addOption(tripIdleTimeoutOption);
+    QCommandLineOption tripParkTimeoutOption("trip-park-timeout",
+        "End a trip after this long stopped with the parking brake on (default 120).", "seconds",
+        QString::number(TripDetector::DefaultParkTimeoutSec));
+    parser.addOption(tripParkTimeoutOption);
+    parser.process(app);
+
+    qRegisterMetaType<SignalSample>();
+    qRegisterMetaType<QList<SignalSample>>();
+    qRegisterMetaType<AnalyticsResult>();
+    qRegisterMetaType<ChargingSession>();
+
+    // Parsed once; components copy the numbers they need on profile changes
+    VehicleProfiles profiles;
+    profiles.load(parser.isSet(vehicleConfigOption) ? parser.value(vehicleConfigOption)
+                                                    : VehicleProfiles::defaultPath());
+    if (parser.isSet(profileOption)) profiles.setActiveProfile(parser.value(profileOption));
+
+    EVVehicleData vehicleData;
+    InputArbiter inputArbiter(&vehicleData);
+
+    SimulationReceiver simReceiver(quint16(parser.value(simPortOption).toUInt()));
+    QObject::connect(&simReceiver, &SimulationReceiver::samplesReceived,
+                     &inputArbiter, &InputArbiter::submitBatch);
+
+    CANInterface canInterface;
+    BMSInterface bmsInterface;
+    QObject::connect(&canInterface, &CANInterface::samplesDecoded,
+                     &inputArbiter, &InputArbiter::submitBatch);
+    QObject::connect(&canInterface, &CANInterface::bmsFrameReceived,
+                     &bmsInterface, &BMSInterface::updateFromCAN);
+    QObject::connect(&bmsInterface, &BMSInterface::samplesDecoded,
+                     &inputArbiter, &InputArbiter::submitBatch);
+
+    canInterface.setReceiveFiltersEnabled(!parser.isSet(noCanFiltersOption));
+    if (parser.isSet(canOption)) {
+        const QStringList canSpec = parser.value(canOption).split(':');
+        if (canSpec.size() == 2) {
+            canInterface.connectDevice(canSpec[0], canSpec[1]);
+        } else {
+            qWarning() << "Invalid --can value, expected plugin:interface";
+        }
+    }
+
+    PositionReceiver positionReceiver;
+    QObject::connect(&positionReceiver, &PositionReceiver::samplesReceived,
+                     &inputArbiter, &InputArbiter::submitBatch);
+    if (parser.isSet(gpsOption) || parser.isSet(gpsSourceOption)) {
+        positionReceiver.start(parser.value(gpsSourceOption));
+    }
+
+    AnalyticsPipeline analytics(&vehicleData);
+    analytics.setProfile(profiles.profile());
+
+    // Restored before the first publish so displays never see a zero odometer
+    StateKeeper stateKeeper(&vehicleData, &analytics);
+    if (stateKeeper.open()) {
+        stateKeeper.restore();
+        stateKeeper.start();
+    }
+    analytics.start();
+
+    // Trip and charging history on its own worker thread; the displays only read it
+    DatabaseService database;
+    database.init();
+    database.startRetention();     // Raw rows past 30 days; rollups keep their totals
+    QObject::connect(&analytics, &AnalyticsPipeline::chargingSessionCompleted, &database,
+                     [&database](const ChargingSession &session, double latitude, double longitude) {
+        database.saveChargingSession(session, latitude, longitude);
+    });
+    TripDetector tripDetector(&vehicleData, &database);
+    tripDetector.setIdleTimeout(timeoutSeconds(parser, tripIdleTimeoutOption, TripDetector::DefaultIdleTimeoutSec));
+    tripDetector.setParkTimeout(timeoutSeconds(parser, tripParkTimeoutOption, TripDetector::DefaultParkTimeoutSec));
+    tripDetector.start();
+
+    StatePublisher publisher(&vehicleData, &inputArbiter);
+    if (!publisher.open(parser.value(shmNameOption))) return 1;
+
+    // Exit through the event loop so the segment is unlinked on shutdown
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    QTimer stopTimer;
+    QObject::connect(&stopTimer, &QTimer::timeout, &app, [] {
+        if (s_stopRequested) QCoreApplication::quit();
+    });
+    stopTimer.start(100);
+
+    qDebug() << "ev-datad publishing to" << parser.value(shmNameOption);
+    const int result = app.exec();
+    qDebug() << "ev-datad stopped after" << publisher.publishCount() << "updates";
+    return result;
+}
@@ -1,24 +1,156 @@
 #include "evvehicledata.h"
 #include <QDebug>
 
-EVVehicleData::EVVehicleData(QObject *parent) : QObject(parent)
+// Thresholds of the derived values; the QML used to repeat these inline
+static const float kOverspeedKmh = 120.0f;
+static const float kLowBatterySoc = 20.0f;
+static const float kMotorTempLimit = 80.0f;
+static const float kPowerDeadbandKw = 0.5f;     // |power| below this reads as idle
+
+EVVehicleData::EVVehicleData(QObject *parent) : QObject(parent),
+    m_consumptionSeries(new ConsumptionSeries(512, this))
+{
+    publish();
+    setUpDerived();
+    connect(&m_statsTimer, &QTimer::timeout, this, &EVVehicleData::logStatistics);
+}
+
+void EVVehicleData::setUpDerived()
+{
+    // Each binding records the inputs it reads; an input change marks it dirty
+    // and the result only notifies (and reaches QML) when it actually changed.
+    // Chained: activeWarningCount reads lowBattery and thermalWarning.
+    m_driveModeName.setBinding([this] {
+        m_statsEvaluations++;
+        switch (m_driveMode.value()) {
+        case Eco: return QStringLiteral("ECO");
+        case Normal: return QStringLiteral("NORMAL");
+        case Sport: return QStringLiteral("SPORT");
+        case Custom: return QStringLiteral("CUSTOM");
+        }
+        return QString();
+    });
+    m_timeToFullText.setBinding([this] {
+        m_statsEvaluations++;
+        const int minutes = m_timeToFull.value();
+        if (minutes <= 0) return QStringLiteral("--:--");
+        return QStringLiteral("%1h %2m").arg(minutes / 60).arg(minutes % 60);
+    });
+    m_powerDirection.setBinding([this] {
+        m_statsEvaluations++;
+        const float power = m_powerOutput.value();
+        if (power > kPowerDeadbandKw) return Drive;
+        if (power < -kPowerDeadbandKw) return Regen;
+        return Idle;
+    });
+    m_overspeed.setBinding([this] {
+        m_statsEvaluations++;
+        return m_speed.value() > kOverspeedKmh;
+    });
+    m_lowBattery.setBinding([this] {
+        m_statsEvaluations++;
+        return m_batterySoc.value() < kLowBatterySoc;
+    });
+    m_thermalWarning.setBinding([this] {
+        m_statsEvaluations++;
+        return m_tempWarning.value() || m_motorTemp.value() > kMotorTempLimit;
+    });
+    m_activeWarningCount.setBinding([this] {
+        m_statsEvaluations++;
+        return int(m_bmsWarning.value()) + int(m_hvWarning.value()) + int(m_thermalWarning.value())
+            + int(m_motorFault.value()) + int(m_reducedPower.value()) + int(m_low12V.value())
+            + int(m_lowBattery.value());
+    });
+    m_statsEvaluations = 0;
+}
+
+void EVVehicleData::setStatisticsInterval(int intervalMs)
+{
+    // Counting connections use the timer as context, so stopping drops them all
+    disconnect(this, nullptr, &m_statsTimer, nullptr);
+    if (intervalMs <= 0) {
+        m_statsTimer.stop();
+        return;
+    }
+    watchStatistics();
+    m_statsInputChanges = m_statsEagerEvaluations = m_statsEvaluations = m_statsNotifications = 0;
+    m_statsTimer.start(intervalMs);
+}
+
+void EVVehicleData::watchStatistics()
+{
+    // Baseline: the inline QML expressions re-ran on every change of an input
+    // they read, so each input change cost one evaluation per expression using it
+    auto watch = [this](void (EVVehicleData::*signal)(), int expressions) {
+        connect(this, signal, &m_statsTimer, [this, expressions] {
+            m_statsInputChanges++;
+            m_statsEagerEvaluations += expressions;
+        });
+    };
+    watch(&EVVehicleData::speedChanged, 1);
+    watch(&EVVehicleData::batterySocChanged, 2);        // lowBattery, warning count
+    watch(&EVVehicleData::powerOutputChanged, 1);
+    watch(&EVVehicleData::timeToFullChanged, 1);
+    watch(&EVVehicleData::motorTempChanged, 2);         // thermalWarning, warning count
+    watch(&EVVehicleData::driveModeChanged, 1);
+    watch(&EVVehicleData::bmsWarningChanged, 1);
+    watch(&EVVehicleData::hvWarningChanged, 1);
+    watch(&EVVehicleData::tempWarningChanged, 2);       // thermalWarning, warning count
+    watch(&EVVehicleData::motorFaultChanged, 1);
+    watch(&EVVehicleData::reducedPowerChanged, 1);
+    watch(&EVVehicleData::low12VChanged, 1);
+
+    for (auto signal : { &EVVehicleData::driveModeNameChanged, &EVVehicleData::timeToFullTextChanged,
+                         &EVVehicleData::powerDirectionChanged, &EVVehicleData::overspeedChanged,
+                         &EVVehicleData::lowBatteryChanged, &EVVehicleData::thermalWarningChanged,
+                         &EVVehicleData::activeWarningCountChanged }) {
+        connect(this, signal, &m_statsTimer, [this] { m_statsNotifications++; });
+    }
+}
+
+void EVVehicleData::logStatistics()
+{
+    const double seconds = m_statsTimer.interval() / 1000.0;
+    qDebug().noquote() << QStringLiteral("[derived] %1 input changes/s, %2 evaluations/s, "
+                                         "%3 QML notifications/s (inline QML: %4 evaluations/s)")
+        .arg(m_statsInputChanges / seconds, 0, 'f', 1)
+        .arg(m_statsEvaluations / seconds, 0, 'f', 1)
+        .arg(m_statsNotifications / seconds, 0, 'f', 1)
+        .arg(m_statsEagerEvaluations / seconds, 0, 'f', 1);
+    m_statsInputChanges = m_statsEagerEvaluations = m_statsEvaluations = m_statsNotifications = 0;
+}
+
+void EVVehicleData::publish()
+{
+    // Single writer (this thread); readers never block it
+    m_published.store(m_state);
+}
+
+static void copyText(char *target, size_t size, const QString &text)
 {
-    // Initialize default values if needed
+    qstrncpy(target, text.toUtf8().constData(), size);
+}
+
+static QString textFrom(const char *source, size_t size)
+{
+    return QString::fromUtf8(source, int(qstrnlen(source, uint(size))));
 }
 
 void EVVehicleData::setSpeed(float speed)
 {
-    if (qFuzzyCompare(m_speed, speed))
+    if (qFuzzyCompare(m_state.speed, speed))
         return;
-    m_speed = speed;
-    emit speedChanged();
+    m_state.speed = speed;
+    publish();
+    m_speed = speed;   // Emits speedChanged, marks dependent bindings dirty
 }
 
 void EVVehicleData::setNavigationActive(bool navigationActive)
 {
-    if (m_navigationActive == navigationActive)
+    if (m_state.navigationActive == navigationActive)
         return;
-    m_navigationActive = navigationActive;
+    m_state.navigationActive = navigationActive;
+    publish();
     emit navigationActiveChanged();
 }
 
@@ -26,337 +158,343 @@ void EVVehicleData::setNavigationActive(bool navigationActive)
 
 void EVVehicleData::setOdometer(float odometer)
 {
-    if (qFuzzyCompare(m_odometer, odometer))
+    if (qFuzzyCompare(m_state.odometer, odometer))
         return;
-    m_odometer = odometer;
+    m_state.odometer = odometer;
+    publish();
     emit odometerChanged();
+    
+    // Sample consumption once per completed km (odometer is in metres)
+    int km = static_cast<int>(m_state.odometer / 1000.0f);
+    if (m_lastConsumptionKm >= 0 && km > m_lastConsumptionKm) {
+        m_consumptionSeries->append(m_state.averageConsumption);
+    }
+    m_lastConsumptionKm = km;
 }
 
 void EVVehicleData::setTripDistanceA(float tripDistanceA)
 {
-    if (qFuzzyCompare(m_tripDistanceA, tripDistanceA))
+    if (qFuzzyCompare(m_state.tripDistanceA, tripDistanceA))
         return;
-    m_tripDistanceA = tripDistanceA;
+    m_state.tripDistanceA = tripDistanceA;
+    publish();
     emit tripDistanceAChanged();
 }
 
 void EVVehicleData::setTripDistanceB(float tripDistanceB)
 {
-    if (qFuzzyCompare(m_tripDistanceB, tripDistanceB))
+    if (qFuzzyCompare(m_state.tripDistanceB, tripDistanceB))
         return;
-    m_tripDistanceB = tripDistanceB;
+    m_state.tripDistanceB = tripDistanceB;
+    publish();
     emit tripDistanceBChanged();
 }
 
 void EVVehicleData::setBatterySoc(float batterySoc)
 {
-    if (qFuzzyCompare(m_batterySoc, batterySoc))
+    if (qFuzzyCompare(m_state.batterySoc, batterySoc))
         return;
+    m_state.batterySoc = batterySoc;
+    publish();
     m_batterySoc = batterySoc;
-    emit batterySocChanged();
-    
-    // Intelligent range calculation with smoothing
-    float batteryCapacityKwh = 77.4f;  // 4W default
-    float availableEnergyKwh = (m_batterySoc / 100.0f) * batteryCapacityKwh;
-    
-    // Update smoothed efficiency with exponential moving average
-    // Only update when we have valid consumption data (ignore during regen)
-    if (m_averageConsumption > 50.0f && m_averageConsumption < 500.0f) {
-        // Alpha = 0.1 means 10% new value, 90% previous (slow, stable)
-        float alpha = 0.1f;
-        m_smoothedEfficiency = alpha * m_averageConsumption + (1.0f - alpha) * m_smoothedEfficiency;
-    }
-    
-    // Use smoothed efficiency for range calculation
-    float efficiencyWhPerKm = m_smoothedEfficiency;
-    
-    // Base range calculation: available energy / efficiency
-    float baseRange = (availableEnergyKwh * 1000.0f) / efficiencyWhPerKm;
-    
-    // Temperature compensation factor
-    float tempFactor = 1.0f;
-    if (m_batteryTempAvg < 0) {
-        tempFactor = 0.70f;  // 30% reduction in extreme cold
-    } else if (m_batteryTempAvg < 10) {
-        tempFactor = 0.85f;  // 15% reduction in cold
-    } else if (m_batteryTempAvg < 20) {
-        tempFactor = 0.95f;  // 5% reduction
-    } else if (m_batteryTempAvg > 45) {
-        tempFactor = 0.85f;  // 15% reduction in high heat
-    } else if (m_batteryTempAvg > 35) {
-        tempFactor = 0.95f;  // Slight reduction
-    }
-    
-    // Apply temperature compensation
-    float calculatedRange = baseRange * tempFactor;
-    
-    // Smooth the range output itself (prevents jumps)
-    // Alpha = 0.2 means 20% new value, 80% previous
-    if (m_previousRange > 0) {
-        calculatedRange = 0.2f * calculatedRange + 0.8f * m_previousRange;
-    }
-    m_previousRange = calculatedRange;
-    
-    // Reserve last 5% of battery
-    if (m_batterySoc < 5.0f) {
-        calculatedRange = 0.0f;
-    }
-    
-    setEstimatedRange(calculatedRange);
 }
 
 void EVVehicleData::setBatteryVoltage(float batteryVoltage)
 {
-    if (qFuzzyCompare(m_batteryVoltage, batteryVoltage))
+    if (qFuzzyCompare(m_state.batteryVoltage, batteryVoltage))
         return;
-    m_batteryVoltage = batteryVoltage;
+    m_state.batteryVoltage = batteryVoltage;
+    publish();
     emit batteryVoltageChanged();
 }
 
 void EVVehicleData::setBatteryCurrent(float batteryCurrent)
 {
-    if (qFuzzyCompare(m_batteryCurrent, batteryCurrent))
+    if (qFuzzyCompare(m_state.batteryCurrent, batteryCurrent))
         return;
-    m_batteryCurrent = batteryCurrent;
+    m_state.batteryCurrent = batteryCurrent;
+    publish();
     emit batteryCurrentChanged();
 }
 
 void EVVehicleData::setBatteryTempAvg(float batteryTempAvg)
 {
-    if (qFuzzyCompare(m_batteryTempAvg, batteryTempAvg))
+    if (qFuzzyCompare(m_state.batteryTempAvg, batteryTempAvg))
         return;
-    m_batteryTempAvg = batteryTempAvg;
+    m_state.batteryTempAvg = batteryTempAvg;
+    publish();
     emit batteryTempAvgChanged();
 }
 
 void EVVehicleData::setBatterySoh(float batterySoh)
 {
-    if (qFuzzyCompare(m_batterySoh, batterySoh))
+    if (qFuzzyCompare(m_state.batterySoh, batterySoh))
         return;
-    m_batterySoh = batterySoh;
+    m_state.batterySoh = batterySoh;
+    publish();
     emit batterySohChanged();
 }
 
 void EVVehicleData::setPowerOutput(float powerOutput)
 {
-    if (qFuzzyCompare(m_powerOutput, powerOutput))
+    if (qFuzzyCompare(m_state.powerOutput, powerOutput))
         return;
+    m_state.powerOutput = powerOutput;
+    publish();
     m_powerOutput = powerOutput;
-    emit powerOutputChanged();
 }
 
 void EVVehicleData::setInstantConsumption(float instantConsumption)
 {
-    if (qFuzzyCompare(m_instantConsumption, instantConsumption))
+    if (qFuzzyCompare(m_state.instantConsumption, instantConsumption))
         return;
-    m_instantConsumption = instantConsumption;
+    m_state.instantConsumption = instantConsumption;
+    publish();
     emit instantConsumptionChanged();
 }
 
 void EVVehicleData::setEstimatedRange(float estimatedRange)
 {
-    if (qFuzzyCompare(m_estimatedRange, estimatedRange))
+    if (qFuzzyCompare(m_state.estimatedRange, estimatedRange))
         return;
-    m_estimatedRange = estimatedRange;
+    m_state.estimatedRange = estimatedRange;
+    publish();
     emit estimatedRangeChanged();
 }
 
 void EVVehicleData::setTimeToEmpty(int timeToEmpty)
 {
-    if (m_timeToEmpty == timeToEmpty)
+    if (m_state.timeToEmpty == timeToEmpty)
         return;
-    m_timeToEmpty = timeToEmpty;
+    m_state.timeToEmpty = timeToEmpty;
+    publish();
     emit timeToEmptyChanged();
 }
 
 void EVVehicleData::setTimeToFull(int timeToFull)
 {
-    if (m_timeToFull == timeToFull) return;
+    if (m_state.timeToFull == timeToFull) return;
+    m_state.timeToFull = timeToFull;
+    publish();
     m_timeToFull = timeToFull;
-    emit timeToFullChanged();
 }
 
 void EVVehicleData::setAverageConsumption(float averageConsumption)
 {
-    if (qFuzzyCompare(m_averageConsumption, averageConsumption))
+    if (qFuzzyCompare(m_state.averageConsumption, averageConsumption))
         return;
-    m_averageConsumption = averageConsumption;
+    m_state.averageConsumption = averageConsumption;
+    publish();
     emit averageConsumptionChanged();
 }
 
-void EVVehicleData::setConsumptionHistory(const QList<float> &consumptionHistory)
+void EVVehicleData::setTripEnergy(float tripEnergy)
 {
-    if (m_consumptionHistory == consumptionHistory)
+    if (qFuzzyCompare(m_state.tripEnergy, tripEnergy))
         return;
-    m_consumptionHistory = consumptionHistory;
-    emit consumptionHistoryChanged();
+    m_state.tripEnergy = tripEnergy;
+    publish();
+    emit tripEnergyChanged();
+}
+
+void EVVehicleData::setTripEfficiency(float tripEfficiency)
+{
+    if (qFuzzyCompare(m_state.tripEfficiency, tripEfficiency))
+        return;
+    m_state.tripEfficiency = tripEfficiency;
+    publish();
+    emit tripEfficiencyChanged();
 }
 
 void EVVehicleData::setMotorTemp(float motorTemp)
 {
-    if (qFuzzyCompare(m_motorTemp, motorTemp))
+    if (qFuzzyCompare(m_state.motorTemp, motorTemp))
         return;
+    m_state.motorTemp = motorTemp;
+    publish();
     m_motorTemp = motorTemp;
-    emit motorTempChanged();
 }
 
 void EVVehicleData::setControllerTemp(float controllerTemp)
 {
-    if (qFuzzyCompare(m_controllerTemp, controllerTemp))
+    if (qFuzzyCompare(m_state.controllerTemp, controllerTemp))
         return;
-    m_controllerTemp = controllerTemp;
+    m_state.controllerTemp = controllerTemp;
+    publish();
     emit controllerTempChanged();
 }
 
 void EVVehicleData::setMotorRpm(float motorRpm)
 {
-    if (qFuzzyCompare(m_motorRpm, motorRpm))
+    if (qFuzzyCompare(m_state.motorRpm, motorRpm))
         return;
-    m_motorRpm = motorRpm;
+    m_state.motorRpm = motorRpm;
+    publish();
     emit motorRpmChanged();
 }
 
 void EVVehicleData::setDriveMode(DriveMode driveMode)
 {
-    if (m_driveMode == driveMode)
+    if (m_state.driveMode == driveMode)
         return;
+    m_state.driveMode = driveMode;
+    publish();
     m_driveMode = driveMode;
-    emit driveModeChanged();
 }
 
 void EVVehicleData::setRegenLevel(RegenLevel regenLevel)
 {
-    if (m_regenLevel == regenLevel)
+    if (m_state.regenLevel == regenLevel)
         return;
-    m_regenLevel = regenLevel;
+    m_state.regenLevel = regenLevel;
+    publish();
     emit regenLevelChanged();
 }
 
 void EVVehicleData::setChargingActive(bool chargingActive)
 {
-    if (m_chargingActive == chargingActive)
+    if (m_state.chargingActive == chargingActive)
         return;
-    m_chargingActive = chargingActive;
+    m_state.chargingActive = chargingActive;
+    publish();
     emit chargingActiveChanged();
 }
 
 void EVVehicleData::setReadyToDrive(bool readyToDrive)
 {
-    if (m_readyToDrive == readyToDrive)
+    if (m_state.readyToDrive == readyToDrive)
         return;
-    m_readyToDrive = readyToDrive;
+    m_state.readyToDrive = readyToDrive;
+    publish();
     emit readyToDriveChanged();
 }
 
 void EVVehicleData::setBmsWarning(bool bmsWarning)
 {
-    if (m_bmsWarning == bmsWarning) return;
+    if (m_state.bmsWarning == bmsWarning) return;
+    m_state.bmsWarning = bmsWarning;
+    publish();
     m_bmsWarning = bmsWarning;
-    emit bmsWarningChanged();
 }
 
 void EVVehicleData::setHvWarning(bool hvWarning)
 {
-    if (m_hvWarning == hvWarning) return;
+    if (m_state.hvWarning == hvWarning) return;
+    m_state.hvWarning = hvWarning;
+    publish();
     m_hvWarning = hvWarning;
-    emit hvWarningChanged();
 }
 
 void EVVehicleData::setTempWarning(bool tempWarning)
 {
-    if (m_tempWarning == tempWarning) return;
+    if (m_state.tempWarning == tempWarning) return;
+    m_state.tempWarning = tempWarning;
+    publish();
     m_tempWarning = tempWarning;
-    emit tempWarningChanged();
 }
 
 void EVVehicleData::setMotorFault(bool motorFault)
 {
-    if (m_motorFault == motorFault) return;
+    if (m_state.motorFault == motorFault) return;
+    m_state.motorFault = motorFault;
+    publish();
     m_motorFault = motorFault;
-    emit motorFaultChanged();
 }
 
 void EVVehicleData::setReducedPower(bool reducedPower)
 {
-    if (m_reducedPower == reducedPower) return;
+    if (m_state.reducedPower == reducedPower) return;
+    m_state.reducedPower = reducedPower;
+    publish();
     m_reducedPower = reducedPower;
-    emit reducedPowerChanged();
 }
 
 void EVVehicleData::setLeftTurnSignal(bool leftTurnSignal)
 {
-    if (m_leftTurnSignal == leftTurnSignal) return;
-    m_leftTurnSignal = leftTurnSignal;
+    if (m_state.leftTurnSignal == leftTurnSignal) return;
+    m_state.leftTurnSignal = leftTurnSignal;
+    publish();
     emit leftTurnSignalChanged();
 }
 
 void EVVehicleData::setRightTurnSignal(bool rightTurnSignal)
 {
-    if (m_rightTurnSignal == rightTurnSignal) return;
-    m_rightTurnSignal = rightTurnSignal;
+    if (m_state.rightTurnSignal == rightTurnSignal) return;
+    m_state.rightTurnSignal = rightTurnSignal;
+    publish();
     emit rightTurnSignalChanged();
 }
 
 void EVVehicleData::setHighBeam(bool highBeam)
 {
-    if (m_highBeam == highBeam) return;
-    m_highBeam = highBeam;
+    if (m_state.highBeam == highBeam) return;
+    m_state.highBeam = highBeam;
+    publish();
     emit highBeamChanged();
 }
 
 void EVVehicleData::setRegeneratonActive(bool regeneratonActive)
 {
-    if (m_regeneratonActive == regeneratonActive) return;
-    m_regeneratonActive = regeneratonActive;
+    if (m_state.regeneratonActive == regeneratonActive) return;
+    m_state.regeneratonActive = regeneratonActive;
+    publish();
     emit regeneratonActiveChanged();
 }
 
 void EVVehicleData::setTractionControl(bool tractionControl)
 {
-    if (m_tractionControl == tractionControl) return;
-    m_tractionControl = tractionControl;
+    if (m_state.tractionControl == tractionControl) return;
+    m_state.tractionControl = tractionControl;
+    publish();
     emit tractionControlChanged();
 }
 
 void EVVehicleData::setAbsWarning(bool absWarning)
 {
-    if (m_absWarning == absWarning) return;
-    m_absWarning = absWarning;
+    if (m_state.absWarning == absWarning) return;
+    m_state.absWarning = absWarning;
+    publish();
     emit absWarningChanged();
 }
 
 void EVVehicleData::setParkingBrake(bool parkingBrake)
 {
-    if (m_parkingBrake == parkingBrake) return;
-    m_parkingBrake = parkingBrake;
+    if (m_state.parkingBrake == parkingBrake) return;
+    m_state.parkingBrake = parkingBrake;
+    publish();
     emit parkingBrakeChanged();
 }
 
 void EVVehicleData::setSeatbeltWarning(bool seatbeltWarning)
 {
-    if (m_seatbeltWarning == seatbeltWarning) return;
-    m_seatbeltWarning = seatbeltWarning;
+    if (m_state.seatbeltWarning == seatbeltWarning) return;
+    m_state.seatbeltWarning = seatbeltWarning;
+    publish();
     emit seatbeltWarningChanged();
 }
 
 void EVVehicleData::setDoorAjar(bool doorAjar)
 {
-    if (m_doorAjar == doorAjar) return;
-    m_doorAjar = doorAjar;
+    if (m_state.doorAjar == doorAjar) return;
+    m_state.doorAjar = doorAjar;
+    publish();
     emit doorAjarChanged();
 }
 
 void EVVehicleData::setLow12V(bool low12V)
 {
-    if (m_low12V == low12V) return;
+    if (m_state.low12V == low12V) return;
+    m_state.low12V = low12V;
+    publish();
     m_low12V = low12V;
-    emit low12VChanged();
 }
 
 void EVVehicleData::setNextTurnIcon(const QString &nextTurnIcon)
 {
     if (m_nextTurnIcon == nextTurnIcon) return;
     m_nextTurnIcon = nextTurnIcon;
+    copyText(m_state.nextTurnIcon, sizeof(m_state.nextTurnIcon), nextTurnIcon);
+    publish();
     emit nextTurnIconChanged();
 }
 
@@ -364,6 +502,8 @@ void EVVehicleData::setNextTurnDistance(const QString &nextTurnDistance)
 {
     if (m_nextTurnDistance == nextTurnDistance) return;
     m_nextTurnDistance = nextTurnDistance;
+    copyText(m_state.nextTurnDistance, sizeof(m_state.nextTurnDistance), nextTurnDistance);
+    publish();
     emit nextTurnDistanceChanged();
 }
 
@@ -371,34 +511,40 @@ void EVVehicleData::setDestinationEta(const QString &destinationEta)
 {
     if (m_destinationEta == destinationEta) return;
     m_destinationEta = destinationEta;
+    copyText(m_state.destinationEta, sizeof(m_state.destinationEta), destinationEta);
+    publish();
     emit destinationEtaChanged();
 }
 
 void EVVehicleData::setDistToDestination(float distToDestination)
 {
-    if (qFuzzyCompare(m_distToDestination, distToDestination)) return;
-    m_distToDestination = distToDestination;
+    if (qFuzzyCompare(m_state.distToDestination, distToDestination)) return;
+    m_state.distToDestination = distToDestination;
+    publish();
     emit distToDestinationChanged();
 }
 
 void EVVehicleData::setGpsLatitude(double gpsLatitude)
 {
-    if (qFuzzyCompare(m_gpsLatitude, gpsLatitude)) return;
-    m_gpsLatitude = gpsLatitude;
+    if (qFuzzyCompare(m_state.gpsLatitude, gpsLatitude)) return;
+    m_state.gpsLatitude = gpsLatitude;
+    publish();
     emit gpsLatitudeChanged();
 }
 
 void EVVehicleData::setGpsLongitude(double gpsLongitude)
 {
-    if (qFuzzyCompare(m_gpsLongitude, gpsLongitude)) return;
-    m_gpsLongitude = gpsLongitude;
+    if (qFuzzyCompare(m_state.gpsLongitude, gpsLongitude)) return;
+    m_state.gpsLongitude = gpsLongitude;
+    publish();
     emit gpsLongitudeChanged();
 }
 
 void EVVehicleData::setHeading(float heading)
 {
-    if (qFuzzyCompare(m_heading, heading)) return;
-    m_heading = heading;
+    if (qFuzzyCompare(m_state.heading, heading)) return;
+    m_state.heading = heading;
+    publish();
     emit headingChanged();
 }
 
@@ -416,49 +562,140 @@ void EVVehicleData::setFullScreenMap(bool fullScreenMap)
     emit fullScreenMapChanged();
 }
 
-void EVVehicleData::updateFromSimulation(const QVariantMap& data)
+void EVVehicleData::applySample(const SignalSample &sample)
 {
-    if (data.contains("speed")) setSpeed(data["speed"].toFloat());
-    if (data.contains("soc")) setBatterySoc(data["soc"].toFloat());
-    if (data.contains("power")) setPowerOutput(data["power"].toFloat());
-    if (data.contains("range")) setEstimatedRange(data["range"].toFloat());
-    if (data.contains("motor_temp")) setMotorTemp(data["motor_temp"].toFloat());
-    if (data.contains("motor_rpm")) setMotorRpm(data["motor_rpm"].toFloat());
-    if (data.contains("battery_voltage")) setBatteryVoltage(data["battery_voltage"].toFloat());
-    if (data.contains("battery_current")) setBatteryCurrent(data["battery_current"].toFloat());
-    if (data.contains("battery_temp")) setBatteryTempAvg(data["battery_temp"].toFloat());
-    if (data.contains("odometer")) setOdometer(data["odometer"].toFloat());
-    if (data.contains("trip_distance_a")) setTripDistanceA(data["trip_distance_a"].toFloat());
-    if (data.contains("soh")) setBatterySoh(data["soh"].toFloat());
-    if (data.contains("efficiency")) setAverageConsumption(data["efficiency"].toFloat());
-    if (data.contains("ready")) setReadyToDrive(data["ready"].toBool());
-    if (data.contains("charging")) setChargingActive(data["charging"].toBool());
+    // Single merge point for every input source. Setters drop unchanged
+    // values, so a source repeating itself emits nothing.
+    const QVariant &v = sample.value;
+    
+    switch (sample.signal) {
+    case VehicleSignal::Speed: setSpeed(v.toFloat()); break;
+    case VehicleSignal::Odometer: setOdometer(v.toFloat()); break;
+    case VehicleSignal::TripDistanceA: setTripDistanceA(v.toFloat()); break;
+    case VehicleSignal::BatterySoc: setBatterySoc(v.toFloat()); break;
+    case VehicleSignal::BatteryVoltage: setBatteryVoltage(v.toFloat()); break;
+    case VehicleSignal::BatteryCurrent: setBatteryCurrent(v.toFloat()); break;
+    case VehicleSignal::BatteryTemp: setBatteryTempAvg(v.toFloat()); break;
+    case VehicleSignal::BatterySoh: setBatterySoh(v.toFloat()); break;
+    case VehicleSignal::PowerOutput: setPowerOutput(v.toFloat()); break;
+    case VehicleSignal::EstimatedRange: setEstimatedRange(v.toFloat()); break;
+    case VehicleSignal::AverageConsumption: setAverageConsumption(v.toFloat()); break;
+    case VehicleSignal::TimeToFull: setTimeToFull(v.toInt()); break;
+    case VehicleSignal::MotorTemp: setMotorTemp(v.toFloat()); break;
+    case VehicleSignal::ControllerTemp: setControllerTemp(v.toFloat()); break;
+    case VehicleSignal::MotorRpm: setMotorRpm(v.toFloat()); break;
+    case VehicleSignal::ReadyToDrive: setReadyToDrive(v.toBool()); break;
+    case VehicleSignal::ChargingActive: setChargingActive(v.toBool()); break;
     
     // Warnings
-    if (data.contains("bms_warning")) setBmsWarning(data["bms_warning"].toBool());
-    if (data.contains("hv_warning")) setHvWarning(data["hv_warning"].toBool());
-    if (data.contains("time_to_full")) setTimeToFull(data["time_to_full"].toInt());
-
-    // Indicators
-    if (data.contains("left_signal")) setLeftTurnSignal(data["left_signal"].toBool());
-    if (data.contains("right_signal")) setRightTurnSignal(data["right_signal"].toBool());
-    if (data.contains("high_beam")) setHighBeam(data["high_beam"].toBool());
+    case VehicleSignal::BmsWarning: setBmsWarning(v.toBool()); break;
+    case VehicleSignal::HvWarning: setHvWarning(v.toBool()); break;
+    case VehicleSignal::TempWarning: setTempWarning(v.toBool()); break;
+    case VehicleSignal::MotorFault: setMotorFault(v.toBool()); break;
+    case VehicleSignal::ReducedPower: setReducedPower(v.toBool()); break;
     
-    if (data.contains("abs")) setAbsWarning(data["abs"].toBool());
-    if (data.contains("tc")) setTractionControl(data["tc"].toBool());
-    if (data.contains("seatbelt")) setSeatbeltWarning(data["seatbelt"].toBool());
-    if (data.contains("door_ajar")) setDoorAjar(data["door_ajar"].toBool());
-    if (data.contains("parking")) setParkingBrake(data["parking"].toBool());
-    if (data.contains("low_12v")) setLow12V(data["low_12v"].toBool());
+    // Indicators
+    case VehicleSignal::LeftTurnSignal: setLeftTurnSignal(v.toBool()); break;
+    case VehicleSignal::RightTurnSignal: setRightTurnSignal(v.toBool()); break;
+    case VehicleSignal::HighBeam: setHighBeam(v.toBool()); break;
+    case VehicleSignal::AbsWarning: setAbsWarning(v.toBool()); break;
+    case VehicleSignal::TractionControl: setTractionControl(v.toBool()); break;
+    case VehicleSignal::SeatbeltWarning: setSeatbeltWarning(v.toBool()); break;
+    case VehicleSignal::DoorAjar: setDoorAjar(v.toBool()); break;
+    case VehicleSignal::ParkingBrake: setParkingBrake(v.toBool()); break;
+    case VehicleSignal::Low12V: setLow12V(v.toBool()); break;
     
     // Nav
-    if (data.contains("next_turn_dist")) setNextTurnDistance(data["next_turn_dist"].toString());
-    if (data.contains("nav_active")) setNavigationActive(data["nav_active"].toBool());
+    case VehicleSignal::NavigationActive: setNavigationActive(v.toBool()); break;
+    case VehicleSignal::NextTurnDistance: setNextTurnDistance(v.toString()); break;
     
     // GPS
-    if (data.contains("lat")) setGpsLatitude(data["lat"].toDouble());
-    if (data.contains("lon")) setGpsLongitude(data["lon"].toDouble());
-    if (data.contains("heading")) setHeading(data["heading"].toFloat());
+    case VehicleSignal::GpsLatitude: setGpsLatitude(v.toDouble()); break;
+    case VehicleSignal::GpsLongitude: setGpsLongitude(v.toDouble()); break;
+    case VehicleSignal::Heading: setHeading(v.toFloat()); break;
     
-    // Add other fields as needed
+    case VehicleSignal::Count:
+        break;
+    }
+}
+
+void EVVehicleData::updateFromSimulation(const QVariantMap& data)
+{
+    // Direct path without arbitration (tools/tests that own the data object)
+    for (auto it = data.constBegin(); it != data.constEnd(); ++it) {
+        SignalSample sample;
+        if (!VehicleSignals::fromSimulationKey(it.key(), &sample.signal)) continue;
+        sample.source = InputSource::Simulation;
+        sample.value = it.value();
+        applySample(sample);
+    }
+}
+
+void EVVehicleData::applyAnalytics(const AnalyticsResult &result)
+{
+    setEstimatedRange(result.estimatedRange);
+    setTripEnergy(result.tripEnergy);
+    setTripEfficiency(result.tripEfficiency);
+    if (result.timeToFull >= 0) setTimeToFull(result.timeToFull);
+}
+
+VehicleState EVVehicleData::snapshot() const
+{
+    VehicleState state;
+    m_published.load(&state);
+    return state;
+}
+
+void EVVehicleData::applyState(const VehicleState &state)
+{
+    // Same deduping setters as live input, so only real changes reach QML
+    setSpeed(state.speed);
+    setOdometer(state.odometer);
+    setTripDistanceA(state.tripDistanceA);
+    setTripDistanceB(state.tripDistanceB);
+    setBatterySoc(state.batterySoc);
+    setBatteryVoltage(state.batteryVoltage);
+    setBatteryCurrent(state.batteryCurrent);
+    setBatteryTempAvg(state.batteryTempAvg);
+    setBatterySoh(state.batterySoh);
+    setPowerOutput(state.powerOutput);
+    setInstantConsumption(state.instantConsumption);
+    setAverageConsumption(state.averageConsumption);
+    setEstimatedRange(state.estimatedRange);
+    setTripEnergy(state.tripEnergy);
+    setTripEfficiency(state.tripEfficiency);
+    setTimeToEmpty(state.timeToEmpty);
+    setTimeToFull(state.timeToFull);
+    setMotorTemp(state.motorTemp);
+    setControllerTemp(state.controllerTemp);
+    setMotorRpm(state.motorRpm);
+    setDriveMode(static_cast<DriveMode>(state.driveMode));
+    setRegenLevel(static_cast<RegenLevel>(state.regenLevel));
+
+    setChargingActive(state.chargingActive);
+    setReadyToDrive(state.readyToDrive);
+    setBmsWarning(state.bmsWarning);
+    setHvWarning(state.hvWarning);
+    setTempWarning(state.tempWarning);
+    setMotorFault(state.motorFault);
+    setReducedPower(state.reducedPower);
+    setLeftTurnSignal(state.leftTurnSignal);
+    setRightTurnSignal(state.rightTurnSignal);
+    setHighBeam(state.highBeam);
+    setRegeneratonActive(state.regeneratonActive);
+    setTractionControl(state.tractionControl);
+    setAbsWarning(state.absWarning);
+    setParkingBrake(state.parkingBrake);
+    setSeatbeltWarning(state.seatbeltWarning);
+    setDoorAjar(state.doorAjar);
+    setLow12V(state.low12V);
+
+    setNavigationActive(state.navigationActive);
+    setNextTurnIcon(textFrom(state.nextTurnIcon, sizeof(state.nextTurnIcon)));
+    setNextTurnDistance(textFrom(state.nextTurnDistance, sizeof(state.nextTurnDistance)));
+    setDestinationEta(textFrom(state.destinationEta, sizeof(state.destinationEta)));
+    setDistToDestination(state.distToDestination);
+    setGpsLatitude(state.gpsLatitude);
+    setGpsLongitude(state.gpsLongitude);
+    setHeading(state.heading);
 }
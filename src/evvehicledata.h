@@ -2,40 +2,53 @@
 #define EVVEHICLEDATA_H
 
 #include <QObject>
+#include <QProperty>
 #include <QString>
 #include <QDateTime>
+#include <QTimer>
+#include "analyticsresult.h"
+#include "consumptionseries.h"
+#include "seqlock.h"
+#include "signalsample.h"
+#include "vehiclestate.h"
 
+// QML façade over VehicleState.
+// Properties, setters and change signals live on the GUI thread; each change
+// is published through a SeqLock so other threads use snapshot() instead of
+// touching this object.
 class EVVehicleData : public QObject
 {
     Q_OBJECT
 
     // Motion
-    Q_PROPERTY(float speed READ speed WRITE setSpeed NOTIFY speedChanged)
+    Q_PROPERTY(float speed READ speed WRITE setSpeed NOTIFY speedChanged BINDABLE bindableSpeed)
     Q_PROPERTY(float odometer READ odometer WRITE setOdometer NOTIFY odometerChanged)
     Q_PROPERTY(float tripDistanceA READ tripDistanceA WRITE setTripDistanceA NOTIFY tripDistanceAChanged)
     Q_PROPERTY(float tripDistanceB READ tripDistanceB WRITE setTripDistanceB NOTIFY tripDistanceBChanged)
 
     // Battery
-    Q_PROPERTY(float batterySoc READ batterySoc WRITE setBatterySoc NOTIFY batterySocChanged)
+    Q_PROPERTY(float batterySoc READ batterySoc WRITE setBatterySoc NOTIFY batterySocChanged BINDABLE bindableBatterySoc)
     Q_PROPERTY(float batteryVoltage READ batteryVoltage WRITE setBatteryVoltage NOTIFY batteryVoltageChanged)
     Q_PROPERTY(float batteryCurrent READ batteryCurrent WRITE setBatteryCurrent NOTIFY batteryCurrentChanged)
     Q_PROPERTY(float batteryTempAvg READ batteryTempAvg WRITE setBatteryTempAvg NOTIFY batteryTempAvgChanged)
     Q_PROPERTY(float batterySoh READ batterySoh WRITE setBatterySoh NOTIFY batterySohChanged)
 
     // Power & Energy
-    Q_PROPERTY(float powerOutput READ powerOutput WRITE setPowerOutput NOTIFY powerOutputChanged)
+    Q_PROPERTY(float powerOutput READ powerOutput WRITE setPowerOutput NOTIFY powerOutputChanged BINDABLE bindablePowerOutput)
     Q_PROPERTY(float instantConsumption READ instantConsumption WRITE setInstantConsumption NOTIFY instantConsumptionChanged)
     Q_PROPERTY(float estimatedRange READ estimatedRange WRITE setEstimatedRange NOTIFY estimatedRangeChanged)
     Q_PROPERTY(int timeToEmpty READ timeToEmpty WRITE setTimeToEmpty NOTIFY timeToEmptyChanged)
-    Q_PROPERTY(int timeToFull READ timeToFull WRITE setTimeToFull NOTIFY timeToFullChanged)
+    Q_PROPERTY(int timeToFull READ timeToFull WRITE setTimeToFull NOTIFY timeToFullChanged BINDABLE bindableTimeToFull)
     Q_PROPERTY(float averageConsumption READ averageConsumption WRITE setAverageConsumption NOTIFY averageConsumptionChanged)
-    Q_PROPERTY(QList<float> consumptionHistory READ consumptionHistory WRITE setConsumptionHistory NOTIFY consumptionHistoryChanged)
-    Q_PROPERTY(float motorTemp READ motorTemp WRITE setMotorTemp NOTIFY motorTempChanged)
+    Q_PROPERTY(float tripEnergy READ tripEnergy WRITE setTripEnergy NOTIFY tripEnergyChanged)
+    Q_PROPERTY(float tripEfficiency READ tripEfficiency WRITE setTripEfficiency NOTIFY tripEfficiencyChanged)
+    Q_PROPERTY(ConsumptionSeries *consumptionSeries READ consumptionSeries CONSTANT)
+    Q_PROPERTY(float motorTemp READ motorTemp WRITE setMotorTemp NOTIFY motorTempChanged BINDABLE bindableMotorTemp)
     Q_PROPERTY(float controllerTemp READ controllerTemp WRITE setControllerTemp NOTIFY controllerTempChanged)
     Q_PROPERTY(float motorRpm READ motorRpm WRITE setMotorRpm NOTIFY motorRpmChanged)
 
     // Drive Mode
-    Q_PROPERTY(DriveMode driveMode READ driveMode WRITE setDriveMode NOTIFY driveModeChanged)
+    Q_PROPERTY(DriveMode driveMode READ driveMode WRITE setDriveMode NOTIFY driveModeChanged BINDABLE bindableDriveMode)
     Q_PROPERTY(RegenLevel regenLevel READ regenLevel WRITE setRegenLevel NOTIFY regenLevelChanged)
 
     // Status
@@ -44,11 +57,11 @@ class EVVehicleData : public QObject
     Q_PROPERTY(bool readyToDrive READ readyToDrive WRITE setReadyToDrive NOTIFY readyToDriveChanged)
 
     // Critical Warnings
-    Q_PROPERTY(bool bmsWarning READ bmsWarning WRITE setBmsWarning NOTIFY bmsWarningChanged)
-    Q_PROPERTY(bool hvWarning READ hvWarning WRITE setHvWarning NOTIFY hvWarningChanged)
-    Q_PROPERTY(bool tempWarning READ tempWarning WRITE setTempWarning NOTIFY tempWarningChanged)
-    Q_PROPERTY(bool motorFault READ motorFault WRITE setMotorFault NOTIFY motorFaultChanged)
-    Q_PROPERTY(bool reducedPower READ reducedPower WRITE setReducedPower NOTIFY reducedPowerChanged)
+    Q_PROPERTY(bool bmsWarning READ bmsWarning WRITE setBmsWarning NOTIFY bmsWarningChanged BINDABLE bindableBmsWarning)
+    Q_PROPERTY(bool hvWarning READ hvWarning WRITE setHvWarning NOTIFY hvWarningChanged BINDABLE bindableHvWarning)
+    Q_PROPERTY(bool tempWarning READ tempWarning WRITE setTempWarning NOTIFY tempWarningChanged BINDABLE bindableTempWarning)
+    Q_PROPERTY(bool motorFault READ motorFault WRITE setMotorFault NOTIFY motorFaultChanged BINDABLE bindableMotorFault)
+    Q_PROPERTY(bool reducedPower READ reducedPower WRITE setReducedPower NOTIFY reducedPowerChanged BINDABLE bindableReducedPower)
 
     // Indicators
     Q_PROPERTY(bool leftTurnSignal READ leftTurnSignal WRITE setLeftTurnSignal NOTIFY leftTurnSignalChanged)
@@ -60,7 +73,7 @@ class EVVehicleData : public QObject
     Q_PROPERTY(bool parkingBrake READ parkingBrake WRITE setParkingBrake NOTIFY parkingBrakeChanged)
     Q_PROPERTY(bool seatbeltWarning READ seatbeltWarning WRITE setSeatbeltWarning NOTIFY seatbeltWarningChanged)
     Q_PROPERTY(bool doorAjar READ doorAjar WRITE setDoorAjar NOTIFY doorAjarChanged)
-    Q_PROPERTY(bool low12V READ low12V WRITE setLow12V NOTIFY low12VChanged)
+    Q_PROPERTY(bool low12V READ low12V WRITE setLow12V NOTIFY low12VChanged BINDABLE bindableLow12V)
     
     // Navigation Data
     Q_PROPERTY(bool navigationActive READ navigationActive WRITE setNavigationActive NOTIFY navigationActiveChanged)
@@ -72,6 +85,18 @@ class EVVehicleData : public QObject
     Q_PROPERTY(double gpsLongitude READ gpsLongitude WRITE setGpsLongitude NOTIFY gpsLongitudeChanged)
     Q_PROPERTY(float heading READ heading WRITE setHeading NOTIFY headingChanged)
     
+    // Derived: C++ bindings over the bindable inputs above. Having notify
+    // signals, they are re-evaluated eagerly on every input change (a 50 Hz
+    // speed still runs "speed > 120" 50 times a second, as a cheap C++
+    // comparison), but QML is notified only when the result changed.
+    Q_PROPERTY(QString driveModeName READ driveModeName NOTIFY driveModeNameChanged BINDABLE bindableDriveModeName)
+    Q_PROPERTY(QString timeToFullText READ timeToFullText NOTIFY timeToFullTextChanged BINDABLE bindableTimeToFullText)
+    Q_PROPERTY(PowerDirection powerDirection READ powerDirection NOTIFY powerDirectionChanged BINDABLE bindablePowerDirection)
+    Q_PROPERTY(bool overspeed READ overspeed NOTIFY overspeedChanged BINDABLE bindableOverspeed)
+    Q_PROPERTY(bool lowBattery READ lowBattery NOTIFY lowBatteryChanged BINDABLE bindableLowBattery)
+    Q_PROPERTY(bool thermalWarning READ thermalWarning NOTIFY thermalWarningChanged BINDABLE bindableThermalWarning)
+    Q_PROPERTY(int activeWarningCount READ activeWarningCount NOTIFY activeWarningCountChanged BINDABLE bindableActiveWarningCount)
+
     // UI State
     Q_PROPERTY(bool nightMode READ nightMode WRITE setNightMode NOTIFY nightModeChanged)
     Q_PROPERTY(bool fullScreenMap READ fullScreenMap WRITE setFullScreenMap NOTIFY fullScreenMapChanged)
@@ -95,55 +120,103 @@ public:
     };
     Q_ENUM(RegenLevel)
 
+    enum PowerDirection {
+        Idle,
+        Drive,
+        Regen
+    };
+    Q_ENUM(PowerDirection)
+
     // Getters
     float speed() const { return m_speed; }
-    float odometer() const { return m_odometer; }
-    float tripDistanceA() const { return m_tripDistanceA; }
-    float tripDistanceB() const { return m_tripDistanceB; }
+    float odometer() const { return m_state.odometer; }
+    float tripDistanceA() const { return m_state.tripDistanceA; }
+    float tripDistanceB() const { return m_state.tripDistanceB; }
     float batterySoc() const { return m_batterySoc; }
-    float batteryVoltage() const { return m_batteryVoltage; }
-    float batteryCurrent() const { return m_batteryCurrent; }
-    float batteryTempAvg() const { return m_batteryTempAvg; }
-    float batterySoh() const { return m_batterySoh; }
+    float batteryVoltage() const { return m_state.batteryVoltage; }
+    float batteryCurrent() const { return m_state.batteryCurrent; }
+    float batteryTempAvg() const { return m_state.batteryTempAvg; }
+    float batterySoh() const { return m_state.batterySoh; }
     float powerOutput() const { return m_powerOutput; }
-    float instantConsumption() const { return m_instantConsumption; }
-    float estimatedRange() const { return m_estimatedRange; }
-    int timeToEmpty() const { return m_timeToEmpty; }
+    float instantConsumption() const { return m_state.instantConsumption; }
+    float estimatedRange() const { return m_state.estimatedRange; }
+    int timeToEmpty() const { return m_state.timeToEmpty; }
     int timeToFull() const { return m_timeToFull; }
-    float averageConsumption() const { return m_averageConsumption; }
-    QList<float> consumptionHistory() const { return m_consumptionHistory; }
+    float averageConsumption() const { return m_state.averageConsumption; }
+    float tripEnergy() const { return m_state.tripEnergy; }
+    float tripEfficiency() const { return m_state.tripEfficiency; }
+    ConsumptionSeries *consumptionSeries() const { return m_consumptionSeries; }
     float motorTemp() const { return m_motorTemp; }
-    float controllerTemp() const { return m_controllerTemp; }
-    float motorRpm() const { return m_motorRpm; }
+    float controllerTemp() const { return m_state.controllerTemp; }
+    float motorRpm() const { return m_state.motorRpm; }
     DriveMode driveMode() const { return m_driveMode; }
-    RegenLevel regenLevel() const { return m_regenLevel; }
-    bool chargingActive() const { return m_chargingActive; }
-    bool readyToDrive() const { return m_readyToDrive; }
+    RegenLevel regenLevel() const { return static_cast<RegenLevel>(m_state.regenLevel); }
+    bool chargingActive() const { return m_state.chargingActive; }
+    bool readyToDrive() const { return m_state.readyToDrive; }
     bool bmsWarning() const { return m_bmsWarning; }
     bool hvWarning() const { return m_hvWarning; }
     bool tempWarning() const { return m_tempWarning; }
     bool motorFault() const { return m_motorFault; }
     bool reducedPower() const { return m_reducedPower; }
-    bool leftTurnSignal() const { return m_leftTurnSignal; }
-    bool rightTurnSignal() const { return m_rightTurnSignal; }
-    bool highBeam() const { return m_highBeam; }
-    bool regeneratonActive() const { return m_regeneratonActive; }
-    bool tractionControl() const { return m_tractionControl; }
-    bool absWarning() const { return m_absWarning; }
-    bool parkingBrake() const { return m_parkingBrake; }
-    bool seatbeltWarning() const { return m_seatbeltWarning; }
-    bool doorAjar() const { return m_doorAjar; }
+    bool leftTurnSignal() const { return m_state.leftTurnSignal; }
+    bool rightTurnSignal() const { return m_state.rightTurnSignal; }
+    bool highBeam() const { return m_state.highBeam; }
+    bool regeneratonActive() const { return m_state.regeneratonActive; }
+    bool tractionControl() const { return m_state.tractionControl; }
+    bool absWarning() const { return m_state.absWarning; }
+    bool parkingBrake() const { return m_state.parkingBrake; }
+    bool seatbeltWarning() const { return m_state.seatbeltWarning; }
+    bool doorAjar() const { return m_state.doorAjar; }
     bool low12V() const { return m_low12V; }
     QString nextTurnIcon() const { return m_nextTurnIcon; }
     QString nextTurnDistance() const { return m_nextTurnDistance; }
     QString destinationEta() const { return m_destinationEta; }
-    float distToDestination() const { return m_distToDestination; }
-    double gpsLatitude() const { return m_gpsLatitude; }
-    double gpsLongitude() const { return m_gpsLongitude; }
-    float heading() const { return m_heading; }
+    float distToDestination() const { return m_state.distToDestination; }
+    double gpsLatitude() const { return m_state.gpsLatitude; }
+    double gpsLongitude() const { return m_state.gpsLongitude; }
+    float heading() const { return m_state.heading; }
     bool nightMode() const { return m_nightMode; }
     bool fullScreenMap() const { return m_fullScreenMap; }
-    bool navigationActive() const { return m_navigationActive; }
+    bool navigationActive() const { return m_state.navigationActive; }
+
+    // Derived
+    QString driveModeName() const { return m_driveModeName; }
+    QString timeToFullText() const { return m_timeToFullText; }
+    PowerDirection powerDirection() const { return m_powerDirection; }
+    bool overspeed() const { return m_overspeed; }
+    bool lowBattery() const { return m_lowBattery; }
+    bool thermalWarning() const { return m_thermalWarning; }
+    int activeWarningCount() const { return m_activeWarningCount; }
+
+    // Bindable inputs and derived values, for C++ bindings
+    QBindable<float> bindableSpeed() { return &m_speed; }
+    QBindable<float> bindableBatterySoc() { return &m_batterySoc; }
+    QBindable<float> bindablePowerOutput() { return &m_powerOutput; }
+    QBindable<int> bindableTimeToFull() { return &m_timeToFull; }
+    QBindable<float> bindableMotorTemp() { return &m_motorTemp; }
+    QBindable<DriveMode> bindableDriveMode() { return &m_driveMode; }
+    QBindable<bool> bindableBmsWarning() { return &m_bmsWarning; }
+    QBindable<bool> bindableHvWarning() { return &m_hvWarning; }
+    QBindable<bool> bindableTempWarning() { return &m_tempWarning; }
+    QBindable<bool> bindableMotorFault() { return &m_motorFault; }
+    QBindable<bool> bindableReducedPower() { return &m_reducedPower; }
+    QBindable<bool> bindableLow12V() { return &m_low12V; }
+    QBindable<QString> bindableDriveModeName() { return &m_driveModeName; }
+    QBindable<QString> bindableTimeToFullText() { return &m_timeToFullText; }
+    QBindable<PowerDirection> bindablePowerDirection() { return &m_powerDirection; }
+    QBindable<bool> bindableOverspeed() { return &m_overspeed; }
+    QBindable<bool> bindableLowBattery() { return &m_lowBattery; }
+    QBindable<bool> bindableThermalWarning() { return &m_thermalWarning; }
+    QBindable<int> bindableActiveWarningCount() { return &m_activeWarningCount; }
+
+    // Log input changes, derived evaluations and QML notifications every intervalMs (0 = off)
+    void setStatisticsInterval(int intervalMs);
+
+    // Consistent copy of all vehicle signals. The only member that is safe to
+    // call from any thread: worker threads read it lock-free while the GUI
+    // thread keeps publishing, and ev-datad shares it with other displays.
+    VehicleState snapshot() const;
+    quint32 snapshotSequence() const { return m_published.sequence(); }   // Bumps on every change
 
 public slots:
     // Setters
@@ -162,7 +235,8 @@ public slots:
     void setTimeToEmpty(int timeToEmpty);
     void setTimeToFull(int timeToFull);
     void setAverageConsumption(float averageConsumption);
-    void setConsumptionHistory(const QList<float> &consumptionHistory);
+    void setTripEnergy(float tripEnergy);
+    void setTripEfficiency(float tripEfficiency);
     void setMotorTemp(float motorTemp);
     void setControllerTemp(float controllerTemp);
     void setMotorRpm(float motorRpm);
@@ -196,6 +270,15 @@ public slots:
     void setFullScreenMap(bool fullScreenMap);
     void setNavigationActive(bool navigationActive);
 
+    // Arbitrated input - the only place external sources write vehicle state
+    void applySample(const SignalSample &sample);
+
+    // Derived values posted by the analytics worker (range, efficiency, ...)
+    void applyAnalytics(const AnalyticsResult &result);
+
+    // Mirror a snapshot published by another process; per-display UI state is kept
+    void applyState(const VehicleState &state);
+
     // Simulation helper
     void updateFromSimulation(const QVariantMap& data);
 
@@ -215,7 +298,8 @@ signals:
     void timeToEmptyChanged();
     void timeToFullChanged();
     void averageConsumptionChanged();
-    void consumptionHistoryChanged();
+    void tripEnergyChanged();
+    void tripEfficiencyChanged();
     void motorTempChanged();
     void controllerTempChanged();
     void motorRpmChanged();
@@ -248,62 +332,69 @@ signals:
     void nightModeChanged();
     void fullScreenMapChanged();
     void navigationActiveChanged();
+    void driveModeNameChanged();
+    void timeToFullTextChanged();
+    void powerDirectionChanged();
+    void overspeedChanged();
+    void lowBatteryChanged();
+    void thermalWarningChanged();
+    void activeWarningCountChanged();
 
+private slots:
+    void logStatistics();
 
 private:
-    float m_speed = 0.0f;
-    float m_odometer = 0.0f;
-    float m_tripDistanceA = 0.0f;
-    float m_tripDistanceB = 0.0f;
-    float m_batterySoc = 0.0f;
-    float m_batteryVoltage = 0.0f;
-    float m_batteryCurrent = 0.0f;
-    float m_batteryTempAvg = 0.0f;
-    float m_batterySoh = 100.0f;
-    float m_powerOutput = 0.0f;
-    float m_instantConsumption = 0.0f;
-    float m_estimatedRange = 0.0f;
-    int m_timeToEmpty = 0;
-    int m_timeToFull = 0;
-    float m_averageConsumption = 0.0f;
-    QList<float> m_consumptionHistory;
-    float m_motorTemp = 0.0f;
-    float m_controllerTemp = 0.0f;
-    float m_motorRpm = 0.0f;
-    DriveMode m_driveMode = Normal;
-    RegenLevel m_regenLevel = Medium;
-    bool m_chargingActive = false;
-    bool m_readyToDrive = false;
-    bool m_bmsWarning = false;
-    bool m_hvWarning = false;
-    bool m_tempWarning = false;
-    bool m_motorFault = false;
-    bool m_reducedPower = false;
-    bool m_leftTurnSignal = false;
-    bool m_rightTurnSignal = false;
-    bool m_highBeam = false;
-    bool m_regeneratonActive = false;
-    bool m_tractionControl = false;
-    bool m_absWarning = false;
-    bool m_parkingBrake = false;
-    bool m_seatbeltWarning = false;
-    bool m_doorAjar = false;
-    bool m_low12V = false;
-    
-    QString m_nextTurnIcon = "";
-    QString m_nextTurnDistance = "";
-    QString m_destinationEta = "";
-    float m_distToDestination = 0.0f;
-    double m_gpsLatitude = 28.6139;
-    double m_gpsLongitude = 77.2090;
-    float m_heading = 0.0f;
+    void publish();
+    void setUpDerived();
+    void watchStatistics();
+
+    // Working copy, GUI thread only; every change is republished to m_published
+    VehicleState m_state;
+    SeqLock<VehicleState> m_published;
+
+    ConsumptionSeries *m_consumptionSeries;  // Per-km Wh/km, owned
+
+    // QString copies of the navigation text for QML (m_state holds UTF-8)
+    QString m_nextTurnIcon;
+    QString m_nextTurnDistance;
+    QString m_destinationEta;
+
+    // UI state, per display
     bool m_nightMode = true; // Default to night/dark mode
     bool m_fullScreenMap = false;
-    bool m_navigationActive = false;
     
-    // Range calculation smoothing
-    float m_previousRange = 0.0f;
-    float m_smoothedEfficiency = 180.0f;  // Wh/km
+    // Last whole km the consumption series was sampled at (-1 = not yet)
+    int m_lastConsumptionKm = -1;
+
+    // Inputs of the derived values; m_state keeps a plain copy for publishing
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, float, m_speed, &EVVehicleData::speedChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, float, m_batterySoc, &EVVehicleData::batterySocChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, float, m_powerOutput, &EVVehicleData::powerOutputChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, int, m_timeToFull, &EVVehicleData::timeToFullChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, float, m_motorTemp, &EVVehicleData::motorTempChanged)
+    Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(EVVehicleData, DriveMode, m_driveMode, Normal, &EVVehicleData::driveModeChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_bmsWarning, &EVVehicleData::bmsWarningChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_hvWarning, &EVVehicleData::hvWarningChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_tempWarning, &EVVehicleData::tempWarningChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_motorFault, &EVVehicleData::motorFaultChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_reducedPower, &EVVehicleData::reducedPowerChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_low12V, &EVVehicleData::low12VChanged)
+
+    // Derived values, bound in setUpDerived()
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, QString, m_driveModeName, &EVVehicleData::driveModeNameChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, QString, m_timeToFullText, &EVVehicleData::timeToFullTextChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, PowerDirection, m_powerDirection, &EVVehicleData::powerDirectionChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_overspeed, &EVVehicleData::overspeedChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_lowBattery, &EVVehicleData::lowBatteryChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, bool, m_thermalWarning, &EVVehicleData::thermalWarningChanged)
+    Q_OBJECT_BINDABLE_PROPERTY(EVVehicleData, int, m_activeWarningCount, &EVVehicleData::activeWarningCountChanged)
+
+    // Statistics: what the bindings cost against re-running every QML expression per input change
+    QTimer m_statsTimer;
+    int m_statsInputChanges = 0;
+    int m_statsEagerEvaluations = 0;
+    int m_statsEvaluations = 0;
+    int m_statsNotifications = 0;
 };
 
 #endif // EVVEHICLEDATA_H
@@ -0,0 +1,90 @@
+#include "framebufferoutput.h"
+#include <QDebug>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/fb.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+FramebufferOutput::~FramebufferOutput()
+{
+    close();
+}
+
+bool FramebufferOutput::open(const QString &device)
+{
+    close();
+
+    m_fd = ::open(device.toLocal8Bit().constData(), O_RDWR | O_CLOEXEC);
+    if (m_fd < 0) {
+        qWarning() << "Cannot open framebuffer" << device << strerror(errno);
+        return false;
+    }
+
+    fb_var_screeninfo var;
+    fb_fix_screeninfo fix;
+    if (ioctl(m_fd, FBIOGET_VSCREENINFO, &var) != 0 || ioctl(m_fd, FBIOGET_FSCREENINFO, &fix) != 0) {
+        qWarning() << "Cannot query framebuffer" << device << strerror(errno);
+        close();
+        return false;
+    }
+
+    // Only formats QImage can render into directly; anything else would need a conversion per flush
+    if (var.bits_per_pixel == 16 && var.red.offset == 11 && var.green.offset == 5) {
+        m_format = QImage::Format_RGB16;
+    } else if (var.bits_per_pixel == 32 && var.red.offset == 16 && var.green.offset == 8) {
+        m_format = QImage::Format_RGB32;
+    } else {
+        qWarning() << "Unsupported framebuffer format on" << device << var.bits_per_pixel << "bpp";
+        close();
+        return false;
+    }
+
+    m_mapLength = fix.smem_len;
+    void *address = mmap(nullptr, m_mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (address == MAP_FAILED) {
+        qWarning() << "mmap failed for" << device << strerror(errno);
+        close();
+        return false;
+    }
+
+    m_map = static_cast<uchar *>(address);
+    m_stride = int(fix.line_length);
+    m_bytesPerPixel = int(var.bits_per_pixel / 8);
+    m_xOffset = int(var.xoffset);
+    m_yOffset = int(var.yoffset);
+    m_size = QSize(int(var.xres), int(var.yres));
+    qDebug() << "Framebuffer" << device << m_size << var.bits_per_pixel << "bpp";
+    return true;
+}
+
+void FramebufferOutput::close()
+{
+    if (m_map) {
+        munmap(m_map, m_mapLength);
+        m_map = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void FramebufferOutput::flush(const QImage &image, const QRegion &region)
+{
+    if (!m_map || image.format() != m_format) return;
+
+    const QRect bounds = QRect(QPoint(0, 0), m_size).intersected(image.rect());
+    for (const QRect &dirty : region) {
+        const QRect rect = dirty.intersected(bounds);
+        if (rect.isEmpty()) continue;
+
+        const int bytes = rect.width() * m_bytesPerPixel;
+        for (int y = rect.top(); y <= rect.bottom(); ++y) {
+            uchar *target = m_map + size_t(y + m_yOffset) * m_stride + size_t(rect.left() + m_xOffset) * m_bytesPerPixel;
+            memcpy(target, image.constScanLine(y) + rect.left() * m_bytesPerPixel, bytes);
+        }
+    }
+}
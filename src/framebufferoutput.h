@@ -0,0 +1,44 @@
+#ifndef FRAMEBUFFEROUTPUT_H
+#define FRAMEBUFFEROUTPUT_H
+
+#include <QImage>
+#include <QRegion>
+#include <QSize>
+#include <QString>
+
+// Linux fbdev output (/dev/fbN) for displays without a GPU or compositor.
+// The device is mapped once; flush() copies only the given rectangles, line
+// by line, from an image that already has the framebuffer's pixel format
+// (RGB565 or XRGB8888), so an update costs a memcpy per dirty scanline.
+// DRM-only drivers are reachable through their fbdev emulation.
+class FramebufferOutput
+{
+public:
+    FramebufferOutput() = default;
+    ~FramebufferOutput();
+
+    FramebufferOutput(const FramebufferOutput &) = delete;
+    FramebufferOutput &operator=(const FramebufferOutput &) = delete;
+
+    bool open(const QString &device = QStringLiteral("/dev/fb0"));
+    void close();
+
+    bool isOpen() const { return m_map != nullptr; }
+    QSize size() const { return m_size; }
+    QImage::Format format() const { return m_format; }
+
+    void flush(const QImage &image, const QRegion &region);
+
+private:
+    int m_fd = -1;
+    uchar *m_map = nullptr;
+    size_t m_mapLength = 0;
+    int m_stride = 0;
+    int m_bytesPerPixel = 0;
+    int m_xOffset = 0;
+    int m_yOffset = 0;
+    QSize m_size;
+    QImage::Format m_format = QImage::Format_Invalid;
+};
+
+#endif // FRAMEBUFFEROUTPUT_H
@@ -0,0 +1,275 @@
+#include "glyphatlas.h"
+#include <QDebug>
+#include <QFontMetricsF>
+#include <QImage>
+#include <QMutex>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QtMath>
+#include <QVector>
+#include <cstring>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#else
+#include <QtGui/private/qrhi_p.h>
+#endif
+
+static const int kSupersample = 4;      // Edges are found on a 4x raster
+static const int kAtlasSize = 512;       // Room for ~90 glyphs
+static const QString kInitialChars = QStringLiteral("0123456789.-");
+
+// ── Distance field ──
+
+// 8-point sequential signed Euclidean distance transform: every cell ends up
+// holding the offset to its nearest seed cell
+struct SeedOffset {
+    int dx, dy;
+    int distance2() const { return dx * dx + dy * dy; }
+};
+
+static const int kFar = 9999;
+
+static void propagate(QVector<SeedOffset> &grid, int width, int height)
+{
+    auto compare = [&](SeedOffset &cell, int x, int y, int ox, int oy) {
+        const int nx = x + ox;
+        const int ny = y + oy;
+        if (nx < 0 || ny < 0 || nx >= width || ny >= height) return;
+        SeedOffset other = grid[ny * width + nx];
+        other.dx += ox;
+        other.dy += oy;
+        if (other.distance2() < cell.distance2()) cell = other;
+    };
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            SeedOffset &cell = grid[y * width + x];
+            compare(cell, x, y, -1, 0);
+            compare(cell, x, y, 0, -1);
+            compare(cell, x, y, -1, -1);
+            compare(cell, x, y, 1, -1);
+        }
+        for (int x = width - 1; x >= 0; --x) {
+            compare(grid[y * width + x], x, y, 1, 0);
+        }
+    }
+    for (int y = height - 1; y >= 0; --y) {
+        for (int x = width - 1; x >= 0; --x) {
+            SeedOffset &cell = grid[y * width + x];
+            compare(cell, x, y, 1, 0);
+            compare(cell, x, y, 0, 1);
+            compare(cell, x, y, -1, 1);
+            compare(cell, x, y, 1, 1);
+        }
+        for (int x = 0; x < width; ++x) {
+            compare(grid[y * width + x], x, y, -1, 0);
+        }
+    }
+}
+
+// coverage: Alpha8 at kSupersample x the cell size. Returns the cell's field,
+// 0.5 on the outline, rising inside, one byte per base-size pixel.
+static QImage distanceField(const QImage &coverage, const QSize &cell)
+{
+    const int width = coverage.width();
+    const int height = coverage.height();
+    QVector<SeedOffset> toInside(width * height, SeedOffset { kFar, kFar });
+    QVector<SeedOffset> toOutside(width * height, SeedOffset { kFar, kFar });
+    for (int y = 0; y < height; ++y) {
+        const uchar *line = coverage.constScanLine(y);
+        for (int x = 0; x < width; ++x) {
+            (line[x] >= 128 ? toInside : toOutside)[y * width + x] = SeedOffset { 0, 0 };
+        }
+    }
+    propagate(toInside, width, height);
+    propagate(toOutside, width, height);
+
+    QImage field(cell, QImage::Format_Alpha8);
+    for (int y = 0; y < cell.height(); ++y) {
+        uchar *line = field.scanLine(y);
+        for (int x = 0; x < cell.width(); ++x) {
+            // Sample the centre of each base pixel; distances in base pixels
+            const int index = (y * kSupersample + kSupersample / 2) * width + x * kSupersample + kSupersample / 2;
+            const qreal inside = qSqrt(toOutside[index].distance2());
+            const qreal outside = qSqrt(toInside[index].distance2());
+            const qreal distance = (inside - outside) / kSupersample;
+            const qreal value = 0.5 + distance / (2.0 * GlyphAtlas::Spread);
+            line[x] = uchar(qBound(0.0, value, 1.0) * 255.0 + 0.5);
+        }
+    }
+    return field;
+}
+
+// ── Texture ──
+
+// One R8 texture for the atlas's lifetime. Cells added since the last commit
+// are uploaded as sub-rectangles, so growing the atlas never re-sends the
+// whole 512x512 field and never swaps the texture out from under a batch.
+class GlyphAtlasTexture : public QSGTexture
+{
+public:
+    explicit GlyphAtlasTexture(const QImage &image) : m_image(image)
+    {
+        m_pending.append(image.rect());
+    }
+
+    ~GlyphAtlasTexture() override { delete m_texture; }
+
+    void markDirty(const QRect &rect) { m_pending.append(rect); }
+    bool hasPendingUploads() const { return !m_pending.isEmpty(); }
+
+    qint64 comparisonKey() const override { return qint64(quintptr(this)); }
+    QRhiTexture *rhiTexture() const override { return m_texture; }
+    QSize textureSize() const override { return m_image.size(); }
+    bool hasAlphaChannel() const override { return false; }
+    bool hasMipmaps() const override { return false; }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        if (!m_texture) {
+            // Single channel where the backend has it; the shader reads red either way
+            m_singleChannel = rhi->isTextureFormatSupported(QRhiTexture::R8);
+            m_texture = rhi->newTexture(m_singleChannel ? QRhiTexture::R8 : QRhiTexture::RGBA8, m_image.size());
+            if (!m_texture->create()) {
+                qWarning() << "Glyph atlas: cannot create texture";
+                delete m_texture;
+                m_texture = nullptr;
+                return;
+            }
+        }
+
+        for (const QRect &rect : std::as_const(m_pending)) {
+            QImage cell = m_image.copy(rect);
+            if (!m_singleChannel) {
+                // Same bytes read as grey, so the field lands in red (and green and blue)
+                cell = QImage(cell.constBits(), cell.width(), cell.height(), cell.bytesPerLine(),
+                              QImage::Format_Grayscale8).convertToFormat(QImage::Format_RGBA8888);
+            }
+            QRhiTextureSubresourceUploadDescription description(cell);
+            description.setDestinationTopLeft(rect.topLeft());
+            resourceUpdates->uploadTexture(m_texture, QRhiTextureUploadDescription(
+                QRhiTextureUploadEntry(0, 0, description)));
+        }
+        m_pending.clear();
+    }
+
+private:
+    const QImage &m_image;      // GlyphAtlas::m_image, which outlives this
+    QVector<QRect> m_pending;
+    QRhiTexture *m_texture = nullptr;
+    bool m_singleChannel = true;
+};
+
+// ── Registry ──
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::get(QQuickWindow *window, const QFont &font)
+{
+    static QMutex mutex;
+    static QHash<QString, std::weak_ptr<GlyphAtlas>> atlases;
+
+    // Size-independent: only what changes the glyph shapes
+    const QString key = QStringLiteral("%1|%2|%3|%4")
+        .arg(quintptr(window)).arg(font.family()).arg(int(font.weight())).arg(int(font.italic()));
+
+    QMutexLocker locker(&mutex);
+    std::shared_ptr<GlyphAtlas> atlas = atlases.value(key).lock();
+    if (!atlas) {
+        atlas.reset(new GlyphAtlas(font));
+        atlases.insert(key, atlas);
+    }
+    return atlas;
+}
+
+GlyphAtlas::GlyphAtlas(const QFont &font)
+    : m_font(font),
+      m_image(kAtlasSize, kAtlasSize, QImage::Format_Alpha8), m_cursor(1, 1)
+{
+    m_font.setPixelSize(BaseSize * kSupersample);
+    m_font.setStyleStrategy(QFont::PreferAntialias);
+    m_image.fill(0);
+    addGlyphs(kInitialChars);
+
+    m_texture = new GlyphAtlasTexture(m_image);
+    m_texture->setFiltering(QSGTexture::Linear);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    delete m_texture;
+}
+
+bool GlyphAtlas::ensure(const QString &chars)
+{
+    for (QChar ch : chars) {
+        if (ch.isSpace() || m_glyphs.contains(ch) || m_missing.contains(ch)) continue;
+        addGlyph(ch);
+    }
+    return m_texture->hasPendingUploads();
+}
+
+QSGTexture *GlyphAtlas::texture() const
+{
+    return m_texture;
+}
+
+const GlyphAtlas::Glyph *GlyphAtlas::glyph(QChar ch) const
+{
+    auto it = m_glyphs.constFind(ch);
+    return it == m_glyphs.constEnd() ? nullptr : &it.value();
+}
+
+bool GlyphAtlas::addGlyphs(const QString &chars)
+{
+    bool added = false;
+    for (QChar ch : chars) {
+        added |= addGlyph(ch);
+    }
+    return added;
+}
+
+bool GlyphAtlas::addGlyph(QChar ch)
+{
+    // Cell in base-size pixels around the glyph's ink, relative to the pen on the baseline
+    const QRectF bounds = QFontMetricsF(m_font).boundingRect(ch);
+    const int left = qFloor(bounds.left() / kSupersample) - Spread;
+    const int top = qFloor(bounds.top() / kSupersample) - Spread;
+    const int right = qCeil(bounds.right() / kSupersample) + Spread;
+    const int bottom = qCeil(bounds.bottom() / kSupersample) + Spread;
+    const QRect rect(left, top, right - left, bottom - top);
+
+    // Shelf packing, one texel apart so linear filtering never bleeds
+    if (m_cursor.x() + rect.width() + 1 > kAtlasSize) {
+        m_cursor = QPoint(1, m_cursor.y() + m_shelfHeight + 1);
+        m_shelfHeight = 0;
+    }
+    if (m_cursor.y() + rect.height() + 1 > kAtlasSize) {
+        qWarning() << "Glyph atlas full, cannot add" << ch << "for" << m_font.family();
+        m_missing.append(ch);
+        return false;
+    }
+    const QPoint position = m_cursor;
+    m_cursor.rx() += rect.width() + 1;
+    m_shelfHeight = qMax(m_shelfHeight, rect.height());
+
+    QImage coverage(rect.size() * kSupersample, QImage::Format_Alpha8);
+    coverage.fill(0);
+    QPainter painter(&coverage);
+    painter.setFont(m_font);
+    painter.setPen(Qt::white);
+    painter.drawText(QPointF(-left * kSupersample, -top * kSupersample), QString(ch));
+    painter.end();
+
+    const QImage field = distanceField(coverage, rect.size());
+    for (int row = 0; row < rect.height(); ++row) {
+        memcpy(m_image.scanLine(position.y() + row) + position.x(), field.constScanLine(row), rect.width());
+    }
+    if (m_texture) m_texture->markDirty(QRect(position, rect.size()));
+
+    Glyph glyph;
+    glyph.uv = QRectF(qreal(position.x()) / kAtlasSize, qreal(position.y()) / kAtlasSize,
+                      qreal(rect.width()) / kAtlasSize, qreal(rect.height()) / kAtlasSize);
+    glyph.quad = rect;
+    m_glyphs.insert(ch, glyph);
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QRectF>
+#include <QString>
+#include <memory>
+
+class GlyphAtlasTexture;
+class QQuickWindow;
+class QSGTexture;
+
+// Distance-field glyphs for native text items, shared per window and font
+// family/weight. Each glyph is rasterized once at a fixed base size and stored
+// as a signed distance field, so readouts of any pixel size draw from the same
+// texture and a value change only rewrites quad positions and UVs - no text
+// layout, no glyph upload. Glyphs are appended, never moved, into one
+// single-channel texture that lives as long as the atlas: a new glyph uploads
+// only its own cell, and the texture every readout's batch is bound to stays
+// valid, as do their UVs.
+// Render thread only (updatePaintNode); the registry itself is locked because
+// each window may have its own render thread.
+class GlyphAtlas
+{
+public:
+    static const int BaseSize = 48;     // Pixel size the fields are generated at
+    static const int Spread = 6;        // Distance range, base-size pixels each side of the edge
+
+    struct Glyph {
+        QRectF uv;          // Normalized texture coordinates
+        QRectF quad;        // Relative to the pen position on the baseline, base-size pixels
+    };
+
+    static std::shared_ptr<GlyphAtlas> get(QQuickWindow *window, const QFont &font);
+
+    ~GlyphAtlas();
+
+    // Adds missing characters; returns true if cells are waiting to be uploaded,
+    // which happens when a material using the atlas next commits the texture
+    bool ensure(const QString &chars);
+    const Glyph *glyph(QChar ch) const;     // nullptr for spaces and glyphs that did not fit
+
+    QSGTexture *texture() const;
+
+private:
+    explicit GlyphAtlas(const QFont &font);
+
+    bool addGlyphs(const QString &chars);
+    bool addGlyph(QChar ch);
+
+    QFont m_font;               // At BaseSize x the supersampling factor
+    QImage m_image;             // Alpha8 CPU copy; new glyphs are packed into the free space
+    QPoint m_cursor;
+    int m_shelfHeight = 0;
+    QHash<QChar, Glyph> m_glyphs;
+    QString m_missing;          // Attempted and did not fit; not retried
+    GlyphAtlasTexture *m_texture = nullptr;
+};
+
+#endif // GLYPHATLAS_H
@@ -0,0 +1,119 @@
+#include "iconatlasprovider.h"
+#include "iconatlas_index.h"
+#include <QDebug>
+#include <QHash>
+#include <QMutex>
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <memory>
+
+// Decoded once, shared by every window
+static const QImage &atlasImage()
+{
+    static const QImage image = [] {
+        QImage decoded(QString::fromLatin1(kIconAtlasPath));
+        if (decoded.isNull()) qWarning() << "Icon atlas missing:" << kIconAtlasPath;
+        return decoded.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    }();
+    return image;
+}
+
+static const IconAtlasEntry *findEntry(const QString &name)
+{
+    static const QHash<QString, const IconAtlasEntry *> lookup = [] {
+        QHash<QString, const IconAtlasEntry *> table;
+        for (const IconAtlasEntry &entry : kIconAtlasEntries) {
+            table.insert(QString::fromLatin1(entry.name), &entry);
+        }
+        return table;
+    }();
+    return lookup.value(name);
+}
+
+// One uploaded atlas per window; icon textures hold a reference
+static std::shared_ptr<QSGTexture> windowAtlas(QQuickWindow *window)
+{
+    static QMutex mutex;
+    static QHash<QQuickWindow *, std::weak_ptr<QSGTexture>> textures;
+
+    QMutexLocker locker(&mutex);
+    std::shared_ptr<QSGTexture> texture = textures.value(window).lock();
+    if (!texture) {
+        texture.reset(window->createTextureFromImage(atlasImage()));
+        texture->setFiltering(QSGTexture::Linear);
+        textures.insert(window, texture);
+    }
+    return texture;
+}
+
+// A sub-rectangle of the window's atlas. Comparing equal to its siblings is
+// what lets the batch renderer merge icons into one draw call.
+class IconTexture : public QSGTexture
+{
+public:
+    IconTexture(const std::shared_ptr<QSGTexture> &atlas, const QRect &rect)
+        : m_atlas(atlas), m_rect(rect) {}
+
+    qint64 comparisonKey() const override { return m_atlas->comparisonKey(); }
+    QRhiTexture *rhiTexture() const override { return m_atlas->rhiTexture(); }
+    QSize textureSize() const override { return m_rect.size(); }
+    bool hasAlphaChannel() const override { return true; }
+    bool hasMipmaps() const override { return false; }
+
+    QRectF normalizedTextureSubRect() const override
+    {
+        const QSizeF size = m_atlas->textureSize();
+        return QRectF(m_rect.x() / size.width(), m_rect.y() / size.height(),
+                      m_rect.width() / size.width(), m_rect.height() / size.height());
+    }
+
+    void commitTextureOperations(QRhi *rhi, QRhiResourceUpdateBatch *resourceUpdates) override
+    {
+        // The first icon drawn uploads the whole atlas; the rest find it done
+        m_atlas->setFiltering(filtering());
+        m_atlas->commitTextureOperations(rhi, resourceUpdates);
+    }
+
+private:
+    std::shared_ptr<QSGTexture> m_atlas;
+    QRect m_rect;
+};
+
+class IconTextureFactory : public QQuickTextureFactory
+{
+public:
+    explicit IconTextureFactory(const QRect &rect) : m_rect(rect) {}
+
+    QSGTexture *createTexture(QQuickWindow *window) const override
+    {
+        return new IconTexture(windowAtlas(window), m_rect);
+    }
+
+    QSize textureSize() const override { return m_rect.size(); }
+    int textureByteCount() const override { return m_rect.width() * m_rect.height() * 4; }
+
+    // Software backend and grabs
+    QImage image() const override { return atlasImage().copy(m_rect); }
+
+private:
+    QRect m_rect;
+};
+
+IconAtlasProvider::IconAtlasProvider()
+    : QQuickImageProvider(QQuickImageProvider::Texture)
+{
+}
+
+QQuickTextureFactory *IconAtlasProvider::requestTexture(const QString &id, QSize *size, const QSize &)
+{
+    // Rasterized at build time for the target scale; the item scales the quad
+    const IconAtlasEntry *entry = findEntry(id);
+    if (!entry) {
+        qWarning() << "Unknown icon" << id;
+        return nullptr;
+    }
+
+    const QRect rect(entry->x, entry->y, entry->width, entry->height);
+    if (size) *size = rect.size();
+    return new IconTextureFactory(rect);
+}
@@ -0,0 +1,20 @@
+#ifndef ICONATLASPROVIDER_H
+#define ICONATLASPROVIDER_H
+
+#include <QQuickImageProvider>
+
+// "image://icons/<name>": telltales and map markers from the build-time icon
+// atlas (tools/iconatlas.cpp, assets/icons/*.svg).
+// The atlas PNG is decoded once, on first use. Every icon is a sub-rectangle
+// of one texture per window that reports the same comparison key, so the
+// renderer can merge the icons on screen into one draw call; no SVG is parsed
+// and no emoji font fallback is resolved at runtime.
+class IconAtlasProvider : public QQuickImageProvider
+{
+public:
+    IconAtlasProvider();
+
+    QQuickTextureFactory *requestTexture(const QString &id, QSize *size, const QSize &requestedSize) override;
+};
+
+#endif // ICONATLASPROVIDER_H
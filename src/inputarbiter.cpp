@@ -0,0 +1,266 @@
+#include "inputarbiter.h"
+#include "evvehicledata.h"
+#include "signaldecimator.h"
+#include "signaljitterbuffer.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QtAlgorithms>
+
+// A source with no samples at all for this long is reported inactive
+static const int kSourceIdleMs = 1000;
+static const int kDefaultFreshnessMs = 500;
+static const int kSourceCheckIntervalMs = 250;
+
+static_assert(VehicleSignals::count() <= 64, "m_pendingMask has one bit per signal");
+
+InputArbiter::InputArbiter(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData),
+      m_watchdog(VehicleSignals::count())
+{
+    // Default priority follows the InputSource order: CAN > GNSS > Replay > Simulation
+    for (SignalState &state : m_signals) {
+        state.lastSeenMs.fill(kNever);
+        for (int source = 0; source < kSourceCount; ++source) {
+            state.rank[source] = quint8(source);
+        }
+        state.timeoutMs = kDefaultFreshnessMs;
+    }
+    m_sourceLastSeenMs.fill(kNever);
+    m_sourceActive.fill(false);
+    m_sourceTimeMs.fill(0);
+
+    // Slow-moving signals get longer deadlines
+    setFreshnessTimeout(VehicleSignal::GpsLatitude, 2000);
+    setFreshnessTimeout(VehicleSignal::GpsLongitude, 2000);
+    setFreshnessTimeout(VehicleSignal::Heading, 2000);
+
+    // Indicators frozen "on" are worse than dark ones
+    setStalePolicy(VehicleSignal::LeftTurnSignal, ResetValue, false);
+    setStalePolicy(VehicleSignal::RightTurnSignal, ResetValue, false);
+
+    connect(&m_watchdog, &SignalWatchdog::timedOut, this, &InputArbiter::onTimedOut);
+    connect(&m_watchdog, &SignalWatchdog::recovered, this, &InputArbiter::stalenessChanged);
+
+    m_clock.start();
+    m_sourceTimer.setInterval(kSourceCheckIntervalMs);
+    connect(&m_sourceTimer, &QTimer::timeout, this, &InputArbiter::checkSources);
+    m_sourceTimer.start();
+
+    m_flushTimer.setSingleShot(true);
+    connect(&m_flushTimer, &QTimer::timeout, this, &InputArbiter::flushPending);
+}
+
+bool InputArbiter::isSourceActive(InputSource source) const
+{
+    const int index = static_cast<int>(source);
+    return index >= 0 && index < kSourceCount && m_sourceActive[index];
+}
+
+void InputArbiter::setPriority(VehicleSignal signal, const QList<InputSource> &order)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+
+    SignalState &state = m_signals[index];
+    state.rank.fill(kIgnored);
+    for (int i = 0; i < order.size() && i < kSourceCount; ++i) {
+        state.rank[static_cast<int>(order[i])] = quint8(i);
+    }
+
+    // Re-arbitrate on the next sample if the owner was dropped
+    if (state.owner >= 0 && state.rank[state.owner] == kIgnored) {
+        state.owner = -1;
+    }
+}
+
+void InputArbiter::setFreshnessTimeout(VehicleSignal signal, int timeoutMs)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+    m_signals[index].timeoutMs = qMax(1, timeoutMs);
+    m_watchdog.setTimeout(index, timeoutMs);
+}
+
+void InputArbiter::setDefaultFreshnessTimeout(int timeoutMs)
+{
+    for (int index = 0; index < VehicleSignals::count(); ++index) {
+        m_signals[index].timeoutMs = qMax(1, timeoutMs);
+        m_watchdog.setTimeout(index, timeoutMs);
+    }
+}
+
+void InputArbiter::setStalePolicy(VehicleSignal signal, StalePolicy policy, const QVariant &fallback)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+    m_signals[index].stalePolicy = policy;
+    m_signals[index].fallback = fallback;
+}
+
+QStringList InputArbiter::staleSignals() const
+{
+    QStringList names;
+    for (int signal = 0; signal < VehicleSignals::count(); ++signal) {
+        if (m_watchdog.isStale(signal)) {
+            names.append(QString::fromLatin1(VehicleSignals::name(static_cast<VehicleSignal>(signal))));
+        }
+    }
+    return names;
+}
+
+bool InputArbiter::isSignalStale(int signal) const
+{
+    return m_watchdog.isStale(signal);
+}
+
+int InputArbiter::signalTimeoutCount(int signal) const
+{
+    return m_watchdog.timeoutCount(signal);
+}
+
+int InputArbiter::activeSource(int signal) const
+{
+    if (signal < 0 || signal >= VehicleSignals::count()) return -1;
+    return m_signals[signal].owner;
+}
+
+QString InputArbiter::activeSourceName(int signal) const
+{
+    const int source = activeSource(signal);
+    if (source < 0) return QString();
+    return QString::fromLatin1(VehicleSignals::sourceName(static_cast<InputSource>(source)));
+}
+
+qint64 InputArbiter::sourceTimeMs(int signal) const
+{
+    if (signal < 0 || signal >= VehicleSignals::count()) return 0;
+    return m_sourceTimeMs[signal];
+}
+
+bool InputArbiter::isFresh(const SignalState &state, int source, qint64 now) const
+{
+    const qint64 lastSeen = state.lastSeenMs[source];
+    return lastSeen != kNever && now - lastSeen <= state.timeoutMs;
+}
+
+void InputArbiter::submit(const SignalSample &sample)
+{
+    const int index = static_cast<int>(sample.signal);
+    const int source = static_cast<int>(sample.source);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+    if (source < 0 || source >= kSourceCount) return;
+
+    SignalState &state = m_signals[index];
+    if (state.rank[source] == kIgnored) return;
+
+    const qint64 now = m_clock.elapsed();
+    state.lastSeenMs[source] = now;
+    m_sourceLastSeenMs[source] = now;
+    if (!m_sourceActive[source]) {
+        m_sourceActive[source] = true;
+        qDebug() << "Input source active:" << VehicleSignals::sourceName(sample.source);
+        emit sourcesChanged();
+    }
+
+    if (state.owner != source) {
+        // Better-ranked sources win at once; worse ones only replace a silent owner
+        const bool takeOver = state.owner < 0
+            || state.rank[source] < state.rank[state.owner]
+            || !isFresh(state, state.owner, now);
+        if (!takeOver) return;
+
+        state.owner = source;
+        emit activeSourceChanged(index, source);
+    }
+
+    m_watchdog.touch(index);
+    apply(sample);
+}
+
+void InputArbiter::apply(const SignalSample &sample)
+{
+    // Subscribers run their own rates; only the property path is coalesced
+    const double value = sample.value.toDouble();
+    // Sources without a clock are stamped on arrival, as the jitter buffer does
+    m_sourceTimeMs[static_cast<int>(sample.signal)] = sample.timestampMs > 0
+        ? sample.timestampMs : QDateTime::currentMSecsSinceEpoch();
+    if (m_decimator) m_decimator->push(sample.signal, value);
+    if (m_jitterBuffer) m_jitterBuffer->push(sample.signal, sample.timestampMs, value);
+
+    if (m_coalesceMs <= 0 || VehicleSignals::isDiscrete(sample.signal)) {
+        m_vehicleData->applySample(sample);
+        return;
+    }
+
+    const int index = static_cast<int>(sample.signal);
+    m_pending[index] = sample;
+    m_pendingMask |= quint64(1) << index;
+    if (!m_flushTimer.isActive()) m_flushTimer.start(m_coalesceMs);
+}
+
+void InputArbiter::setCoalesceInterval(int intervalMs)
+{
+    intervalMs = qMax(0, intervalMs);
+    if (m_coalesceMs == intervalMs) return;
+    m_coalesceMs = intervalMs;
+
+    // Leaving coalescing (e.g. the vehicle starts moving) must not wait out the old interval
+    if (m_coalesceMs == 0) flushPending();
+}
+
+void InputArbiter::flushPending()
+{
+    m_flushTimer.stop();
+    for (quint64 mask = m_pendingMask; mask; mask &= mask - 1) {
+        const int index = qCountTrailingZeroBits(mask);
+        m_vehicleData->applySample(m_pending[index]);
+    }
+    m_pendingMask = 0;
+}
+
+void InputArbiter::submitBatch(const QList<SignalSample> &samples)
+{
+    for (const SignalSample &sample : samples) {
+        submit(sample);
+    }
+}
+
+void InputArbiter::checkSources()
+{
+    const qint64 now = m_clock.elapsed();
+
+    bool sourcesDirty = false;
+    for (int source = 0; source < kSourceCount; ++source) {
+        const bool active = m_sourceLastSeenMs[source] != kNever
+            && now - m_sourceLastSeenMs[source] <= kSourceIdleMs;
+        if (active != m_sourceActive[source]) {
+            m_sourceActive[source] = active;
+            qDebug() << "Input source" << (active ? "active:" : "idle:")
+                     << VehicleSignals::sourceName(static_cast<InputSource>(source));
+            sourcesDirty = true;
+        }
+    }
+
+    if (sourcesDirty) emit sourcesChanged();
+}
+
+void InputArbiter::onTimedOut(const QVector<int> &signalIds)
+{
+    QStringList names;
+    for (int index : signalIds) {
+        const SignalState &state = m_signals[index];
+        const VehicleSignal signal = static_cast<VehicleSignal>(index);
+        names.append(QString::fromLatin1(VehicleSignals::name(signal)));
+
+        if (state.stalePolicy == ResetValue) {
+            SignalSample sample;
+            sample.signal = signal;
+            sample.source = static_cast<InputSource>(state.owner);
+            sample.value = state.fallback;
+            apply(sample);
+        }
+    }
+
+    qWarning() << "Signals timed out:" << names.join(", ");
+    emit stalenessChanged();
+}
@@ -0,0 +1,132 @@
+#ifndef INPUTARBITER_H
+#define INPUTARBITER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QList>
+#include <QStringList>
+#include <QTimer>
+#include <array>
+#include "signalsample.h"
+#include "signalwatchdog.h"
+
+class EVVehicleData;
+class SignalDecimator;
+class SignalJitterBuffer;
+
+// Decides, per signal, which input source feeds EVVehicleData.
+// Each signal has a source priority and a freshness timeout. The best-ranked
+// source that is still fresh owns the signal; a lower-ranked source only takes
+// over once the owner has been silent for longer than the timeout, and the
+// owner takes the signal back with its next sample. Samples from non-owners
+// are dropped, so two live sources never alternate on the same property.
+// Signals that nobody updates within their deadline are flagged stale by a
+// SignalWatchdog and, depending on their StalePolicy, reset to a fallback.
+class InputArbiter : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool canActive READ canActive NOTIFY sourcesChanged)
+    Q_PROPERTY(bool simulationActive READ simulationActive NOTIFY sourcesChanged)
+    Q_PROPERTY(bool replayActive READ replayActive NOTIFY sourcesChanged)
+    Q_PROPERTY(int staleCount READ staleCount NOTIFY stalenessChanged)
+    Q_PROPERTY(QStringList staleSignals READ staleSignals NOTIFY stalenessChanged)
+    Q_PROPERTY(bool speedStale READ speedStale NOTIFY stalenessChanged)
+    Q_PROPERTY(bool powerStale READ powerStale NOTIFY stalenessChanged)
+    Q_PROPERTY(int timeoutCount READ timeoutCount NOTIFY stalenessChanged)
+
+public:
+    enum StalePolicy {
+        HoldValue,      // Keep the last value, only flag it
+        ResetValue      // Apply the fallback value once the signal times out
+    };
+
+    explicit InputArbiter(EVVehicleData *vehicleData, QObject *parent = nullptr);
+
+    bool canActive() const { return isSourceActive(InputSource::Can); }
+    bool simulationActive() const { return isSourceActive(InputSource::Simulation); }
+    bool replayActive() const { return isSourceActive(InputSource::Replay); }
+    int staleCount() const { return m_watchdog.staleCount(); }
+    QStringList staleSignals() const;   // EVVehicleData property names, built per read
+    // Cheap per-signal flags for bindings on the gauges that show `--`
+    bool speedStale() const { return isSignalStale(int(VehicleSignal::Speed)); }
+    bool powerStale() const { return isSignalStale(int(VehicleSignal::PowerOutput)); }
+    int timeoutCount() const { return m_watchdog.timeoutCount(); }
+
+    bool isSourceActive(InputSource source) const;
+
+    // Highest priority first. Sources left out are ignored for this signal.
+    void setPriority(VehicleSignal signal, const QList<InputSource> &order);
+    void setFreshnessTimeout(VehicleSignal signal, int timeoutMs);
+    void setDefaultFreshnessTimeout(int timeoutMs);
+    void setStalePolicy(VehicleSignal signal, StalePolicy policy, const QVariant &fallback = QVariant());
+
+    // Applied values are also pushed here for rate-limited subscribers
+    void setDecimator(SignalDecimator *decimator) { m_decimator = decimator; }
+
+    // ...and, with their source timestamps, here for frame-accurate gauges
+    void setJitterBuffer(SignalJitterBuffer *buffer) { m_jitterBuffer = buffer; }
+
+    // Hold continuous values and hand only the latest of each to EVVehicleData
+    // every intervalMs (0 = apply at once). Discrete flags always pass
+    // straight through, so telltales never wait for the next flush.
+    void setCoalesceInterval(int intervalMs);
+    int coalesceInterval() const { return m_coalesceMs; }
+
+    // QML helpers; signal/source are VehicleSignal/InputSource values
+    Q_INVOKABLE bool isSignalStale(int signal) const;
+    Q_INVOKABLE int activeSource(int signal) const;   // -1 if never received
+    Q_INVOKABLE QString activeSourceName(int signal) const;
+    Q_INVOKABLE int signalTimeoutCount(int signal) const;
+
+    // Source time (ms since epoch) of the last applied sample, 0 if none
+    qint64 sourceTimeMs(int signal) const;
+
+public slots:
+    void submit(const SignalSample &sample);
+    void submitBatch(const QList<SignalSample> &samples);
+
+signals:
+    void sourcesChanged();
+    void stalenessChanged();
+    void activeSourceChanged(int signal, int source);
+
+private slots:
+    void checkSources();
+    void onTimedOut(const QVector<int> &signalIds);
+    void flushPending();
+
+private:
+    static constexpr int kSourceCount = static_cast<int>(InputSource::Count);
+    static constexpr quint8 kIgnored = 0xFF;
+    static constexpr qint64 kNever = -1;
+
+    struct SignalState {
+        std::array<qint64, kSourceCount> lastSeenMs;   // Arrival time per source
+        std::array<quint8, kSourceCount> rank;         // 0 = highest, kIgnored = dropped
+        int timeoutMs = 0;
+        int owner = -1;                                // Source index, -1 = none yet
+        StalePolicy stalePolicy = HoldValue;
+        QVariant fallback;
+    };
+
+    bool isFresh(const SignalState &state, int source, qint64 now) const;
+    void apply(const SignalSample &sample);
+
+    EVVehicleData *m_vehicleData;
+    SignalDecimator *m_decimator = nullptr;
+    SignalJitterBuffer *m_jitterBuffer = nullptr;
+    QElapsedTimer m_clock;             // Monotonic; sources' own clocks are not trusted
+    QTimer m_sourceTimer;
+    SignalWatchdog m_watchdog;
+    std::array<SignalState, VehicleSignals::count()> m_signals;
+    std::array<qint64, VehicleSignals::count()> m_sourceTimeMs;
+    std::array<qint64, kSourceCount> m_sourceLastSeenMs;
+    std::array<bool, kSourceCount> m_sourceActive;
+
+    int m_coalesceMs = 0;
+    QTimer m_flushTimer;
+    std::array<SignalSample, VehicleSignals::count()> m_pending;
+    quint64 m_pendingMask = 0;
+};
+
+#endif // INPUTARBITER_H
@@ -0,0 +1,113 @@
+#include "interpolatedsignal.h"
+#include "signaldecimator.h"
+#include "signaljitterbuffer.h"
+#include <QQuickWindow>
+#include <QScreen>
+#include <QDebug>
+
+InterpolatedSignal::InterpolatedSignal(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    connect(SignalJitterBuffer::instance(), &SignalJitterBuffer::sampleAdded,
+            this, &InterpolatedSignal::onSampleAdded);
+}
+
+InterpolatedSignal::~InterpolatedSignal()
+{
+    if (m_signal != VehicleSignal::Count) SignalJitterBuffer::instance()->untrack(m_signal);
+}
+
+void InterpolatedSignal::setSignalName(const QString &signalName)
+{
+    if (m_signalName == signalName) return;
+    m_signalName = signalName;
+    emit signalNameChanged();
+    retrack();
+}
+
+void InterpolatedSignal::componentComplete()
+{
+    QQuickItem::componentComplete();
+    retrack();
+}
+
+void InterpolatedSignal::retrack()
+{
+    if (!isComponentComplete()) return;   // Track once with the final QML property values
+
+    SignalJitterBuffer *buffer = SignalJitterBuffer::instance();
+    if (m_signal != VehicleSignal::Count) {
+        buffer->untrack(m_signal);
+        m_signal = VehicleSignal::Count;
+    }
+    if (m_signalName.isEmpty()) return;
+
+    VehicleSignal signal;
+    if (!VehicleSignals::fromName(m_signalName, &signal)) {
+        qWarning() << "InterpolatedSignal: unknown signal" << m_signalName;
+        return;
+    }
+    m_signal = signal;
+    buffer->track(m_signal);
+
+    // Start from the last applied value until the buffer has history
+    double current = 0.0;
+    if (SignalDecimator::instance()->latest(m_signal, &current)) setValue(current);
+}
+
+void InterpolatedSignal::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    if (change == ItemSceneChange) {
+        disconnect(m_frameConnection);
+        if (value.window) {
+            // Once per frame on the GUI thread, before the scene is synchronized
+            m_frameConnection = connect(value.window, &QQuickWindow::afterAnimating,
+                                        this, &InterpolatedSignal::onAfterAnimating);
+        }
+    }
+    QQuickItem::itemChange(change, value);
+}
+
+void InterpolatedSignal::onSampleAdded(int signal, double value)
+{
+    if (signal != static_cast<int>(m_signal)) return;
+
+    // A repeat of what is shown needs no frame - keeps a parked cluster idle
+    if (!m_moving && qFuzzyCompare(value + 1.0, m_value + 1.0)) return;
+    requestFrame();
+}
+
+void InterpolatedSignal::onAfterAnimating()
+{
+    if (m_signal == VehicleSignal::Count) return;
+
+    const SignalJitterBuffer *buffer = SignalJitterBuffer::instance();
+    if (!buffer->hasSamples(m_signal)) return;
+
+    // This frame reaches the screen about one refresh interval from now
+    const QScreen *screen = window() ? window()->screen() : nullptr;
+    const qreal refreshRate = screen && screen->refreshRate() > 0 ? screen->refreshRate() : 60.0;
+    const qint64 presentMs = buffer->nowMs() + qRound64(1000.0 / refreshRate);
+
+    setValue(buffer->valueAt(m_signal, presentMs, &m_moving));
+
+    const int latency = buffer->playoutDelayMs(m_signal);
+    if (latency != m_latency) {
+        m_latency = latency;
+        emit latencyChanged();
+    }
+
+    if (m_moving) requestFrame();
+}
+
+void InterpolatedSignal::requestFrame()
+{
+    if (window() && isVisible()) window()->update();
+}
+
+void InterpolatedSignal::setValue(double value)
+{
+    if (m_value == value) return;
+    m_value = value;
+    emit valueChanged();
+}
@@ -0,0 +1,59 @@
+#ifndef INTERPOLATEDSIGNAL_H
+#define INTERPOLATEDSIGNAL_H
+
+#include <QQuickItem>
+#include <QMetaObject>
+#include "signalsample.h"
+
+// QML consumer of the jitter buffer:
+//     InterpolatedSignal { id: speedTrack; signalName: "speed" }
+//     Needle { angle: speedTrack.value * 1.8 }
+// value is re-evaluated once per frame for the frame's presentation time and
+// only keeps the window rendering while it is actually moving. latency is the
+// current playout delay in ms (bounded by SignalJitterBuffer::MaxLatencyMs).
+// An Item only to follow its window's frames; it draws nothing.
+class InterpolatedSignal : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QString signalName READ signalName WRITE setSignalName NOTIFY signalNameChanged)
+    Q_PROPERTY(double value READ value NOTIFY valueChanged)
+    Q_PROPERTY(int latency READ latency NOTIFY latencyChanged)
+
+public:
+    explicit InterpolatedSignal(QQuickItem *parent = nullptr);
+    ~InterpolatedSignal();
+
+    QString signalName() const { return m_signalName; }
+    double value() const { return m_value; }
+    int latency() const { return m_latency; }
+
+    void setSignalName(const QString &signalName);
+
+    void componentComplete() override;
+
+signals:
+    void signalNameChanged();
+    void valueChanged();
+    void latencyChanged();
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private slots:
+    void onSampleAdded(int signal, double value);
+    void onAfterAnimating();
+
+private:
+    void retrack();
+    void requestFrame();
+    void setValue(double value);
+
+    QString m_signalName;
+    VehicleSignal m_signal = VehicleSignal::Count;
+    double m_value = 0.0;
+    int m_latency = 0;
+    bool m_moving = false;
+    QMetaObject::Connection m_frameConnection;
+};
+
+#endif // INTERPOLATEDSIGNAL_H
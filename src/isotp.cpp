@@ -0,0 +1,325 @@
+#include "isotp.h"
+#include "caninterface.h"
+#include <QCanBusFrame>
+#include <QDebug>
+
+// ISO 15765-2 protocol control information (upper nibble of byte 0)
+static const quint8 kSingleFrame = 0x0;
+static const quint8 kFirstFrame = 0x1;
+static const quint8 kConsecutiveFrame = 0x2;
+static const quint8 kFlowControl = 0x3;
+
+// Flow status
+static const quint8 kContinueToSend = 0x0;
+static const quint8 kWait = 0x1;
+static const quint8 kOverflow = 0x2;
+
+static const int kFrameSize = 8;
+static const char kPadding = char(0xCC);
+static const int kTimeoutMs = 1000;      // N_Bs and N_Cr
+static const int kMaxWaitFrames = 10;    // FC WAIT frames accepted in a row
+
+static quint32 channelKey(quint32 rxId, bool extendedIds)
+{
+    return rxId | (extendedIds ? 0x80000000u : 0u);
+}
+
+static int decodeStMin(quint8 stMin)
+{
+    // 0x00-0x7F: milliseconds; 0xF1-0xF9: 100-900 us, rounded up to the timer's 1 ms
+    if (stMin <= 0x7F) return stMin;
+    if (stMin >= 0xF1 && stMin <= 0xF9) return 1;
+    return 0x7F;   // Reserved values: use the maximum
+}
+
+// ---------------------------------------------------------------------------
+
+IsoTpBufferPool::IsoTpBufferPool(int preallocate)
+{
+    m_free.reserve(preallocate);
+    for (int i = 0; i < preallocate; ++i) {
+        QByteArray buffer;
+        buffer.reserve(MaxMessageSize);
+        m_free.append(buffer);
+    }
+}
+
+QByteArray IsoTpBufferPool::acquire()
+{
+    if (m_free.isEmpty()) {
+        QByteArray buffer;
+        buffer.reserve(MaxMessageSize);
+        return buffer;
+    }
+    return m_free.takeLast();
+}
+
+void IsoTpBufferPool::release(QByteArray &buffer)
+{
+    if (buffer.capacity() == 0) return;   // Never acquired
+
+    // A copy still held by a receiver makes this detach; restore the reservation
+    buffer.resize(0);
+    if (buffer.capacity() < MaxMessageSize) buffer.reserve(MaxMessageSize);
+    m_free.append(std::move(buffer));
+    buffer = QByteArray();
+}
+
+// ---------------------------------------------------------------------------
+
+IsoTpChannel::IsoTpChannel(const IsoTpAddress &address, CANInterface *can, IsoTpBufferPool *pool,
+                           QObject *parent)
+    : QObject(parent), m_address(address), m_can(can), m_pool(pool)
+{
+    m_txPacing.setSingleShot(true);
+    m_txPacing.setTimerType(Qt::PreciseTimer);
+    connect(&m_txPacing, &QTimer::timeout, this, &IsoTpChannel::sendConsecutiveFrames);
+
+    m_txTimeout.setSingleShot(true);
+    m_txTimeout.setInterval(kTimeoutMs);
+    connect(&m_txTimeout, &QTimer::timeout, this, &IsoTpChannel::onTxTimeout);
+
+    m_rxTimeout.setSingleShot(true);
+    m_rxTimeout.setInterval(kTimeoutMs);
+    connect(&m_rxTimeout, &QTimer::timeout, this, &IsoTpChannel::onRxTimeout);
+}
+
+void IsoTpChannel::setReceiveFlowControl(quint8 blockSize, quint8 stMin)
+{
+    m_rxBlockSize = blockSize;
+    m_rxStMin = stMin;
+}
+
+void IsoTpChannel::writeFrame(const QByteArray &data)
+{
+    QByteArray payload = data;
+    if (payload.size() < kFrameSize) {
+        payload.append(kFrameSize - payload.size(), kPadding);
+    }
+
+    QCanBusFrame frame(m_address.txId, payload);
+    frame.setExtendedFrameFormat(m_address.extendedIds);
+    m_can->writeFrame(frame);
+}
+
+bool IsoTpChannel::send(const QByteArray &payload)
+{
+    // Refusals are only returned: a caller reacting to errorOccurred would
+    // otherwise see the same failure twice
+    if (m_txState != TxIdle) return false;
+    if (payload.isEmpty() || payload.size() > IsoTpBufferPool::MaxMessageSize) return false;
+
+    if (payload.size() <= kFrameSize - 1) {
+        QByteArray frame;
+        frame.append(char((kSingleFrame << 4) | payload.size()));
+        frame.append(payload);
+        writeFrame(frame);
+        emit sendComplete();
+        return true;
+    }
+
+    // First frame carries the 12-bit length and 6 data bytes, then wait for FC
+    m_txData = payload;
+    m_txOffset = 6;
+    m_txSequence = 1;
+
+    QByteArray frame;
+    frame.append(char((kFirstFrame << 4) | ((payload.size() >> 8) & 0x0F)));
+    frame.append(char(payload.size() & 0xFF));
+    frame.append(payload.left(6));
+    writeFrame(frame);
+
+    m_txState = TxWaitFlowControl;
+    m_txWaitCount = 0;
+    m_txTimeout.start();
+    return true;
+}
+
+void IsoTpChannel::sendConsecutiveFrames()
+{
+    if (m_txState != TxSending) return;
+
+    // Without a separation time the whole block goes out in one pass
+    do {
+        const int chunk = qMin(kFrameSize - 1, int(m_txData.size()) - m_txOffset);
+        QByteArray frame;
+        frame.append(char((kConsecutiveFrame << 4) | m_txSequence));
+        frame.append(m_txData.constData() + m_txOffset, chunk);
+        writeFrame(frame);
+
+        m_txOffset += chunk;
+        m_txSequence = (m_txSequence + 1) & 0x0F;
+
+        if (m_txOffset >= m_txData.size()) {
+            m_txState = TxIdle;
+            m_txData.clear();
+            emit sendComplete();
+            return;
+        }
+
+        if (m_txBlockSize > 0 && --m_txBlockRemaining == 0) {
+            m_txState = TxWaitFlowControl;
+            m_txTimeout.start();
+            return;
+        }
+    } while (m_txStMinMs == 0);
+
+    m_txPacing.start(m_txStMinMs);
+}
+
+void IsoTpChannel::sendFlowControl(quint8 status)
+{
+    QByteArray frame;
+    frame.append(char((kFlowControl << 4) | status));
+    frame.append(char(m_rxBlockSize));
+    frame.append(char(m_rxStMin));
+    writeFrame(frame);
+}
+
+void IsoTpChannel::handleFrame(const QByteArray &data)
+{
+    if (data.isEmpty()) return;
+
+    const quint8 pci = quint8(data[0]) >> 4;
+    const quint8 low = quint8(data[0]) & 0x0F;
+
+    switch (pci) {
+    case kSingleFrame: {
+        if (low == 0 || low > data.size() - 1) return;   // CAN FD escape or malformed
+        if (m_receiving) abortRx();                     // A new message supersedes
+        emit messageReceived(data.mid(1, low));
+        break;
+    }
+    case kFirstFrame: {
+        if (data.size() < kFrameSize) return;
+        const int length = (low << 8) | quint8(data[1]);
+        if (length < kFrameSize) return;                // 0 = 32-bit length (FD only)
+
+        if (m_receiving) abortRx();
+        m_rxBuffer = m_pool->acquire();
+        m_rxBuffer.append(data.constData() + 2, 6);
+        m_rxExpected = length;
+        m_rxSequence = 1;
+        m_rxBlockCount = 0;
+        m_receiving = true;
+
+        emit receptionStarted(length);
+        sendFlowControl(kContinueToSend);
+        m_rxTimeout.start();
+        break;
+    }
+    case kConsecutiveFrame: {
+        if (!m_receiving) return;
+        if (low != m_rxSequence) {
+            qWarning() << "ISO-TP sequence error on" << Qt::hex << m_address.rxId
+                       << "expected" << int(m_rxSequence) << "got" << int(low);
+            abortRx();
+            emit errorOccurred(WrongSequence);
+            return;
+        }
+
+        const int chunk = qMin(int(data.size()) - 1, m_rxExpected - int(m_rxBuffer.size()));
+        m_rxBuffer.append(data.constData() + 1, chunk);
+        m_rxSequence = (m_rxSequence + 1) & 0x0F;
+
+        if (m_rxBuffer.size() >= m_rxExpected) {
+            m_rxTimeout.stop();
+            m_receiving = false;
+            emit messageReceived(m_rxBuffer);
+            m_pool->release(m_rxBuffer);
+            return;
+        }
+
+        if (m_rxBlockSize > 0 && ++m_rxBlockCount == m_rxBlockSize) {
+            m_rxBlockCount = 0;
+            sendFlowControl(kContinueToSend);
+        }
+        m_rxTimeout.start();
+        break;
+    }
+    case kFlowControl: {
+        if (m_txState != TxWaitFlowControl || data.size() < 3) return;
+
+        if (low == kContinueToSend) {
+            m_txTimeout.stop();
+            m_txBlockSize = quint8(data[1]);
+            m_txBlockRemaining = m_txBlockSize;
+            m_txStMinMs = decodeStMin(quint8(data[2]));
+            m_txState = TxSending;
+            sendConsecutiveFrames();
+        } else if (low == kWait) {
+            if (++m_txWaitCount > kMaxWaitFrames) {
+                abortTx();
+                emit errorOccurred(Timeout);
+                return;
+            }
+            m_txTimeout.start();
+        } else if (low == kOverflow) {
+            abortTx();
+            emit errorOccurred(Overflow);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void IsoTpChannel::abortTx()
+{
+    m_txPacing.stop();
+    m_txTimeout.stop();
+    m_txState = TxIdle;
+    m_txData.clear();
+}
+
+void IsoTpChannel::abortRx()
+{
+    m_rxTimeout.stop();
+    m_receiving = false;
+    m_pool->release(m_rxBuffer);
+}
+
+void IsoTpChannel::onTxTimeout()
+{
+    qWarning() << "ISO-TP flow control timeout on" << Qt::hex << m_address.txId;
+    abortTx();
+    emit errorOccurred(Timeout);
+}
+
+void IsoTpChannel::onRxTimeout()
+{
+    qWarning() << "ISO-TP consecutive frame timeout on" << Qt::hex << m_address.rxId;
+    abortRx();
+    emit errorOccurred(Timeout);
+}
+
+// ---------------------------------------------------------------------------
+
+IsoTpTransport::IsoTpTransport(CANInterface *can, QObject *parent)
+    : QObject(parent), m_can(can)
+{
+    connect(m_can, &CANInterface::frameReceived, this, &IsoTpTransport::onFrameReceived);
+}
+
+IsoTpChannel *IsoTpTransport::channel(const IsoTpAddress &address)
+{
+    const quint32 key = channelKey(address.rxId, address.extendedIds);
+    IsoTpChannel *existing = m_channels.value(key);
+    if (existing) return existing;
+
+    IsoTpChannel *created = new IsoTpChannel(address, m_can, &m_pool, this);
+    m_can->addReceiveId(address.rxId, address.extendedIds);
+    m_channels.insert(key, created);
+    return created;
+}
+
+void IsoTpTransport::onFrameReceived(const QCanBusFrame &frame)
+{
+    if (m_channels.isEmpty() || frame.frameType() != QCanBusFrame::DataFrame) return;
+
+    IsoTpChannel *target = m_channels.value(channelKey(frame.frameId(), frame.hasExtendedFrameFormat()));
+    if (target) {
+        target->handleFrame(frame.payload());
+    }
+}
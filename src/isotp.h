@@ -0,0 +1,132 @@
+#ifndef ISOTP_H
+#define ISOTP_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QTimer>
+#include <QVector>
+
+class CANInterface;
+class QCanBusFrame;
+
+// Normal (11/29-bit) addressing: we send on txId and listen on rxId
+struct IsoTpAddress {
+    quint32 txId = 0;
+    quint32 rxId = 0;
+    bool extendedIds = false;
+};
+
+// Reassembly buffers, reserved once at the ISO-TP maximum and recycled.
+// Released buffers are reused if nobody kept a copy; a retained copy simply
+// detaches (implicit sharing), so handing messages out stays safe.
+class IsoTpBufferPool
+{
+public:
+    static const int MaxMessageSize = 4095;
+
+    explicit IsoTpBufferPool(int preallocate = 4);
+
+    QByteArray acquire();
+    void release(QByteArray &buffer);
+
+private:
+    QVector<QByteArray> m_free;
+};
+
+// One ISO 15765-2 connection (classic CAN, 8-byte frames).
+// Sending and receiving are independent state machines driven by incoming
+// frames and timers; nothing blocks. One outgoing message at a time.
+class IsoTpChannel : public QObject
+{
+    Q_OBJECT
+public:
+    enum Error {
+        Timeout,            // N_Bs / N_Cr expired
+        WrongSequence,      // Consecutive frame out of order
+        Overflow            // Receiver reported buffer overflow
+    };
+    Q_ENUM(Error)
+
+    IsoTpChannel(const IsoTpAddress &address, CANInterface *can, IsoTpBufferPool *pool,
+                 QObject *parent = nullptr);
+
+    const IsoTpAddress &address() const { return m_address; }
+    bool isSending() const { return m_txState != TxIdle; }
+
+    // False, without errorOccurred, while a message is still going out or if
+    // the payload is empty or over MaxMessageSize. Errors after a true return
+    // arrive as errorOccurred.
+    bool send(const QByteArray &payload);
+
+    // Flow control we advertise when receiving (0 = no limit / no gap)
+    void setReceiveFlowControl(quint8 blockSize, quint8 stMin);
+
+    void handleFrame(const QByteArray &data);
+
+signals:
+    void messageReceived(const QByteArray &payload);
+    void receptionStarted(int length);
+    void sendComplete();
+    void errorOccurred(IsoTpChannel::Error error);
+
+private slots:
+    void sendConsecutiveFrames();
+    void onTxTimeout();
+    void onRxTimeout();
+
+private:
+    enum TxState { TxIdle, TxWaitFlowControl, TxSending };
+
+    void writeFrame(const QByteArray &data);
+    void sendFlowControl(quint8 status);
+    void abortTx();
+    void abortRx();
+
+    IsoTpAddress m_address;
+    CANInterface *m_can;
+    IsoTpBufferPool *m_pool;
+
+    // Transmit
+    TxState m_txState = TxIdle;
+    QByteArray m_txData;
+    int m_txOffset = 0;
+    quint8 m_txSequence = 0;
+    int m_txBlockSize = 0;
+    int m_txBlockRemaining = 0;
+    int m_txStMinMs = 0;
+    int m_txWaitCount = 0;
+    QTimer m_txPacing;
+    QTimer m_txTimeout;
+
+    // Receive
+    bool m_receiving = false;
+    QByteArray m_rxBuffer;
+    int m_rxExpected = 0;
+    quint8 m_rxSequence = 0;
+    int m_rxBlockCount = 0;
+    quint8 m_rxBlockSize = 0;
+    quint8 m_rxStMin = 0;
+    QTimer m_rxTimeout;
+};
+
+// Routes incoming CAN frames to ISO-TP channels by response ID
+class IsoTpTransport : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IsoTpTransport(CANInterface *can, QObject *parent = nullptr);
+
+    // Returns the channel for this address, creating it on first use
+    IsoTpChannel *channel(const IsoTpAddress &address);
+
+private slots:
+    void onFrameReceived(const QCanBusFrame &frame);
+
+private:
+    CANInterface *m_can;
+    IsoTpBufferPool m_pool;
+    QHash<quint32, IsoTpChannel *> m_channels;   // By rxId
+};
+
+#endif // ISOTP_H
@@ -0,0 +1,67 @@
+#include "j1939.h"
+#include <QDebug>
+
+static const quint8 kBamControl = 32;
+static const int kT1Ms = 750;
+
+J1939BamReassembler::J1939BamReassembler()
+{
+    m_clock.start();
+}
+
+bool J1939BamReassembler::handle(quint32 canId, const QByteArray &payload, quint32 *pgn, QByteArray *message)
+{
+    if (payload.size() < 8) return false;
+
+    const uchar *data = reinterpret_cast<const uchar *>(payload.constData());
+    Session &session = m_sessions[J1939::sourceAddress(canId)];
+    const qint64 now = m_clock.elapsed();
+    const quint32 framePgn = J1939::pgn(canId);
+
+    if (framePgn == J1939::TpConnectionManagementPgn) {
+        // Only broadcasts; RTS/CTS needs a destination-specific handshake
+        if (data[0] != kBamControl) return false;
+
+        const int size = data[1] | (data[2] << 8);
+        const int packets = data[3];
+        if (size < 9 || size > MaxMessageSize || packets != (size + 6) / 7) {
+            session.active = false;
+            return false;
+        }
+
+        session.active = true;
+        session.pgn = data[5] | (data[6] << 8) | (quint32(data[7]) << 16);
+        session.size = size;
+        session.packets = packets;
+        session.nextSequence = 1;
+        session.lastPacketMs = now;
+        session.data.resize(0);
+        session.data.reserve(packets * 7);
+        return false;
+    }
+
+    if (framePgn != J1939::TpDataTransferPgn || !session.active) return false;
+
+    if (now - session.lastPacketMs > kT1Ms) {
+        qWarning() << "J1939 BAM timeout from source" << J1939::sourceAddress(canId);
+        session.active = false;
+        return false;
+    }
+
+    if (data[0] != session.nextSequence) {
+        qWarning() << "J1939 BAM sequence error from source" << J1939::sourceAddress(canId);
+        session.active = false;
+        return false;
+    }
+
+    session.data.append(reinterpret_cast<const char *>(data + 1), 7);
+    session.nextSequence++;
+    session.lastPacketMs = now;
+
+    if (session.nextSequence <= session.packets) return false;
+
+    session.active = false;
+    *pgn = session.pgn;
+    *message = session.data.left(session.size);
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef J1939_H
+#define J1939_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <array>
+
+// SAE J1939 addressing on 29-bit identifiers:
+// priority(3) | reserved/data page(2) | PDU format(8) | PDU specific(8) | source address(8)
+namespace J1939 {
+    static const quint32 TpConnectionManagementPgn = 0xEC00;   // TP.CM (60416)
+    static const quint32 TpDataTransferPgn = 0xEB00;           // TP.DT (60160)
+
+    inline quint8 pduFormat(quint32 canId) { return quint8(canId >> 16); }
+    inline quint8 sourceAddress(quint32 canId) { return quint8(canId); }
+
+    // PDU1 (PF < 240) carries a destination address in PS, which is not part of the PGN
+    inline quint32 pgn(quint32 canId)
+    {
+        const quint32 pgn = (canId >> 8) & 0x3FFFF;
+        return pduFormat(canId) < 240 ? (pgn & 0x3FF00) : pgn;
+    }
+
+    // Identifier mask that matches every frame of a PGN, from any source
+    inline quint32 filterMask(quint32 pgn)
+    {
+        return ((pgn >> 8) & 0xFF) < 240 ? 0x03FF0000u : 0x03FFFF00u;
+    }
+}
+
+// Reassembles J1939 broadcast multi-packet messages (TP.CM BAM + TP.DT).
+// One session per source address; a session that stalls longer than T1
+// (750 ms) between packets is dropped when the next packet arrives.
+class J1939BamReassembler
+{
+public:
+    static const int MaxMessageSize = 1785;   // 255 packets x 7 bytes
+
+    J1939BamReassembler();
+
+    // Feed a TP.CM or TP.DT frame. Returns true when a message completed;
+    // its PGN and data are written to pgn/message.
+    bool handle(quint32 canId, const QByteArray &payload, quint32 *pgn, QByteArray *message);
+
+private:
+    struct Session {
+        bool active = false;
+        quint32 pgn = 0;
+        int size = 0;
+        int packets = 0;
+        int nextSequence = 1;
+        qint64 lastPacketMs = 0;
+        QByteArray data;
+    };
+
+    std::array<Session, 256> m_sessions;
+    QElapsedTimer m_clock;
+};
+
+#endif // J1939_H
@@ -2,40 +2,364 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QQuickWindow>
+#include <QCommandLineParser>
+#include <QDebug>
+#include "analyticspipeline.h"
+#include "blinkclock.h"
+#include "bmsinterface.h"
+#include "boottimer.h"
+#include "caninterface.h"
+#include "canreplay.h"
+#include "chargingeffectitem.h"
+#include "databaseservice.h"
+#include "directcluster2w.h"
+#include "efficiencygraphitem.h"
 #include "evvehicledata.h"
+#include "iconatlasprovider.h"
+#include "inputarbiter.h"
+#include "interpolatedsignal.h"
+#include "numericreadout.h"
+#include "renderscheduler.h"
+#include "routeplanner.h"
+#include "sharedstatereader.h"
+#include "signaljitterbuffer.h"
+#include "signalsubscription.h"
 #include "simulationreceiver.h"
+#include "statekeeper.h"
+#include "tripdetector.h"
+#include "udsclient.h"
+#include "vehicleprofile.h"
+#include <memory>
+
+// Seconds from a timeout option; malformed or non-positive values keep the default
+static int timeoutSeconds(const QCommandLineParser &parser, const QCommandLineOption &option, int fallback)
+{
+    bool ok = false;
+    const int seconds = parser.value(option).toInt(&ok);
+    if (ok && seconds > 0) return seconds;
+    qWarning().noquote() << QStringLiteral("Invalid --%1 value \"%2\", using %3 s")
+        .arg(option.names().constFirst(), parser.value(option)).arg(fallback);
+    return fallback;
+}
 
 int main(int argc, char *argv[])
 {
+    BootTimer::instance()->start();
+
 #if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
     QCoreApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
 #endif
     QGuiApplication app(argc, argv);
+    BootTimer::instance()->mark("app-constructed");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption legacyBootOption("legacy-boot",
+        "Load the full cluster before the first frame instead of staging it behind the telltale layer.");
+    parser.addOption(legacyBootOption);
+    QCommandLineOption canOption("can",
+        "Read live vehicle data from a CAN bus, e.g. socketcan:can0 or virtualcan:can0.",
+        "plugin:interface");
+    parser.addOption(canOption);
+    QCommandLineOption noCanFiltersOption("no-can-filters",
+        "Receive every frame on the bus instead of programming kernel receive filters.");
+    parser.addOption(noCanFiltersOption);
+    QCommandLineOption canStatsOption("can-stats",
+        "Log CAN frame rates and process CPU usage every 5 seconds.");
+    parser.addOption(canStatsOption);
+    QCommandLineOption recordOption("record",
+        "Record raw frames from --can to a candump log (.log) or Vector ASC file (.asc).", "file");
+    parser.addOption(recordOption);
+    QCommandLineOption replayOption("replay",
+        "Replay a recorded candump/ASC log as the replay input source.", "file");
+    parser.addOption(replayOption);
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay rate: 1 = recorded timing (default), N = N times faster, max = unthrottled.", "factor", "1");
+    parser.addOption(replaySpeedOption);
+    QCommandLineOption replayToOption("replay-to",
+        "Also write replayed frames to a bus, e.g. virtualcan:can0 or socketcan:vcan0.", "plugin:interface");
+    parser.addOption(replayToOption);
+    QCommandLineOption udsProbeOption("uds-probe",
+        "Read VIN and DTCs from the BMS over UDS on the --can bus and log them.");
+    parser.addOption(udsProbeOption);
+    QCommandLineOption datadOption("datad",
+        "Show the state published by ev-datad instead of reading inputs in this process.");
+    parser.addOption(datadOption);
+    QCommandLineOption shmNameOption("shm-name",
+        "Shared memory object published by ev-datad, default /ev-vehicle-state.", "name",
+        QString::fromLatin1(SharedVehicleState::DefaultName));
+    parser.addOption(shmNameOption);
+    QCommandLineOption vehicleConfigOption("vehicle-config",
+        "Vehicle profiles file (default config/vehicle.json next to the executable).", "file");
+    parser.addOption(vehicleConfigOption);
+    QCommandLineOption profileOption("profile",
+        "Vehicle profile id to start with, overriding active_profile in the config.", "id");
+    parser.addOption(profileOption);
+    QCommandLineOption noIdleThrottleOption("no-idle-throttle",
+        "Keep full-rate display updates while parked instead of coalescing idle values.");
+    parser.addOption(noIdleThrottleOption);
+    QCommandLineOption renderStatsOption("render-stats",
+        "Log render mode, frame rate and process CPU usage every 5 seconds.");
+    parser.addOption(renderStatsOption);
+    QCommandLineOption tripIdleTimeoutOption("trip-idle-timeout",
+        "End a trip after this long stopped while ready to drive (default 600).", "seconds",
+        QString::number(TripDetector::DefaultIdleTimeoutSec));
+    parser.addOption(tripIdleTimeoutOption);
+    QCommandLineOption tripParkTimeoutOption("trip-park-timeout",
+        "End a trip after this long stopped with the parking brake on (default 120).", "seconds",
+        QString::number(TripDetector::DefaultParkTimeoutSec));
+    parser.addOption(tripParkTimeoutOption);
+    QCommandLineOption routeGraphOption("route-graph",
+        "Routing graph built with ev-routegraph; enables on-board route guidance.", "file");
+    parser.addOption(routeGraphOption);
+    QCommandLineOption bindingStatsOption("binding-stats",
+        "Log derived-value evaluations and QML notifications every 5 seconds.");
+    parser.addOption(bindingStatsOption);
+    QCommandLineOption direct2WOption("direct-2w",
+        "Draw the two-wheeler layout with the partial-update software renderer instead of QML.");
+    parser.addOption(direct2WOption);
+    QCommandLineOption fbdevOption("fbdev",
+        "With --direct-2w, write straight to a Linux framebuffer device (e.g. /dev/fb0).", "device");
+    parser.addOption(fbdevOption);
+    parser.process(app);
+
+    const bool stagedBoot = !parser.isSet(legacyBootOption);
+    const bool useDatad = parser.isSet(datadOption);
 
     // Register our C++ types
     qmlRegisterType<EVVehicleData>("EVComponents", 1, 0, "EVVehicleData");
+    qmlRegisterType<EfficiencyGraphItem>("EVComponents", 1, 0, "EfficiencyGraphItem");
+    qmlRegisterType<ChargingEffectItem>("EVComponents", 1, 0, "ChargingEffectItem");
+    qmlRegisterType<SignalSubscription>("EVComponents", 1, 0, "SignalSubscription");
+    qmlRegisterType<InterpolatedSignal>("EVComponents", 1, 0, "InterpolatedSignal");
+    qmlRegisterType<NumericReadout>("EVComponents", 1, 0, "NumericReadout");
+    qmlRegisterUncreatableType<ConsumptionSeries>("EVComponents", 1, 0, "ConsumptionSeries",
+                                                  "ConsumptionSeries is owned by VehicleData");
+    qRegisterMetaType<SignalSample>();
+    qRegisterMetaType<QList<SignalSample>>();
+    qRegisterMetaType<AnalyticsResult>();
+    qRegisterMetaType<ChargingSession>();
+    qRegisterMetaType<RouteResult>();
+
+    // Parsed once; components copy the numbers they need on profile changes
+    VehicleProfiles profiles;
+    profiles.load(parser.isSet(vehicleConfigOption) ? parser.value(vehicleConfigOption)
+                                                    : VehicleProfiles::defaultPath());
+    if (parser.isSet(profileOption)) profiles.setActiveProfile(parser.value(profileOption));
 
     EVVehicleData vehicleData; // The singleton instance for the app
+    if (parser.isSet(bindingStatsOption)) vehicleData.setStatisticsInterval(5000);
+
+    // All sources feed the arbiter; it is the only writer of vehicleData.
+    // With --datad the shared-state reader is the only writer instead and the
+    // local bus is left to diagnostics.
+    InputArbiter inputArbiter(&vehicleData);
+    SharedStateReader sharedState(&vehicleData);
+    inputArbiter.setDecimator(SignalDecimator::instance());
+    sharedState.setDecimator(SignalDecimator::instance());
+    inputArbiter.setJitterBuffer(SignalJitterBuffer::instance());
+    sharedState.setJitterBuffer(SignalJitterBuffer::instance());
+
+    // Start ingest before QML so the first frame already shows live telltales
+    std::unique_ptr<SimulationReceiver> simReceiver;
+    if (useDatad) {
+        sharedState.open(parser.value(shmNameOption));
+    } else {
+        simReceiver.reset(new SimulationReceiver);
+        QObject::connect(simReceiver.get(), &SimulationReceiver::samplesReceived,
+                         &inputArbiter, &InputArbiter::submitBatch);
+    }
+
+    CANInterface canInterface;
+    BMSInterface bmsInterface;
+    if (!useDatad) {
+        QObject::connect(&canInterface, &CANInterface::samplesDecoded,
+                         &inputArbiter, &InputArbiter::submitBatch);
+    }
+    QObject::connect(&canInterface, &CANInterface::bmsFrameReceived,
+                     &bmsInterface, &BMSInterface::updateFromCAN);
+    if (!useDatad) {
+        QObject::connect(&bmsInterface, &BMSInterface::samplesDecoded,
+                         &inputArbiter, &InputArbiter::submitBatch);
+    }
+
+    canInterface.setReceiveFiltersEnabled(!parser.isSet(noCanFiltersOption));
+    if (parser.isSet(canStatsOption)) canInterface.setStatisticsInterval(5000);
+
+    if (parser.isSet(canOption)) {
+        const QStringList canSpec = parser.value(canOption).split(':');
+        if (canSpec.size() == 2) {
+            if (canInterface.connectDevice(canSpec[0], canSpec[1]) && parser.isSet(recordOption)) {
+                canInterface.startRecording(parser.value(recordOption));
+            }
+        } else {
+            qWarning() << "Invalid --can value, expected plugin:interface";
+        }
+    }
+
+    // Diagnostics (VIN, DTCs, cell dumps) share the live bus
+    IsoTpTransport isoTp(&canInterface);
+    UdsClient uds(&isoTp);
+    if (parser.isSet(udsProbeOption)) {
+        const UdsEcu bms { "BMS", 0x7E4, 0x7EC };
+        uds.readDataByIdentifier(bms, UdsClient::VinDid).then(&app, [](const UdsResponse &response) {
+            if (response.ok) qDebug() << "[uds] VIN:" << response.data.mid(2);
+            else qWarning() << "[uds] VIN read failed:" << response.error;
+        });
+        uds.readDtcByStatusMask(bms).then(&app, [](const UdsResponse &response) {
+            const QList<UdsDtc> dtcs = UdsClient::parseDtcs(response);
+            if (!response.ok) qWarning() << "[uds] DTC read failed:" << response.error;
+            for (const UdsDtc &dtc : dtcs) {
+                qDebug() << "[uds] DTC" << dtc.toString() << "status" << Qt::hex << dtc.status;
+            }
+        });
+    }
+
+    // Replayed frames go through their own decoder so they arbitrate as Replay
+    CANInterface replayDecoder;
+    replayDecoder.setSource(InputSource::Replay);
+    QObject::connect(&replayDecoder, &CANInterface::samplesDecoded,
+                     &inputArbiter, &InputArbiter::submitBatch);
+    QObject::connect(&replayDecoder, &CANInterface::bmsFrameReceived,
+                     &bmsInterface, &BMSInterface::updateFromCAN);
+
+    CanReplayDevice replay;
+    QObject::connect(&replay, &CanReplayDevice::frameReplayed,
+                     &replayDecoder, &CANInterface::processFrame);
+
+    if (useDatad && parser.isSet(replayOption)) {
+        // Replay onto the bus ev-datad reads instead (tools: canplayer, --replay-to)
+        qWarning() << "--replay is ignored with --datad; ev-datad owns vehicle input";
+    } else if (parser.isSet(replayOption) && replay.load(parser.value(replayOption))) {
+        const QString speed = parser.value(replaySpeedOption);
+        replay.setSpeed(speed == "max" ? 0.0 : speed.toDouble());
+        if (parser.isSet(replayToOption)) {
+            const QStringList target = parser.value(replayToOption).split(':');
+            if (target.size() == 2) {
+                replay.setTargetDevice(target[0], target[1]);
+            } else {
+                qWarning() << "Invalid --replay-to value, expected plugin:interface";
+            }
+        }
+        replay.start();
+    }
+    BootTimer::instance()->mark("receivers-started");
+
+    // Range, efficiency and charging estimates; ev-datad runs its own
+    AnalyticsPipeline analytics(&vehicleData);
+    analytics.setProfile(profiles.profile());
+    QObject::connect(&profiles, &VehicleProfiles::profileChanged, &analytics, [&] {
+        analytics.setProfile(profiles.profile());
+    });
+
+    // Odometer, trip counters and learnt range from the last run, before the
+    // first frame; with --datad the service keeps them
+    StateKeeper stateKeeper(&vehicleData, &analytics);
+    if (!useDatad && stateKeeper.open()) {
+        stateKeeper.restore();
+        stateKeeper.start();
+        BootTimer::instance()->mark("state-restored");
+    }
+    if (!useDatad) analytics.start();
+
+    // Parked and quiet: coalesce continuous values so the scene stops repainting
+    RenderScheduler renderScheduler(&vehicleData);
+    renderScheduler.setEnabled(!parser.isSet(noIdleThrottleOption));
+    QObject::connect(&renderScheduler, &RenderScheduler::idleChanged, [&](bool idle) {
+        const int interval = idle ? RenderScheduler::IdleUpdateIntervalMs : 0;
+        inputArbiter.setCoalesceInterval(interval);
+        sharedState.setCoalesceInterval(interval);
+    });
+    if (parser.isSet(renderStatsOption)) renderScheduler.setStatisticsInterval(5000);
+
+    // Trip history & settings - opened on its own worker thread, never blocks boot.
+    // With --datad the service records trips; every display doing it too would
+    // save each drive once per display.
+    DatabaseService database;
+    TripDetector tripDetector(&vehicleData, &database);
+    if (useDatad) {
+        if (parser.isSet(tripIdleTimeoutOption) || parser.isSet(tripParkTimeoutOption)) {
+            qWarning() << "--trip-idle-timeout/--trip-park-timeout are ignored with --datad; pass them to ev-datad";
+        }
+    } else {
+        database.init();
+
+        // Finished charging sessions are logged next to the trips; raw rows
+        // older than 30 days are pruned daily, the rollups keep their totals
+        database.startRetention();
+        QObject::connect(&analytics, &AnalyticsPipeline::chargingSessionCompleted, &database,
+                         [&database](const ChargingSession &session, double latitude, double longitude) {
+            database.saveChargingSession(session, latitude, longitude);
+        });
+
+        // Drives are split into trips here and saved on the database thread
+        tripDetector.setIdleTimeout(timeoutSeconds(parser, tripIdleTimeoutOption, TripDetector::DefaultIdleTimeoutSec));
+        tripDetector.setParkTimeout(timeoutSeconds(parser, tripParkTimeoutOption, TripDetector::DefaultParkTimeoutSec));
+        tripDetector.start();
+    }
+
+    // Energy-optimal routes and turn-by-turn guidance from a local map; the
+    // graph is mapped on the routing thread, so boot does not wait for it
+    RoutePlanner routePlanner(&vehicleData);
+    if (parser.isSet(routeGraphOption)) {
+        if (useDatad) {
+            qWarning() << "--route-graph is ignored with --datad; the service owns the vehicle state";
+        } else {
+            routePlanner.open(parser.value(routeGraphOption));
+        }
+    }
+
+    // Low-end 2W displays: no scene graph, only changed panels are repainted
+    if (parser.isSet(direct2WOption)) {
+        DirectCluster2W direct(&vehicleData);
+        direct.setStaleCheck([&](VehicleSignal signal) {
+            const int index = static_cast<int>(signal);
+            return useDatad ? sharedState.isSignalStale(index) : inputArbiter.isSignalStale(index);
+        });
+        if (parser.isSet(fbdevOption)) {
+            if (!direct.openFramebuffer(parser.value(fbdevOption))) return -1;
+        } else {
+            direct.openWindow(QSize(1280, 480));
+        }
+        if (parser.isSet(renderStatsOption)) direct.setStatisticsInterval(5000);
+        direct.start();
+        return app.exec();
+    }
 
     QQmlApplicationEngine engine;
-    
+    engine.addImageProvider("icons", new IconAtlasProvider);   // Engine takes ownership
+
     // transform the EVVehicleData instance into a context property
     // so it is accessible globally in QML as "Vehicle"
     engine.rootContext()->setContextProperty("VehicleData", &vehicleData);
-    
+    engine.rootContext()->setContextProperty("InputStatus",
+        useDatad ? static_cast<QObject *>(&sharedState) : &inputArbiter);
+    engine.rootContext()->setContextProperty("VehicleProfile", &profiles);
+    engine.rootContext()->setContextProperty("BootTimer", BootTimer::instance());
+    engine.rootContext()->setContextProperty("BlinkClock", BlinkClock::instance());
+    engine.rootContext()->setContextProperty("RenderScheduler", &renderScheduler);
+    engine.rootContext()->setContextProperty("Navigation", &routePlanner);
+    engine.rootContext()->setContextProperty("StagedBoot", stagedBoot);
+
     // Load from embedded resource for portability
     const QUrl url(QStringLiteral("qrc:/qml/main.qml"));
-    
+
     QObject::connect(&engine, &QQmlApplicationEngine::objectCreated,
-                     &app, [url](QObject *obj, const QUrl &objUrl) {
-        if (!obj && url == objUrl)
+                     &app, [url, &renderScheduler](QObject *obj, const QUrl &objUrl) {
+        if (!obj && url == objUrl) {
             QCoreApplication::exit(-1);
+            return;
+        }
+
+        // First swapped frame is the time-to-first-telltale
+        BootTimer::instance()->watchWindow(qobject_cast<QQuickWindow *>(obj));
+        renderScheduler.watchWindow(qobject_cast<QQuickWindow *>(obj));
     }, Qt::QueuedConnection);
-    
-    engine.load(url);
 
-    // Initialize Simulation Receiver
-    SimulationReceiver simReceiver(&vehicleData);
+    BootTimer::instance()->mark("qml-load-begin");
+    engine.load(url);
+    BootTimer::instance()->mark("qml-load-end");
 
     return app.exec();
 }
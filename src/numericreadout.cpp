@@ -0,0 +1,398 @@
+#include "numericreadout.h"
+#include "glyphatlas.h"
+#include <QFontInfo>
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGMaterial>
+#include <QSGMaterialShader>
+#include <QSGTexture>
+#include <cstring>
+
+static const double kKmToMiles = 0.621371;
+static const double kPowersOfTen[] = { 1.0, 10.0, 100.0, 1e3, 1e4, 1e5, 1e6 };
+static const int kMaxDecimals = 6;
+
+// ── Material ──
+
+class NumericReadoutMaterial : public QSGMaterial
+{
+public:
+    NumericReadoutMaterial() { setFlag(Blending); }
+
+    QSGMaterialType *type() const override
+    {
+        static QSGMaterialType type;
+        return &type;
+    }
+
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode) const override;
+
+    int compare(const QSGMaterial *other) const override
+    {
+        // Same atlas and color batch into one draw call
+        const auto *o = static_cast<const NumericReadoutMaterial *>(other);
+        if (atlas != o->atlas) return atlas < o->atlas ? -1 : 1;
+        const QRgb a = color.rgba();
+        const QRgb b = o->color.rgba();
+        return a == b ? 0 : (a < b ? -1 : 1);
+    }
+
+    std::shared_ptr<GlyphAtlas> atlas;
+    QColor color;
+};
+
+class NumericReadoutShader : public QSGMaterialShader
+{
+public:
+    NumericReadoutShader()
+    {
+        setShaderFileName(VertexStage, QStringLiteral(":/shaders/distancefieldtext.vert.qsb"));
+        setShaderFileName(FragmentStage, QStringLiteral(":/shaders/distancefieldtext.frag.qsb"));
+    }
+
+    bool updateUniformData(RenderState &state, QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        // std140: qt_Matrix at 0, qt_Opacity at 64, color at 80
+        QByteArray *buffer = state.uniformData();
+        Q_ASSERT(buffer->size() >= 96);
+
+        if (state.isMatrixDirty()) {
+            const QMatrix4x4 matrix = state.combinedMatrix();
+            memcpy(buffer->data(), matrix.constData(), 64);
+        }
+
+        const auto *material = static_cast<NumericReadoutMaterial *>(newMaterial);
+        const float opacity = state.opacity();
+        const float alpha = material->color.alphaF();
+        const float color[4] = { float(material->color.redF()) * alpha, float(material->color.greenF()) * alpha,
+                                 float(material->color.blueF()) * alpha, alpha };
+        memcpy(buffer->data() + 64, &opacity, sizeof(opacity));
+        memcpy(buffer->data() + 80, color, sizeof(color));
+        return true;
+    }
+
+    void updateSampledImage(RenderState &state, int binding, QSGTexture **texture,
+                            QSGMaterial *newMaterial, QSGMaterial *) override
+    {
+        if (binding != 1) return;
+        // Commit every time: another readout may have added glyph cells since
+        auto *material = static_cast<NumericReadoutMaterial *>(newMaterial);
+        *texture = material->atlas->texture();
+        (*texture)->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+    }
+};
+
+QSGMaterialShader *NumericReadoutMaterial::createShader(QSGRendererInterface::RenderMode) const
+{
+    return new NumericReadoutShader;
+}
+
+// ── Item ──
+
+NumericReadout::NumericReadout(QQuickItem *parent)
+    : QQuickItem(parent), m_metrics(m_font)
+{
+    setFlag(ItemHasContents, true);
+    updateMetrics();
+    updateUnitLabel();
+    updateText();
+}
+
+void NumericReadout::setValue(qreal value)
+{
+    if (m_value == value)
+        return;
+    m_value = value;
+    emit valueChanged();
+    updateText();
+}
+
+void NumericReadout::setDecimals(int decimals)
+{
+    decimals = qBound(0, decimals, kMaxDecimals);
+    if (m_decimals == decimals)
+        return;
+    m_decimals = decimals;
+    emit decimalsChanged();
+    updateText();
+}
+
+void NumericReadout::setQuantity(Quantity quantity)
+{
+    if (m_quantity == quantity)
+        return;
+    m_quantity = quantity;
+    emit quantityChanged();
+    updateUnitLabel();
+    updateText();
+}
+
+void NumericReadout::setImperial(bool imperial)
+{
+    if (m_imperial == imperial)
+        return;
+    m_imperial = imperial;
+    emit imperialChanged();
+    updateUnitLabel();
+    updateText();
+}
+
+void NumericReadout::setUnit(const QString &unit)
+{
+    if (m_unit == unit)
+        return;
+    m_unit = unit;
+    emit unitChanged();
+    updateUnitLabel();
+    updateText();
+}
+
+void NumericReadout::setShowUnit(bool showUnit)
+{
+    if (m_showUnit == showUnit)
+        return;
+    m_showUnit = showUnit;
+    emit showUnitChanged();
+    updateText();
+}
+
+void NumericReadout::setAbsolute(bool absolute)
+{
+    if (m_absolute == absolute)
+        return;
+    m_absolute = absolute;
+    emit absoluteChanged();
+    updateText();
+}
+
+void NumericReadout::setStale(bool stale)
+{
+    if (m_stale == stale)
+        return;
+    m_stale = stale;
+    emit staleChanged();
+    updateText();
+}
+
+void NumericReadout::setColor(const QColor &color)
+{
+    if (m_color == color)
+        return;
+    m_color = color;
+    emit colorChanged();
+    update();
+}
+
+void NumericReadout::setFont(const QFont &font)
+{
+    if (m_font == font)
+        return;
+    m_font = font;
+    updateMetrics();
+    m_fontDirty = true;
+    emit fontChanged();
+    layoutText();
+}
+
+void NumericReadout::setHorizontalAlignment(int alignment)
+{
+    alignment &= Qt::AlignHorizontal_Mask;
+    if (m_alignment == alignment)
+        return;
+    m_alignment = alignment;
+    emit horizontalAlignmentChanged();
+    m_textDirty = true;
+    update();
+}
+
+void NumericReadout::geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry)
+{
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        m_textDirty = true;
+        update();
+    }
+}
+
+void NumericReadout::updateMetrics()
+{
+    m_metrics = QFontMetricsF(m_font);
+    m_pixelSize = QFontInfo(m_font).pixelSize();
+    m_digitAdvance = 0.0;
+    for (char16_t digit = u'0'; digit <= u'9'; ++digit) {
+        m_digitAdvance = qMax(m_digitAdvance, m_metrics.horizontalAdvance(QChar(digit)));
+    }
+}
+
+void NumericReadout::updateUnitLabel()
+{
+    QString label = m_unit;
+    if (label.isEmpty()) {
+        switch (m_quantity) {
+        case Speed: label = m_imperial ? QStringLiteral("mph") : QStringLiteral("km/h"); break;
+        case Distance: label = m_imperial ? QStringLiteral("mi") : QStringLiteral("km"); break;
+        case Temperature: label = m_imperial ? QStringLiteral("°F") : QStringLiteral("°C"); break;
+        case Plain: break;
+        }
+    }
+
+    if (m_unitLabel == label)
+        return;
+    m_unitLabel = label;
+    emit unitLabelChanged();
+}
+
+void NumericReadout::updateText()
+{
+    char16_t text[MaxChars];
+    int length = 0;
+    auto put = [&](char16_t ch) {
+        if (length < MaxChars) text[length++] = ch;
+    };
+
+    double value = m_value;
+    if (m_stale || !qIsFinite(value)) {
+        put(u'-');
+        put(u'-');
+    } else {
+        if (m_imperial) {
+            switch (m_quantity) {
+            case Speed:
+            case Distance: value *= kKmToMiles; break;
+            case Temperature: value = value * 1.8 + 32.0; break;
+            case Plain: break;
+            }
+        }
+
+        // Fixed point, rounded half away from zero like toFixed()
+        const qint64 fixed = qRound64(qMin(qAbs(value) * kPowersOfTen[m_decimals], 1e15));
+        if (value < 0 && fixed != 0 && !m_absolute) put(u'-');
+
+        char16_t digits[24];
+        int count = 0;
+        qint64 rest = fixed;
+        do {
+            digits[count++] = char16_t(u'0' + rest % 10);
+            rest /= 10;
+        } while (rest > 0 || count <= m_decimals);
+        for (int i = count - 1; i >= 0; --i) {
+            put(digits[i]);
+            if (i == m_decimals && m_decimals > 0) put(u'.');
+        }
+    }
+
+    if (m_showUnit && !m_unitLabel.isEmpty()) {
+        put(u' ');
+        for (QChar ch : m_unitLabel) put(ch.unicode());
+    }
+
+    // Most samples round to what is already on screen
+    if (length == m_length && memcmp(text, m_text, length * sizeof(char16_t)) == 0)
+        return;
+    memcpy(m_text, text, length * sizeof(char16_t));
+    m_length = length;
+    layoutText();
+}
+
+void NumericReadout::layoutText()
+{
+    // Digits sit centred in equal cells so the readout does not jitter
+    qreal pen = 0.0;
+    for (int i = 0; i < m_length; ++i) {
+        const QChar ch(m_text[i]);
+        const qreal advance = m_metrics.horizontalAdvance(ch);
+        if (ch.isDigit()) {
+            m_pen[i] = pen + (m_digitAdvance - advance) / 2.0;
+            pen += m_digitAdvance;
+        } else {
+            m_pen[i] = pen;
+            pen += advance;
+        }
+    }
+    m_textWidth = pen;
+
+    setImplicitSize(m_textWidth, m_metrics.height());
+    m_textDirty = true;
+    update();
+}
+
+QSGNode *NumericReadout::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    auto *node = static_cast<QSGGeometryNode *>(oldNode);
+    if (m_length == 0 || m_pixelSize <= 0) {
+        delete node;
+        return nullptr;
+    }
+
+    if (!node) {
+        node = new QSGGeometryNode;
+        auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0, 0);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new NumericReadoutMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+        m_fontDirty = true;
+    }
+
+    auto *material = static_cast<NumericReadoutMaterial *>(node->material());
+    if (m_fontDirty || !material->atlas) {
+        material->atlas = GlyphAtlas::get(window(), m_font);
+        node->markDirty(QSGNode::DirtyMaterial);
+        m_fontDirty = false;
+        m_textDirty = true;
+    }
+    if (material->color != m_color) {
+        material->color = m_color;
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    // New characters (a unit, a sign) are rasterized once per atlas
+    const QString chars = QString::fromRawData(reinterpret_cast<const QChar *>(m_text), m_length);
+    if (material->atlas->ensure(chars)) {
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    if (!m_textDirty)
+        return node;
+    m_textDirty = false;
+
+    // Quads only grow; unused ones collapse to a point
+    QSGGeometry *geometry = node->geometry();
+    if (geometry->vertexCount() < m_length * 4) {
+        geometry->allocate(m_length * 4, m_length * 6);
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int quad = 0; quad < m_length; ++quad) {
+            const quint16 base = quint16(quad * 4);
+            const quint16 corners[6] = { 0, 1, 2, 2, 1, 3 };
+            for (int i = 0; i < 6; ++i) indices[quad * 6 + i] = quint16(base + corners[i]);
+        }
+    }
+
+    const qreal scale = m_pixelSize / GlyphAtlas::BaseSize;
+    const qreal baseline = (height() - m_metrics.height()) / 2.0 + m_metrics.ascent();
+    qreal offset = 0.0;
+    if (m_alignment & Qt::AlignRight) offset = width() - m_textWidth;
+    else if (m_alignment & Qt::AlignHCenter) offset = (width() - m_textWidth) / 2.0;
+
+    QSGGeometry::TexturedPoint2D *vertices = geometry->vertexDataAsTexturedPoint2D();
+    const int quads = geometry->vertexCount() / 4;
+    for (int i = 0; i < quads; ++i) {
+        QSGGeometry::TexturedPoint2D *v = vertices + i * 4;
+        const GlyphAtlas::Glyph *glyph = i < m_length ? material->atlas->glyph(QChar(m_text[i])) : nullptr;
+        if (!glyph) {
+            for (int corner = 0; corner < 4; ++corner) v[corner].set(0, 0, 0, 0);
+            continue;
+        }
+
+        const QRectF quad(offset + m_pen[i] + glyph->quad.left() * scale, baseline + glyph->quad.top() * scale,
+                          glyph->quad.width() * scale, glyph->quad.height() * scale);
+        const QRectF &uv = glyph->uv;
+        v[0].set(quad.left(), quad.top(), uv.left(), uv.top());
+        v[1].set(quad.right(), quad.top(), uv.right(), uv.top());
+        v[2].set(quad.left(), quad.bottom(), uv.left(), uv.bottom());
+        v[3].set(quad.right(), quad.bottom(), uv.right(), uv.bottom());
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
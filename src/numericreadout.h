@@ -0,0 +1,123 @@
+#ifndef NUMERICREADOUT_H
+#define NUMERICREADOUT_H
+
+#include <QQuickItem>
+#include <QColor>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QString>
+
+// Fixed-point number with an optional unit, drawn from a shared
+// distance-field glyph atlas (GlyphAtlas).
+// A value change formats into a fixed buffer on the GUI thread and, only if
+// the characters differ, rewrites one textured quad per character - no JS
+// string, no text layout, no glyph upload. Digits are tabular so readouts do
+// not jitter. Units convert in C++: set quantity and imperial and the value
+// and unitLabel follow (km/h -> mph, km -> mi, °C -> °F).
+class NumericReadout : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal value READ value WRITE setValue NOTIFY valueChanged)
+    Q_PROPERTY(int decimals READ decimals WRITE setDecimals NOTIFY decimalsChanged)
+    Q_PROPERTY(Quantity quantity READ quantity WRITE setQuantity NOTIFY quantityChanged)
+    Q_PROPERTY(bool imperial READ imperial WRITE setImperial NOTIFY imperialChanged)
+    Q_PROPERTY(QString unit READ unit WRITE setUnit NOTIFY unitChanged)
+    Q_PROPERTY(QString unitLabel READ unitLabel NOTIFY unitLabelChanged)
+    Q_PROPERTY(bool showUnit READ showUnit WRITE setShowUnit NOTIFY showUnitChanged)
+    Q_PROPERTY(bool absolute READ absolute WRITE setAbsolute NOTIFY absoluteChanged)
+    Q_PROPERTY(bool stale READ stale WRITE setStale NOTIFY staleChanged)
+    Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged)
+    Q_PROPERTY(QFont font READ font WRITE setFont NOTIFY fontChanged)
+    Q_PROPERTY(int horizontalAlignment READ horizontalAlignment WRITE setHorizontalAlignment NOTIFY horizontalAlignmentChanged)
+
+public:
+    enum Quantity {
+        Plain,          // Shown as given, unit from the unit property
+        Speed,          // km/h
+        Distance,       // km
+        Temperature     // °C
+    };
+    Q_ENUM(Quantity)
+
+    static const int MaxChars = 24;
+
+    explicit NumericReadout(QQuickItem *parent = nullptr);
+
+    qreal value() const { return m_value; }
+    int decimals() const { return m_decimals; }
+    Quantity quantity() const { return m_quantity; }
+    bool imperial() const { return m_imperial; }
+    QString unit() const { return m_unit; }
+    QString unitLabel() const { return m_unitLabel; }
+    bool showUnit() const { return m_showUnit; }
+    bool absolute() const { return m_absolute; }
+    bool stale() const { return m_stale; }
+    QColor color() const { return m_color; }
+    QFont font() const { return m_font; }
+    int horizontalAlignment() const { return m_alignment; }
+
+    void setValue(qreal value);             // In the quantity's metric unit
+    void setDecimals(int decimals);         // 0-6
+    void setQuantity(Quantity quantity);
+    void setImperial(bool imperial);
+    void setUnit(const QString &unit);      // Overrides the quantity's label
+    void setShowUnit(bool showUnit);        // Append " <unitLabel>" in the same font
+    void setAbsolute(bool absolute);        // Drop the sign
+    void setStale(bool stale);              // Show "--"
+    void setColor(const QColor &color);
+    void setFont(const QFont &font);
+    void setHorizontalAlignment(int alignment);
+
+signals:
+    void valueChanged();
+    void decimalsChanged();
+    void quantityChanged();
+    void imperialChanged();
+    void unitChanged();
+    void unitLabelChanged();
+    void showUnitChanged();
+    void absoluteChanged();
+    void staleChanged();
+    void colorChanged();
+    void fontChanged();
+    void horizontalAlignmentChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+    void geometryChange(const QRectF &newGeometry, const QRectF &oldGeometry) override;
+
+private:
+    void updateMetrics();
+    void updateUnitLabel();
+    void updateText();
+    void layoutText();
+
+    qreal m_value = 0.0;
+    int m_decimals = 0;
+    Quantity m_quantity = Plain;
+    bool m_imperial = false;
+    QString m_unit;
+    QString m_unitLabel;
+    bool m_showUnit = false;
+    bool m_absolute = false;
+    bool m_stale = false;
+    QColor m_color = Qt::white;
+    QFont m_font;
+    int m_alignment = Qt::AlignLeft;
+
+    // Current characters and their pen positions, item pixels from the left
+    char16_t m_text[MaxChars];
+    qreal m_pen[MaxChars];
+    int m_length = 0;
+    qreal m_textWidth = 0.0;
+
+    // GUI-thread metrics of m_font; digits share the widest digit advance
+    QFontMetricsF m_metrics;
+    qreal m_digitAdvance = 0.0;
+    qreal m_pixelSize = 0.0;
+
+    bool m_fontDirty = true;    // Fetch another atlas on the next sync
+    bool m_textDirty = true;
+};
+
+#endif // NUMERICREADOUT_H
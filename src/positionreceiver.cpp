@@ -0,0 +1,73 @@
+#include "positionreceiver.h"
+#include <QGeoPositionInfoSource>
+#include <QDebug>
+
+PositionReceiver::PositionReceiver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool PositionReceiver::start(const QString &sourceName, int intervalMs)
+{
+    stop();
+
+    m_source = sourceName.isEmpty() ? QGeoPositionInfoSource::createDefaultSource(this)
+                                    : QGeoPositionInfoSource::createSource(sourceName, this);
+    if (!m_source) {
+        qWarning() << "No positioning source available"
+                   << (sourceName.isEmpty() ? QString() : sourceName);
+        return false;
+    }
+
+    connect(m_source, &QGeoPositionInfoSource::positionUpdated,
+            this, &PositionReceiver::onPositionUpdated);
+    connect(m_source, &QGeoPositionInfoSource::errorOccurred, this,
+            [](QGeoPositionInfoSource::Error error) {
+        qWarning() << "Positioning source error:" << error;
+    });
+
+    m_source->setUpdateInterval(intervalMs);
+    m_source->startUpdates();
+    qDebug() << "GNSS input started:" << m_source->sourceName();
+    return true;
+}
+
+void PositionReceiver::stop()
+{
+    if (!m_source) return;
+    m_source->stopUpdates();
+    m_source->deleteLater();
+    m_source = nullptr;
+}
+
+void PositionReceiver::onPositionUpdated(const QGeoPositionInfo &info)
+{
+    if (!info.isValid()) return;
+
+    const qint64 timestampMs = info.timestamp().toMSecsSinceEpoch();
+    const QGeoCoordinate coordinate = info.coordinate();
+
+    QList<SignalSample> samples;
+    samples.reserve(3);
+
+    SignalSample sample;
+    sample.source = InputSource::Gnss;
+    sample.timestampMs = timestampMs;
+
+    sample.signal = VehicleSignal::GpsLatitude;
+    sample.value = coordinate.latitude();
+    samples.append(sample);
+
+    sample.signal = VehicleSignal::GpsLongitude;
+    sample.value = coordinate.longitude();
+    samples.append(sample);
+
+    // Course over ground is only reported while moving
+    if (info.hasAttribute(QGeoPositionInfo::Direction)) {
+        sample.signal = VehicleSignal::Heading;
+        sample.value = float(info.attribute(QGeoPositionInfo::Direction));
+        samples.append(sample);
+    }
+
+    emit samplesReceived(samples);
+}
@@ -0,0 +1,32 @@
+#ifndef POSITIONRECEIVER_H
+#define POSITIONRECEIVER_H
+
+#include <QObject>
+#include <QGeoPositionInfo>
+#include "signalsample.h"
+
+class QGeoPositionInfoSource;
+
+// Feeds a QtPositioning source (gpsd, NMEA serial, platform GNSS) into the
+// arbiter as GpsLatitude/GpsLongitude/Heading samples tagged InputSource::Gnss.
+class PositionReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PositionReceiver(QObject *parent = nullptr);
+
+    // Empty name = platform default plugin. Returns false if none is available.
+    bool start(const QString &sourceName = QString(), int intervalMs = 1000);
+    void stop();
+
+signals:
+    void samplesReceived(const QList<SignalSample> &samples);
+
+private slots:
+    void onPositionUpdated(const QGeoPositionInfo &info);
+
+private:
+    QGeoPositionInfoSource *m_source = nullptr;
+};
+
+#endif // POSITIONRECEIVER_H
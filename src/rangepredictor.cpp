@@ -1,15 +1,35 @@
 #include "rangepredictor.h"
+#include "vehicleprofile.h"
 #include <QDebug>
 #include <QtMath>
 
 RangePredictor::RangePredictor(QObject *parent)
     : QObject(parent),
-      m_batteryCapacityKwh(77.4),  // Default 4W capacity
+      m_batteryCapacityKwh(VehicleProfile().batteryCapacityKwh),  // Until a profile is applied
       m_temperatureFactor(1.0),
-      m_sampleCount(0)
+      m_sampleCount(0),
+      m_previousRange(0.0f),
+      m_smoothedEfficiency(180.0f)
 {
 }
 
+float RangePredictor::temperatureFactor(float batteryTemp)
+{
+    // Optimal at 20-35°C, efficiency drops at extremes
+    if (batteryTemp < 0) {
+        return 0.70f;  // 30% reduction in extreme cold
+    } else if (batteryTemp < 10) {
+        return 0.85f;  // 15% reduction in cold
+    } else if (batteryTemp < 20) {
+        return 0.95f;  // 5% reduction
+    } else if (batteryTemp <= 35) {
+        return 1.0f;   // Optimal
+    } else if (batteryTemp <= 45) {
+        return 0.95f;  // Slight reduction in heat
+    }
+    return 0.85f;      // 15% reduction in high heat
+}
+
 void RangePredictor::updateState(float batterySoc, float powerKw, float speedKmh, float batteryTemp)
 {
     // Only calculate efficiency when moving
@@ -21,20 +41,7 @@ void RangePredictor::updateState(float batterySoc, float powerKw, float speedKmh
     float instantEfficiency = (powerKw * 1000.0f) / speedKmh;  // kW to Wh, per km
     
     // Temperature impact (simplified model)
-    // Optimal at 20-30°C, efficiency drops at extremes
-    if (batteryTemp < 0) {
-        m_temperatureFactor = 0.70;  // 30% reduction in cold
-    } else if (batteryTemp < 10) {
-        m_temperatureFactor = 0.85;  // 15% reduction
-    } else if (batteryTemp < 20) {
-        m_temperatureFactor = 0.95;  // 5% reduction
-    } else if (batteryTemp <= 35) {
-        m_temperatureFactor = 1.0;   // Optimal
-    } else if (batteryTemp <= 45) {
-        m_temperatureFactor = 0.95;  // Slight reduction in heat
-    } else {
-        m_temperatureFactor = 0.85;  // 15% reduction in high heat
-    }
+    m_temperatureFactor = temperatureFactor(batteryTemp);
     
     // Add to recent efficiency (last ~5 minutes at 200ms updates = 1500 samples)
     m_recentEfficiency.append(instantEfficiency);
@@ -51,6 +58,37 @@ void RangePredictor::updateState(float batterySoc, float powerKw, float speedKmh
     m_sampleCount++;
 }
 
+float RangePredictor::updateRange(float batterySoc, float batteryTemp, float consumptionWhPerKm)
+{
+    float availableEnergyKwh = (batterySoc / 100.0f) * m_batteryCapacityKwh;
+    
+    // Update smoothed efficiency with exponential moving average
+    // Only update when we have valid consumption data (ignore during regen)
+    if (consumptionWhPerKm > 50.0f && consumptionWhPerKm < 500.0f) {
+        // Alpha = 0.1 means 10% new value, 90% previous (slow, stable)
+        float alpha = 0.1f;
+        m_smoothedEfficiency = alpha * consumptionWhPerKm + (1.0f - alpha) * m_smoothedEfficiency;
+    }
+    
+    // Base range calculation: available energy / efficiency, temperature compensated
+    float calculatedRange = (availableEnergyKwh * 1000.0f) / m_smoothedEfficiency;
+    calculatedRange *= temperatureFactor(batteryTemp);
+    
+    // Smooth the range output itself (prevents jumps)
+    // Alpha = 0.2 means 20% new value, 80% previous
+    if (m_previousRange > 0) {
+        calculatedRange = 0.2f * calculatedRange + 0.8f * m_previousRange;
+    }
+    m_previousRange = calculatedRange;
+    
+    // Reserve last 5% of battery
+    if (batterySoc < 5.0f) {
+        calculatedRange = 0.0f;
+    }
+    
+    return calculatedRange;
+}
+
 float RangePredictor::calculateRangeEstimate(float efficiency, float batterySoc) const
 {
     if (efficiency <= 0 || batterySoc <= 0) {
@@ -135,11 +173,20 @@ float RangePredictor::getRecentEfficiency() const
     return sum / m_recentEfficiency.size();
 }
 
+void RangePredictor::restoreSmoothing(float previousRange, float smoothedEfficiency)
+{
+    if (smoothedEfficiency <= 0.0f) return;     // Nothing learnt yet
+    m_previousRange = previousRange;
+    m_smoothedEfficiency = smoothedEfficiency;
+}
+
 void RangePredictor::reset()
 {
     m_efficiencyHistory.clear();
     m_recentEfficiency.clear();
     m_temperatureFactor = 1.0;
     m_sampleCount = 0;
+    m_previousRange = 0.0f;
+    m_smoothedEfficiency = 180.0f;
     qDebug() << "RangePredictor: Reset";
 }
@@ -19,14 +19,26 @@ public:
     float getRealisticRange() const;     // Most likely range
     float getPessimisticRange() const;   // Worst case scenario
     
+    // Displayed range: smoothed efficiency and output, temperature-compensated,
+    // zero below the 5% reserve. consumptionWhPerKm is the reported average.
+    float updateRange(float batterySoc, float batteryTemp, float consumptionWhPerKm);
+    
+    void setBatteryCapacity(float capacityKwh) { m_batteryCapacityKwh = capacityKwh; }
+    
     // Get efficiency metrics
     float getAverageEfficiency() const;  // Wh/km
     float getRecentEfficiency() const;   // Wh/km (last few minutes)
     
+    // Displayed range smoothing, saved across restarts so the range does not jump at boot
+    float previousRange() const { return m_previousRange; }
+    float smoothedEfficiency() const { return m_smoothedEfficiency; }
+    void restoreSmoothing(float previousRange, float smoothedEfficiency);
+
     // Reset learning
     void reset();
 
 private:
+    static float temperatureFactor(float batteryTemp);
     float calculateRangeEstimate(float efficiency, float batterySoc) const;
     float m_batteryCapacityKwh;          // Total battery capacity
     
@@ -35,6 +47,10 @@ private:
     
     float m_temperatureFactor;           // Efficiency impact from temperature
     int m_sampleCount;
+    
+    // Displayed range smoothing
+    float m_previousRange;
+    float m_smoothedEfficiency;          // Wh/km
 };
 
 #endif // RANGEPREDICTOR_H
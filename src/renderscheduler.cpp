@@ -0,0 +1,155 @@
+#include "renderscheduler.h"
+#include "evvehicledata.h"
+#include <QCoreApplication>
+#include <QQuickWindow>
+#include <QDebug>
+#include <QtMath>
+#include <ctime>
+
+static const int kActivityCheckMs = 250;
+static const qint64 kIdleAfterMs = 5000;       // Quiet this long before throttling
+static const qint64 kFrameRateSampleMs = 1000;
+
+// Below both of these the vehicle counts as parked
+static const float kMovingSpeedKmh = 1.0f;
+static const float kTractionPowerKw = 1.0f;
+
+RenderScheduler::RenderScheduler(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData)
+{
+    m_clock.start();
+
+    m_activityTimer.setInterval(kActivityCheckMs);
+    connect(&m_activityTimer, &QTimer::timeout, this, &RenderScheduler::checkActivity);
+    m_activityTimer.start();
+
+    // Moving off wakes at the first sample instead of the next check
+    connect(m_vehicleData, &EVVehicleData::speedChanged, this, [this] {
+        if (m_idle && isActive()) checkActivity();
+    });
+    connect(m_vehicleData, &EVVehicleData::powerOutputChanged, this, [this] {
+        if (m_idle && isActive()) checkActivity();
+    });
+
+    connect(&m_statsTimer, &QTimer::timeout, this, &RenderScheduler::logStatistics);
+}
+
+void RenderScheduler::watchWindow(QQuickWindow *window)
+{
+    disconnect(m_frameConnection);
+    if (!window) return;
+
+    // frameSwapped comes from the render thread; only bump a counter there
+    m_frameConnection = connect(window, &QQuickWindow::frameSwapped, this, [this] {
+        m_frames.fetch_add(1, std::memory_order_relaxed);
+    }, Qt::DirectConnection);
+}
+
+void RenderScheduler::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    if (!m_enabled) setIdle(false);
+}
+
+bool RenderScheduler::isActive() const
+{
+    return m_vehicleData->speed() >= kMovingSpeedKmh
+        || qAbs(m_vehicleData->powerOutput()) >= kTractionPowerKw;
+}
+
+void RenderScheduler::checkActivity()
+{
+    const qint64 now = m_clock.elapsed();
+
+    if (isActive()) m_lastActiveMs = now;
+    setIdle(m_enabled && now - m_lastActiveMs >= kIdleAfterMs);
+
+    if (now - m_lastSampleMs >= kFrameRateSampleMs) {
+        const int frames = m_frames.exchange(0, std::memory_order_relaxed);
+        const qreal rate = frames * 1000.0 / qMax<qint64>(1, now - m_lastSampleMs);
+        m_statsFrames += frames;
+        m_modeFrames += frames;
+        m_lastSampleMs = now;
+        if (!qFuzzyCompare(m_frameRate + 1.0, rate + 1.0)) {
+            m_frameRate = rate;
+            emit frameRateChanged();
+        }
+    }
+}
+
+void RenderScheduler::setIdle(bool idle)
+{
+    if (m_idle == idle) return;
+    closeModePeriod();
+    m_idle = idle;
+    if (idle) qDebug() << "Render scheduling: idle, continuous values every" << IdleUpdateIntervalMs << "ms";
+    else qDebug() << "Render scheduling: active";
+    emit idleChanged(m_idle);
+}
+
+void RenderScheduler::setStatisticsInterval(int intervalMs)
+{
+    disconnect(m_summaryConnection);
+    if (intervalMs <= 0) {
+        m_statsTimer.stop();
+        return;
+    }
+    m_lastStatsCpuTicks = qint64(std::clock());
+    m_lastStatsMs = m_clock.elapsed();
+    m_statsFrames = 0;
+    m_modeTotals[0] = m_modeTotals[1] = ModeTotals();
+    m_modeCpuTicks = m_lastStatsCpuTicks;
+    m_modeSinceMs = m_lastStatsMs;
+    m_modeFrames = 0;
+    m_statsTimer.start(intervalMs);
+    m_summaryConnection = connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                                  this, &RenderScheduler::logSummary);
+}
+
+void RenderScheduler::closeModePeriod()
+{
+    if (!m_statsTimer.isActive()) return;
+
+    const qint64 cpuTicks = qint64(std::clock());
+    const qint64 now = m_clock.elapsed();
+    ModeTotals &totals = m_modeTotals[m_idle ? 1 : 0];
+    totals.seconds += (now - m_modeSinceMs) / 1000.0;
+    totals.cpuSeconds += double(cpuTicks - m_modeCpuTicks) / CLOCKS_PER_SEC;
+    totals.frames += m_modeFrames;
+    m_modeSinceMs = now;
+    m_modeCpuTicks = cpuTicks;
+    m_modeFrames = 0;
+}
+
+void RenderScheduler::logSummary()
+{
+    // One run through parking and driving gives both rows of the comparison
+    closeModePeriod();
+    for (int idle = 1; idle >= 0; --idle) {
+        const ModeTotals &totals = m_modeTotals[idle];
+        const double seconds = qMax(0.001, totals.seconds);
+        qDebug().noquote() << QStringLiteral("[render] total %1: %2 s, %3 frames/s, process CPU %4%")
+            .arg(idle ? "idle" : "active")
+            .arg(totals.seconds, 0, 'f', 0)
+            .arg(totals.frames / seconds, 0, 'f', 1)
+            .arg(100.0 * totals.cpuSeconds / seconds, 0, 'f', 1);
+    }
+}
+
+void RenderScheduler::logStatistics()
+{
+    const qint64 cpuTicks = qint64(std::clock());
+    const qint64 now = m_clock.elapsed();
+    const double seconds = qMax<qint64>(1, now - m_lastStatsMs) / 1000.0;
+    const double cpuSeconds = double(cpuTicks - m_lastStatsCpuTicks) / CLOCKS_PER_SEC;
+
+    // Compare parked-idle and driving runs; CPU covers the whole process
+    qDebug().noquote() << QStringLiteral("[render] %1, %2 frames/s, process CPU %3%")
+        .arg(m_idle ? "idle" : "active")
+        .arg(m_statsFrames / seconds, 0, 'f', 1)
+        .arg(100.0 * cpuSeconds / seconds, 0, 'f', 1);
+
+    m_statsFrames = 0;
+    m_lastStatsCpuTicks = cpuTicks;
+    m_lastStatsMs = now;
+}
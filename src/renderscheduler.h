@@ -0,0 +1,91 @@
+#ifndef RENDERSCHEDULER_H
+#define RENDERSCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QTimer>
+#include <atomic>
+
+class EVVehicleData;
+class QQuickWindow;
+
+// Decides when the cluster is idle and measures what it renders.
+// The scene graph only draws a frame when something in the scene changed, so
+// the frame rate follows how often values and animations change. Parked with
+// the motor quiet, the inputs still deliver noisy voltage, current and
+// temperature at bus rate; while idle the scheduler asks the data path to
+// coalesce continuous values (IdleUpdateIntervalMs), QML drops its needle
+// Behaviors via the "idle" property, and telltales flash from BlinkClock, so
+// an unchanged scene renders nothing at all. Movement or traction power
+// switches back to full rate at once.
+// Exposed to QML as "RenderScheduler".
+class RenderScheduler : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool idle READ idle NOTIFY idleChanged)
+    Q_PROPERTY(qreal frameRate READ frameRate NOTIFY frameRateChanged)
+
+public:
+    static constexpr int IdleUpdateIntervalMs = 250;
+
+    explicit RenderScheduler(EVVehicleData *vehicleData, QObject *parent = nullptr);
+
+    void watchWindow(QQuickWindow *window);
+
+    // false keeps full-rate updates even when parked
+    void setEnabled(bool enabled);
+
+    // Log mode, frame rate and process CPU usage every intervalMs (0 = off),
+    // and on exit the totals for idle and active time
+    void setStatisticsInterval(int intervalMs);
+
+    bool idle() const { return m_idle; }
+    qreal frameRate() const { return m_frameRate; }
+
+signals:
+    void idleChanged(bool idle);
+    void frameRateChanged();
+
+private slots:
+    void checkActivity();
+    void logStatistics();
+    void logSummary();
+
+private:
+    bool isActive() const;
+    void setIdle(bool idle);
+    void closeModePeriod();
+
+    EVVehicleData *m_vehicleData;
+    bool m_enabled = true;
+    bool m_idle = false;
+    QTimer m_activityTimer;
+    QElapsedTimer m_clock;
+    qint64 m_lastActiveMs = 0;
+
+    // Frames are counted on the render thread and sampled once per second
+    std::atomic<int> m_frames { 0 };
+    QMetaObject::Connection m_frameConnection;
+    qint64 m_lastSampleMs = 0;
+    qreal m_frameRate = 0.0;
+
+    QTimer m_statsTimer;
+    qint64 m_lastStatsMs = 0;
+    qint64 m_lastStatsCpuTicks = 0;
+    int m_statsFrames = 0;
+
+    // Per-mode totals for the exit summary; index 1 is idle
+    struct ModeTotals {
+        double seconds = 0.0;
+        double cpuSeconds = 0.0;
+        qint64 frames = 0;
+    };
+    ModeTotals m_modeTotals[2];
+    qint64 m_modeSinceMs = 0;
+    qint64 m_modeCpuTicks = 0;
+    qint64 m_modeFrames = 0;
+    QMetaObject::Connection m_summaryConnection;
+};
+
+#endif // RENDERSCHEDULER_H
@@ -0,0 +1,381 @@
+#include "routegraph.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QtMath>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace RouteGraphFormat;
+
+static const double kGravity = 9.81;
+static const float kMinTurnDegrees = 30.0f;     // Less is following the road
+
+static double toDegrees(qint32 microdegrees)
+{
+    return microdegrees / 1e6;
+}
+
+// Local flat projection, plenty for the few hundred metres around a junction
+static double distanceMetres(double latitudeA, double longitudeA, double latitudeB, double longitudeB)
+{
+    const double x = (longitudeB - longitudeA) * 111320.0 * qCos(qDegreesToRadians((latitudeA + latitudeB) / 2));
+    const double y = (latitudeB - latitudeA) * 110540.0;
+    return qSqrt(x * x + y * y);
+}
+
+static float bearingDegrees(const RouteVertex &from, const RouteVertex &to)
+{
+    const double x = (to.longitude - from.longitude) * qCos(qDegreesToRadians(from.latitude));
+    const double y = to.latitude - from.latitude;
+    return float(qRadiansToDegrees(std::atan2(x, y)));
+}
+
+template <typename T>
+static bool fits(quint64 offset, quint64 count, quint64 fileSize)
+{
+    return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / sizeof(T);
+}
+
+RouteGraph::~RouteGraph()
+{
+    close();
+}
+
+bool RouteGraph::open(const QString &path)
+{
+    close();
+
+    const QByteArray fileName = QFile::encodeName(path);
+    const int fd = ::open(fileName.constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        qWarning() << "Cannot open route graph" << path << strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(Header)) {
+        qWarning() << "Route graph" << path << "is truncated";
+        ::close(fd);
+        return false;
+    }
+
+    const size_t size = size_t(info.st_size);
+    void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        qWarning() << "mmap failed for" << path << strerror(errno);
+        return false;
+    }
+    // Queries hop across the whole file
+    madvise(address, size, MADV_RANDOM);
+
+    const char *base = static_cast<const char *>(address);
+    m_header = reinterpret_cast<const Header *>(base);
+    m_mappedSize = size;
+    if (m_header->magic != Magic || m_header->version != Version) {
+        qWarning() << "Route graph" << path << "has an unsupported format, rebuild it with ev-routegraph";
+        close();
+        return false;
+    }
+    if (!validate(size)) {
+        qWarning() << "Route graph" << path << "is corrupt";
+        close();
+        return false;
+    }
+
+    m_nodes = reinterpret_cast<const Node *>(base + m_header->nodesOffset);
+    m_edges = reinterpret_cast<const Edge *>(base + m_header->edgesOffset);
+    m_segments = reinterpret_cast<const Segment *>(base + m_header->segmentsOffset);
+    m_points = reinterpret_cast<const Point *>(base + m_header->pointsOffset);
+    m_grid = reinterpret_cast<const quint32 *>(base + m_header->gridOffset);
+    m_gridNodes = reinterpret_cast<const quint32 *>(base + m_header->gridNodesOffset);
+    m_names = base + m_header->namesOffset;
+
+    for (Search *search : { &m_forward, &m_backward }) {
+        search->distance.assign(m_header->nodeCount, 0.0f);
+        search->parent.assign(m_header->nodeCount, NoNode);
+        search->parentEdge.assign(m_header->nodeCount, 0);
+        search->stamp.assign(m_header->nodeCount, 0);
+        search->heap.clear();
+    }
+    m_stamp = 0;
+    return true;
+}
+
+void RouteGraph::close()
+{
+    if (!m_header) return;
+
+    munmap(const_cast<Header *>(m_header), m_mappedSize);
+    m_header = nullptr;
+    m_nodes = nullptr;
+    m_edges = nullptr;
+    m_segments = nullptr;
+    m_points = nullptr;
+    m_grid = nullptr;
+    m_gridNodes = nullptr;
+    m_names = nullptr;
+    m_mappedSize = 0;
+}
+
+bool RouteGraph::validate(quint64 fileSize) const
+{
+    const Header &header = *m_header;
+    const quint64 cells = quint64(header.gridColumns) * header.gridRows;
+    if (header.fileSize != fileSize || cells == 0 || header.nameBytes == 0
+        || !fits<Node>(header.nodesOffset, quint64(header.nodeCount) + 1, fileSize)
+        || !fits<Edge>(header.edgesOffset, header.edgeCount, fileSize)
+        || !fits<Segment>(header.segmentsOffset, header.segmentCount, fileSize)
+        || !fits<Point>(header.pointsOffset, header.pointCount, fileSize)
+        || !fits<quint32>(header.gridOffset, cells + 1, fileSize)
+        || !fits<quint32>(header.gridNodesOffset, header.nodeCount, fileSize)
+        || !fits<char>(header.namesOffset, header.nameBytes, fileSize)) {
+        return false;
+    }
+
+    // Every index a query follows, so a bad file fails here and not mid-route
+    const char *base = reinterpret_cast<const char *>(m_header);
+    const Node *nodes = reinterpret_cast<const Node *>(base + header.nodesOffset);
+    const Edge *edges = reinterpret_cast<const Edge *>(base + header.edgesOffset);
+    for (quint32 node = 0; node < header.nodeCount; ++node) {
+        if (nodes[node].firstEdge > nodes[node + 1].firstEdge) return false;
+    }
+    if (nodes[header.nodeCount].firstEdge != header.edgeCount) return false;
+    for (quint32 index = 0; index < header.edgeCount; ++index) {
+        const Edge &edge = edges[index];
+        const quint32 detailLimit = (edge.flags & Shortcut) ? header.nodeCount : header.segmentCount;
+        if (edge.target >= header.nodeCount || edge.detail >= detailLimit
+            || !(edge.cost >= 0.0f) || std::isinf(edge.cost)) {
+            return false;
+        }
+    }
+
+    const Segment *segments = reinterpret_cast<const Segment *>(base + header.segmentsOffset);
+    for (quint32 index = 0; index < header.segmentCount; ++index) {
+        const Segment &segment = segments[index];
+        if (segment.pointCount < 2 || segment.firstPoint > header.pointCount
+            || segment.pointCount > header.pointCount - segment.firstPoint
+            || segment.nameOffset >= header.nameBytes || !(segment.speedKmh > 0.0f)) {
+            return false;
+        }
+    }
+
+    const quint32 *grid = reinterpret_cast<const quint32 *>(base + header.gridOffset);
+    const quint32 *gridNodes = reinterpret_cast<const quint32 *>(base + header.gridNodesOffset);
+    for (quint64 cell = 0; cell < cells; ++cell) {
+        if (grid[cell] > grid[cell + 1]) return false;
+    }
+    if (grid[0] != 0 || grid[cells] != header.nodeCount) return false;
+    for (quint32 index = 0; index < header.nodeCount; ++index) {
+        if (gridNodes[index] >= header.nodeCount) return false;
+    }
+
+    return base[header.namesOffset + header.nameBytes - 1] == '\0';
+}
+
+quint32 RouteGraph::nearestNode(double latitude, double longitude, double maxMetres) const
+{
+    if (!m_header) return NoNode;
+
+    const double cellDegrees = m_header->gridCellDegrees;
+    const qint64 columns = m_header->gridColumns;
+    const qint64 rows = m_header->gridRows;
+    const qint64 column = qint64(std::floor((longitude - m_header->gridLongitude) / cellDegrees));
+    const qint64 row = qint64(std::floor((latitude - m_header->gridLatitude) / cellDegrees));
+
+    // Ring r holds the cells r steps away; nothing beyond it can be nearer than r cells
+    const double cellMetres = cellDegrees * qMin(110540.0, 111320.0 * qCos(qDegreesToRadians(latitude)));
+    const int maxRing = int(maxMetres / cellMetres) + 1;
+    quint32 best = NoNode;
+    double bestMetres = maxMetres;
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        for (qint64 r = row - ring; r <= row + ring; ++r) {
+            if (r < 0 || r >= rows) continue;
+            const bool edgeRow = r == row - ring || r == row + ring;
+            for (qint64 c = column - ring; c <= column + ring; c += (edgeRow || ring == 0) ? 1 : 2 * ring) {
+                if (c < 0 || c >= columns) continue;
+                const qint64 cell = r * columns + c;
+                for (quint32 i = m_grid[cell]; i < m_grid[cell + 1]; ++i) {
+                    const Node &node = m_nodes[m_gridNodes[i]];
+                    const double metres = distanceMetres(latitude, longitude,
+                                                         toDegrees(node.latitudeE6), toDegrees(node.longitudeE6));
+                    if (metres < bestMetres) {
+                        best = m_gridNodes[i];
+                        bestMetres = metres;
+                    }
+                }
+            }
+        }
+        if (best != NoNode && bestMetres <= ring * cellMetres) break;
+    }
+    return best;
+}
+
+void RouteGraph::relax(Search &search, quint32 node, float distance, quint32 parent, quint32 edge)
+{
+    if (reached(search, node) && search.distance[node] <= distance) return;
+
+    search.stamp[node] = m_stamp;
+    search.distance[node] = distance;
+    search.parent[node] = parent;
+    search.parentEdge[node] = edge;
+    search.heap.push_back({ distance, node });
+    std::push_heap(search.heap.begin(), search.heap.end(), std::greater<>());
+}
+
+RouteResult RouteGraph::route(quint32 source, quint32 target)
+{
+    RouteResult result;
+    if (!m_header || source >= m_header->nodeCount || target >= m_header->nodeCount) return result;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (++m_stamp == 0) {
+        // Wrapped: old stamps could look current again
+        m_forward.stamp.assign(m_forward.stamp.size(), 0);
+        m_backward.stamp.assign(m_backward.stamp.size(), 0);
+        m_stamp = 1;
+    }
+    m_forward.heap.clear();
+    m_backward.heap.clear();
+    relax(m_forward, source, 0.0f, NoNode, 0);
+    relax(m_backward, target, 0.0f, NoNode, 0);
+
+    const float infinity = std::numeric_limits<float>::infinity();
+    float best = infinity;
+    quint32 meeting = NoNode;
+    while (true) {
+        const float forwardKey = m_forward.heap.empty() ? infinity : m_forward.heap.front().first;
+        const float backwardKey = m_backward.heap.empty() ? infinity : m_backward.heap.front().first;
+        if (qMin(forwardKey, backwardKey) >= best) break;   // Also ends when both are exhausted
+
+        const bool forward = forwardKey <= backwardKey;
+        Search &search = forward ? m_forward : m_backward;
+        const Search &other = forward ? m_backward : m_forward;
+        std::pop_heap(search.heap.begin(), search.heap.end(), std::greater<>());
+        const auto [distance, node] = search.heap.back();
+        search.heap.pop_back();
+        if (distance > search.distance[node]) continue;    // Superseded entry
+        result.settledNodes++;
+
+        if (reached(other, node) && distance + other.distance[node] < best) {
+            best = distance + other.distance[node];
+            meeting = node;
+        }
+
+        const quint32 direction = forward ? Forward : Backward;
+        for (quint32 index = m_nodes[node].firstEdge; index < m_nodes[node + 1].firstEdge; ++index) {
+            const Edge &edge = m_edges[index];
+            if (edge.flags & direction) relax(search, edge.target, distance + edge.cost, node, index);
+        }
+    }
+    if (meeting == NoNode) return result;
+
+    // Hierarchy edges source -> meeting -> target, then the road segments under them
+    QVector<Step> steps;
+    QVector<quint32> upward;
+    for (quint32 node = meeting; node != source; node = m_forward.parent[node]) upward.append(node);
+    quint32 from = source;
+    for (auto it = upward.crbegin(); it != upward.crend(); ++it) {
+        if (!unpack(from, *it, m_edges[m_forward.parentEdge[*it]], &steps)) return result;
+        from = *it;
+    }
+    for (quint32 node = meeting; node != target; node = m_backward.parent[node]) {
+        const quint32 next = m_backward.parent[node];
+        if (!unpack(node, next, m_edges[m_backward.parentEdge[node]], &steps)) return result;
+    }
+
+    result.found = true;
+    result.energyWh = best - potential(source) + potential(target);
+    buildPath(steps, &result);
+    result.queryMs = timer.nsecsElapsed() / 1e6f;
+    return result;
+}
+
+bool RouteGraph::unpack(quint32 from, quint32 to, const Edge &edge, QVector<Step> *steps) const
+{
+    if (!(edge.flags & Shortcut)) {
+        steps->append(Step { edge.detail, bool(edge.flags & Reversed), to });
+        return true;
+    }
+
+    // Both halves were the middle node's upward edges when it was contracted
+    const quint32 middle = edge.detail;
+    const Edge *first = nullptr;
+    const Edge *second = nullptr;
+    for (quint32 index = m_nodes[middle].firstEdge; index < m_nodes[middle + 1].firstEdge; ++index) {
+        const Edge &candidate = m_edges[index];
+        if (candidate.target == from && (candidate.flags & Backward)
+            && (!first || candidate.cost < first->cost)) {
+            first = &candidate;
+        } else if (candidate.target == to && (candidate.flags & Forward)
+                   && (!second || candidate.cost < second->cost)) {
+            second = &candidate;
+        }
+    }
+    if (!first || !second) {
+        qWarning() << "Route graph shortcut via" << middle << "cannot be unpacked";
+        return false;
+    }
+    return unpack(from, middle, *first, steps) && unpack(middle, to, *second, steps);
+}
+
+void RouteGraph::buildPath(const QVector<Step> &steps, RouteResult *result) const
+{
+    double distance = 0.0;
+    double time = 0.0;
+    for (int i = 0; i < steps.size(); ++i) {
+        const Step &step = steps[i];
+        const Segment &segment = m_segments[step.segment];
+        const double metresPerSecond = segment.speedKmh / 3.6;
+
+        // Junction between this segment and the previous one
+        if (i > 0 && m_nodes[steps[i - 1].toNode].degree > 2 && result->path.size() >= 2) {
+            const Point &next = m_points[segment.firstPoint + (step.reversed ? segment.pointCount - 2 : 1)];
+            const RouteVertex &corner = result->path.last();
+            const float in = bearingDegrees(result->path[result->path.size() - 2], corner);
+            const float out = bearingDegrees(corner, RouteVertex { toDegrees(next.latitudeE6),
+                                                                    toDegrees(next.longitudeE6), 0.0f, 0.0f });
+            const float turn = std::remainder(out - in, 360.0f);
+            if (qAbs(turn) >= kMinTurnDegrees) {
+                result->maneuvers.append(RouteManeuver {
+                    turn > 0.0f ? RouteManeuver::TurnRight : RouteManeuver::TurnLeft,
+                    float(distance), QString::fromUtf8(m_names + segment.nameOffset) });
+            }
+        }
+
+        for (quint32 j = (i == 0 ? 0 : 1); j < segment.pointCount; ++j) {
+            const Point &point = m_points[segment.firstPoint + (step.reversed ? segment.pointCount - 1 - j : j)];
+            const RouteVertex vertex { toDegrees(point.latitudeE6), toDegrees(point.longitudeE6), 0.0f, 0.0f };
+            if (!result->path.isEmpty()) {
+                const RouteVertex &previous = result->path.last();
+                const double metres = distanceMetres(previous.latitude, previous.longitude,
+                                                     vertex.latitude, vertex.longitude);
+                distance += metres;
+                time += metres / metresPerSecond;
+            }
+            result->path.append(RouteVertex { vertex.latitude, vertex.longitude, float(distance), float(time) });
+        }
+    }
+
+    result->distanceMetres = float(distance);
+    result->durationSeconds = float(time);
+    result->maneuvers.append(RouteManeuver { RouteManeuver::Arrive, float(distance), QString() });
+}
+
+float RouteGraph::potential(quint32 node) const
+{
+    // Same shift ev-routegraph applied to the edge costs, in Wh
+    return float(m_header->regenEfficiency * m_header->vehicleMassKg * kGravity
+                 * m_nodes[node].elevation / 3600.0);
+}
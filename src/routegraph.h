@@ -0,0 +1,107 @@
+#ifndef ROUTEGRAPH_H
+#define ROUTEGRAPH_H
+
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+#include <vector>
+#include "routegraphformat.h"
+
+// One point of a planned route, with distance and driving time from its start
+struct RouteVertex {
+    double latitude;
+    double longitude;
+    float distanceMetres;
+    float timeSeconds;
+};
+
+struct RouteManeuver {
+    enum Type {
+        TurnLeft,
+        TurnRight,
+        Arrive
+    };
+
+    Type type;
+    float distanceMetres;       // From the start of the route
+    QString street;             // Road taken after the manoeuvre
+};
+
+struct RouteResult {
+    bool found = false;
+    QVector<RouteVertex> path;
+    QVector<RouteManeuver> maneuvers;
+    float energyWh = 0.0f;      // Battery energy, net of regen
+    float distanceMetres = 0.0f;
+    float durationSeconds = 0.0f;
+    float queryMs = 0.0f;
+    int settledNodes = 0;
+};
+
+// Energy-optimal routing over a graph built by ev-routegraph.
+// The file is memory-mapped read-only and used in place: open() checks that
+// every index in it is in range, after which a query touches only the pages
+// of the nodes it visits. route() runs a bidirectional Dijkstra that only
+// climbs the contraction hierarchy from both ends, then unpacks shortcuts into
+// road segments. Query state is kept between calls, so one RouteGraph serves
+// one thread.
+class RouteGraph
+{
+public:
+    static constexpr quint32 NoNode = 0xFFFFFFFF;
+
+    RouteGraph() = default;
+    ~RouteGraph();
+
+    RouteGraph(const RouteGraph &) = delete;
+    RouteGraph &operator=(const RouteGraph &) = delete;
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    quint32 nodeCount() const { return m_header ? m_header->nodeCount : 0; }
+
+    // Closest junction within maxMetres, NoNode if there is none
+    quint32 nearestNode(double latitude, double longitude, double maxMetres = 2000.0) const;
+
+    RouteResult route(quint32 source, quint32 target);
+
+private:
+    struct Search {
+        std::vector<float> distance;
+        std::vector<quint32> parent;
+        std::vector<quint32> parentEdge;
+        std::vector<quint32> stamp;     // Entries are valid for the current query only
+        std::vector<std::pair<float, quint32>> heap;
+    };
+    struct Step {
+        quint32 segment;
+        bool reversed;
+        quint32 toNode;
+    };
+
+    bool validate(quint64 fileSize) const;
+    bool reached(const Search &search, quint32 node) const { return search.stamp[node] == m_stamp; }
+    void relax(Search &search, quint32 node, float distance, quint32 parent, quint32 edge);
+    bool unpack(quint32 from, quint32 to, const RouteGraphFormat::Edge &edge, QVector<Step> *steps) const;
+    void buildPath(const QVector<Step> &steps, RouteResult *result) const;
+    float potential(quint32 node) const;
+
+    const RouteGraphFormat::Header *m_header = nullptr;
+    const RouteGraphFormat::Node *m_nodes = nullptr;
+    const RouteGraphFormat::Edge *m_edges = nullptr;
+    const RouteGraphFormat::Segment *m_segments = nullptr;
+    const RouteGraphFormat::Point *m_points = nullptr;
+    const quint32 *m_grid = nullptr;
+    const quint32 *m_gridNodes = nullptr;
+    const char *m_names = nullptr;
+    size_t m_mappedSize = 0;
+
+    Search m_forward;
+    Search m_backward;
+    quint32 m_stamp = 0;
+};
+
+Q_DECLARE_METATYPE(RouteResult)
+
+#endif // ROUTEGRAPH_H
@@ -0,0 +1,91 @@
+#ifndef ROUTEGRAPHFORMAT_H
+#define ROUTEGRAPHFORMAT_H
+
+#include <QtGlobal>
+
+// On-disk layout of the routing graph: written by ev-routegraph
+// (tools/routegraph.cpp), memory-mapped as-is by RouteGraph.
+// Native byte order, every section 8-byte aligned, offsets from the start of
+// the file. Nodes are road junctions; edges are the upward half of a
+// contraction hierarchy, so a query only ever walks towards more important
+// nodes from both ends.
+namespace RouteGraphFormat {
+
+static const quint32 Magic = 0x47525645;        // "EVRG"
+static const quint32 Version = 1;
+
+struct Header {
+    quint32 magic;
+    quint32 version;
+    quint32 nodeCount;
+    quint32 edgeCount;
+    quint32 segmentCount;
+    quint32 pointCount;
+    quint32 nameBytes;
+    quint32 gridColumns;
+    quint32 gridRows;
+    float gridCellDegrees;
+    double gridLatitude;            // South-west corner of the grid
+    double gridLongitude;
+
+    // Energy model the edge costs were computed with
+    float vehicleMassKg;
+    float regenEfficiency;
+
+    quint64 nodesOffset;            // Node[nodeCount + 1], the last one only ends the edge list
+    quint64 edgesOffset;            // Edge[edgeCount]
+    quint64 segmentsOffset;         // Segment[segmentCount]
+    quint64 pointsOffset;           // Point[pointCount]
+    quint64 gridOffset;             // quint32[gridColumns * gridRows + 1], first node of each cell
+    quint64 gridNodesOffset;        // quint32[nodeCount], node ids ordered by cell
+    quint64 namesOffset;            // NUL-terminated UTF-8; offset 0 is the empty name
+    quint64 fileSize;
+};
+
+struct Node {
+    qint32 latitudeE6;              // Microdegrees
+    qint32 longitudeE6;
+    float elevation;                // Metres
+    quint32 firstEdge;              // Upward edges are [firstEdge, next node's firstEdge)
+    quint32 degree;                 // Road segments meeting here
+};
+
+enum EdgeFlag : quint32 {
+    Forward = 0x1,                  // Usable from this node to target
+    Backward = 0x2,                 // Usable from target to this node
+    Shortcut = 0x4,                 // detail is the contracted middle node
+    Reversed = 0x8                  // Original edge running against its segment's geometry
+};
+
+// Cost is battery energy in Wh plus potential(from) - potential(to), with
+// potential = regenEfficiency * mass * g * elevation: downhill regen never
+// recovers more than that, so no edge is negative and Dijkstra applies. The
+// shift cancels along a path except at its two ends.
+struct Edge {
+    quint32 target;
+    float cost;
+    quint32 detail;                 // Segment index, or middle node for shortcuts
+    quint32 flags;
+};
+
+struct Segment {
+    quint32 firstPoint;             // Geometry from one junction to the other, both included
+    quint32 pointCount;
+    quint32 nameOffset;
+    float lengthMetres;
+    float speedKmh;
+};
+
+struct Point {
+    qint32 latitudeE6;
+    qint32 longitudeE6;
+};
+
+inline quint64 aligned(quint64 offset)
+{
+    return (offset + 7) & ~quint64(7);
+}
+
+} // namespace RouteGraphFormat
+
+#endif // ROUTEGRAPHFORMAT_H
@@ -0,0 +1,264 @@
+#include "routeplanner.h"
+#include "evvehicledata.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QGeoCoordinate>
+#include <QTime>
+#include <QtMath>
+#include <limits>
+
+static const int kGuidanceIntervalMs = 1000;
+static const double kOffRouteMetres = 40.0;
+static const int kOffRouteChecks = 3;           // Consecutive, so one GPS jump does not replan
+static const float kArrivedMetres = 25.0f;
+static const int kMatchWindow = 200;            // Vertices ahead of the last match searched first
+
+void RouteWorker::open(const QString &path)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = m_graph.open(path);
+    if (ok) {
+        qDebug().noquote() << QStringLiteral("[route] Loaded %1 junctions from %2 in %3 ms")
+            .arg(m_graph.nodeCount()).arg(path).arg(timer.elapsed());
+    }
+    emit opened(ok);
+}
+
+void RouteWorker::plan(quint32 request, double fromLatitude, double fromLongitude,
+                       double toLatitude, double toLongitude)
+{
+    RouteResult result;
+    const quint32 source = m_graph.nearestNode(fromLatitude, fromLongitude);
+    const quint32 target = m_graph.nearestNode(toLatitude, toLongitude);
+    if (source != RouteGraph::NoNode && target != RouteGraph::NoNode) {
+        result = m_graph.route(source, target);
+    }
+    emit planned(request, result);
+}
+
+RoutePlanner::RoutePlanner(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData), m_worker(new RouteWorker)
+{
+    m_thread.setObjectName("routing");
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    connect(m_worker, &RouteWorker::opened, this, [this](bool ok) {
+        if (m_available == ok) return;
+        m_available = ok;
+        emit availableChanged();
+    });
+    connect(m_worker, &RouteWorker::planned, this, &RoutePlanner::applyRoute);
+
+    m_guidanceTimer.setInterval(kGuidanceIntervalMs);
+    connect(&m_guidanceTimer, &QTimer::timeout, this, &RoutePlanner::updateGuidance);
+}
+
+RoutePlanner::~RoutePlanner()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void RoutePlanner::open(const QString &path)
+{
+    if (!m_thread.isRunning()) m_thread.start(QThread::LowPriority);
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, path] {
+        worker->open(path);
+    }, Qt::QueuedConnection);
+}
+
+void RoutePlanner::routeTo(double latitude, double longitude)
+{
+    if (!m_available) {
+        emit routeFailed(QStringLiteral("No route graph loaded"));
+        return;
+    }
+    m_destinationLatitude = latitude;
+    m_destinationLongitude = longitude;
+    request();
+}
+
+void RoutePlanner::cancel()
+{
+    if (m_pendingRequest != 0) {
+        m_pendingRequest = 0;
+        emit busyChanged();
+    }
+    if (isActive()) clearRoute();
+}
+
+void RoutePlanner::request()
+{
+    const VehicleState vehicle = m_vehicleData->snapshot();
+    const bool wasBusy = isBusy();
+    if (++m_lastRequest == 0) m_lastRequest = 1;
+    m_pendingRequest = m_lastRequest;
+    if (!wasBusy) emit busyChanged();
+
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, request = m_pendingRequest,
+                                         fromLatitude = vehicle.gpsLatitude, fromLongitude = vehicle.gpsLongitude,
+                                         toLatitude = m_destinationLatitude, toLongitude = m_destinationLongitude] {
+        worker->plan(request, fromLatitude, fromLongitude, toLatitude, toLongitude);
+    }, Qt::QueuedConnection);
+}
+
+void RoutePlanner::applyRoute(quint32 request, const RouteResult &result)
+{
+    if (request != m_pendingRequest) return;   // Cancelled or superseded
+    m_pendingRequest = 0;
+    emit busyChanged();
+
+    if (!result.found || result.path.size() < 2) {
+        // A failed replan keeps guiding along the old route
+        qWarning().noquote() << QStringLiteral("[route] No route to %1, %2")
+            .arg(m_destinationLatitude, 0, 'f', 5).arg(m_destinationLongitude, 0, 'f', 5);
+        emit routeFailed(QStringLiteral("No route found"));
+        return;
+    }
+
+    m_route = result;
+    m_path.clear();
+    m_points.clear();
+    m_path.reserve(result.path.size());
+    m_points.reserve(result.path.size());
+    for (const RouteVertex &vertex : result.path) {
+        m_path.append(QVariant::fromValue(QGeoCoordinate(vertex.latitude, vertex.longitude)));
+        m_points.append(project(vertex.latitude, vertex.longitude));
+    }
+    m_vertex = 0;
+    m_offRouteCount = 0;
+
+    qDebug().noquote() << QStringLiteral("[route] %1 km, %2 kWh, %3 min, %4 turns; query %5 ms, %6 nodes settled")
+        .arg(distanceKm(), 0, 'f', 1)
+        .arg(energyKwh(), 0, 'f', 2)
+        .arg(result.durationSeconds / 60.0f, 0, 'f', 0)
+        .arg(result.maneuvers.size() - 1)
+        .arg(result.queryMs, 0, 'f', 2)
+        .arg(result.settledNodes);
+    emit routeChanged();
+
+    updateGuidance();
+    m_guidanceTimer.start();
+}
+
+void RoutePlanner::clearRoute()
+{
+    m_guidanceTimer.stop();
+    m_route = RouteResult();
+    m_path.clear();
+    m_points.clear();
+    m_nextStreet.clear();
+
+    m_vehicleData->setNavigationActive(false);
+    m_vehicleData->setNextTurnIcon(QString());
+    m_vehicleData->setNextTurnDistance(QString());
+    m_vehicleData->setDestinationEta(QString());
+    m_vehicleData->setDistToDestination(0.0f);
+    emit routeChanged();
+    emit guidanceChanged();
+}
+
+QPointF RoutePlanner::project(double latitude, double longitude) const
+{
+    // Flat around the route start; good to a few metres over a city route
+    const RouteVertex &origin = m_route.path.first();
+    return QPointF((longitude - origin.longitude) * 111320.0 * qCos(qDegreesToRadians(origin.latitude)),
+                   (latitude - origin.latitude) * 110540.0);
+}
+
+void RoutePlanner::updateGuidance()
+{
+    if (!isActive()) return;
+
+    const VehicleState vehicle = m_vehicleData->snapshot();
+    const QPointF position = project(vehicle.gpsLatitude, vehicle.gpsLongitude);
+
+    // Closest point on the route: ahead of the last match first, so a route
+    // that passes the same street twice is followed in order
+    int vertex = -1;
+    double fraction = 0.0;
+    double offset = 0.0;
+    auto match = [&](int first, int last) {
+        vertex = -1;
+        offset = std::numeric_limits<double>::max();
+        for (int i = first; i < last; ++i) {
+            const QPointF start = m_points[i];
+            const QPointF direction = m_points[i + 1] - start;
+            const double lengthSquared = QPointF::dotProduct(direction, direction);
+            const double t = lengthSquared > 0.0
+                ? qBound(0.0, QPointF::dotProduct(position - start, direction) / lengthSquared, 1.0) : 0.0;
+            const QPointF delta = position - (start + t * direction);
+            const double distance = qSqrt(QPointF::dotProduct(delta, delta));
+            if (distance < offset) {
+                vertex = i;
+                fraction = t;
+                offset = distance;
+            }
+        }
+    };
+    const int lastPiece = int(m_points.size()) - 1;
+    match(qMax(0, m_vertex - 2), qMin(lastPiece, m_vertex + kMatchWindow));
+    if (offset > kOffRouteMetres) match(0, lastPiece);
+
+    if (offset > kOffRouteMetres) {
+        if (++m_offRouteCount >= kOffRouteChecks && !isBusy()) {
+            qDebug().noquote() << QStringLiteral("[route] %1 m off the route, replanning").arg(qRound(offset));
+            m_offRouteCount = 0;
+            request();
+        }
+        return;
+    }
+    m_offRouteCount = 0;
+    m_vertex = vertex;
+
+    const RouteVertex &from = m_route.path[vertex];
+    const RouteVertex &to = m_route.path[vertex + 1];
+    const float along = from.distanceMetres + float(fraction) * (to.distanceMetres - from.distanceMetres);
+    const float elapsed = from.timeSeconds + float(fraction) * (to.timeSeconds - from.timeSeconds);
+    const float remaining = m_route.distanceMetres - along;
+    if (remaining < kArrivedMetres) {
+        qDebug() << "[route] Arrived";
+        clearRoute();
+        return;
+    }
+
+    // Arrive is always last, so there is a next manoeuvre
+    const QVector<RouteManeuver> &maneuvers = m_route.maneuvers;
+    const RouteManeuver *next = &maneuvers.constLast();
+    for (const RouteManeuver &maneuver : maneuvers) {
+        if (maneuver.distanceMetres > along) {
+            next = &maneuver;
+            break;
+        }
+    }
+
+    QString icon;
+    QString street = next->street;
+    switch (next->type) {
+    case RouteManeuver::TurnLeft: icon = QStringLiteral("turn_left"); break;
+    case RouteManeuver::TurnRight: icon = QStringLiteral("turn_right"); break;
+    case RouteManeuver::Arrive:
+        icon = QStringLiteral("navigation_arrow");
+        street = QStringLiteral("Destination");
+        break;
+    }
+
+    const int secondsLeft = qRound(m_route.durationSeconds - elapsed);
+    m_vehicleData->setNavigationActive(true);
+    m_vehicleData->setNextTurnIcon(icon);
+    m_vehicleData->setNextTurnDistance(formatDistance(next->distanceMetres - along));
+    m_vehicleData->setDestinationEta(QTime::currentTime().addSecs(secondsLeft).toString("HH:mm"));
+    m_vehicleData->setDistToDestination(remaining / 1000.0f);
+
+    if (m_nextStreet != street) {
+        m_nextStreet = street;
+        emit guidanceChanged();
+    }
+}
+
+QString RoutePlanner::formatDistance(float metres)
+{
+    if (metres < 1000.0f) return QStringLiteral("%1 m").arg(qMax(0, qRound(metres / 10.0f) * 10));
+    return QStringLiteral("%1 km").arg(metres / 1000.0f, 0, 'f', 1);
+}
@@ -0,0 +1,105 @@
+#ifndef ROUTEPLANNER_H
+#define ROUTEPLANNER_H
+
+#include <QObject>
+#include <QPointF>
+#include <QThread>
+#include <QTimer>
+#include <QVariantList>
+#include <QVector>
+#include "routegraph.h"
+
+class EVVehicleData;
+
+// Owns the RouteGraph and answers route requests on the routing thread
+class RouteWorker : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::QObject;
+
+public slots:
+    void open(const QString &path);
+    void plan(quint32 request, double fromLatitude, double fromLongitude,
+              double toLatitude, double toLongitude);
+
+signals:
+    void opened(bool ok);
+    void planned(quint32 request, const RouteResult &result);
+
+private:
+    RouteGraph m_graph;
+};
+
+// On-board navigation: plans energy-optimal routes from the vehicle position
+// and turns the GPS track into turn-by-turn guidance in EVVehicleData.
+// Queries run on their own thread; the GUI thread only matches the position
+// against the finished route once a second. Leaving the route by more than
+// 40 m for a few seconds plans again from where the vehicle is.
+class RoutePlanner : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool available READ isAvailable NOTIFY availableChanged)
+    Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+    Q_PROPERTY(bool active READ isActive NOTIFY routeChanged)
+    Q_PROPERTY(QVariantList path READ path NOTIFY routeChanged)
+    Q_PROPERTY(float distanceKm READ distanceKm NOTIFY routeChanged)
+    Q_PROPERTY(float energyKwh READ energyKwh NOTIFY routeChanged)
+    Q_PROPERTY(QString nextStreet READ nextStreet NOTIFY guidanceChanged)
+
+public:
+    explicit RoutePlanner(EVVehicleData *vehicleData, QObject *parent = nullptr);
+    ~RoutePlanner();
+
+    // Maps and checks the graph on the routing thread; available once it is loaded
+    void open(const QString &path);
+
+    bool isAvailable() const { return m_available; }
+    bool isBusy() const { return m_pendingRequest != 0; }
+    bool isActive() const { return m_route.found; }
+    QVariantList path() const { return m_path; }
+    float distanceKm() const { return m_route.distanceMetres / 1000.0f; }
+    float energyKwh() const { return m_route.energyWh / 1000.0f; }
+    QString nextStreet() const { return m_nextStreet; }
+
+    Q_INVOKABLE void routeTo(double latitude, double longitude);
+    Q_INVOKABLE void cancel();
+
+signals:
+    void availableChanged();
+    void busyChanged();
+    void routeChanged();
+    void guidanceChanged();
+    void routeFailed(const QString &reason);
+
+private slots:
+    void updateGuidance();
+
+private:
+    void request();
+    void applyRoute(quint32 request, const RouteResult &result);
+    void clearRoute();
+    QPointF project(double latitude, double longitude) const;
+    static QString formatDistance(float metres);
+
+    EVVehicleData *m_vehicleData;
+    QThread m_thread;
+    RouteWorker *m_worker;
+    QTimer m_guidanceTimer;
+    bool m_available = false;
+
+    double m_destinationLatitude = 0.0;
+    double m_destinationLongitude = 0.0;
+    quint32 m_lastRequest = 0;
+    quint32 m_pendingRequest = 0;       // 0 = none in flight
+
+    // Current route, its vertices in metres around the first one for matching
+    RouteResult m_route;
+    QVariantList m_path;
+    QVector<QPointF> m_points;
+    int m_vertex = 0;                   // Start of the route piece last matched
+    int m_offRouteCount = 0;
+    QString m_nextStreet;
+};
+
+#endif // ROUTEPLANNER_H
@@ -0,0 +1,223 @@
+#include "schemamigrator.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QDebug>
+
+// Legacy DATETIME text -> integer epoch milliseconds. The baseline bound local
+// QDateTimes, stored as ISO strings without an offset; 'utc' reads them as local
+// time (at the offset in force on that date, so DST too) instead of as UTC.
+#define JULIANDAY_UTC(column) "julianday(" column ", 'utc')"
+#define EPOCH_MS(column) "CAST(ROUND((" JULIANDAY_UTC(column) " - 2440587.5) * 86400000.0) AS INTEGER)"
+
+SchemaMigrator::SchemaMigrator(const QSqlDatabase &db)
+    : m_db(db)
+{
+}
+
+const QList<Migration> &SchemaMigrator::migrations()
+{
+    // Append only - never edit a migration that has shipped
+    static const QList<Migration> list = {
+        {
+            1, "Baseline schema (trips, settings, lifetime totals)",
+            {
+                R"(CREATE TABLE IF NOT EXISTS trips (
+                    id INTEGER PRIMARY KEY AUTOINCREMENT,
+                    start_time DATETIME,
+                    end_time DATETIME,
+                    distance_km REAL,
+                    energy_kwh REAL,
+                    avg_efficiency REAL,
+                    start_soc REAL,
+                    end_soc REAL
+                ))",
+                R"(CREATE TABLE IF NOT EXISTS settings (
+                    key TEXT PRIMARY KEY,
+                    value TEXT
+                ))",
+                R"(CREATE TABLE IF NOT EXISTS trip_totals (
+                    id INTEGER PRIMARY KEY CHECK (id = 1),
+                    total_distance_km REAL NOT NULL DEFAULT 0,
+                    total_energy_kwh REAL NOT NULL DEFAULT 0,
+                    trip_count INTEGER NOT NULL DEFAULT 0
+                ))",
+                R"(INSERT OR IGNORE INTO trip_totals (id, total_distance_km, total_energy_kwh, trip_count)
+                   SELECT 1, COALESCE(SUM(distance_km), 0), COALESCE(SUM(energy_kwh), 0), COUNT(*) FROM trips)"
+            }
+        },
+        {
+            2, "Trips: integer epoch-ms timestamps, avg speed, end_time index",
+            {
+                R"(CREATE TABLE trips_v2 (
+                    id INTEGER PRIMARY KEY AUTOINCREMENT,
+                    start_time INTEGER NOT NULL,
+                    end_time INTEGER NOT NULL,
+                    distance_km REAL,
+                    energy_kwh REAL,
+                    avg_efficiency REAL,
+                    avg_speed_kmh REAL,
+                    start_soc REAL,
+                    end_soc REAL
+                ))",
+                "INSERT INTO trips_v2 (id, start_time, end_time, distance_km, energy_kwh, "
+                "                      avg_efficiency, avg_speed_kmh, start_soc, end_soc) "
+                "SELECT id, " EPOCH_MS("start_time") ", " EPOCH_MS("end_time") ", "
+                "       distance_km, energy_kwh, avg_efficiency, "
+                "       CASE WHEN " JULIANDAY_UTC("end_time") " > " JULIANDAY_UTC("start_time") " "
+                "            THEN distance_km / ((" JULIANDAY_UTC("end_time") " - " JULIANDAY_UTC("start_time") ") * 24.0) "
+                "            ELSE 0 END, "
+                "       start_soc, end_soc "
+                "FROM trips WHERE start_time IS NOT NULL AND end_time IS NOT NULL",
+                "DROP TABLE trips",
+                "ALTER TABLE trips_v2 RENAME TO trips",
+                "CREATE INDEX IF NOT EXISTS idx_trips_end_time ON trips (end_time)",
+                R"(CREATE TRIGGER IF NOT EXISTS trips_totals_insert AFTER INSERT ON trips
+                BEGIN
+                    UPDATE trip_totals
+                    SET total_distance_km = total_distance_km + COALESCE(NEW.distance_km, 0),
+                        total_energy_kwh = total_energy_kwh + COALESCE(NEW.energy_kwh, 0),
+                        trip_count = trip_count + 1
+                    WHERE id = 1;
+                END)"
+            }
+        },
+        {
+            3, "Charging session log",
+            {
+                R"(CREATE TABLE IF NOT EXISTS charging_logs (
+                    id INTEGER PRIMARY KEY AUTOINCREMENT,
+                    start_time INTEGER NOT NULL,
+                    end_time INTEGER NOT NULL,
+                    plug_in_soc REAL,
+                    unplug_soc REAL,
+                    energy_added_kwh REAL,
+                    max_power_kw REAL,
+                    avg_power_kw REAL,
+                    location_lat REAL,
+                    location_lon REAL
+                ))",
+                "CREATE INDEX IF NOT EXISTS idx_charging_logs_end_time ON charging_logs (end_time)"
+            }
+        },
+        {
+            4, "Hourly/daily/monthly trip and charge rollups",
+            {
+                "ALTER TABLE trips ADD COLUMN regen_kwh REAL NOT NULL DEFAULT 0",
+                // bucket: 0 = hour, 1 = day, 2 = month (RollupBucket)
+                R"(CREATE TABLE IF NOT EXISTS trip_rollups (
+                    bucket INTEGER NOT NULL,
+                    bucket_start INTEGER NOT NULL,
+                    distance_km REAL NOT NULL DEFAULT 0,
+                    energy_kwh REAL NOT NULL DEFAULT 0,
+                    regen_kwh REAL NOT NULL DEFAULT 0,
+                    trip_count INTEGER NOT NULL DEFAULT 0,
+                    charge_kwh REAL NOT NULL DEFAULT 0,
+                    charge_sessions INTEGER NOT NULL DEFAULT 0,
+                    efficiency_histogram BLOB,
+                    PRIMARY KEY (bucket, bucket_start)
+                ) WITHOUT ROWID)"
+            }
+        },
+        {
+            5, "Trip GPS extent and simplified route",
+            {
+                "ALTER TABLE trips ADD COLUMN min_lat REAL",
+                "ALTER TABLE trips ADD COLUMN min_lon REAL",
+                "ALTER TABLE trips ADD COLUMN max_lat REAL",
+                "ALTER TABLE trips ADD COLUMN max_lon REAL",
+                // Big-endian int32 microdegree pairs (latitude, longitude)
+                "ALTER TABLE trips ADD COLUMN route BLOB"
+            }
+        },
+        {
+            6, "Resumable rollup backfill",
+            {
+                // A row here means trip_rollups still has to be rebuilt from history;
+                // DatabaseManager::rebuildRollups() deletes it in the same transaction
+                "CREATE TABLE IF NOT EXISTS rollup_backfill (pending INTEGER PRIMARY KEY)",
+                "INSERT OR IGNORE INTO rollup_backfill (pending) VALUES (1)"
+            }
+        }
+    };
+    return list;
+}
+
+int SchemaMigrator::latestVersion()
+{
+    return migrations().isEmpty() ? 0 : migrations().last().version;
+}
+
+int SchemaMigrator::currentVersion() const
+{
+    QSqlQuery query(m_db);
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return 0;
+}
+
+bool SchemaMigrator::applyNext()
+{
+    const int version = currentVersion();
+    for (const Migration &migration : migrations()) {
+        if (migration.version > version) {
+            return apply(migration);
+        }
+    }
+    return true;
+}
+
+bool SchemaMigrator::migrate()
+{
+    const int from = currentVersion();
+    if (from >= latestVersion()) {
+        return true;
+    }
+
+    qDebug() << "SchemaMigrator: Upgrading schema from version" << from << "to" << latestVersion();
+    while (!isUpToDate()) {
+        if (!applyNext()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SchemaMigrator::apply(const Migration &migration)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_db.transaction()) {
+        qCritical() << "SchemaMigrator: Cannot begin transaction:" << m_db.lastError().text();
+        return false;
+    }
+
+    QSqlQuery query(m_db);
+    for (const QString &statement : migration.statements) {
+        if (!query.exec(statement)) {
+            qCritical() << "SchemaMigrator: Migration" << migration.version << "failed:"
+                        << query.lastError().text();
+            m_db.rollback();
+            return false;
+        }
+    }
+
+    // user_version lives in the database header and is covered by the transaction
+    if (!query.exec(QString("PRAGMA user_version = %1").arg(migration.version))) {
+        qCritical() << "SchemaMigrator: Cannot set user_version:" << query.lastError().text();
+        m_db.rollback();
+        return false;
+    }
+
+    if (!m_db.commit()) {
+        qCritical() << "SchemaMigrator: Commit failed:" << m_db.lastError().text();
+        m_db.rollback();
+        return false;
+    }
+
+    qDebug() << "SchemaMigrator: Applied" << migration.version << "-" << migration.description
+             << "in" << timer.elapsed() << "ms";
+    return true;
+}
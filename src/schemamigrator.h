@@ -0,0 +1,39 @@
+#ifndef SCHEMAMIGRATOR_H
+#define SCHEMAMIGRATOR_H
+
+#include <QSqlDatabase>
+#include <QStringList>
+#include <QList>
+
+struct Migration {
+    int version;               // PRAGMA user_version after this migration
+    QString description;
+    QStringList statements;    // Executed in order inside one transaction
+};
+
+// Brings the database schema up to date using PRAGMA user_version.
+// Each migration is applied and committed on its own, so an interrupted run
+// (power loss mid-upgrade) resumes from the last completed version next boot.
+class SchemaMigrator
+{
+public:
+    explicit SchemaMigrator(const QSqlDatabase &db);
+
+    int currentVersion() const;
+    static int latestVersion();
+    bool isUpToDate() const { return currentVersion() >= latestVersion(); }
+
+    // Applies the next pending migration. Returns false on error.
+    bool applyNext();
+
+    // Applies every pending migration in order
+    bool migrate();
+
+private:
+    static const QList<Migration> &migrations();
+    bool apply(const Migration &migration);
+
+    QSqlDatabase m_db;
+};
+
+#endif // SCHEMAMIGRATOR_H
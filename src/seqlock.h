@@ -0,0 +1,77 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for a trivially copyable value.
+// The writer never blocks; readers retry while a write is in progress.
+// The payload is kept in relaxed atomic words rather than a plain T so that
+// concurrent reads are well-defined (and clean under ThreadSanitizer). The
+// layout is address-free, so it can also live in shared memory.
+template <typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock needs a trivially copyable type");
+    static_assert(std::atomic<quint64>::is_always_lock_free, "SeqLock needs lock-free 64-bit atomics");
+
+public:
+    SeqLock()
+    {
+        for (std::atomic<quint64> &word : m_words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Writer side - only one thread/process may call this
+    void store(const T &value)
+    {
+        quint64 buffer[kWords] = {};
+        memcpy(buffer, &value, sizeof(T));
+
+        const quint32 sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);   // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < kWords; ++i) {
+            m_words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Reader side - any number of threads/processes. Returns the sequence read.
+    quint32 load(T *value) const
+    {
+        quint64 buffer[kWords];
+        quint32 before = 0;
+        quint32 after = 0;
+
+        do {
+            before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+
+            for (size_t i = 0; i < kWords; ++i) {
+                buffer[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        memcpy(value, buffer, sizeof(T));
+        return before;
+    }
+
+    // Even and unchanged since the last load() means nothing new to read
+    quint32 sequence() const { return m_sequence.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(quint64) - 1) / sizeof(quint64);
+
+    std::atomic<quint32> m_sequence{0};
+    std::atomic<quint64> m_words[kWords];
+};
+
+#endif // SEQLOCK_H
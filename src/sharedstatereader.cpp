@@ -0,0 +1,150 @@
+#include "sharedstatereader.h"
+#include "evvehicledata.h"
+#include "signaldecimator.h"
+#include "signaljitterbuffer.h"
+#include <QDebug>
+
+static const int kFrameIntervalMs = 16;
+static const int kAttachRetryMs = 1000;
+
+SharedStateReader::SharedStateReader(EVVehicleData *vehicleData, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData)
+{
+    m_pollTimer.setTimerType(Qt::PreciseTimer);
+    m_pollTimer.setInterval(kFrameIntervalMs);
+    connect(&m_pollTimer, &QTimer::timeout, this, &SharedStateReader::poll);
+}
+
+void SharedStateReader::open(const QString &name)
+{
+    m_name = name;
+    m_sequence = 0;
+    m_lastAttachAttemptMs = 0;
+    poll();
+    m_pollTimer.start();
+}
+
+bool SharedStateReader::isSourceActive(InputSource source) const
+{
+    return m_connected && (m_activeSources & (1u << static_cast<int>(source)));
+}
+
+bool SharedStateReader::isSignalStale(int signal) const
+{
+    if (signal < 0 || signal >= VehicleSignals::count()) return false;
+    return !m_connected || (m_staleMask & (quint64(1) << signal));
+}
+
+int SharedStateReader::staleCount() const
+{
+    if (!m_connected) return VehicleSignals::count();
+    int count = 0;
+    for (quint64 mask = m_staleMask; mask; mask &= mask - 1) count++;
+    return count;
+}
+
+QStringList SharedStateReader::staleSignals() const
+{
+    QStringList names;
+    for (int signal = 0; signal < VehicleSignals::count(); ++signal) {
+        if (isSignalStale(signal)) {
+            names.append(QString::fromLatin1(VehicleSignals::name(static_cast<VehicleSignal>(signal))));
+        }
+    }
+    return names;
+}
+
+void SharedStateReader::poll()
+{
+    const qint64 now = SharedVehicleState::monotonicMs();
+
+    if (!m_shared.isAttached()) {
+        if (now - m_lastAttachAttemptMs < kAttachRetryMs) return;
+        m_lastAttachAttemptMs = now;
+        if (!m_shared.attach(m_name)) return;
+        m_sequence = 0;
+        m_readState = VehicleState();   // Seed consumers from the first read
+    }
+
+    // A dead writer leaves its segment behind; only the heartbeat tells
+    const bool alive = now - m_shared.heartbeatMs() <= SharedVehicleState::HeartbeatTimeoutMs;
+    setConnected(alive);
+    if (!alive) {
+        // Re-attach on retry: a restarted service creates a fresh segment
+        m_shared.detach();
+        m_lastAttachAttemptMs = now;
+        return;
+    }
+
+    // Unchanged since last frame: one atomic load
+    const quint32 sequence = m_shared.sequence();
+    if (sequence == m_sequence) {
+        if (m_pending) applyPending(now);
+        return;
+    }
+
+    m_sequence = m_shared.read(&m_pendingState);
+    m_pending = true;
+    // Only signals with a new sample since the last read go downstream, with
+    // their source time: republished values would skew the decimator's
+    // windows, and the poll time would hide the source timing from the
+    // jitter buffer
+    for (int signal = 0; signal < VehicleSignals::count(); ++signal) {
+        const VehicleSignal id = static_cast<VehicleSignal>(signal);
+        const qint64 sourceMs = m_pendingState.sourceTimeMs[signal];
+        const double value = VehicleSignals::valueOf(m_pendingState, id);
+        if (sourceMs == m_readState.sourceTimeMs[signal] && value == VehicleSignals::valueOf(m_readState, id)) {
+            continue;
+        }
+        if (m_decimator) m_decimator->push(id, value);
+        if (m_jitterBuffer) m_jitterBuffer->push(id, sourceMs, value);
+    }
+    m_readState = m_pendingState;
+    setStatus(m_pendingState.staleMask, m_pendingState.activeSources, m_pendingState.timeoutCount);
+    applyPending(now);
+}
+
+void SharedStateReader::setCoalesceInterval(int intervalMs)
+{
+    m_coalesceMs = qMax(0, intervalMs);
+    if (m_coalesceMs == 0 && m_pending) applyPending(SharedVehicleState::monotonicMs());
+}
+
+void SharedStateReader::applyPending(qint64 now)
+{
+    bool due = m_coalesceMs <= 0 || now - m_lastApplyMs >= m_coalesceMs;
+    for (int signal = 0; !due && signal < VehicleSignals::count(); ++signal) {
+        const VehicleSignal id = static_cast<VehicleSignal>(signal);
+        due = VehicleSignals::isDiscrete(id)
+            && VehicleSignals::valueOf(m_pendingState, id) != VehicleSignals::valueOf(m_appliedState, id);
+    }
+    if (!due) return;
+
+    m_vehicleData->applyState(m_pendingState);
+    m_appliedState = m_pendingState;
+    m_pending = false;
+    m_lastApplyMs = now;
+}
+
+void SharedStateReader::setConnected(bool connected)
+{
+    if (m_connected == connected) return;
+    m_connected = connected;
+    qDebug() << "Shared vehicle state" << m_name << (connected ? "connected" : "lost (no heartbeat)");
+    emit connectedChanged();
+    emit sourcesChanged();
+    emit stalenessChanged();
+}
+
+void SharedStateReader::setStatus(quint64 staleMask, quint32 activeSources, quint32 timeoutCount)
+{
+    if (activeSources != m_activeSources) {
+        m_activeSources = activeSources;
+        emit sourcesChanged();
+    }
+    if (staleMask != m_staleMask || timeoutCount != m_timeoutCount) {
+        m_staleMask = staleMask;
+        m_timeoutCount = timeoutCount;
+        emit stalenessChanged();
+    }
+}
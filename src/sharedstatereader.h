@@ -0,0 +1,92 @@
+#ifndef SHAREDSTATEREADER_H
+#define SHAREDSTATEREADER_H
+
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include "sharedvehiclestate.h"
+#include "signalsample.h"
+
+class EVVehicleData;
+class SignalDecimator;
+class SignalJitterBuffer;
+
+// Display side of the shared snapshot.
+// Polls the ev-datad segment once per display frame and mirrors new states
+// into a local EVVehicleData, so QML keeps binding to VehicleData unchanged.
+// Exposes the same input-status properties as InputArbiter for use as the
+// "InputStatus" context property. If the service stops heartbeating every
+// signal is reported stale until it comes back.
+class SharedStateReader : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
+    Q_PROPERTY(bool canActive READ canActive NOTIFY sourcesChanged)
+    Q_PROPERTY(bool simulationActive READ simulationActive NOTIFY sourcesChanged)
+    Q_PROPERTY(bool replayActive READ replayActive NOTIFY sourcesChanged)
+    Q_PROPERTY(int staleCount READ staleCount NOTIFY stalenessChanged)
+    Q_PROPERTY(QStringList staleSignals READ staleSignals NOTIFY stalenessChanged)
+    Q_PROPERTY(bool speedStale READ speedStale NOTIFY stalenessChanged)
+    Q_PROPERTY(bool powerStale READ powerStale NOTIFY stalenessChanged)
+    Q_PROPERTY(int timeoutCount READ timeoutCount NOTIFY stalenessChanged)
+
+public:
+    explicit SharedStateReader(EVVehicleData *vehicleData, QObject *parent = nullptr);
+
+    void open(const QString &name = SharedVehicleState::DefaultName);
+    void setDecimator(SignalDecimator *decimator) { m_decimator = decimator; }
+    void setJitterBuffer(SignalJitterBuffer *buffer) { m_jitterBuffer = buffer; }
+
+    // Apply states that only move continuous values at most every intervalMs
+    // (0 = every new state). A changed flag is applied at once.
+    void setCoalesceInterval(int intervalMs);
+
+    bool connected() const { return m_connected; }
+    bool canActive() const { return isSourceActive(InputSource::Can); }
+    bool simulationActive() const { return isSourceActive(InputSource::Simulation); }
+    bool replayActive() const { return isSourceActive(InputSource::Replay); }
+    int staleCount() const;
+    QStringList staleSignals() const;
+    bool speedStale() const { return isSignalStale(int(VehicleSignal::Speed)); }
+    bool powerStale() const { return isSignalStale(int(VehicleSignal::PowerOutput)); }
+    int timeoutCount() const { return int(m_timeoutCount); }
+
+    bool isSourceActive(InputSource source) const;
+    Q_INVOKABLE bool isSignalStale(int signal) const;
+
+signals:
+    void connectedChanged();
+    void sourcesChanged();
+    void stalenessChanged();
+
+private slots:
+    void poll();
+
+private:
+    void setConnected(bool connected);
+    void setStatus(quint64 staleMask, quint32 activeSources, quint32 timeoutCount);
+    void applyPending(qint64 now);
+
+    EVVehicleData *m_vehicleData;
+    SignalDecimator *m_decimator = nullptr;
+    SignalJitterBuffer *m_jitterBuffer = nullptr;
+    SharedVehicleState m_shared;
+    QString m_name;
+    QTimer m_pollTimer;
+    quint32 m_sequence = 0;
+    qint64 m_lastAttachAttemptMs = 0;
+    bool m_connected = false;
+
+    int m_coalesceMs = 0;
+    VehicleState m_readState;           // Last state read, to find the signals that changed
+    VehicleState m_pendingState;
+    VehicleState m_appliedState;
+    bool m_pending = false;
+    qint64 m_lastApplyMs = 0;
+
+    quint64 m_staleMask = 0;
+    quint32 m_activeSources = 0;
+    quint32 m_timeoutCount = 0;
+};
+
+#endif // SHAREDSTATEREADER_H
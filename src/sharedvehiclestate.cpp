@@ -0,0 +1,185 @@
+#include "sharedvehiclestate.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char *const SharedVehicleState::DefaultName = "/ev-vehicle-state";
+
+static const quint32 kMagic = 0x45565344;   // "EVSD"
+
+qint64 SharedVehicleState::monotonicMs()
+{
+    // CLOCK_MONOTONIC on Linux - the same reference in every process
+    QElapsedTimer timer;
+    timer.start();
+    return timer.msecsSinceReference();
+}
+
+SharedVehicleState::~SharedVehicleState()
+{
+    detach();
+}
+
+bool SharedVehicleState::create(const QString &name)
+{
+    return map(name, true);
+}
+
+bool SharedVehicleState::attach(const QString &name)
+{
+    return map(name, false);
+}
+
+bool SharedVehicleState::hasLiveWriter(const QByteArray &name, qint64 *pid)
+{
+    const int fd = shm_open(name.constData(), O_RDONLY, 0);
+    if (fd < 0) return false;
+
+    struct stat info;
+    void *address = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && size_t(info.st_size) >= sizeof(Block)) {
+        address = mmap(nullptr, sizeof(Block), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (address == MAP_FAILED) return false;     // Half-created or foreign: not live
+
+    const Block *block = static_cast<const Block *>(address);
+    bool live = false;
+    if (block->magic == kMagic) {
+        // Heartbeat within the readers' timeout and the process still there, so
+        // a writer restarted right after a crash does not wait for the timeout
+        *pid = block->writerPid;
+        const bool fresh = monotonicMs() - block->heartbeatMs.load(std::memory_order_acquire)
+            <= HeartbeatTimeoutMs;
+        live = fresh && *pid > 0 && (kill(pid_t(*pid), 0) == 0 || errno == EPERM);
+    }
+    munmap(address, sizeof(Block));
+    return live;
+}
+
+bool SharedVehicleState::map(const QString &name, bool writer)
+{
+    detach();
+
+    const QByteArray shmName = name.toLocal8Bit();
+    int fd = -1;
+    if (writer) {
+        // Never map over an existing object: readers may still be attached to it
+        fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST) {
+            qint64 pid = 0;
+            if (hasLiveWriter(shmName, &pid)) {
+                qWarning() << "Shared vehicle state" << name << "is already published by pid" << pid;
+                return false;
+            }
+            qDebug() << "Replacing stale shared vehicle state" << name;
+            shm_unlink(shmName.constData());
+            fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+    } else {
+        fd = shm_open(shmName.constData(), O_RDONLY, 0);
+    }
+    if (fd < 0) {
+        if (writer) qWarning() << "shm_open failed for" << name << strerror(errno);
+        return false;
+    }
+
+    const size_t size = sizeof(Block);
+    if (writer && ftruncate(fd, off_t(size)) != 0) {
+        qWarning() << "ftruncate failed for" << name << strerror(errno);
+        close(fd);
+        return false;
+    }
+
+    struct stat info;
+    if (!writer && (fstat(fd, &info) != 0 || size_t(info.st_size) < size)) {
+        // Writer has not sized it yet, or a different build created it
+        close(fd);
+        return false;
+    }
+
+    void *address = mmap(nullptr, size, writer ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                         MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) {
+        qWarning() << "mmap failed for" << name << strerror(errno);
+        return false;
+    }
+
+    Block *block = static_cast<Block *>(address);
+    if (writer) {
+        // New object, so nobody else sees this; the state starts from defaults at sequence 0
+        block = new (address) Block;
+        block->magic = kMagic;
+        block->version = VehicleStateVersion;
+        block->stateSize = sizeof(VehicleState);
+        block->writerPid = qint32(getpid());
+        block->heartbeatMs.store(monotonicMs(), std::memory_order_relaxed);
+        block->state.store(VehicleState());
+    } else if (block->magic != kMagic || block->version != VehicleStateVersion
+               || block->stateSize != sizeof(VehicleState)) {
+        qWarning() << "Shared vehicle state" << name << "has an incompatible layout (version"
+                   << block->version << "expected" << VehicleStateVersion << ")";
+        munmap(address, size);
+        return false;
+    }
+
+    m_block = block;
+    m_name = shmName;
+    m_writer = writer;
+    if (writer) qDebug() << "Shared vehicle state created:" << name;
+    return true;
+}
+
+void SharedVehicleState::detach()
+{
+    if (!m_block) return;
+
+    munmap(m_block, sizeof(Block));
+    m_block = nullptr;
+
+    // Readers keep their mapping; the name disappears so a restart starts clean
+    if (m_writer) shm_unlink(m_name.constData());
+    m_writer = false;
+}
+
+void SharedVehicleState::publish(const VehicleState &state)
+{
+    if (!m_block || !m_writer) return;
+    m_block->state.store(state);
+    touchHeartbeat();
+}
+
+void SharedVehicleState::touchHeartbeat()
+{
+    if (!m_block || !m_writer) return;
+    m_block->heartbeatMs.store(monotonicMs(), std::memory_order_release);
+}
+
+quint32 SharedVehicleState::sequence() const
+{
+    return m_block ? m_block->state.sequence() : 0;
+}
+
+quint32 SharedVehicleState::read(VehicleState *state) const
+{
+    if (!m_block) return 0;
+    return m_block->state.load(state);
+}
+
+qint64 SharedVehicleState::heartbeatMs() const
+{
+    return m_block ? m_block->heartbeatMs.load(std::memory_order_acquire) : 0;
+}
+
+qint64 SharedVehicleState::writerPid() const
+{
+    return m_block ? m_block->writerPid : 0;
+}
@@ -0,0 +1,65 @@
+#ifndef SHAREDVEHICLESTATE_H
+#define SHAREDVEHICLESTATE_H
+
+#include <QString>
+#include <atomic>
+#include "seqlock.h"
+#include "vehiclestate.h"
+
+// VehicleState in a POSIX shared memory object.
+// ev-datad creates the region and is its only writer; displays attach
+// read-only and poll sequence() once per frame, so an unchanged state costs a
+// single atomic load and a changed one a ~250-byte copy - no sockets, no
+// serialization.
+class SharedVehicleState
+{
+public:
+    static const char *const DefaultName;   // "/ev-vehicle-state"
+    static const int HeartbeatTimeoutMs = 1000;     // Writer heartbeats every 100 ms
+
+    SharedVehicleState() = default;
+    ~SharedVehicleState();
+
+    SharedVehicleState(const SharedVehicleState &) = delete;
+    SharedVehicleState &operator=(const SharedVehicleState &) = delete;
+
+    // Writer. Refuses a name another live writer holds; a segment left by a
+    // dead one is unlinked and a new object created, so readers re-attach
+    bool create(const QString &name = DefaultName);
+    bool attach(const QString &name = DefaultName);   // Read-only
+    void detach();
+
+    bool isAttached() const { return m_block != nullptr; }
+    bool isWriter() const { return m_writer; }
+
+    void publish(const VehicleState &state);
+    void touchHeartbeat();
+
+    quint32 sequence() const;
+    quint32 read(VehicleState *state) const;
+
+    // Writer liveness: monotonic ms of the last publish/heartbeat (system-wide clock)
+    qint64 heartbeatMs() const;
+    qint64 writerPid() const;
+
+    static qint64 monotonicMs();
+
+private:
+    struct Block {
+        quint32 magic;
+        quint32 version;
+        quint32 stateSize;
+        qint32 writerPid;
+        std::atomic<qint64> heartbeatMs;
+        SeqLock<VehicleState> state;
+    };
+
+    bool map(const QString &name, bool writer);
+    static bool hasLiveWriter(const QByteArray &name, qint64 *pid);
+
+    Block *m_block = nullptr;
+    QByteArray m_name;
+    bool m_writer = false;
+};
+
+#endif // SHAREDVEHICLESTATE_H
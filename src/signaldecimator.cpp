@@ -0,0 +1,236 @@
+#include "signaldecimator.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QPointer>
+#include <QtMath>
+
+static const double kMinRateHz = 0.1;
+static const double kMaxRateHz = 100.0;
+
+SignalDecimator::SignalDecimator(QObject *parent) : QObject(parent)
+{
+    m_latest.fill(0.0);
+    m_hasLatest.fill(false);
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &SignalDecimator::emitDue);
+}
+
+SignalDecimator *SignalDecimator::instance()
+{
+    // A child of the application, so the timer is torn down with the event
+    // loop instead of by a static destructor after QCoreApplication is gone
+    static QPointer<SignalDecimator> decimator;
+    if (!decimator) {
+        Q_ASSERT(QCoreApplication::instance());
+        decimator = new SignalDecimator(QCoreApplication::instance());
+    }
+    return decimator;
+}
+
+int SignalDecimator::subscribe(VehicleSignal signal, double rateHz, DecimationFilter filter,
+                               const Callback &callback, double cutoffHz)
+{
+    if (static_cast<int>(signal) < 0 || signal >= VehicleSignal::Count) return 0;
+
+    const double rate = qBound(kMinRateHz, rateHz, kMaxRateHz);
+    const int periodMs = qMax(1, qRound(1000.0 / rate));
+    const double cutoff = filter == DecimationFilter::LowPass
+        ? (cutoffHz > 0.0 ? cutoffHz : rate / 2.0) : 0.0;
+
+    const int id = m_nextId++;
+
+    // Join an identical stream if there is one
+    for (Stream &stream : m_streams) {
+        if (stream.signal == signal && stream.filter == filter
+            && stream.periodMs == periodMs && qFuzzyCompare(stream.cutoffHz + 1.0, cutoff + 1.0)) {
+            stream.consumers.append({ id, callback });
+            return id;
+        }
+    }
+
+    Stream stream;
+    stream.signal = signal;
+    stream.filter = filter;
+    stream.periodMs = periodMs;
+    stream.cutoffHz = cutoff;
+    stream.nextDueMs = m_clock.elapsed() + periodMs;
+    stream.consumers.append({ id, callback });
+
+    // Start low-pass and latest from the current value rather than from zero
+    const int index = static_cast<int>(signal);
+    if (m_hasLatest[index]) {
+        stream.last = m_latest[index];
+        stream.filtered = m_latest[index];
+        stream.lastInputMs = m_clock.elapsed();
+    }
+
+    m_streams.append(stream);
+    rebuildIndex();
+    schedule();
+    return id;
+}
+
+void SignalDecimator::unsubscribe(int id)
+{
+    for (int i = 0; i < m_streams.size(); ++i) {
+        QVector<Consumer> &consumers = m_streams[i].consumers;
+        for (int c = 0; c < consumers.size(); ++c) {
+            if (consumers[c].id != id) continue;
+
+            consumers.remove(c);
+            if (consumers.isEmpty()) {
+                m_streams.remove(i);
+                rebuildIndex();
+                schedule();
+            }
+            return;
+        }
+    }
+}
+
+bool SignalDecimator::latest(VehicleSignal signal, double *value) const
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count() || !m_hasLatest[index]) return false;
+    *value = m_latest[index];
+    return true;
+}
+
+void SignalDecimator::push(VehicleSignal signal, double value)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+
+    m_latest[index] = value;
+    m_hasLatest[index] = true;
+
+    const QVector<int> &streams = m_streamsBySignal[index];
+    if (streams.isEmpty()) return;
+
+    const qint64 now = m_clock.elapsed();
+    for (int stream : streams) {
+        accumulate(m_streams[stream], value, now);
+    }
+}
+
+void SignalDecimator::accumulate(Stream &stream, double value, qint64 now)
+{
+    if (stream.count == 0) {
+        stream.sum = 0.0;
+        stream.min = value;
+        stream.max = value;
+    }
+    stream.count++;
+    stream.sum += value;
+    stream.min = qMin(stream.min, value);
+    stream.max = qMax(stream.max, value);
+    stream.last = value;
+
+    if (stream.filter == DecimationFilter::LowPass) {
+        if (stream.lastInputMs < 0) {
+            stream.filtered = value;
+        } else {
+            // First-order IIR; alpha follows the actual input spacing
+            const double dt = (now - stream.lastInputMs) / 1000.0;
+            const double alpha = 1.0 - qExp(-2.0 * M_PI * stream.cutoffHz * dt);
+            stream.filtered += alpha * (value - stream.filtered);
+        }
+    }
+    stream.lastInputMs = now;
+}
+
+bool SignalDecimator::output(const Stream &stream, double *value)
+{
+    switch (stream.filter) {
+    case DecimationFilter::Latest:
+        if (stream.lastInputMs < 0) return false;
+        *value = stream.last;
+        return true;
+    case DecimationFilter::LowPass:
+        if (stream.lastInputMs < 0) return false;
+        *value = stream.filtered;
+        return true;
+    case DecimationFilter::Mean:
+        if (stream.count == 0) return false;   // Hold the previous output
+        *value = stream.sum / stream.count;
+        return true;
+    case DecimationFilter::Min:
+        if (stream.count == 0) return false;
+        *value = stream.min;
+        return true;
+    case DecimationFilter::Max:
+        if (stream.count == 0) return false;
+        *value = stream.max;
+        return true;
+    }
+    return false;
+}
+
+void SignalDecimator::emitDue()
+{
+    const qint64 now = m_clock.elapsed();
+
+    // Collect first: callbacks may subscribe or unsubscribe
+    QVector<QPair<int, double>> deliveries;   // Consumer id, value
+    for (Stream &stream : m_streams) {
+        if (stream.nextDueMs > now) continue;
+
+        double value = 0.0;
+        if (output(stream, &value) && (!stream.emitted || value != stream.lastEmitted)) {
+            stream.emitted = true;
+            stream.lastEmitted = value;
+            for (const Consumer &consumer : stream.consumers) {
+                deliveries.append(qMakePair(consumer.id, value));
+            }
+        }
+        stream.count = 0;
+
+        // Keep the cadence; skip missed periods rather than bursting
+        stream.nextDueMs += stream.periodMs;
+        if (stream.nextDueMs <= now) stream.nextDueMs = now + stream.periodMs;
+    }
+
+    schedule();
+
+    for (const auto &delivery : deliveries) {
+        // Looked up again: an earlier callback may have removed this consumer
+        const Callback callback = findConsumer(delivery.first);
+        if (callback) callback(delivery.second);
+    }
+}
+
+SignalDecimator::Callback SignalDecimator::findConsumer(int id) const
+{
+    for (const Stream &stream : m_streams) {
+        for (const Consumer &consumer : stream.consumers) {
+            if (consumer.id == id) return consumer.callback;
+        }
+    }
+    return Callback();
+}
+
+void SignalDecimator::rebuildIndex()
+{
+    for (QVector<int> &streams : m_streamsBySignal) {
+        streams.clear();
+    }
+    for (int i = 0; i < m_streams.size(); ++i) {
+        m_streamsBySignal[static_cast<int>(m_streams[i].signal)].append(i);
+    }
+}
+
+void SignalDecimator::schedule()
+{
+    if (m_streams.isEmpty()) {
+        m_timer.stop();
+        return;
+    }
+
+    qint64 nextDueMs = m_streams.first().nextDueMs;
+    for (const Stream &stream : m_streams) {
+        nextDueMs = qMin(nextDueMs, stream.nextDueMs);
+    }
+    m_timer.start(int(qMax<qint64>(0, nextDueMs - m_clock.elapsed())));
+}
@@ -0,0 +1,97 @@
+#ifndef SIGNALDECIMATOR_H
+#define SIGNALDECIMATOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <array>
+#include <functional>
+#include "signalsample.h"
+
+enum class DecimationFilter : quint8 {
+    Latest,     // Last value in the window
+    Mean,       // Average of the window
+    Min,
+    Max,
+    LowPass     // First-order low-pass at the cutoff, sampled at the rate
+};
+
+// Shared decimation stage between ingest and consumers (GUI thread).
+// Consumers subscribe to a signal at a rate and filter; subscriptions with the
+// same signal, rate and filter share one stream. Ingest pushes every applied
+// value, which only touches the streams of that signal - nothing for signals
+// nobody asked for - and each stream delivers at most once per period, only
+// when its output changed. One single-shot timer serves all streams, aimed at
+// the next due one, so idle cost follows the subscriptions, not the bus.
+class SignalDecimator : public QObject
+{
+    Q_OBJECT
+public:
+    using Callback = std::function<void(double)>;
+
+    // Created on first use, owned by the application
+    static SignalDecimator *instance();
+
+    // rateHz is clamped to 0.1-100 Hz; cutoffHz (LowPass only) defaults to rateHz / 2.
+    // Returns a subscription id for unsubscribe().
+    int subscribe(VehicleSignal signal, double rateHz, DecimationFilter filter,
+                  const Callback &callback, double cutoffHz = 0.0);
+    void unsubscribe(int id);
+
+    // Ingest side, once per applied value
+    void push(VehicleSignal signal, double value);
+
+    // Last pushed value, to seed new consumers; false if none yet
+    bool latest(VehicleSignal signal, double *value) const;
+
+    int streamCount() const { return m_streams.size(); }
+
+private slots:
+    void emitDue();
+
+private:
+    explicit SignalDecimator(QObject *parent = nullptr);
+
+    struct Consumer {
+        int id;
+        Callback callback;
+    };
+
+    struct Stream {
+        VehicleSignal signal;
+        DecimationFilter filter;
+        int periodMs;
+        double cutoffHz;
+        qint64 nextDueMs = 0;
+
+        // Window accumulators
+        int count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double last = 0.0;
+        double filtered = 0.0;
+        qint64 lastInputMs = -1;
+
+        bool emitted = false;
+        double lastEmitted = 0.0;
+        QVector<Consumer> consumers;
+    };
+
+    static void accumulate(Stream &stream, double value, qint64 now);
+    static bool output(const Stream &stream, double *value);
+    Callback findConsumer(int id) const;
+    void rebuildIndex();
+    void schedule();
+
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+    QVector<Stream> m_streams;
+    std::array<QVector<int>, VehicleSignals::count()> m_streamsBySignal;
+    std::array<double, VehicleSignals::count()> m_latest;
+    std::array<bool, VehicleSignals::count()> m_hasLatest;
+    int m_nextId = 1;
+};
+
+#endif // SIGNALDECIMATOR_H
@@ -0,0 +1,153 @@
+#include "signaljitterbuffer.h"
+#include <QDateTime>
+#include <QtMath>
+
+static const double kMinDelayMs = 10.0;
+static const double kMarginMs = 5.0;
+static const qint64 kMaxExtrapolateMs = 50;     // Then hold the last value
+static const double kResyncMs = 2000.0;         // Source restarted or switched clocks
+static const double kDriftPerMs = 0.001;        // Minimum transit may creep up 1 ms/s
+
+SignalJitterBuffer::SignalJitterBuffer(QObject *parent) : QObject(parent)
+{
+    m_clock.start();
+}
+
+SignalJitterBuffer *SignalJitterBuffer::instance()
+{
+    static SignalJitterBuffer buffer;
+    return &buffer;
+}
+
+void SignalJitterBuffer::track(VehicleSignal signal)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+    m_tracks[index].users++;
+}
+
+void SignalJitterBuffer::untrack(VehicleSignal signal)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+
+    Track &track = m_tracks[index];
+    if (track.users > 0 && --track.users == 0) {
+        track = Track();
+    }
+}
+
+void SignalJitterBuffer::push(VehicleSignal signal, qint64 sourceMs, double value)
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return;
+
+    Track &track = m_tracks[index];
+    if (track.users == 0) return;
+
+    if (sourceMs <= 0) sourceMs = QDateTime::currentMSecsSinceEpoch();
+    const qint64 arrival = nowMs();
+    const double transit = double(arrival - sourceMs);
+
+    if (!track.synced || qAbs(transit - track.offsetMs) > kResyncMs) {
+        // First sample, or the source clock jumped: start over
+        track.synced = true;
+        track.offsetMs = transit;
+        track.jitterMs = 0.0;
+        track.intervalMs = 0.0;
+        track.delayMs = kMinDelayMs;
+        track.count = 0;
+    } else if (transit < track.offsetMs) {
+        track.offsetMs = transit;
+    } else {
+        // Follow slow drift between the clocks without chasing jitter
+        track.offsetMs = qMin(transit, track.offsetMs + kDriftPerMs * (arrival - track.lastArrivalMs));
+    }
+    track.lastArrivalMs = arrival;
+
+    if (track.count > 0) {
+        const Point &newest = track.at(0);
+        if (sourceMs < newest.sourceMs) return;      // Reordered datagram - already played past it
+        if (sourceMs == newest.sourceMs) {
+            track.points[track.newest].value = value;
+            emit sampleAdded(index, value);
+            return;
+        }
+        track.intervalMs += (double(sourceMs - newest.sourceMs) - track.intervalMs) / 8.0;
+    }
+
+    track.newest = (track.newest + 1) % kHistory;
+    track.points[track.newest] = { sourceMs, value };
+    track.count = qMin(track.count + 1, kHistory);
+
+    // RFC 3550-style jitter estimate; the delay needs one interval plus the jitter
+    // so the sample after the playout point has normally arrived
+    track.jitterMs += ((transit - track.offsetMs) - track.jitterMs) / 16.0;
+    const double target = qBound(kMinDelayMs, track.intervalMs + 2.0 * track.jitterMs + kMarginMs,
+                                  double(MaxLatencyMs));
+    track.delayMs += (target - track.delayMs) / 16.0;
+
+    emit sampleAdded(index, value);
+}
+
+double SignalJitterBuffer::valueAt(VehicleSignal signal, qint64 localMs, bool *moving) const
+{
+    if (moving) *moving = false;
+
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return 0.0;
+
+    const Track &track = m_tracks[index];
+    if (track.count == 0) return 0.0;
+
+    const double playout = double(localMs) - track.offsetMs - track.delayMs;
+    const Point &newest = track.at(0);
+
+    double value;
+    if (playout >= newest.sourceMs) {
+        // Next sample is late: continue the last slope for a moment, then hold
+        value = newest.value;
+        if (track.count > 1) {
+            const Point &previous = track.at(1);
+            const double ahead = qMin(playout - newest.sourceMs, double(kMaxExtrapolateMs));
+            const double slope = (newest.value - previous.value) / double(newest.sourceMs - previous.sourceMs);
+            value += slope * ahead;
+            if (moving) *moving = slope != 0.0 && ahead < kMaxExtrapolateMs;
+        }
+        return value;
+    }
+
+    // Newest first: find the pair around the playout point
+    int age = 1;
+    while (age < track.count && track.at(age).sourceMs > playout) {
+        age++;
+    }
+    if (age == track.count) {
+        value = track.at(age - 1).value;    // Older than the history; only at startup
+    } else {
+        const Point &before = track.at(age);
+        const Point &after = track.at(age - 1);
+        const double t = (playout - before.sourceMs) / double(after.sourceMs - before.sourceMs);
+        value = before.value + (after.value - before.value) * t;
+    }
+
+    if (moving) {
+        for (int ahead = age - 1; ahead >= 0 && !*moving; --ahead) {
+            *moving = !qFuzzyCompare(track.at(ahead).value + 1.0, value + 1.0);
+        }
+    }
+    return value;
+}
+
+int SignalJitterBuffer::playoutDelayMs(VehicleSignal signal) const
+{
+    const int index = static_cast<int>(signal);
+    if (index < 0 || index >= VehicleSignals::count()) return 0;
+    return qRound(m_tracks[index].delayMs);
+}
+
+bool SignalJitterBuffer::hasSamples(VehicleSignal signal) const
+{
+    const int index = static_cast<int>(signal);
+    return index >= 0 && index < VehicleSignals::count() && m_tracks[index].count > 0;
+}
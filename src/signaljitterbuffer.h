@@ -0,0 +1,74 @@
+#ifndef SIGNALJITTERBUFFER_H
+#define SIGNALJITTERBUFFER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <array>
+#include "signalsample.h"
+
+// Short timestamped history of display-critical signals (GUI thread).
+// Ingest pushes every applied value with its source timestamp. Source clocks
+// are mapped onto the local monotonic clock by tracking the smallest observed
+// transit time, so only the arrival jitter - not the clock domain - matters.
+// Displays ask for a value at the frame's presentation time; it is read a
+// playout delay in the past and interpolated between the samples around it,
+// or briefly extrapolated when the next sample is late. The delay adapts to
+// the sample interval plus the measured jitter and never exceeds
+// MaxLatencyMs, so gauges lag the source by a known, bounded amount.
+// Only signals somebody tracks are stored.
+class SignalJitterBuffer : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int MaxLatencyMs = 120;
+
+    static SignalJitterBuffer *instance();
+
+    // Reference-counted; pushes for untracked signals are dropped at once
+    void track(VehicleSignal signal);
+    void untrack(VehicleSignal signal);
+
+    // sourceMs <= 0 means the source has no clock; arrival time is used
+    void push(VehicleSignal signal, qint64 sourceMs, double value);
+
+    // Value at localMs (nowMs() domain). moving is set while samples ahead of
+    // the playout point differ from the result, i.e. more frames are needed.
+    double valueAt(VehicleSignal signal, qint64 localMs, bool *moving = nullptr) const;
+    int playoutDelayMs(VehicleSignal signal) const;
+    bool hasSamples(VehicleSignal signal) const;
+
+    qint64 nowMs() const { return m_clock.elapsed(); }
+
+signals:
+    void sampleAdded(int signal, double value);
+
+private:
+    explicit SignalJitterBuffer(QObject *parent = nullptr);
+
+    static constexpr int kHistory = 32;
+
+    struct Point {
+        qint64 sourceMs;
+        double value;
+    };
+
+    struct Track {
+        int users = 0;
+        std::array<Point, kHistory> points;   // Ring, oldest overwritten
+        int newest = -1;
+        int count = 0;
+        bool synced = false;
+        double offsetMs = 0.0;    // Local minus source clock, minimum transit
+        double jitterMs = 0.0;    // Mean transit above the minimum
+        double intervalMs = 0.0;  // Mean source interval between samples
+        double delayMs = 0.0;     // Current playout delay
+        qint64 lastArrivalMs = 0;
+
+        const Point &at(int age) const { return points[(newest - age + kHistory) % kHistory]; }
+    };
+
+    QElapsedTimer m_clock;
+    std::array<Track, VehicleSignals::count()> m_tracks;
+};
+
+#endif // SIGNALJITTERBUFFER_H
@@ -0,0 +1,154 @@
+#include "signalsample.h"
+#include "vehiclestate.h"
+#include <QHash>
+
+struct SignalInfo {
+    VehicleSignal signal;
+    const char *name;
+    const char *simulationKey;   // nullptr if the simulator never sends it
+    bool discrete;               // On/off flag (telltales, modes)
+};
+
+// One row per VehicleSignal, in enum order
+static const SignalInfo kSignals[] = {
+    { VehicleSignal::Speed,              "speed",              "speed",           false },
+    { VehicleSignal::Odometer,           "odometer",           "odometer",        false },
+    { VehicleSignal::TripDistanceA,      "tripDistanceA",      "trip_distance_a", false },
+    { VehicleSignal::BatterySoc,         "batterySoc",         "soc",             false },
+    { VehicleSignal::BatteryVoltage,     "batteryVoltage",     "battery_voltage", false },
+    { VehicleSignal::BatteryCurrent,     "batteryCurrent",     "battery_current", false },
+    { VehicleSignal::BatteryTemp,        "batteryTempAvg",     "battery_temp",    false },
+    { VehicleSignal::BatterySoh,         "batterySoh",         "soh",             false },
+    { VehicleSignal::PowerOutput,        "powerOutput",        "power",           false },
+    { VehicleSignal::EstimatedRange,     "estimatedRange",     "range",           false },
+    { VehicleSignal::AverageConsumption, "averageConsumption", "efficiency",      false },
+    { VehicleSignal::TimeToFull,         "timeToFull",         "time_to_full",    false },
+    { VehicleSignal::MotorTemp,          "motorTemp",          "motor_temp",      false },
+    { VehicleSignal::ControllerTemp,     "controllerTemp",     nullptr,           false },
+    { VehicleSignal::MotorRpm,           "motorRpm",           "motor_rpm",       false },
+    { VehicleSignal::ReadyToDrive,       "readyToDrive",       "ready",           true },
+    { VehicleSignal::ChargingActive,     "chargingActive",     "charging",        true },
+    { VehicleSignal::BmsWarning,         "bmsWarning",         "bms_warning",     true },
+    { VehicleSignal::HvWarning,          "hvWarning",          "hv_warning",      true },
+    { VehicleSignal::TempWarning,        "tempWarning",        "temp_warning",    true },
+    { VehicleSignal::MotorFault,         "motorFault",         "motor_fault",     true },
+    { VehicleSignal::ReducedPower,       "reducedPower",       "reduced_power",   true },
+    { VehicleSignal::LeftTurnSignal,     "leftTurnSignal",     "left_signal",     true },
+    { VehicleSignal::RightTurnSignal,    "rightTurnSignal",    "right_signal",    true },
+    { VehicleSignal::HighBeam,           "highBeam",           "high_beam",       true },
+    { VehicleSignal::AbsWarning,         "absWarning",         "abs",             true },
+    { VehicleSignal::TractionControl,    "tractionControl",    "tc",              true },
+    { VehicleSignal::SeatbeltWarning,    "seatbeltWarning",    "seatbelt",        true },
+    { VehicleSignal::DoorAjar,           "doorAjar",           "door_ajar",       true },
+    { VehicleSignal::ParkingBrake,       "parkingBrake",       "parking",         true },
+    { VehicleSignal::Low12V,             "low12V",             "low_12v",         true },
+    { VehicleSignal::NavigationActive,   "navigationActive",   "nav_active",      true },
+    { VehicleSignal::NextTurnDistance,   "nextTurnDistance",   "next_turn_dist",  false },
+    { VehicleSignal::GpsLatitude,        "gpsLatitude",        "lat",             false },
+    { VehicleSignal::GpsLongitude,       "gpsLongitude",       "lon",             false },
+    { VehicleSignal::Heading,            "heading",            "heading",         false },
+};
+
+static_assert(sizeof(kSignals) / sizeof(kSignals[0]) == VehicleSignals::count(),
+              "kSignals must have one row per VehicleSignal");
+static_assert(VehicleStateSignalCount == VehicleSignals::count(),
+              "VehicleState::sourceTimeMs must have one slot per VehicleSignal");
+
+bool VehicleSignals::fromSimulationKey(const QString &key, VehicleSignal *signal)
+{
+    // Built once; lookups on the ingest path are a single hash probe
+    static const QHash<QString, VehicleSignal> lookup = [] {
+        QHash<QString, VehicleSignal> table;
+        for (const SignalInfo &info : kSignals) {
+            if (info.simulationKey) {
+                table.insert(QString::fromLatin1(info.simulationKey), info.signal);
+            }
+        }
+        return table;
+    }();
+
+    auto it = lookup.constFind(key);
+    if (it == lookup.constEnd()) {
+        return false;
+    }
+    *signal = it.value();
+    return true;
+}
+
+const char *VehicleSignals::name(VehicleSignal signal)
+{
+    const int index = static_cast<int>(signal);
+    return index >= 0 && index < count() ? kSignals[index].name : "unknown";
+}
+
+const char *VehicleSignals::sourceName(InputSource source)
+{
+    switch (source) {
+    case InputSource::Can: return "CAN";
+    case InputSource::Gnss: return "GNSS";
+    case InputSource::Replay: return "Replay";
+    case InputSource::Simulation: return "Simulation";
+    default: return "unknown";
+    }
+}
+
+bool VehicleSignals::isDiscrete(VehicleSignal signal)
+{
+    const int index = static_cast<int>(signal);
+    return index >= 0 && index < count() && kSignals[index].discrete;
+}
+
+bool VehicleSignals::fromName(const QString &name, VehicleSignal *signal)
+{
+    for (const SignalInfo &info : kSignals) {
+        if (name == QLatin1String(info.name)) {
+            *signal = info.signal;
+            return true;
+        }
+    }
+    return false;
+}
+
+double VehicleSignals::valueOf(const VehicleState &state, VehicleSignal signal)
+{
+    switch (signal) {
+    case VehicleSignal::Speed: return state.speed;
+    case VehicleSignal::Odometer: return state.odometer;
+    case VehicleSignal::TripDistanceA: return state.tripDistanceA;
+    case VehicleSignal::BatterySoc: return state.batterySoc;
+    case VehicleSignal::BatteryVoltage: return state.batteryVoltage;
+    case VehicleSignal::BatteryCurrent: return state.batteryCurrent;
+    case VehicleSignal::BatteryTemp: return state.batteryTempAvg;
+    case VehicleSignal::BatterySoh: return state.batterySoh;
+    case VehicleSignal::PowerOutput: return state.powerOutput;
+    case VehicleSignal::EstimatedRange: return state.estimatedRange;
+    case VehicleSignal::AverageConsumption: return state.averageConsumption;
+    case VehicleSignal::TimeToFull: return state.timeToFull;
+    case VehicleSignal::MotorTemp: return state.motorTemp;
+    case VehicleSignal::ControllerTemp: return state.controllerTemp;
+    case VehicleSignal::MotorRpm: return state.motorRpm;
+    case VehicleSignal::ReadyToDrive: return state.readyToDrive;
+    case VehicleSignal::ChargingActive: return state.chargingActive;
+    case VehicleSignal::BmsWarning: return state.bmsWarning;
+    case VehicleSignal::HvWarning: return state.hvWarning;
+    case VehicleSignal::TempWarning: return state.tempWarning;
+    case VehicleSignal::MotorFault: return state.motorFault;
+    case VehicleSignal::ReducedPower: return state.reducedPower;
+    case VehicleSignal::LeftTurnSignal: return state.leftTurnSignal;
+    case VehicleSignal::RightTurnSignal: return state.rightTurnSignal;
+    case VehicleSignal::HighBeam: return state.highBeam;
+    case VehicleSignal::AbsWarning: return state.absWarning;
+    case VehicleSignal::TractionControl: return state.tractionControl;
+    case VehicleSignal::SeatbeltWarning: return state.seatbeltWarning;
+    case VehicleSignal::DoorAjar: return state.doorAjar;
+    case VehicleSignal::ParkingBrake: return state.parkingBrake;
+    case VehicleSignal::Low12V: return state.low12V;
+    case VehicleSignal::NavigationActive: return state.navigationActive;
+    case VehicleSignal::NextTurnDistance: return 0.0;
+    case VehicleSignal::GpsLatitude: return state.gpsLatitude;
+    case VehicleSignal::GpsLongitude: return state.gpsLongitude;
+    case VehicleSignal::Heading: return state.heading;
+    case VehicleSignal::Count: break;
+    }
+    return 0.0;
+}
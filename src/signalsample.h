@@ -0,0 +1,90 @@
+#ifndef SIGNALSAMPLE_H
+#define SIGNALSAMPLE_H
+
+#include <QList>
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+
+struct VehicleState;
+
+// Every vehicle signal that an input source can provide.
+// Values index per-signal tables, so keep Count last.
+enum class VehicleSignal : quint16 {
+    Speed,
+    Odometer,
+    TripDistanceA,
+    BatterySoc,
+    BatteryVoltage,
+    BatteryCurrent,
+    BatteryTemp,
+    BatterySoh,
+    PowerOutput,
+    EstimatedRange,
+    AverageConsumption,
+    TimeToFull,
+    MotorTemp,
+    ControllerTemp,
+    MotorRpm,
+    ReadyToDrive,
+    ChargingActive,
+    BmsWarning,
+    HvWarning,
+    TempWarning,
+    MotorFault,
+    ReducedPower,
+    LeftTurnSignal,
+    RightTurnSignal,
+    HighBeam,
+    AbsWarning,
+    TractionControl,
+    SeatbeltWarning,
+    DoorAjar,
+    ParkingBrake,
+    Low12V,
+    NavigationActive,
+    NextTurnDistance,
+    GpsLatitude,
+    GpsLongitude,
+    Heading,
+    Count
+};
+
+// Where a sample came from. Order is the default arbitration priority.
+enum class InputSource : quint8 {
+    Can,
+    Gnss,
+    Replay,
+    Simulation,
+    Count
+};
+
+// Common typed sample produced by every input source
+struct SignalSample {
+    VehicleSignal signal = VehicleSignal::Count;
+    InputSource source = InputSource::Simulation;
+    qint64 timestampMs = 0;    // Source timestamp (ms since epoch)
+    QVariant value;
+};
+
+Q_DECLARE_METATYPE(SignalSample)
+
+namespace VehicleSignals {
+    constexpr int count() { return static_cast<int>(VehicleSignal::Count); }
+
+    // Simulator JSON key ("speed", "soc", ...) -> signal; returns false if unknown
+    bool fromSimulationKey(const QString &key, VehicleSignal *signal);
+
+    // EVVehicleData property name ("speed", "powerOutput", ...) and back
+    const char *name(VehicleSignal signal);
+    bool fromName(const QString &name, VehicleSignal *signal);
+
+    // On/off flags (telltales, ready, charging) - latency-critical, never coalesced
+    bool isDiscrete(VehicleSignal signal);
+
+    // Numeric value of a signal in a snapshot (bools as 0/1, text as 0)
+    double valueOf(const VehicleState &state, VehicleSignal signal);
+    const char *sourceName(InputSource source);
+}
+
+#endif // SIGNALSAMPLE_H
@@ -0,0 +1,88 @@
+#include "signalsubscription.h"
+#include <QDebug>
+
+SignalSubscription::SignalSubscription(QObject *parent) : QObject(parent)
+{
+}
+
+SignalSubscription::~SignalSubscription()
+{
+    if (m_subscriptionId) SignalDecimator::instance()->unsubscribe(m_subscriptionId);
+}
+
+void SignalSubscription::setSignalName(const QString &signalName)
+{
+    if (m_signalName == signalName) return;
+    m_signalName = signalName;
+    emit signalNameChanged();
+    resubscribe();
+}
+
+void SignalSubscription::setRate(double rate)
+{
+    if (qFuzzyCompare(m_rate, rate)) return;
+    m_rate = rate;
+    emit rateChanged();
+    resubscribe();
+}
+
+void SignalSubscription::setFilter(Filter filter)
+{
+    if (m_filter == filter) return;
+    m_filter = filter;
+    emit filterChanged();
+    resubscribe();
+}
+
+void SignalSubscription::setCutoff(double cutoff)
+{
+    if (qFuzzyCompare(m_cutoff, cutoff)) return;
+    m_cutoff = cutoff;
+    emit cutoffChanged();
+    resubscribe();
+}
+
+void SignalSubscription::setEnabled(bool enabled)
+{
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    emit enabledChanged();
+    resubscribe();
+}
+
+void SignalSubscription::componentComplete()
+{
+    m_complete = true;
+    resubscribe();
+}
+
+void SignalSubscription::resubscribe()
+{
+    if (!m_complete) return;   // Subscribe once with the final QML property values
+
+    SignalDecimator *decimator = SignalDecimator::instance();
+    if (m_subscriptionId) {
+        decimator->unsubscribe(m_subscriptionId);
+        m_subscriptionId = 0;
+    }
+    if (!m_enabled || m_signalName.isEmpty()) return;
+
+    VehicleSignal signal;
+    if (!VehicleSignals::fromName(m_signalName, &signal)) {
+        qWarning() << "SignalSubscription: unknown signal" << m_signalName;
+        return;
+    }
+
+    m_subscriptionId = decimator->subscribe(signal, m_rate, static_cast<DecimationFilter>(m_filter),
+                                            [this](double value) { setValue(value); }, m_cutoff);
+
+    double current = 0.0;
+    if (decimator->latest(signal, &current)) setValue(current);
+}
+
+void SignalSubscription::setValue(double value)
+{
+    if (m_value == value) return;
+    m_value = value;
+    emit valueChanged();
+}
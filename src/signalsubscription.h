@@ -0,0 +1,74 @@
+#ifndef SIGNALSUBSCRIPTION_H
+#define SIGNALSUBSCRIPTION_H
+
+#include <QObject>
+#include <QQmlParserStatus>
+#include "signaldecimator.h"
+
+// QML consumer:
+//     SignalSubscription { id: speedText; signalName: "speed"; rate: 8; filter: SignalSubscription.Mean }
+//     Text { text: Math.round(speedText.value) }
+// signalName is the VehicleData property name. Disable it to drop its demand.
+class SignalSubscription : public QObject, public QQmlParserStatus
+{
+    Q_OBJECT
+    Q_INTERFACES(QQmlParserStatus)
+    Q_PROPERTY(QString signalName READ signalName WRITE setSignalName NOTIFY signalNameChanged)
+    Q_PROPERTY(double rate READ rate WRITE setRate NOTIFY rateChanged)
+    Q_PROPERTY(Filter filter READ filter WRITE setFilter NOTIFY filterChanged)
+    Q_PROPERTY(double cutoff READ cutoff WRITE setCutoff NOTIFY cutoffChanged)
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(double value READ value NOTIFY valueChanged)
+
+public:
+    enum Filter {
+        Latest = int(DecimationFilter::Latest),
+        Mean = int(DecimationFilter::Mean),
+        Min = int(DecimationFilter::Min),
+        Max = int(DecimationFilter::Max),
+        LowPass = int(DecimationFilter::LowPass)
+    };
+    Q_ENUM(Filter)
+
+    explicit SignalSubscription(QObject *parent = nullptr);
+    ~SignalSubscription();
+
+    QString signalName() const { return m_signalName; }
+    double rate() const { return m_rate; }
+    Filter filter() const { return m_filter; }
+    double cutoff() const { return m_cutoff; }
+    bool enabled() const { return m_enabled; }
+    double value() const { return m_value; }
+
+    void setSignalName(const QString &signalName);
+    void setRate(double rate);
+    void setFilter(Filter filter);
+    void setCutoff(double cutoff);
+    void setEnabled(bool enabled);
+
+    void classBegin() override {}
+    void componentComplete() override;
+
+signals:
+    void signalNameChanged();
+    void rateChanged();
+    void filterChanged();
+    void cutoffChanged();
+    void enabledChanged();
+    void valueChanged();
+
+private:
+    void resubscribe();
+    void setValue(double value);
+
+    QString m_signalName;
+    double m_rate = 10.0;
+    Filter m_filter = Latest;
+    double m_cutoff = 0.0;
+    bool m_enabled = true;
+    double m_value = 0.0;
+    bool m_complete = false;
+    int m_subscriptionId = 0;
+};
+
+#endif // SIGNALSUBSCRIPTION_H
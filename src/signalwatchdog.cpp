@@ -0,0 +1,113 @@
+#include "signalwatchdog.h"
+
+static const int kDefaultTimeoutMs = 500;
+
+SignalWatchdog::SignalWatchdog(int signalCount, QObject *parent)
+    : QObject(parent),
+      m_lastUpdateMs(signalCount, 0),
+      m_timeoutMs(signalCount, kDefaultTimeoutMs),
+      m_timeouts(signalCount, 0),
+      m_next(signalCount, kNone),
+      m_scheduled(signalCount, false),
+      m_stale(signalCount, false)
+{
+    Q_ASSERT(signalCount <= 0x7FFF);
+
+    m_slots.fill(kNone);
+    m_expired.reserve(signalCount);
+
+    m_clock.start();
+    m_timer.setInterval(TickMs);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &SignalWatchdog::tick);
+}
+
+void SignalWatchdog::setTimeout(int signal, int timeoutMs)
+{
+    if (signal < 0 || signal >= signalCount()) return;
+
+    // Applies from the next deadline check of this signal
+    m_timeoutMs[signal] = qMax(TickMs, timeoutMs);
+}
+
+int SignalWatchdog::slotFor(qint64 deadlineMs) const
+{
+    // The slot after the deadline's tick, so the deadline has passed when it is checked
+    return int((deadlineMs / TickMs + 1) & (kSlotCount - 1));
+}
+
+void SignalWatchdog::schedule(int signal, qint64 deadlineMs)
+{
+    const int slot = slotFor(deadlineMs);
+    m_next[signal] = m_slots[slot];
+    m_slots[slot] = qint16(signal);
+    m_scheduled[signal] = true;
+}
+
+void SignalWatchdog::touch(int signal)
+{
+    if (signal < 0 || signal >= signalCount()) return;
+
+    const qint64 now = m_clock.elapsed();
+    m_lastUpdateMs[signal] = now;
+
+    // Already in the wheel: the new timestamp is picked up when its slot comes round
+    if (m_scheduled[signal]) return;
+
+    schedule(signal, now + m_timeoutMs[signal]);
+    m_scheduledCount++;
+    if (!m_timer.isActive()) {
+        // Idle wheel: resume at the current tick rather than catching up
+        m_lastTick = now / TickMs;
+        m_timer.start();
+    }
+    if (m_stale[signal]) {
+        m_stale[signal] = false;
+        m_staleCount--;
+        emit recovered(signal);
+    }
+}
+
+void SignalWatchdog::tick()
+{
+    const qint64 now = m_clock.elapsed();
+    const qint64 currentTick = now / TickMs;
+
+    // Catch up on late timer events; one full turn visits every slot
+    qint64 firstTick = qMax(m_lastTick + 1, currentTick - kSlotCount + 1);
+    m_lastTick = currentTick;
+
+    m_expired.clear();
+    for (qint64 t = firstTick; t <= currentTick; ++t) {
+        const int slot = int(t & (kSlotCount - 1));
+
+        // Detach the list first; entries that are still alive get re-slotted
+        qint16 signal = m_slots[slot];
+        m_slots[slot] = kNone;
+
+        while (signal != kNone) {
+            const qint16 next = m_next[signal];
+            const qint64 deadline = m_lastUpdateMs[signal] + m_timeoutMs[signal];
+
+            if (deadline <= now) {
+                m_scheduled[signal] = false;
+                m_scheduledCount--;
+                m_stale[signal] = true;
+                m_timeouts[signal]++;
+                m_totalTimeouts++;
+                m_staleCount++;
+                m_expired.append(signal);
+            } else {
+                schedule(signal, deadline);
+            }
+            signal = next;
+        }
+    }
+
+    // Nothing left to check until the next touch()
+    if (m_scheduledCount == 0) m_timer.stop();
+
+    if (!m_expired.isEmpty()) {
+        emit timedOut(m_expired);
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef SIGNALWATCHDOG_H
+#define SIGNALWATCHDOG_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+#include <array>
+
+// Per-signal update deadlines checked by a single hashed timer wheel.
+// touch() only stores a timestamp. Each signal sits in the wheel slot of its
+// deadline and is looked at once when that slot comes round: it either expires
+// or is moved to the slot of its new deadline. A tick therefore costs one slot
+// of work, independent of how many signals are tracked or how often they update,
+// and the timer only runs while at least one signal is in the wheel.
+class SignalWatchdog : public QObject
+{
+    Q_OBJECT
+public:
+    static const int TickMs = 50;
+
+    explicit SignalWatchdog(int signalCount, QObject *parent = nullptr);
+
+    int signalCount() const { return m_lastUpdateMs.size(); }
+
+    void setTimeout(int signal, int timeoutMs);
+    int timeout(int signal) const { return m_timeoutMs.value(signal); }
+
+    // Record an update; arms the deadline on first use and clears staleness
+    void touch(int signal);
+
+    bool isStale(int signal) const { return m_stale.value(signal, false); }
+    int staleCount() const { return m_staleCount; }
+    int timeoutCount() const { return m_totalTimeouts; }
+    int timeoutCount(int signal) const { return int(m_timeouts.value(signal)); }
+
+signals:
+    void timedOut(const QVector<int> &signalIds);   // Once per tick, batched
+    void recovered(int signal);
+
+private slots:
+    void tick();
+
+private:
+    static const int kSlotCount = 64;               // Power of two; 3.2 s per turn
+    static const qint16 kNone = -1;
+
+    void schedule(int signal, qint64 deadlineMs);
+    int slotFor(qint64 deadlineMs) const;
+
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+    qint64 m_lastTick = 0;
+
+    // Structure of arrays indexed by signal id
+    QVector<qint64> m_lastUpdateMs;
+    QVector<qint32> m_timeoutMs;
+    QVector<quint32> m_timeouts;
+    QVector<qint16> m_next;                         // Singly linked wheel slot lists
+    QVector<bool> m_scheduled;
+    QVector<bool> m_stale;
+
+    std::array<qint16, kSlotCount> m_slots;
+    QVector<int> m_expired;                         // Reused between ticks
+    int m_scheduledCount = 0;                       // Signals in the wheel; 0 = timer stopped
+    int m_staleCount = 0;
+    int m_totalTimeouts = 0;
+};
+
+#endif // SIGNALWATCHDOG_H
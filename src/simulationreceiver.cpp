@@ -2,17 +2,18 @@
 #include <QNetworkDatagram>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QDateTime>
 #include <QDebug>
 
-SimulationReceiver::SimulationReceiver(EVVehicleData *data, QObject *parent)
-    : QObject(parent), m_vehicleData(data)
+SimulationReceiver::SimulationReceiver(quint16 port, QObject *parent)
+    : QObject(parent)
 {
     m_socket = new QUdpSocket(this);
-    if (m_socket->bind(QHostAddress::LocalHost, 5555)) {
-        qDebug() << "Simulation Receiver listening on port 5555";
+    if (m_socket->bind(QHostAddress::LocalHost, port)) {
+        qDebug() << "Simulation Receiver listening on port" << port;
         connect(m_socket, &QUdpSocket::readyRead, this, &SimulationReceiver::processPendingDatagrams);
     } else {
-        qWarning() << "Failed to bind Simulation Receiver socket port 5555";
+        qWarning() << "Failed to bind Simulation Receiver socket port" << port;
     }
 }
 
@@ -21,10 +22,27 @@ void SimulationReceiver::processPendingDatagrams()
     while (m_socket->hasPendingDatagrams()) {
         QNetworkDatagram datagram = m_socket->receiveDatagram();
         QJsonDocument doc = QJsonDocument::fromJson(datagram.data());
-        
-        if (doc.isObject()) {
-            QVariantMap data = doc.object().toVariantMap();
-            m_vehicleData->updateFromSimulation(data);
+
+        if (!doc.isObject()) continue;
+
+        // Send time from the simulator ("ts", ms since epoch); older ones lack it
+        const QJsonObject object = doc.object();
+        const qint64 sentMs = qint64(object.value(QLatin1String("ts")).toDouble());
+        const qint64 timestampMs = sentMs > 0 ? sentMs : QDateTime::currentMSecsSinceEpoch();
+
+        QList<SignalSample> samples;
+        samples.reserve(object.size());
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            SignalSample sample;
+            if (!VehicleSignals::fromSimulationKey(it.key(), &sample.signal)) continue;
+            sample.source = InputSource::Simulation;
+            sample.timestampMs = timestampMs;
+            sample.value = it.value().toVariant();
+            samples.append(sample);
+        }
+
+        if (!samples.isEmpty()) {
+            emit samplesReceived(samples);
         }
     }
 }
@@ -3,20 +3,24 @@
 
 #include <QObject>
 #include <QUdpSocket>
-#include "evvehicledata.h"
+#include "signalsample.h"
 
+// Receives JSON state datagrams from tools/ev_simulator.py and turns them into
+// typed samples. Whether they reach EVVehicleData is up to InputArbiter.
 class SimulationReceiver : public QObject
 {
     Q_OBJECT
 public:
-    explicit SimulationReceiver(EVVehicleData *data, QObject *parent = nullptr);
+    explicit SimulationReceiver(quint16 port = 5555, QObject *parent = nullptr);
+
+signals:
+    void samplesReceived(const QList<SignalSample> &samples);
 
 private slots:
     void processPendingDatagrams();
 
 private:
     QUdpSocket *m_socket;
-    EVVehicleData *m_vehicleData;
 };
 
 #endif // SIMULATIONRECEIVER_H
@@ -0,0 +1,105 @@
+#include "statekeeper.h"
+#include "analyticspipeline.h"
+#include "evvehicledata.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <cstring>
+
+static const int kSaveIntervalMs = 60 * 1000;
+static const float kJournalStepMetres = 100.0f;
+
+StateKeeper::StateKeeper(EVVehicleData *vehicleData, AnalyticsPipeline *analytics, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData), m_analytics(analytics)
+{
+    m_saveTimer.setInterval(kSaveIntervalMs);
+    connect(&m_saveTimer, &QTimer::timeout, this, &StateKeeper::save);
+}
+
+bool StateKeeper::open(const QString &path)
+{
+    return m_snapshot.open(path);
+}
+
+bool StateKeeper::restore()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    PersistedState state;
+    if (!m_snapshot.load(&state)) {
+        qDebug() << "No saved vehicle state, starting from defaults";
+        return false;
+    }
+
+    m_vehicleData->setOdometer(state.odometer);
+    m_vehicleData->setTripDistanceA(state.tripDistanceA);
+    m_vehicleData->setTripDistanceB(state.tripDistanceB);
+    m_vehicleData->setEstimatedRange(state.estimatedRange);
+    m_vehicleData->setTripEnergy(state.tripEnergy);
+    m_vehicleData->setTripEfficiency(state.tripEfficiency);
+    if (m_analytics) m_analytics->restore(state.analytics);
+
+    m_restoredAnalytics = state.analytics;
+    m_lastSaved = state;
+    m_lastJournaledOdometer = state.odometer;
+
+    qDebug().noquote() << QStringLiteral("[state] Restored generation %1, journal %2, odometer %3 km in %4 us")
+        .arg(m_snapshot.generation())
+        .arg(m_snapshot.journalSequence())
+        .arg(state.odometer / 1000.0f, 0, 'f', 1)
+        .arg(timer.nsecsElapsed() / 1000);
+    return true;
+}
+
+void StateKeeper::start()
+{
+    if (!m_snapshot.isOpen()) return;
+
+    connect(m_vehicleData, &EVVehicleData::odometerChanged, this, &StateKeeper::journalOdometer);
+
+    // Switching off may be followed by a power cut rather than a clean exit
+    connect(m_vehicleData, &EVVehicleData::readyToDriveChanged, this, [this] {
+        if (!m_vehicleData->readyToDrive()) save();
+    });
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &StateKeeper::save);
+    m_saveTimer.start();
+}
+
+PersistedState StateKeeper::collect() const
+{
+    const VehicleState vehicle = m_vehicleData->snapshot();
+
+    PersistedState state;
+    state.odometer = vehicle.odometer;
+    state.tripDistanceA = vehicle.tripDistanceA;
+    state.tripDistanceB = vehicle.tripDistanceB;
+    state.estimatedRange = vehicle.estimatedRange;
+    state.tripEnergy = vehicle.tripEnergy;
+    state.tripEfficiency = vehicle.tripEfficiency;
+    if (!m_analytics || !m_analytics->memory(&state.analytics)) {
+        state.analytics = m_restoredAnalytics;
+    }
+    return state;
+}
+
+void StateKeeper::save()
+{
+    if (!m_snapshot.isOpen()) return;
+
+    // Parked and unchanged: nothing reaches the flash
+    const PersistedState state = collect();
+    if (memcmp(&state, &m_lastSaved, sizeof(state)) == 0) return;
+
+    if (m_snapshot.save(state)) m_lastSaved = state;
+}
+
+void StateKeeper::journalOdometer()
+{
+    const float odometer = m_vehicleData->odometer();
+    if (m_lastJournaledOdometer >= 0.0f && qAbs(odometer - m_lastJournaledOdometer) < kJournalStepMetres) {
+        return;
+    }
+    m_snapshot.journal(odometer, m_vehicleData->tripDistanceA(), m_vehicleData->tripDistanceB());
+    m_lastJournaledOdometer = odometer;
+}
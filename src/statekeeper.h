@@ -0,0 +1,49 @@
+#ifndef STATEKEEPER_H
+#define STATEKEEPER_H
+
+#include <QObject>
+#include <QTimer>
+#include "statesnapshot.h"
+
+class AnalyticsPipeline;
+class EVVehicleData;
+
+// Keeps odometer, trip counters, energy totals and range smoothing across
+// restarts through a StateSnapshot file.
+// restore() runs before QML loads and only copies a few floats out of the
+// mapping. After that the state is saved once a minute if it changed, when
+// the vehicle is switched off and on shutdown; in between, every 100 m of
+// odometer goes to the journal.
+class StateKeeper : public QObject
+{
+    Q_OBJECT
+public:
+    StateKeeper(EVVehicleData *vehicleData, AnalyticsPipeline *analytics, QObject *parent = nullptr);
+
+    bool open(const QString &path = StateSnapshot::defaultPath());
+
+    // Applies the saved state to EVVehicleData and the analytics pipeline
+    bool restore();
+
+    // Starts periodic saves and the odometer journal
+    void start();
+
+public slots:
+    void save();
+
+private slots:
+    void journalOdometer();
+
+private:
+    PersistedState collect() const;
+
+    EVVehicleData *m_vehicleData;
+    AnalyticsPipeline *m_analytics;
+    StateSnapshot m_snapshot;
+    QTimer m_saveTimer;
+    PersistedState m_lastSaved;
+    AnalyticsMemory m_restoredAnalytics;    // Until the pipeline has its own
+    float m_lastJournaledOdometer = -1.0f;
+};
+
+#endif // STATEKEEPER_H
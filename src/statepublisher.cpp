@@ -0,0 +1,61 @@
+#include "statepublisher.h"
+#include "evvehicledata.h"
+#include "inputarbiter.h"
+#include <QDebug>
+#include <cstring>
+
+// Faster than any display refreshes, well below the 500 ms signal deadlines
+static const int kDefaultPublishMs = 10;
+static const int kHeartbeatMs = 100;
+
+static_assert(VehicleSignals::count() <= 64, "staleMask has one bit per signal");
+
+StatePublisher::StatePublisher(EVVehicleData *vehicleData, InputArbiter *arbiter, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData), m_arbiter(arbiter)
+{
+    memset(&m_last, 0, sizeof(m_last));
+    m_timer.setTimerType(Qt::PreciseTimer);
+    m_timer.setInterval(kDefaultPublishMs);
+    connect(&m_timer, &QTimer::timeout, this, &StatePublisher::publish);
+}
+
+bool StatePublisher::open(const QString &name)
+{
+    if (!m_shared.create(name)) return false;
+
+    publish();
+    m_timer.start();
+    return true;
+}
+
+void StatePublisher::setPublishInterval(int intervalMs)
+{
+    m_timer.setInterval(qMax(1, intervalMs));
+}
+
+void StatePublisher::publish()
+{
+    VehicleState state = m_vehicleData->snapshot();
+
+    for (int signal = 0; signal < VehicleSignals::count(); ++signal) {
+        if (m_arbiter->isSignalStale(signal)) state.staleMask |= quint64(1) << signal;
+        state.sourceTimeMs[signal] = m_arbiter->sourceTimeMs(signal);
+    }
+    for (int source = 0; source < int(InputSource::Count); ++source) {
+        if (m_arbiter->isSourceActive(static_cast<InputSource>(source))) {
+            state.activeSources |= 1u << source;
+        }
+    }
+    state.timeoutCount = quint32(m_arbiter->timeoutCount());
+
+    const qint64 now = SharedVehicleState::monotonicMs();
+    if (memcmp(&state, &m_last, sizeof(state)) != 0) {
+        m_shared.publish(state);
+        m_last = state;
+        m_lastHeartbeatMs = now;
+        m_publishCount++;
+    } else if (now - m_lastHeartbeatMs >= kHeartbeatMs) {
+        m_shared.touchHeartbeat();
+        m_lastHeartbeatMs = now;
+    }
+}
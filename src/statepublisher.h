@@ -0,0 +1,40 @@
+#ifndef STATEPUBLISHER_H
+#define STATEPUBLISHER_H
+
+#include <QObject>
+#include <QTimer>
+#include "sharedvehiclestate.h"
+
+class EVVehicleData;
+class InputArbiter;
+
+// ev-datad side of the shared snapshot.
+// Samples EVVehicleData and the arbiter's input status at a fixed rate and
+// publishes a new VehicleState only when something changed; otherwise it
+// just refreshes the heartbeat so readers can tell a quiet bus from a dead
+// service.
+class StatePublisher : public QObject
+{
+    Q_OBJECT
+public:
+    StatePublisher(EVVehicleData *vehicleData, InputArbiter *arbiter, QObject *parent = nullptr);
+
+    bool open(const QString &name = SharedVehicleState::DefaultName);
+    void setPublishInterval(int intervalMs);
+
+    quint64 publishCount() const { return m_publishCount; }
+
+private slots:
+    void publish();
+
+private:
+    EVVehicleData *m_vehicleData;
+    InputArbiter *m_arbiter;
+    SharedVehicleState m_shared;
+    QTimer m_timer;
+    VehicleState m_last;
+    qint64 m_lastHeartbeatMs = 0;
+    quint64 m_publishCount = 0;
+};
+
+#endif // STATEPUBLISHER_H
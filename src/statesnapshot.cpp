@@ -0,0 +1,274 @@
+#include "statesnapshot.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const quint32 kMagic = 0x45565353;       // "EVSS"
+static const quint32 kVersion = 1;
+static const size_t kBlockSize = 4096;          // Flash page; slots and journal pages never share one
+static const quint32 kJournalRecords = 8192;    // 64 blocks of 128 records
+
+struct StateSnapshot::Slot {
+    quint32 checksum;           // CRC-32 of everything after it
+    quint32 journalSequence;    // Last journal record folded into this slot
+    quint64 generation;         // 0 = never written
+    PersistedState state;
+};
+
+struct StateSnapshot::JournalRecord {
+    quint32 checksum;           // CRC-32 of everything after it
+    quint32 sequence;           // 0 = never written
+    float odometer;
+    float tripDistanceA;
+    float tripDistanceB;
+    quint32 reserved[3];
+};
+
+struct StateSnapshot::File {
+    struct alignas(kBlockSize) Header {
+        quint32 magic;
+        quint32 version;
+        quint32 stateSize;
+        quint32 journalRecords;
+    } header;
+    struct alignas(kBlockSize) SlotBlock {
+        Slot slot;
+    } slots[2];
+    alignas(kBlockSize) JournalRecord journal[kJournalRecords];
+
+    static_assert(sizeof(Slot) <= kBlockSize, "a slot fits one block");
+    static_assert(kBlockSize % sizeof(JournalRecord) == 0, "journal records pack evenly into blocks");
+};
+
+static quint32 crc32(const void *data, size_t size)
+{
+    static const std::array<quint32, 256> table = [] {
+        std::array<quint32, 256> table {};
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            table[i] = value;
+        }
+        return table;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    const uchar *bytes = static_cast<const uchar *>(data);
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+static quint32 checksumOf(const T &record)
+{
+    const size_t offset = offsetof(T, checksum) + sizeof(record.checksum);
+    return crc32(reinterpret_cast<const char *>(&record) + offset, sizeof(T) - offset);
+}
+
+template <typename T>
+static bool isValid(const T &record)
+{
+    return checksumOf(record) == record.checksum;
+}
+
+static quint32 journalIndex(quint32 sequence)
+{
+    return (sequence - 1) % kJournalRecords;
+}
+
+QString StateSnapshot::defaultPath()
+{
+    // Shared by ev-cluster and ev-datad; whichever runs the analytics owns it
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation)
+        + "/ev-instrument-cluster/state.snap";
+}
+
+StateSnapshot::~StateSnapshot()
+{
+    close();
+}
+
+bool StateSnapshot::open(const QString &path)
+{
+    close();
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    const QByteArray fileName = QFile::encodeName(path);
+    const int fd = ::open(fileName.constData(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        qWarning() << "Cannot open state snapshot" << path << strerror(errno);
+        return false;
+    }
+
+    // One writer; the lock goes away with the process, crashed or not
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        qWarning() << "State snapshot" << path << "is in use by another process";
+        ::close(fd);
+        return false;
+    }
+
+    struct stat info;
+    const bool sized = fstat(fd, &info) == 0 && size_t(info.st_size) == sizeof(File);
+    if (!sized && ftruncate(fd, off_t(sizeof(File))) != 0) {
+        qWarning() << "ftruncate failed for" << path << strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    void *address = mmap(nullptr, sizeof(File), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        qWarning() << "mmap failed for" << path << strerror(errno);
+        ::close(fd);
+        return false;
+    }
+
+    m_file = static_cast<File *>(address);
+    m_fd = fd;
+
+    const File::Header &header = m_file->header;
+    if (!sized || header.magic != kMagic || header.version != kVersion
+        || header.stateSize != sizeof(PersistedState) || header.journalRecords != kJournalRecords) {
+        if (sized) qWarning() << "State snapshot" << path << "has an incompatible layout, starting over";
+        initialize();
+    }
+
+    const Slot *slot = newestSlot();
+    m_generation = slot ? slot->generation : 0;
+    m_journalSequence = findJournalHead(slot ? slot->journalSequence : 0);
+    return true;
+}
+
+void StateSnapshot::close()
+{
+    if (!m_file) return;
+
+    munmap(m_file, sizeof(File));
+    ::close(m_fd);
+    m_file = nullptr;
+    m_fd = -1;
+    m_generation = 0;
+    m_journalSequence = 0;
+}
+
+void StateSnapshot::initialize()
+{
+    memset(static_cast<void *>(m_file), 0, sizeof(File));
+    m_file->header.magic = kMagic;
+    m_file->header.version = kVersion;
+    m_file->header.stateSize = sizeof(PersistedState);
+    m_file->header.journalRecords = kJournalRecords;
+    sync(m_file, sizeof(File), MS_SYNC);
+}
+
+const StateSnapshot::Slot *StateSnapshot::newestSlot() const
+{
+    const Slot *newest = nullptr;
+    for (const File::SlotBlock &block : m_file->slots) {
+        const Slot &slot = block.slot;
+        if (slot.generation == 0 || !isValid(slot)) continue;   // Never written or torn
+        if (!newest || slot.generation > newest->generation) newest = &slot;
+    }
+    return newest;
+}
+
+quint32 StateSnapshot::findJournalHead(quint32 after) const
+{
+    // Records since the last save normally follow the slot's sequence directly,
+    // so this touches a handful of records instead of the whole ring
+    quint32 head = after;
+    for (quint32 steps = 0; steps < kJournalRecords; ++steps) {
+        const JournalRecord &record = m_file->journal[journalIndex(head + 1)];
+        if (record.sequence != head + 1 || !isValid(record)) break;
+        head++;
+    }
+    if (head != after || after != 0) return head;
+
+    // No slot to start from: take the newest valid record anywhere in the ring
+    for (const JournalRecord &record : m_file->journal) {
+        if (record.sequence > head && isValid(record)) head = record.sequence;
+    }
+    return head;
+}
+
+bool StateSnapshot::load(PersistedState *state)
+{
+    if (!m_file) return false;
+
+    const Slot *slot = newestSlot();
+    const quint32 slotSequence = slot ? slot->journalSequence : 0;
+    if (!slot && m_journalSequence == 0) return false;
+
+    *state = slot ? slot->state : PersistedState();
+
+    // Distance driven after the last save
+    if (m_journalSequence > slotSequence) {
+        const JournalRecord &record = m_file->journal[journalIndex(m_journalSequence)];
+        state->odometer = record.odometer;
+        state->tripDistanceA = record.tripDistanceA;
+        state->tripDistanceB = record.tripDistanceB;
+    }
+    return true;
+}
+
+bool StateSnapshot::save(const PersistedState &state)
+{
+    if (!m_file) return false;
+
+    // Never overwrite the newest good copy
+    const Slot *newest = newestSlot();
+    Slot &target = newest == &m_file->slots[0].slot ? m_file->slots[1].slot : m_file->slots[0].slot;
+    target.generation = m_generation + 1;
+    target.journalSequence = m_journalSequence;
+    target.state = state;
+    target.checksum = checksumOf(target);
+
+    if (!sync(&target, sizeof(target), MS_SYNC)) return false;
+    m_generation = target.generation;
+    return true;
+}
+
+void StateSnapshot::journal(float odometer, float tripDistanceA, float tripDistanceB)
+{
+    if (!m_file) return;
+
+    const quint32 sequence = m_journalSequence + 1;
+    JournalRecord &record = m_file->journal[journalIndex(sequence)];
+    record.sequence = sequence;
+    record.odometer = odometer;
+    record.tripDistanceA = tripDistanceA;
+    record.tripDistanceB = tripDistanceB;
+    memset(record.reserved, 0, sizeof(record.reserved));
+    record.checksum = checksumOf(record);
+
+    // Writeback coalesces the records of one block into a single flash write
+    sync(&record, sizeof(record), MS_ASYNC);
+    m_journalSequence = sequence;
+}
+
+bool StateSnapshot::sync(const void *address, size_t size, int flags)
+{
+    // msync wants a page-aligned start
+    static const quintptr pageSize = quintptr(sysconf(_SC_PAGESIZE));
+    const quintptr begin = quintptr(address) & ~(pageSize - 1);
+    const quintptr end = quintptr(address) + size;
+    if (msync(reinterpret_cast<void *>(begin), end - begin, flags) != 0) {
+        qWarning() << "msync failed for the state snapshot" << strerror(errno);
+        return false;
+    }
+    return true;
+}
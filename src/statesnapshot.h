@@ -0,0 +1,70 @@
+#ifndef STATESNAPSHOT_H
+#define STATESNAPSHOT_H
+
+#include <QString>
+#include "analyticsresult.h"
+
+// Values that must survive a restart, as stored in the snapshot file
+struct PersistedState {
+    float odometer = 0.0f;          // Metres
+    float tripDistanceA = 0.0f;
+    float tripDistanceB = 0.0f;
+    float estimatedRange = 0.0f;    // km, shown until analytics posts its first result
+    float tripEnergy = 0.0f;        // kWh
+    float tripEfficiency = 0.0f;    // Wh/km
+    AnalyticsMemory analytics;
+};
+
+// Crash-consistent state file, memory-mapped.
+// Two checksummed slots, each in its own page: a save writes the older slot
+// and syncs only that page, so a power cut mid-write leaves the other slot
+// intact. Distance between saves goes to a ring journal of small checksummed
+// records that walks through 64 pages, so frequent odometer updates spread
+// over the flash instead of rewriting one block. Loading checks two slots and
+// the journal records written since the newer one - no parsing, no SQL.
+class StateSnapshot
+{
+public:
+    StateSnapshot() = default;
+    ~StateSnapshot();
+
+    StateSnapshot(const StateSnapshot &) = delete;
+    StateSnapshot &operator=(const StateSnapshot &) = delete;
+
+    static QString defaultPath();   // <GenericDataLocation>/ev-instrument-cluster/state.snap
+
+    // Maps the file, creating or re-initializing it if its layout does not match.
+    // Fails if another process holds it.
+    bool open(const QString &path = defaultPath());
+    void close();
+    bool isOpen() const { return m_file != nullptr; }
+
+    // Newest valid slot with newer journal distances applied; false if there is none
+    bool load(PersistedState *state);
+
+    // Writes the older slot and waits for it to reach storage
+    bool save(const PersistedState &state);
+
+    // Appends distances to the journal; written back by the kernel, not waited for
+    void journal(float odometer, float tripDistanceA, float tripDistanceB);
+
+    quint64 generation() const { return m_generation; }
+    quint32 journalSequence() const { return m_journalSequence; }
+
+private:
+    struct File;
+    struct Slot;
+    struct JournalRecord;
+
+    const Slot *newestSlot() const;
+    quint32 findJournalHead(quint32 after) const;   // Last sequence continuing from after
+    void initialize();
+    bool sync(const void *address, size_t size, int flags);
+
+    File *m_file = nullptr;
+    int m_fd = -1;
+    quint64 m_generation = 0;           // Of the newest valid slot
+    quint32 m_journalSequence = 0;      // Of the last valid journal record
+};
+
+#endif // STATESNAPSHOT_H
@@ -0,0 +1,288 @@
+#include "tripdetector.h"
+#include "databaseservice.h"
+#include "evvehicledata.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFuture>
+#include <QPair>
+#include <QPointF>
+#include <QtMath>
+
+static const int kSampleIntervalMs = 200;       // 5 Hz
+static const float kMovingKmh = 3.0f;           // Start/resume above, stop below kStoppedKmh
+static const float kStoppedKmh = 1.0f;
+static const float kMinTripKm = 0.1f;           // Shorter is a manoeuvre, not a trip
+static const double kRouteSpacingM = 25.0;      // Thinning while driving
+static const double kRouteToleranceM = 10.0;    // Simplification when the trip closes
+static const int kMaxRoutePoints = 1024;        // Re-simplified coarser beyond this while driving
+
+// Local flat projection, good to well under a metre over a trip's extent
+static QPointF toMetres(const RoutePoint &point, double referenceLatitude)
+{
+    return QPointF(point.longitude * 111320.0 * qCos(qDegreesToRadians(referenceLatitude)),
+                   point.latitude * 110540.0);
+}
+
+// No fix reads as 0,0 (or garbage); such samples must not stretch the extent
+static bool hasFix(const VehicleState &vehicle)
+{
+    const double latitude = vehicle.gpsLatitude;
+    const double longitude = vehicle.gpsLongitude;
+    if (!(qAbs(latitude) <= 90.0 && qAbs(longitude) <= 180.0)) return false;     // Also NaN
+    return qAbs(latitude) > 1e-6 || qAbs(longitude) > 1e-6;
+}
+
+static double distanceMetres(const RoutePoint &a, const RoutePoint &b)
+{
+    const QPointF delta = toMetres(a, a.latitude) - toMetres(b, a.latitude);
+    return qSqrt(QPointF::dotProduct(delta, delta));
+}
+
+// Ramer-Douglas-Peucker: keeps the points that deviate more than tolerance
+// from the line between their kept neighbours
+static QVector<RoutePoint> simplified(const QVector<RoutePoint> &route, double toleranceM)
+{
+    if (route.size() < 3) return route;
+
+    const double referenceLatitude = route.first().latitude;
+    QVector<QPointF> points;
+    points.reserve(route.size());
+    for (const RoutePoint &point : route) {
+        points.append(toMetres(point, referenceLatitude));
+    }
+
+    QVector<bool> keep(route.size(), false);
+    keep.first() = keep.last() = true;
+    QVector<QPair<int, int>> spans { qMakePair(0, int(route.size()) - 1) };
+    while (!spans.isEmpty()) {
+        const auto [first, last] = spans.takeLast();
+        const QPointF origin = points[first];
+        const QPointF direction = points[last] - origin;
+        const double length = qSqrt(QPointF::dotProduct(direction, direction));
+
+        int farthest = -1;
+        double farthestDistance = toleranceM;
+        for (int i = first + 1; i < last; ++i) {
+            const QPointF offset = points[i] - origin;
+            const double distance = length > 0.0
+                ? qAbs(direction.x() * offset.y() - direction.y() * offset.x()) / length
+                : qSqrt(QPointF::dotProduct(offset, offset));
+            if (distance > farthestDistance) {
+                farthest = i;
+                farthestDistance = distance;
+            }
+        }
+        if (farthest < 0) continue;
+
+        keep[farthest] = true;
+        spans.append(qMakePair(first, farthest));
+        spans.append(qMakePair(farthest, last));
+    }
+
+    QVector<RoutePoint> result;
+    for (int i = 0; i < route.size(); ++i) {
+        if (keep[i]) result.append(route[i]);
+    }
+    return result;
+}
+
+TripDetector::TripDetector(EVVehicleData *vehicleData, DatabaseService *database, QObject *parent)
+    : QObject(parent), m_vehicleData(vehicleData), m_database(database)
+{
+    m_now = [this] { return m_clock.elapsed(); };
+    m_timer.setInterval(kSampleIntervalMs);
+    connect(&m_timer, &QTimer::timeout, this, &TripDetector::sample);
+}
+
+void TripDetector::start()
+{
+    m_clock.start();
+    m_lastSampleMs = -1;
+    m_timer.start();
+
+    // Switching off may be followed by a power cut rather than a clean exit,
+    // so the trip is saved then instead of after the park timeout
+    connect(m_vehicleData, &EVVehicleData::readyToDriveChanged, this, [this] {
+        if (!m_vehicleData->readyToDrive()) endTrip("switched off");
+    });
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this] {
+        endTrip("exit");
+    });
+}
+
+void TripDetector::sample()
+{
+    const VehicleState vehicle = m_vehicleData->snapshot();
+    const qint64 now = m_now();
+    const float deltaHours = m_lastSampleMs >= 0 ? (now - m_lastSampleMs) / 3600000.0f : 0.0f;
+    m_lastSampleMs = now;
+
+    const bool ready = vehicle.readyToDrive;
+    const bool moving = vehicle.speed >= kMovingKmh;
+
+    switch (m_state) {
+    case Parked:
+        if (ready && moving && !vehicle.chargingActive) {
+            beginTrip(vehicle);
+            setState(Driving);
+        }
+        break;
+
+    case Driving:
+        accumulate(vehicle, deltaHours);
+        if (vehicle.speed < kStoppedKmh) stopAt(vehicle, now);
+        break;
+
+    case Stopped:
+        accumulate(vehicle, deltaHours);
+        if (ready && moving) {
+            setState(Driving);
+        } else if (vehicle.chargingActive) {
+            finishTrip("charging");
+        } else {
+            const bool parked = !ready || vehicle.parkingBrake;
+            if (now - m_stoppedSinceMs >= (parked ? m_parkTimeoutMs : m_idleTimeoutMs)) {
+                finishTrip(!ready ? "switched off" : parked ? "parked" : "idle");
+            }
+        }
+        break;
+    }
+}
+
+void TripDetector::stopAt(const VehicleState &vehicle, qint64 now)
+{
+    // A timeout later ends the trip here, not when it expired
+    m_atStop = m_trip;
+    m_atStop.endTime = QDateTime::currentDateTime();
+    const RoutePoint position { vehicle.gpsLatitude, vehicle.gpsLongitude };
+    if (hasFix(vehicle) && (m_atStop.route.isEmpty() || distanceMetres(m_atStop.route.last(), position) > 1.0)) {
+        m_atStop.route.append(position);
+    }
+    m_stoppedSinceMs = now;
+    setState(Stopped);
+}
+
+void TripDetector::endTrip(const char *reason)
+{
+    if (m_state == Parked) return;
+
+    // Take in the stretch since the last sample; still rolling counts as stopped now
+    sample();
+    if (m_state == Driving) stopAt(m_vehicleData->snapshot(), m_now());
+    if (m_state == Stopped) finishTrip(reason);
+}
+
+void TripDetector::beginTrip(const VehicleState &vehicle)
+{
+    m_trip = TripRecord();
+    m_trip.id = -1;
+    m_trip.startTime = QDateTime::currentDateTime();
+    m_trip.endTime = m_trip.startTime;
+    m_trip.distanceKm = 0.0f;
+    m_trip.energyKwh = 0.0f;
+    m_trip.averageEfficiency = 0.0f;
+    m_trip.startSoc = vehicle.batterySoc;
+    m_trip.endSoc = vehicle.batterySoc;
+    addPosition(vehicle);
+
+    m_startOdometer = vehicle.odometer;
+    m_integratedKm = 0.0f;
+    m_consumedKwh = 0.0f;
+
+    qDebug().noquote() << QStringLiteral("[trip] Started at %1% SoC").arg(vehicle.batterySoc, 0, 'f', 1);
+    emit tripStarted();
+}
+
+void TripDetector::accumulate(const VehicleState &vehicle, float deltaHours)
+{
+    // Odometer when the source provides one, integrated speed otherwise
+    m_integratedKm += vehicle.speed * deltaHours;
+    const float odometerKm = (vehicle.odometer - m_startOdometer) / 1000.0f;
+    m_trip.distanceKm = odometerKm > 0.0f ? odometerKm : m_integratedKm;
+
+    const float energyKwh = vehicle.powerOutput * deltaHours;
+    if (energyKwh >= 0.0f) {
+        m_consumedKwh += energyKwh;
+    } else if (!vehicle.chargingActive) {
+        m_trip.regenKwh -= energyKwh;
+    }
+    m_trip.energyKwh = m_consumedKwh - m_trip.regenKwh;
+    m_trip.endSoc = vehicle.batterySoc;
+
+    addPosition(vehicle);
+}
+
+void TripDetector::addPosition(const VehicleState &vehicle)
+{
+    if (!hasFix(vehicle)) return;
+
+    // The extent starts at the first fix; the route is empty until then
+    const double latitude = vehicle.gpsLatitude;
+    const double longitude = vehicle.gpsLongitude;
+    if (m_trip.route.isEmpty()) {
+        m_trip.minLatitude = m_trip.maxLatitude = latitude;
+        m_trip.minLongitude = m_trip.maxLongitude = longitude;
+    } else {
+        m_trip.minLatitude = qMin(m_trip.minLatitude, latitude);
+        m_trip.maxLatitude = qMax(m_trip.maxLatitude, latitude);
+        m_trip.minLongitude = qMin(m_trip.minLongitude, longitude);
+        m_trip.maxLongitude = qMax(m_trip.maxLongitude, longitude);
+    }
+    addRoutePoint(latitude, longitude);
+}
+
+void TripDetector::addRoutePoint(double latitude, double longitude)
+{
+    const RoutePoint point { latitude, longitude };
+    if (!m_trip.route.isEmpty() && distanceMetres(m_trip.route.last(), point) < kRouteSpacingM) return;
+
+    m_trip.route.append(point);
+    if (m_trip.route.size() <= kMaxRoutePoints) return;
+
+    // Long drive: halve the route with a coarser tolerance until it fits
+    double tolerance = kRouteToleranceM;
+    while (m_trip.route.size() > kMaxRoutePoints / 2) {
+        m_trip.route = simplified(m_trip.route, tolerance);
+        tolerance *= 2.0;
+    }
+}
+
+void TripDetector::finishTrip(const char *reason)
+{
+    TripRecord trip = m_atStop;
+    setState(Parked);
+
+    if (trip.distanceKm < kMinTripKm) {
+        qDebug().noquote() << QStringLiteral("[trip] Discarded, %1 km (%2)")
+            .arg(trip.distanceKm, 0, 'f', 2).arg(QLatin1String(reason));
+        return;
+    }
+
+    trip.route = simplified(trip.route, kRouteToleranceM);
+    trip.averageEfficiency = trip.energyKwh * 1000.0f / trip.distanceKm;
+
+    qDebug().noquote() << QStringLiteral("[trip] Finished (%1): %2 km, %3 kWh net, %4 kWh regen, "
+                                         "SoC %5% -> %6%, %7 Wh/km, %8 route points")
+        .arg(QLatin1String(reason))
+        .arg(trip.distanceKm, 0, 'f', 2)
+        .arg(trip.energyKwh, 0, 'f', 2)
+        .arg(trip.regenKwh, 0, 'f', 2)
+        .arg(trip.startSoc, 0, 'f', 1)
+        .arg(trip.endSoc, 0, 'f', 1)
+        .arg(trip.averageEfficiency, 0, 'f', 0)
+        .arg(trip.route.size());
+    emit tripFinished(trip);
+
+    if (!m_database) return;
+    m_database->saveTrip(trip).then(this, [this](int tripId) {
+        if (tripId >= 0) emit tripSaved(tripId);
+    });
+}
+
+void TripDetector::setState(State state)
+{
+    if (m_state == state) return;
+    const bool wasActive = isActive();
+    m_state = state;
+    if (isActive() != wasActive) emit activeChanged();
+}
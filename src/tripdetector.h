@@ -0,0 +1,97 @@
+#ifndef TRIPDETECTOR_H
+#define TRIPDETECTOR_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <functional>
+#include "database.h"
+#include "vehiclestate.h"
+
+class DatabaseService;
+class EVVehicleData;
+
+// Splits driving into trips and hands each finished one to DatabaseService.
+// Samples EVVehicleData::snapshot() (lock-free) at 5 Hz and builds the record
+// as the drive goes: distance, net energy and regen, SoC, GPS extent and a
+// route thinned to points 25 m apart, simplified again when the trip closes.
+//
+//   Parked --ready and moving--> Driving --stopped--> Stopped --moving--> Driving
+//
+// Stopped ends the trip when charging starts, or after parkTimeout with the
+// parking brake on, or after idleTimeout otherwise - so traffic lights and
+// short stops do not split a drive. The trip ends at the moment the vehicle
+// stopped. Switching off or quitting ends it at once, since power may be cut
+// next; GPS samples without a fix are left out of the extent and route.
+// Saving is queued to the database thread; nothing here waits on SQLite.
+class TripDetector : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool active READ isActive NOTIFY activeChanged)
+
+public:
+    enum State {
+        Parked,
+        Driving,
+        Stopped
+    };
+    Q_ENUM(State)
+
+    static const int DefaultIdleTimeoutSec = 600;
+    static const int DefaultParkTimeoutSec = 120;
+
+    TripDetector(EVVehicleData *vehicleData, DatabaseService *database, QObject *parent = nullptr);
+
+    void start();
+
+    // Milliseconds since start(); scripted tests swap in their own clock
+    void setClock(std::function<qint64()> clock) { m_now = std::move(clock); }
+
+    // Stopped but ready to drive
+    void setIdleTimeout(int seconds) { m_idleTimeoutMs = qint64(seconds) * 1000; }
+    // Stopped with the parking brake on
+    void setParkTimeout(int seconds) { m_parkTimeoutMs = qint64(seconds) * 1000; }
+
+    State state() const { return m_state; }
+    bool isActive() const { return m_state != Parked; }
+
+signals:
+    void activeChanged();
+    void tripStarted();
+    void tripFinished(const TripRecord &trip);
+    void tripSaved(int tripId);
+
+public slots:
+    // Called at 5 Hz by the timer; tests call it directly
+    void sample();
+
+private:
+    void beginTrip(const VehicleState &vehicle);
+    void accumulate(const VehicleState &vehicle, float deltaHours);
+    void addPosition(const VehicleState &vehicle);
+    void addRoutePoint(double latitude, double longitude);
+    void stopAt(const VehicleState &vehicle, qint64 now);
+    void endTrip(const char *reason);
+    void finishTrip(const char *reason);
+    void setState(State state);
+
+    EVVehicleData *m_vehicleData;
+    DatabaseService *m_database;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    std::function<qint64()> m_now;
+    qint64 m_lastSampleMs = -1;
+    qint64 m_stoppedSinceMs = 0;
+    qint64 m_idleTimeoutMs = qint64(DefaultIdleTimeoutSec) * 1000;
+    qint64 m_parkTimeoutMs = qint64(DefaultParkTimeoutSec) * 1000;
+    State m_state = Parked;
+
+    // Trip being built; m_atStop is its state when the vehicle last stopped
+    TripRecord m_trip;
+    TripRecord m_atStop;
+    float m_startOdometer = 0.0f;       // Metres
+    float m_integratedKm = 0.0f;        // From speed, if the odometer does not move
+    float m_consumedKwh = 0.0f;
+};
+
+#endif // TRIPDETECTOR_H
@@ -0,0 +1,84 @@
+#include "triprollup.h"
+#include <QDataStream>
+#include <QtMath>
+
+void EfficiencyHistogram::add(float efficiencyWhPerKm)
+{
+    // Net-regen trips (negative Wh/km) land in the first bin
+    int bin = qBound(0, int(efficiencyWhPerKm / kBinWidthWhPerKm), kBinCount - 1);
+    m_bins[bin]++;
+}
+
+quint32 EfficiencyHistogram::count() const
+{
+    quint32 total = 0;
+    for (quint32 n : m_bins) {
+        total += n;
+    }
+    return total;
+}
+
+float EfficiencyHistogram::percentile(float p) const
+{
+    const quint32 total = count();
+    if (total == 0) {
+        return 0.0f;
+    }
+
+    // Linear interpolation inside the bin that crosses the target rank
+    const float target = qBound(0.0f, p, 1.0f) * total;
+    float cumulative = 0.0f;
+    for (int i = 0; i < kBinCount; ++i) {
+        if (m_bins[i] == 0) continue;
+        if (cumulative + m_bins[i] >= target) {
+            float fraction = (target - cumulative) / m_bins[i];
+            return (i + fraction) * kBinWidthWhPerKm;
+        }
+        cumulative += m_bins[i];
+    }
+    return kBinCount * kBinWidthWhPerKm;
+}
+
+QByteArray EfficiencyHistogram::toBlob() const
+{
+    QByteArray blob;
+    QDataStream stream(&blob, QIODevice::WriteOnly);
+    for (quint32 n : m_bins) {
+        stream << n;
+    }
+    return blob;
+}
+
+EfficiencyHistogram EfficiencyHistogram::fromBlob(const QByteArray &blob)
+{
+    EfficiencyHistogram histogram;
+    QDataStream stream(blob);
+    for (int i = 0; i < kBinCount && !stream.atEnd(); ++i) {
+        stream >> histogram.m_bins[i];
+    }
+    return histogram;
+}
+
+QDateTime TripRollup::bucketStart(RollupBucket bucket, const QDateTime &time)
+{
+    const QDateTime local = time.toLocalTime();
+    const QDate date = local.date();
+
+    switch (bucket) {
+    case RollupBucket::Hour:
+        return QDateTime(date, QTime(local.time().hour(), 0));
+    case RollupBucket::Day:
+        return QDateTime(date, QTime(0, 0));
+    case RollupBucket::Month:
+        return QDateTime(QDate(date.year(), date.month(), 1), QTime(0, 0));
+    }
+    return local;
+}
+
+const QList<RollupBucket> &TripRollup::allBuckets()
+{
+    static const QList<RollupBucket> buckets = {
+        RollupBucket::Hour, RollupBucket::Day, RollupBucket::Month
+    };
+    return buckets;
+}
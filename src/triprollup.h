@@ -0,0 +1,58 @@
+#ifndef TRIPROLLUP_H
+#define TRIPROLLUP_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <array>
+
+// Aggregation granularity for trip/charge rollups (stored as an integer column)
+enum class RollupBucket {
+    Hour = 0,
+    Day = 1,
+    Month = 2
+};
+
+// One dashboard-ready point of a rollup series
+struct RollupPoint {
+    QDateTime bucketStart;
+    float distanceKm = 0.0f;
+    float energyKwh = 0.0f;
+    float regenKwh = 0.0f;
+    float chargeKwh = 0.0f;
+    int tripCount = 0;
+    int chargeSessions = 0;
+    float efficiencyWhPerKm = 0.0f;   // energy / distance over the bucket
+    float efficiencyP10 = 0.0f;       // Per-trip efficiency percentiles (Wh/km)
+    float efficiencyP50 = 0.0f;
+    float efficiencyP90 = 0.0f;
+};
+
+// Fixed-bin histogram of per-trip efficiency. Mergeable, so percentiles can be
+// maintained incrementally without keeping individual trips.
+class EfficiencyHistogram
+{
+public:
+    static constexpr int kBinCount = 21;          // 20 bins + overflow
+    static constexpr float kBinWidthWhPerKm = 20.0f;
+
+    void add(float efficiencyWhPerKm);
+    float percentile(float p) const;              // p in [0, 1]
+    quint32 count() const;
+
+    QByteArray toBlob() const;
+    static EfficiencyHistogram fromBlob(const QByteArray &blob);
+
+private:
+    std::array<quint32, kBinCount> m_bins = {};
+};
+
+namespace TripRollup {
+    // Local-time start of the bucket containing the given time
+    QDateTime bucketStart(RollupBucket bucket, const QDateTime &time);
+
+    // All bucket sizes, finest first
+    const QList<RollupBucket> &allBuckets();
+}
+
+#endif // TRIPROLLUP_H
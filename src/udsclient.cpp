@@ -0,0 +1,223 @@
+#include "udsclient.h"
+#include <QDebug>
+
+static const quint8 kNegativeResponse = 0x7F;
+static const quint8 kPositiveOffset = 0x40;
+static const quint8 kResponsePending = 0x78;
+
+static const quint8 kDiagnosticSessionControl = 0x10;
+static const quint8 kReadDtcInformation = 0x19;
+static const quint8 kReadDataByIdentifier = 0x22;
+static const quint8 kTesterPresent = 0x3E;
+static const quint8 kReportDtcByStatusMask = 0x02;
+
+QString UdsDtc::toString() const
+{
+    // Upper two bits of the first byte select the system letter
+    static const char systems[] = { 'P', 'C', 'B', 'U' };
+    const quint8 high = quint8(code >> 16);
+    return QStringLiteral("%1%2%3-%4")
+        .arg(QChar(systems[high >> 6]))
+        .arg((high >> 4) & 0x3)
+        .arg(((code >> 8) & 0xFFF), 3, 16, QChar('0'))
+        .arg(code & 0xFF, 2, 16, QChar('0'))
+        .toUpper();
+}
+
+UdsClient::UdsClient(IsoTpTransport *transport, QObject *parent)
+    : QObject(parent), m_transport(transport)
+{
+}
+
+UdsClient::~UdsClient()
+{
+    for (Session *s : std::as_const(m_sessions)) {
+        UdsResponse aborted;
+        aborted.error = QStringLiteral("client destroyed");
+        while (!s->queue.isEmpty()) {
+            PendingRequest pending = s->queue.dequeue();
+            pending.promise->addResult(aborted);
+            pending.promise->finish();
+        }
+        delete s;
+    }
+}
+
+void UdsClient::setTimeouts(int p2Ms, int p2StarMs)
+{
+    m_p2Ms = p2Ms;
+    m_p2StarMs = p2StarMs;
+}
+
+UdsClient::Session *UdsClient::session(const UdsEcu &ecu)
+{
+    const quint64 key = (quint64(ecu.responseId | (ecu.extendedIds ? 0x80000000u : 0u)) << 32)
+                        | ecu.requestId;
+    Session *existing = m_sessions.value(key);
+    if (existing) return existing;
+
+    IsoTpAddress address;
+    address.txId = ecu.requestId;
+    address.rxId = ecu.responseId;
+    address.extendedIds = ecu.extendedIds;
+
+    Session *created = new Session;
+    created->channel = m_transport->channel(address);
+    created->timer = new QTimer(this);
+    created->timer->setSingleShot(true);
+
+    connect(created->channel, &IsoTpChannel::messageReceived, this, [this, created](const QByteArray &payload) {
+        onMessage(created, payload);
+    });
+    connect(created->channel, &IsoTpChannel::receptionStarted, this, [created]() {
+        // A long response is on its way; ISO-TP guards the rest
+        created->timer->stop();
+    });
+    connect(created->channel, &IsoTpChannel::sendComplete, this, [this, created]() {
+        if (created->busy) created->timer->start(m_p2Ms);
+    });
+    connect(created->channel, &IsoTpChannel::errorOccurred, this, [this, created](IsoTpChannel::Error error) {
+        if (!created->busy) return;
+        UdsResponse failed;
+        failed.error = QStringLiteral("ISO-TP error %1").arg(int(error));
+        finish(created, failed);
+    });
+    connect(created->timer, &QTimer::timeout, this, [this, created]() {
+        UdsResponse failed;
+        failed.error = QStringLiteral("no response");
+        finish(created, failed);
+    });
+
+    m_sessions.insert(key, created);
+    return created;
+}
+
+QFuture<UdsResponse> UdsClient::request(const UdsEcu &ecu, const QByteArray &request)
+{
+    auto promise = std::make_shared<QPromise<UdsResponse>>();
+    QFuture<UdsResponse> future = promise->future();
+    promise->start();
+
+    if (request.isEmpty()) {
+        UdsResponse failed;
+        failed.error = QStringLiteral("empty request");
+        promise->addResult(failed);
+        promise->finish();
+        return future;
+    }
+
+    Session *s = session(ecu);
+    s->queue.enqueue({ request, promise });
+    if (!s->busy) sendNext(s);
+    return future;
+}
+
+void UdsClient::sendNext(Session *s)
+{
+    if (s->busy || s->queue.isEmpty()) return;
+
+    s->busy = true;
+    if (!s->channel->send(s->queue.head().payload)) {
+        UdsResponse failed;
+        failed.error = QStringLiteral("send failed");
+        finish(s, failed);
+    }
+}
+
+void UdsClient::finish(Session *s, const UdsResponse &response)
+{
+    s->timer->stop();
+    if (s->queue.isEmpty()) {
+        s->busy = false;
+        return;
+    }
+
+    PendingRequest pending = s->queue.dequeue();
+    UdsResponse result = response;
+    result.service = quint8(pending.payload[0]);
+    pending.promise->addResult(result);
+    pending.promise->finish();
+
+    s->busy = false;
+    sendNext(s);
+}
+
+void UdsClient::onMessage(Session *s, const QByteArray &payload)
+{
+    if (!s->busy || s->queue.isEmpty() || payload.isEmpty()) return;
+
+    const quint8 service = quint8(s->queue.head().payload[0]);
+    const quint8 first = quint8(payload[0]);
+
+    if (first == kNegativeResponse && payload.size() >= 3 && quint8(payload[1]) == service) {
+        const quint8 nrc = quint8(payload[2]);
+        if (nrc == kResponsePending) {
+            s->timer->start(m_p2StarMs);
+            return;
+        }
+
+        UdsResponse refused;
+        refused.negativeCode = nrc;
+        refused.error = QStringLiteral("negative response 0x%1").arg(nrc, 2, 16, QChar('0'));
+        finish(s, refused);
+        return;
+    }
+
+    if (first == quint8(service + kPositiveOffset)) {
+        UdsResponse positive;
+        positive.ok = true;
+        positive.data = payload.mid(1);
+        finish(s, positive);
+    }
+    // Anything else is unsolicited and ignored
+}
+
+QFuture<UdsResponse> UdsClient::diagnosticSessionControl(const UdsEcu &ecu, quint8 sessionType)
+{
+    QByteArray payload;
+    payload.append(char(kDiagnosticSessionControl));
+    payload.append(char(sessionType));
+    return request(ecu, payload);
+}
+
+QFuture<UdsResponse> UdsClient::testerPresent(const UdsEcu &ecu)
+{
+    QByteArray payload;
+    payload.append(char(kTesterPresent));
+    payload.append(char(0x00));
+    return request(ecu, payload);
+}
+
+QFuture<UdsResponse> UdsClient::readDataByIdentifier(const UdsEcu &ecu, quint16 did)
+{
+    QByteArray payload;
+    payload.append(char(kReadDataByIdentifier));
+    payload.append(char(did >> 8));
+    payload.append(char(did & 0xFF));
+    return request(ecu, payload);
+}
+
+QFuture<UdsResponse> UdsClient::readDtcByStatusMask(const UdsEcu &ecu, quint8 statusMask)
+{
+    QByteArray payload;
+    payload.append(char(kReadDtcInformation));
+    payload.append(char(kReportDtcByStatusMask));
+    payload.append(char(statusMask));
+    return request(ecu, payload);
+}
+
+QList<UdsDtc> UdsClient::parseDtcs(const UdsResponse &response)
+{
+    // [subfunction][availability mask] then 4 bytes per DTC: 3 code + 1 status
+    QList<UdsDtc> dtcs;
+    if (!response.ok || response.data.size() < 2) return dtcs;
+
+    const uchar *data = reinterpret_cast<const uchar *>(response.data.constData());
+    for (int i = 2; i + 4 <= response.data.size(); i += 4) {
+        UdsDtc dtc;
+        dtc.code = (quint32(data[i]) << 16) | (quint32(data[i + 1]) << 8) | data[i + 2];
+        dtc.status = data[i + 3];
+        dtcs.append(dtc);
+    }
+    return dtcs;
+}
@@ -0,0 +1,87 @@
+#ifndef UDSCLIENT_H
+#define UDSCLIENT_H
+
+#include <QObject>
+#include <QFuture>
+#include <QPromise>
+#include <QHash>
+#include <QQueue>
+#include <QTimer>
+#include <memory>
+#include "isotp.h"
+
+// A diagnostic ECU: physical request and response CAN IDs
+struct UdsEcu {
+    QString name;
+    quint32 requestId = 0;
+    quint32 responseId = 0;
+    bool extendedIds = false;
+};
+
+struct UdsResponse {
+    bool ok = false;
+    quint8 service = 0;         // Request service ID
+    quint8 negativeCode = 0;    // NRC if the ECU refused, else 0
+    QByteArray data;            // Positive response without the service byte
+    QString error;
+};
+
+struct UdsDtc {
+    quint32 code = 0;           // 3-byte DTC
+    quint8 status = 0;
+
+    QString toString() const;   // e.g. "P0A80-00"
+};
+
+// UDS (ISO 14229) request/response client over ISO-TP.
+// Requests to one ECU are queued and sent one at a time, as the protocol
+// requires; different ECUs are served concurrently. All I/O is event-driven
+// on the caller's thread and results arrive through QFutures.
+class UdsClient : public QObject
+{
+    Q_OBJECT
+public:
+    // Common data identifiers
+    static const quint16 VinDid = 0xF190;
+
+    explicit UdsClient(IsoTpTransport *transport, QObject *parent = nullptr);
+    ~UdsClient();
+
+    // P2 = response deadline, P2* = deadline after "response pending" (NRC 0x78)
+    void setTimeouts(int p2Ms, int p2StarMs);
+
+    QFuture<UdsResponse> request(const UdsEcu &ecu, const QByteArray &request);
+
+    QFuture<UdsResponse> diagnosticSessionControl(const UdsEcu &ecu, quint8 sessionType);
+    QFuture<UdsResponse> testerPresent(const UdsEcu &ecu);
+    QFuture<UdsResponse> readDataByIdentifier(const UdsEcu &ecu, quint16 did);
+    QFuture<UdsResponse> readDtcByStatusMask(const UdsEcu &ecu, quint8 statusMask = 0xFF);
+
+    // Data of a readDtcByStatusMask response as DTC records
+    static QList<UdsDtc> parseDtcs(const UdsResponse &response);
+
+private:
+    struct PendingRequest {
+        QByteArray payload;
+        std::shared_ptr<QPromise<UdsResponse>> promise;
+    };
+
+    struct Session {
+        IsoTpChannel *channel = nullptr;
+        QQueue<PendingRequest> queue;
+        bool busy = false;
+        QTimer *timer = nullptr;
+    };
+
+    Session *session(const UdsEcu &ecu);
+    void sendNext(Session *session);
+    void finish(Session *session, const UdsResponse &response);
+    void onMessage(Session *session, const QByteArray &payload);
+
+    IsoTpTransport *m_transport;
+    QHash<quint64, Session *> m_sessions;
+    int m_p2Ms = 1000;
+    int m_p2StarMs = 5000;
+};
+
+#endif // UDSCLIENT_H
@@ -0,0 +1,105 @@
+#include "vehicleprofile.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+static VehicleProfile parseProfile(const QJsonObject &json)
+{
+    // Missing keys keep the built-in defaults
+    VehicleProfile profile;
+    profile.id = json.value("id").toString(profile.id);
+    profile.name = json.value("name").toString(profile.id);
+    profile.vehicleId = json.value("vehicle_id").toString();
+    profile.type = json.value("vehicle_type").toString() == "2W" ? VehicleProfile::Bike
+                                                                  : VehicleProfile::Car;
+    profile.batteryCapacityKwh = float(json.value("battery_capacity_kwh").toDouble(profile.batteryCapacityKwh));
+    profile.maxChargePowerKw = float(json.value("max_charge_power_kw").toDouble(profile.maxChargePowerKw));
+    profile.maxMotorPowerKw = float(json.value("max_motor_power_kw").toDouble(profile.maxMotorPowerKw));
+    profile.maxRegenPowerKw = float(json.value("max_regen_power_kw").toDouble(profile.maxRegenPowerKw));
+    profile.tireDiameterMm = json.value("tire_diameter_mm").toInt(profile.tireDiameterMm);
+    return profile;
+}
+
+VehicleProfiles::VehicleProfiles(QObject *parent)
+    : QObject(parent)
+{
+    m_active = std::make_shared<const VehicleProfile>();
+    m_profiles.append(m_active);
+}
+
+QString VehicleProfiles::defaultPath()
+{
+    return QCoreApplication::applicationDirPath() + "/config/vehicle.json";
+}
+
+bool VehicleProfiles::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Vehicle config not found:" << path << "- using built-in defaults";
+        return false;
+    }
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (!document.isObject()) {
+        qWarning() << "Vehicle config" << path << "is invalid:" << error.errorString();
+        return false;
+    }
+
+    const QJsonObject root = document.object();
+    QVector<std::shared_ptr<const VehicleProfile>> profiles;
+    if (root.contains("profiles")) {
+        const QJsonArray array = root.value("profiles").toArray();
+        for (const QJsonValue &value : array) {
+            profiles.append(std::make_shared<const VehicleProfile>(parseProfile(value.toObject())));
+        }
+    } else {
+        // Single-vehicle file
+        profiles.append(std::make_shared<const VehicleProfile>(parseProfile(root)));
+    }
+
+    if (profiles.isEmpty()) {
+        qWarning() << "Vehicle config" << path << "has no profiles";
+        return false;
+    }
+
+    m_profiles = profiles;
+    m_active = m_profiles.first();
+    const QString activeId = root.value("active_profile").toString();
+    for (const auto &profile : m_profiles) {
+        if (profile->id == activeId) m_active = profile;
+    }
+    emit profilesLoaded();
+    emit profileChanged();
+
+    qDebug() << "Vehicle profiles loaded:" << profileIds() << "active:" << m_active->id;
+    return true;
+}
+
+QStringList VehicleProfiles::profileIds() const
+{
+    QStringList ids;
+    for (const auto &profile : m_profiles) {
+        ids.append(profile->id);
+    }
+    return ids;
+}
+
+bool VehicleProfiles::setActiveProfile(const QString &id)
+{
+    for (const auto &profile : m_profiles) {
+        if (profile->id != id) continue;
+        if (profile != m_active) {
+            m_active = profile;
+            emit profileChanged();
+        }
+        return true;
+    }
+
+    qWarning() << "Unknown vehicle profile:" << id;
+    return false;
+}
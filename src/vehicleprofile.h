@@ -0,0 +1,78 @@
+#ifndef VEHICLEPROFILE_H
+#define VEHICLEPROFILE_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+// One vehicle variant from config/vehicle.json, parsed once at startup.
+// Components copy the numbers they need when the profile changes, so hot
+// paths only ever read plain fields - never strings or JSON.
+struct VehicleProfile {
+    enum Type {
+        Car,
+        Bike
+    };
+
+    QString id = QStringLiteral("default");
+    QString name = QStringLiteral("Default");
+    QString vehicleId;
+    Type type = Car;
+    float batteryCapacityKwh = 77.4f;
+    float maxChargePowerKw = 250.0f;
+    float maxMotorPowerKw = 150.0f;
+    float maxRegenPowerKw = 50.0f;
+    int tireDiameterMm = 680;
+};
+
+// The loaded profiles and the active one. Exposed to QML as "VehicleProfile".
+// Profiles are immutable once loaded; switching just swaps the shared
+// pointer and emits profileChanged() for components to pick up the values.
+class VehicleProfiles : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QStringList profileIds READ profileIds NOTIFY profilesLoaded)
+    Q_PROPERTY(QString activeId READ activeId WRITE setActiveId NOTIFY profileChanged)
+    Q_PROPERTY(QString name READ name NOTIFY profileChanged)
+    Q_PROPERTY(bool isBike READ isBike NOTIFY profileChanged)
+    Q_PROPERTY(float batteryCapacityKwh READ batteryCapacityKwh NOTIFY profileChanged)
+    Q_PROPERTY(float maxChargePowerKw READ maxChargePowerKw NOTIFY profileChanged)
+    Q_PROPERTY(float maxMotorPowerKw READ maxMotorPowerKw NOTIFY profileChanged)
+    Q_PROPERTY(float maxRegenPowerKw READ maxRegenPowerKw NOTIFY profileChanged)
+
+public:
+    explicit VehicleProfiles(QObject *parent = nullptr);
+
+    // Replaces all profiles; keeps the built-in default if the file is unusable
+    bool load(const QString &path);
+    static QString defaultPath();   // <app dir>/config/vehicle.json
+
+    std::shared_ptr<const VehicleProfile> active() const { return m_active; }
+    const VehicleProfile &profile() const { return *m_active; }
+
+    QStringList profileIds() const;
+    QString activeId() const { return m_active->id; }
+    QString name() const { return m_active->name; }
+    bool isBike() const { return m_active->type == VehicleProfile::Bike; }
+    float batteryCapacityKwh() const { return m_active->batteryCapacityKwh; }
+    float maxChargePowerKw() const { return m_active->maxChargePowerKw; }
+    float maxMotorPowerKw() const { return m_active->maxMotorPowerKw; }
+    float maxRegenPowerKw() const { return m_active->maxRegenPowerKw; }
+
+    void setActiveId(const QString &id) { setActiveProfile(id); }
+
+public slots:
+    bool setActiveProfile(const QString &id);   // False if the id is unknown
+
+signals:
+    void profilesLoaded();
+    void profileChanged();
+
+private:
+    QVector<std::shared_ptr<const VehicleProfile>> m_profiles;
+    std::shared_ptr<const VehicleProfile> m_active;
+};
+
+#endif // VEHICLEPROFILE_H
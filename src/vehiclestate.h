@@ -0,0 +1,95 @@
+#ifndef VEHICLESTATE_H
+#define VEHICLESTATE_H
+
+#include <QtGlobal>
+#include <type_traits>
+
+// Plain-data copy of every shared vehicle signal.
+// Published through a SeqLock - in process for worker threads and in POSIX
+// shared memory by ev-datad - so it must stay trivially copyable: no Qt
+// containers, fixed-size strings only. Bump VehicleStateVersion whenever the
+// layout changes so readers built against another layout refuse to map it.
+// Per-display UI state (night mode, full-screen map) is not part of it.
+static const quint32 VehicleStateVersion = 3;
+static const int VehicleStateSignalCount = 36;     // VehicleSignal::Count, checked in signalsample.cpp
+
+struct VehicleState {
+    // Navigation/GPS (8-byte fields first to keep the layout free of holes)
+    double gpsLatitude = 28.6139;
+    double gpsLongitude = 77.2090;
+
+    // Input status from the arbiter
+    quint64 staleMask = 0;          // Bit per VehicleSignal
+    // Source time (ms since epoch) of the sample each signal last took its
+    // value from, by VehicleSignal; 0 = none yet. Lets a reader tell fresh
+    // samples from values that were merely published again.
+    qint64 sourceTimeMs[VehicleStateSignalCount] = {};
+    quint32 activeSources = 0;      // Bit per InputSource
+    quint32 timeoutCount = 0;
+
+    // Motion
+    float speed = 0.0f;
+    float odometer = 0.0f;          // Metres
+    float tripDistanceA = 0.0f;
+    float tripDistanceB = 0.0f;
+
+    // Battery
+    float batterySoc = 0.0f;
+    float batteryVoltage = 0.0f;
+    float batteryCurrent = 0.0f;
+    float batteryTempAvg = 0.0f;
+    float batterySoh = 100.0f;
+
+    // Power & Energy
+    float powerOutput = 0.0f;
+    float instantConsumption = 0.0f;
+    float estimatedRange = 0.0f;
+    qint32 timeToEmpty = 0;
+    qint32 timeToFull = 0;
+    float averageConsumption = 0.0f;
+    float motorTemp = 0.0f;
+    float controllerTemp = 0.0f;
+    float motorRpm = 0.0f;
+
+    // Drive Mode (EVVehicleData::DriveMode / RegenLevel)
+    qint32 driveMode = 1;
+    qint32 regenLevel = 1;
+
+    float distToDestination = 0.0f;
+    float heading = 0.0f;
+
+    // Derived by the analytics pipeline
+    float tripEnergy = 0.0f;        // kWh, net of regen
+    float tripEfficiency = 0.0f;    // Wh/km
+
+    // Status, warnings and indicators (0/1)
+    quint8 chargingActive = 0;
+    quint8 readyToDrive = 0;
+    quint8 bmsWarning = 0;
+    quint8 hvWarning = 0;
+    quint8 tempWarning = 0;
+    quint8 motorFault = 0;
+    quint8 reducedPower = 0;
+    quint8 leftTurnSignal = 0;
+    quint8 rightTurnSignal = 0;
+    quint8 highBeam = 0;
+    quint8 regeneratonActive = 0;
+    quint8 tractionControl = 0;
+    quint8 absWarning = 0;
+    quint8 parkingBrake = 0;
+    quint8 seatbeltWarning = 0;
+    quint8 doorAjar = 0;
+    quint8 low12V = 0;
+    quint8 navigationActive = 0;
+    quint8 reserved[6] = {};
+
+    // Navigation text, NUL-terminated
+    char nextTurnIcon[32] = {};
+    char nextTurnDistance[32] = {};
+    char destinationEta[32] = {};
+};
+
+static_assert(std::is_trivially_copyable<VehicleState>::value, "VehicleState must be plain data");
+static_assert(sizeof(VehicleState) % 8 == 0, "VehicleState must not end in padding");
+
+#endif // VEHICLESTATE_H
@@ -0,0 +1,97 @@
+// Migration check on a baseline (version 1) database: trips written the way
+// the baseline wrote them - local QDateTimes bound as ISO text - must come out
+// of the v2 conversion as the right UTC epoch milliseconds, in summer and in
+// winter time. Runs with TZ=Europe/Berlin; skipped if that zone is missing.
+//
+//   ev-migration-test
+
+#include "schemamigrator.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QTemporaryDir>
+#include <ctime>
+
+namespace {
+
+const int kSkipped = 77;     // ctest SKIP_RETURN_CODE
+
+int s_failures = 0;
+
+void check(bool condition, const char *what)
+{
+    if (condition) return;
+    s_failures++;
+    qWarning() << "[migration-test] FAILED:" << what;
+}
+
+struct LegacyTrip {
+    QDateTime start;        // Local wall-clock time, as the baseline bound it
+    QDateTime end;
+    qint64 expectedStartMs;
+    qint64 expectedEndMs;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    qputenv("TZ", "Europe/Berlin");
+    tzset();
+    QCoreApplication app(argc, argv);
+
+    // CEST is UTC+2, CET UTC+1
+    const QList<LegacyTrip> trips = {
+        { QDateTime(QDate(2023, 7, 1), QTime(12, 0)), QDateTime(QDate(2023, 7, 1), QTime(12, 30)),
+          1688205600000LL, 1688207400000LL },
+        { QDateTime(QDate(2023, 1, 15), QTime(8, 30)), QDateTime(QDate(2023, 1, 15), QTime(9, 30)),
+          1673767800000LL, 1673771400000LL },
+    };
+    if (trips.first().start.offsetFromUtc() != 7200 || trips.last().start.offsetFromUtc() != 3600) {
+        qWarning() << "[migration-test] Europe/Berlin time zone not available, skipping";
+        return kSkipped;
+    }
+
+    QTemporaryDir directory;
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "migration-test");
+    db.setDatabaseName(directory.filePath("legacy.db"));
+    check(directory.isValid() && db.open(), "scratch database opens");
+
+    {
+        // Baseline schema only, then rows as the baseline saveTrip wrote them
+        SchemaMigrator migrator(db);
+        check(migrator.applyNext() && migrator.currentVersion() == 1, "baseline schema");
+
+        QSqlQuery insert(db);
+        insert.prepare("INSERT INTO trips (start_time, end_time, distance_km, energy_kwh, avg_efficiency, "
+                       "start_soc, end_soc) VALUES (:start, :end, 25.0, 4.0, 160.0, 80.0, 74.0)");
+        for (const LegacyTrip &trip : trips) {
+            insert.bindValue(":start", trip.start);
+            insert.bindValue(":end", trip.end);
+            if (!insert.exec()) qWarning() << "[migration-test]" << insert.lastError().text();
+        }
+
+        check(migrator.migrate() && migrator.isUpToDate(), "migrates to the latest version");
+    }
+
+    QSqlQuery select(db);
+    check(select.exec("SELECT start_time, end_time, avg_speed_kmh FROM trips ORDER BY id"), "trips readable");
+    for (const LegacyTrip &trip : trips) {
+        check(select.next(), "legacy trip kept");
+        const qint64 startMs = select.value(0).toLongLong();
+        const qint64 endMs = select.value(1).toLongLong();
+        if (startMs != trip.expectedStartMs || endMs != trip.expectedEndMs) {
+            qWarning() << "[migration-test]" << trip.start.toString(Qt::ISODate) << "became" << startMs
+                       << "-" << endMs << "expected" << trip.expectedStartMs << "-" << trip.expectedEndMs;
+        }
+        check(startMs == trip.expectedStartMs && endMs == trip.expectedEndMs, "local time converted to UTC epoch ms");
+        const double hours = (trip.expectedEndMs - trip.expectedStartMs) / 3600000.0;
+        check(qAbs(select.value(2).toDouble() - 25.0 / hours) < 0.01, "average speed");
+    }
+
+    qDebug().noquote() << QStringLiteral("[migration-test] %1 legacy trips checked, %2 failures")
+        .arg(trips.size()).arg(s_failures);
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,144 @@
+// ThreadSanitizer stress test for the published VehicleState.
+// One writer hammers SeqLock<VehicleState> - bare, then through EVVehicleData's
+// setters - while several reader threads copy it out and check that no copy
+// mixes two writes. Built only with -DEV_TSAN_STRESS=ON; TSan reports any
+// data race, the checks below report torn or out-of-order snapshots.
+//
+//   ev-seqlock-stress [seconds per phase] [reader threads]
+
+#include "evvehicledata.h"
+#include "seqlock.h"
+#include "vehiclestate.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct ReaderStats {
+    quint64 reads = 0;
+    quint64 failures = 0;
+};
+
+// Readers run until stop is set; check(state, previous) returns false on a bad copy
+template <typename Load, typename Check>
+std::vector<ReaderStats> runReaders(int count, std::atomic<bool> &stop, Load load, Check check,
+                                    std::vector<std::thread> *threads)
+{
+    std::vector<ReaderStats> stats(count);
+    for (int i = 0; i < count; ++i) {
+        threads->emplace_back([&stop, &stats, i, load, check] {
+            ReaderStats &mine = stats[i];
+            VehicleState previous;
+            load(&previous);
+            while (!stop.load(std::memory_order_relaxed)) {
+                VehicleState state;
+                load(&state);
+                mine.reads++;
+                if (!check(state, previous)) {
+                    if (mine.failures++ < 5) {
+                        qWarning() << "[stress] bad snapshot: speed" << state.speed << "odometer" << state.odometer
+                                   << "after speed" << previous.speed << "odometer" << previous.odometer;
+                    }
+                }
+                previous = state;
+            }
+        });
+    }
+    return stats;
+}
+
+bool report(const char *phase, quint64 writes, const std::vector<ReaderStats> &stats, qint64 ms)
+{
+    quint64 reads = 0;
+    quint64 failures = 0;
+    for (const ReaderStats &reader : stats) {
+        reads += reader.reads;
+        failures += reader.failures;
+    }
+    qDebug().noquote() << QStringLiteral("[stress] %1: %2 writes, %3 reads by %4 readers in %5 ms, %6 bad")
+        .arg(QLatin1String(phase)).arg(writes).arg(reads).arg(stats.size()).arg(ms).arg(failures);
+    return failures == 0 && reads > 0;
+}
+
+// Every field the writer sets carries the same counter, so a torn copy shows
+// up as a mismatch; the counter never goes back for one reader
+bool bareStressOk(int seconds, int readers)
+{
+    SeqLock<VehicleState> lock;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+
+    auto load = [&lock](VehicleState *state) { lock.load(state); };
+    auto check = [](const VehicleState &state, const VehicleState &previous) {
+        const float n = state.speed;
+        return state.odometer == n && state.batterySoc == n && state.powerOutput == -n
+            && state.gpsLatitude == double(n) && state.staleMask == quint64(n)
+            && n >= previous.speed;
+    };
+    std::vector<ReaderStats> stats = runReaders(readers, stop, load, check, &threads);
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 writes = 0;
+    VehicleState state;
+    while (timer.elapsed() < seconds * 1000 && writes < (1u << 24)) {     // Exact in a float
+        const float n = float(++writes);
+        state.speed = n;
+        state.odometer = n;
+        state.batterySoc = n;
+        state.powerOutput = -n;
+        state.gpsLatitude = n;
+        state.staleMask = quint64(n);
+        lock.store(state);
+    }
+    stop = true;
+    for (std::thread &thread : threads) thread.join();
+    return report("SeqLock<VehicleState>", writes, stats, timer.elapsed());
+}
+
+// The GUI-thread path: each setter republishes, so a snapshot may sit between
+// setOdometer(n) and setSpeed(n), but never further apart or backwards
+bool vehicleDataStressOk(int seconds, int readers)
+{
+    EVVehicleData vehicleData;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+
+    auto load = [&vehicleData](VehicleState *state) { *state = vehicleData.snapshot(); };
+    auto check = [](const VehicleState &state, const VehicleState &previous) {
+        return (state.speed == state.odometer || state.speed == state.odometer - 1.0f)
+            && state.odometer >= previous.odometer;
+    };
+    std::vector<ReaderStats> stats = runReaders(readers, stop, load, check, &threads);
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 writes = 0;
+    while (timer.elapsed() < seconds * 1000 && writes < (1u << 24)) {
+        const float n = float(++writes);
+        vehicleData.setOdometer(n);
+        vehicleData.setSpeed(n);
+    }
+    stop = true;
+    for (std::thread &thread : threads) thread.join();
+    return report("EVVehicleData::snapshot()", writes, stats, timer.elapsed());
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const int seconds = args.size() > 1 ? qMax(1, args.at(1).toInt()) : 2;
+    const int readers = args.size() > 2 ? qMax(1, args.at(2).toInt())
+                                        : qBound(2, int(std::thread::hardware_concurrency()) - 1, 8);
+
+    const bool bare = bareStressOk(seconds, readers);
+    const bool vehicleData = vehicleDataStressOk(seconds, readers);
+    return bare && vehicleData ? 0 : 1;
+}
@@ -0,0 +1,108 @@
+// ev-datad -> display round trip over a private shared memory name: samples
+// submitted to the publisher's InputArbiter must show up in the reader's
+// EVVehicleData with their source and staleness flags, a second writer must
+// be refused while the first is alive, and the reader must drop out when the
+// writer goes away and come back when it is restarted.
+//
+//   ev-sharedstate-test
+
+#include "evvehicledata.h"
+#include "inputarbiter.h"
+#include "sharedstatereader.h"
+#include "statepublisher.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <functional>
+#include <memory>
+
+namespace {
+
+int s_failures = 0;
+
+void check(bool condition, const char *what)
+{
+    if (condition) return;
+    s_failures++;
+    qWarning() << "[sharedstate-test] FAILED:" << what;
+}
+
+// Runs the event loop until done() holds or timeoutMs passes
+bool waitUntil(const std::function<bool()> &done, int timeoutMs)
+{
+    QElapsedTimer clock;
+    clock.start();
+    while (!done()) {
+        if (clock.elapsed() > timeoutMs) return false;
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(5);
+    }
+    return true;
+}
+
+SignalSample sample(VehicleSignal signal, const QVariant &value)
+{
+    SignalSample s;
+    s.signal = signal;
+    s.source = InputSource::Simulation;
+    s.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    s.value = value;
+    return s;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QString name = QStringLiteral("/ev-test-%1").arg(QCoreApplication::applicationPid());
+
+    // ev-datad side
+    EVVehicleData source;
+    InputArbiter arbiter(&source);
+    auto publisher = std::make_unique<StatePublisher>(&source, &arbiter);
+    check(publisher->open(name), "publisher creates the segment");
+
+    StatePublisher second(&source, &arbiter);
+    check(!second.open(name), "second writer refused while the first is alive");
+
+    // Display side
+    EVVehicleData display;
+    SharedStateReader reader(&display);
+    reader.open(name);
+    check(waitUntil([&] { return reader.connected(); }, 500), "reader attaches");
+
+    arbiter.submitBatch({ sample(VehicleSignal::Speed, 87.5), sample(VehicleSignal::BatterySoc, 64.0),
+                          sample(VehicleSignal::ReadyToDrive, true) });
+    check(waitUntil([&] { return display.speed() == 87.5f; }, 500), "speed reaches the display");
+    check(display.batterySoc() == 64.0f && display.readyToDrive(), "SoC and ready flag reach the display");
+    check(waitUntil([&] { return reader.simulationActive(); }, 1000) && !reader.canActive(),
+          "active source published");
+    check(!reader.speedStale(), "fresh speed not stale");
+
+    // Only the SoC keeps coming; the speed deadline (500 ms) passes
+    check(waitUntil([&] {
+        arbiter.submit(sample(VehicleSignal::BatterySoc, 63.0));
+        return reader.speedStale();
+    }, 2000), "silent speed flagged stale on the display");
+    check(!reader.isSignalStale(int(VehicleSignal::BatterySoc)), "updated SoC not stale");
+
+    // Writer exits: no heartbeat, every signal stale
+    publisher.reset();
+    check(waitUntil([&] { return !reader.connected(); }, 2000), "reader notices the writer is gone");
+    check(reader.staleCount() == VehicleSignals::count(), "all signals stale without a writer");
+
+    // Restarted writer: a new segment under the same name
+    arbiter.submit(sample(VehicleSignal::Speed, 42.0));
+    publisher = std::make_unique<StatePublisher>(&source, &arbiter);
+    check(publisher->open(name), "restarted publisher takes the name over");
+    check(waitUntil([&] { return reader.connected() && display.speed() == 42.0f; }, 3000),
+          "reader re-attaches to the restarted writer");
+
+    qDebug().noquote() << QStringLiteral("[sharedstate-test] round trip over %1, %2 failures")
+        .arg(name).arg(s_failures);
+    return s_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,193 @@
+// Scripted drives through TripDetector on a fake clock: checks where trips
+// start and end, that traffic-light stops do not split them, that positions
+// without a fix stay out of the extent, and that the TripRecord read back
+// from a scratch database matches the one the detector finished.
+//
+//   ev-tripdetector-test
+
+#include "databaseservice.h"
+#include "evvehicledata.h"
+#include "tripdetector.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEventLoop>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QTimer>
+
+namespace {
+
+int s_failures = 0;
+
+void check(bool condition, const char *what)
+{
+    if (condition) return;
+    s_failures++;
+    qWarning() << "[trip-test] FAILED:" << what;
+}
+
+bool near(double actual, double expected, double tolerance)
+{
+    return qAbs(actual - expected) <= tolerance;
+}
+
+// Feeds EVVehicleData and steps the detector in 200 ms ticks of scripted time
+class Drive
+{
+public:
+    Drive(EVVehicleData *vehicle, TripDetector *detector)
+        : m_vehicle(vehicle), m_detector(detector)
+    {
+        m_detector->setClock([this] { return m_nowMs; });
+    }
+
+    // speed in km/h, power in kW; the odometer and position follow the speed
+    void run(double seconds, float speed, float powerKw, bool gpsFix = true)
+    {
+        for (int tick = 0; tick < qRound(seconds * 5.0); ++tick) {
+            m_nowMs += 200;
+            m_vehicle->setOdometer(m_vehicle->odometer() + speed / 3.6f * 0.2f);
+            if (speed > 0.0f) {
+                m_latitude += 0.0001;
+                m_vehicle->setBatterySoc(m_vehicle->batterySoc() - 0.005f);
+            }
+            m_vehicle->setGpsLatitude(gpsFix ? m_latitude : 0.0);
+            m_vehicle->setGpsLongitude(gpsFix ? m_longitude : 0.0);
+            m_vehicle->setPowerOutput(powerKw);
+            m_vehicle->setSpeed(speed);
+            m_detector->sample();
+        }
+    }
+
+    double latitude() const { return m_latitude; }
+    double longitude() const { return m_longitude; }
+
+private:
+    EVVehicleData *m_vehicle;
+    TripDetector *m_detector;
+    qint64 m_nowMs = 0;
+    double m_latitude = 52.0;
+    double m_longitude = 13.0;
+};
+
+template <typename T>
+T await(QFuture<T> future)
+{
+    future.waitForFinished();
+    return future.result();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir directory;
+    DatabaseService database;
+    check(directory.isValid() && await(database.init(directory.filePath("trips.db"))), "scratch database opens");
+
+    EVVehicleData vehicle;
+    vehicle.setOdometer(10000.0f);
+    vehicle.setBatterySoc(80.0f);
+
+    TripDetector detector(&vehicle, &database);
+    detector.setIdleTimeout(60);
+    detector.setParkTimeout(10);
+    Drive drive(&vehicle, &detector);
+    detector.start();
+
+    QList<TripRecord> finished;
+    QList<int> saved;
+    int started = 0;
+    QObject::connect(&detector, &TripDetector::tripStarted, [&] { started++; });
+    QObject::connect(&detector, &TripDetector::tripFinished, [&](const TripRecord &trip) { finished.append(trip); });
+    QObject::connect(&detector, &TripDetector::tripSaved, [&](int tripId) { saved.append(tripId); });
+
+    // Rolling but not ready to drive (towed, pushed): no trip
+    drive.run(2, 20.0f, 0.0f);
+    check(detector.state() == TripDetector::Parked && started == 0, "no trip while not ready to drive");
+
+    // 1: two minutes at 50 km/h around a 30 s traffic light, a stretch
+    // without a fix, a regen phase, then parked with the brake on
+    vehicle.setReadyToDrive(true);
+    drive.run(0.2, 50.0f, 20.0f);
+    const float startSoc = vehicle.batterySoc();
+    check(detector.state() == TripDetector::Driving && started == 1, "trip starts when ready and moving");
+    drive.run(40, 50.0f, 20.0f);
+    drive.run(5, 50.0f, 20.0f, false);
+    drive.run(15, 50.0f, 20.0f);
+    drive.run(30, 0.0f, 0.0f);
+    check(detector.state() == TripDetector::Stopped && finished.isEmpty(), "traffic light does not end the trip");
+    drive.run(48, 50.0f, 20.0f);
+    drive.run(12, 50.0f, -10.0f);
+    check(started == 1, "resuming continues the same trip");
+
+    vehicle.setParkingBrake(true);
+    drive.run(0.2, 0.0f, 0.0f);
+    const float stopSoc = vehicle.batterySoc();
+    const QDateTime stoppedAt = QDateTime::currentDateTime();
+    QThread::msleep(20);     // Apart from the park timeout in wall time too
+    drive.run(9.6, 0.0f, 1.0f);     // Climate control while parked is not part of the trip
+    check(finished.isEmpty(), "park timeout not reached yet");
+    drive.run(0.4, 0.0f, 1.0f);
+    check(finished.size() == 1 && detector.state() == TripDetector::Parked, "parked trip ends after the park timeout");
+
+    if (finished.size() == 1) {
+        const TripRecord &trip = finished.first();
+        check(near(trip.distanceKm, 120 * 50 / 3600.0, 0.01), "distance from the odometer");
+        check(near(trip.energyKwh, (20.0 * 108 - 10.0 * 12) / 3600.0, 0.002), "net energy stops at the stop");
+        check(near(trip.regenKwh, 10.0 * 12 / 3600.0, 0.001), "regen energy");
+        check(near(trip.startSoc, startSoc, 0.001) && near(trip.endSoc, stopSoc, 0.001), "SoC at start and stop");
+        check(trip.endTime <= stoppedAt && trip.startTime <= trip.endTime, "trip ends when the vehicle stopped");
+        check(trip.minLatitude >= 52.0 && trip.minLongitude == 13.0 && trip.maxLatitude <= drive.latitude(),
+              "extent ignores samples without a fix");
+        check(trip.route.size() >= 2 && trip.route.first().latitude >= 52.0, "route recorded");
+
+        QEventLoop loop;
+        QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+        QObject::connect(&detector, &TripDetector::tripSaved, &loop, &QEventLoop::quit);
+        if (saved.isEmpty()) loop.exec();
+        check(saved.size() == 1, "trip saved");
+
+        if (saved.size() == 1) {
+            const TripRecord stored = await(database.getTrip(saved.first()));
+            check(stored.id == saved.first(), "saved trip reads back");
+            check(near(stored.distanceKm, trip.distanceKm, 1e-4) && near(stored.energyKwh, trip.energyKwh, 1e-4)
+                  && near(stored.regenKwh, trip.regenKwh, 1e-4), "stored distance and energy");
+            check(near(stored.startSoc, trip.startSoc, 1e-3) && near(stored.endSoc, trip.endSoc, 1e-3), "stored SoC");
+            check(stored.startTime.toMSecsSinceEpoch() == trip.startTime.toMSecsSinceEpoch()
+                  && stored.endTime.toMSecsSinceEpoch() == trip.endTime.toMSecsSinceEpoch(), "stored start and end");
+            check(near(stored.minLatitude, trip.minLatitude, 1e-6) && near(stored.maxLatitude, trip.maxLatitude, 1e-6),
+                  "stored extent");
+            check(stored.route.size() == trip.route.size(), "stored route");
+            check(await(database.getLifetimeStats()).totalTrips == 1, "trip counted once");
+        }
+    }
+    vehicle.setParkingBrake(false);
+
+    // 2: a short manoeuvre is discarded
+    drive.run(5, 20.0f, 5.0f);
+    drive.run(61, 0.0f, 0.0f);
+    check(started == 2 && finished.size() == 1 && detector.state() == TripDetector::Parked,
+          "manoeuvre under 100 m is not a trip");
+
+    // 3: stopped but ready, brake off: the idle timeout applies, not the park one
+    drive.run(30, 50.0f, 20.0f);
+    drive.run(59, 0.0f, 0.0f);
+    check(finished.size() == 1 && detector.state() == TripDetector::Stopped, "idle timeout not reached yet");
+    drive.run(1.2, 0.0f, 0.0f);
+    check(finished.size() == 2, "idle trip ends after the idle timeout");
+
+    // 4: switching off mid-drive ends the trip at once
+    drive.run(30, 50.0f, 20.0f);
+    vehicle.setReadyToDrive(false);
+    check(finished.size() == 3 && detector.state() == TripDetector::Parked, "switching off ends the trip");
+    if (finished.size() == 3) {
+        check(near(finished.last().distanceKm, 30 * 50 / 3600.0, 0.01), "switched-off trip keeps its distance");
+    }
+
+    qDebug().noquote() << QStringLiteral("[trip-test] %1 trips finished, %2 failures")
+        .arg(finished.size()).arg(s_failures);
+    return s_failures == 0 ? 0 : 1;
+}
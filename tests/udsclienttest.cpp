@@ -0,0 +1,134 @@
+// ISO-TP/UDS exchange against tools/uds_ecu_stub.py on a virtual CAN bus:
+// single-frame and multi-frame responses, queued requests to one ECU, DTC
+// parsing and a negative response. Skipped when the interface, the kernel's
+// CAN_ISOTP sockets (needed by the stub) or python3 are missing.
+//
+//   ev-udsclient-test <uds_ecu_stub.py> [interface, default vcan0]
+
+#include "caninterface.h"
+#include "isotp.h"
+#include "udsclient.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QProcess>
+#include <QThread>
+
+namespace {
+
+const int kSkipped = 77;     // ctest SKIP_RETURN_CODE
+
+int s_failures = 0;
+
+void check(bool condition, const char *what)
+{
+    if (condition) return;
+    s_failures++;
+    qWarning() << "[uds-test] FAILED:" << what;
+}
+
+// The client runs on this thread, so spin the event loop instead of blocking
+UdsResponse await(const QFuture<UdsResponse> &future, int timeoutMs = 3000)
+{
+    QElapsedTimer clock;
+    clock.start();
+    while (!future.isFinished() && clock.elapsed() < timeoutMs) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        QThread::msleep(1);
+    }
+    if (!future.isFinished()) {
+        UdsResponse failed;
+        failed.error = QStringLiteral("test timeout");
+        return failed;
+    }
+    return future.result();
+}
+
+quint16 cellMillivolts(const QByteArray &data, int cell)
+{
+    // Response data starts with the echoed DID
+    return quint16((quint8(data[2 + cell * 2]) << 8) | quint8(data[3 + cell * 2]));
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() < 2) {
+        qWarning() << "usage: ev-udsclient-test <uds_ecu_stub.py> [interface]";
+        return 2;
+    }
+    const QString stub = args.at(1);
+    const QString interface = args.value(2, QStringLiteral("vcan0"));
+
+    if (!QFileInfo::exists(QStringLiteral("/sys/class/net/%1").arg(interface))) {
+        qWarning() << "[uds-test]" << interface << "not available, skipping";
+        return kSkipped;
+    }
+
+    QProcess ecu;
+    ecu.setProcessChannelMode(QProcess::MergedChannels);
+    ecu.start(QStringLiteral("python3"), { QStringLiteral("-u"), stub, interface });
+    if (!ecu.waitForStarted(3000)) {
+        qWarning() << "[uds-test] python3 not available, skipping";
+        return kSkipped;
+    }
+    // The stub prints once its ISO-TP socket is bound, or dies if the kernel lacks CAN_ISOTP
+    const QByteArray banner = ecu.waitForReadyRead(3000) ? ecu.readAll() : QByteArray();
+    if (!banner.contains("listening")) {
+        qWarning() << "[uds-test] UDS stub did not start, skipping:" << banner.trimmed();
+        ecu.kill();
+        ecu.waitForFinished();
+        return kSkipped;
+    }
+
+    CANInterface can;
+    if (!can.connectDevice(QStringLiteral("socketcan"), interface)) {
+        qWarning() << "[uds-test] cannot open" << interface << ", skipping";
+        ecu.kill();
+        ecu.waitForFinished();
+        return kSkipped;
+    }
+    IsoTpTransport isoTp(&can);
+    UdsClient uds(&isoTp);
+    const UdsEcu bms { "BMS", 0x7E4, 0x7EC };
+
+    const UdsResponse session = await(uds.diagnosticSessionControl(bms, 0x03));
+    check(session.ok && session.data.startsWith(char(0x03)), "extended session accepted (single frame)");
+
+    // Queued back to back: the client sends the second only after the first answer
+    const QFuture<UdsResponse> vinRequest = uds.readDataByIdentifier(bms, UdsClient::VinDid);
+    const QFuture<UdsResponse> cellRequest = uds.readDataByIdentifier(bms, 0x0100);
+    const UdsResponse vin = await(vinRequest);
+    check(vin.ok && vin.data.mid(2) == QByteArray("MAT12345EV0000042"), "VIN (multi-frame)");
+    const UdsResponse cells = await(cellRequest);
+    check(cells.ok && cells.data.size() == 2 + 96 * 2, "96 cell voltages (consecutive frames)");
+    if (cells.ok && cells.data.size() == 2 + 96 * 2) {
+        check(cellMillivolts(cells.data, 0) == 3700 && cellMillivolts(cells.data, 1) == 3707
+              && cellMillivolts(cells.data, 95) == 3700 + (95 * 7) % 40, "cell voltage payload intact");
+    }
+
+    const UdsResponse dtcResponse = await(uds.readDtcByStatusMask(bms));
+    const QList<UdsDtc> dtcs = UdsClient::parseDtcs(dtcResponse);
+    check(dtcResponse.ok && dtcs.size() == 2, "two DTCs reported");
+    if (dtcs.size() == 2) {
+        check(dtcs.at(0).toString() == QLatin1String("P0A80-00") && dtcs.at(0).status == 0x09, "first DTC");
+        check(dtcs.at(1).toString() == QLatin1String("P0AFA-00") && dtcs.at(1).status == 0x08, "second DTC");
+    }
+    check(UdsClient::parseDtcs(await(uds.readDtcByStatusMask(bms, 0x01))).size() == 1, "status mask applied");
+
+    const UdsResponse refused = await(uds.request(bms, QByteArray::fromHex("3101ff00")));
+    check(!refused.ok && refused.negativeCode == 0x11, "unsupported service refused with NRC 0x11");
+    check(await(uds.testerPresent(bms)).ok, "client usable after a negative response");
+
+    ecu.kill();
+    ecu.waitForFinished();
+
+    qDebug().noquote() << QStringLiteral("[uds-test] exchange with the stub on %1, %2 failures")
+        .arg(interface).arg(s_failures);
+    return s_failures == 0 ? 0 : 1;
+}
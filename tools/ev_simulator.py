@@ -1,4 +1,6 @@
+import argparse
 import socket
+import sys
 import json
 import time
 import math
@@ -531,25 +533,48 @@ class PhysicsEngine:
         return min(speed_kmh * self.rpm_factor, self.max_rpm)
 
 
+def load_vehicle_profile(config_path, profile_id=None):
+    """Profile from config/vehicle.json as VehicleProfiles reads it: a "profiles"
+    list with "active_profile", or one flat profile. None if unreadable."""
+    try:
+        with open(config_path, 'r') as f:
+            config = json.load(f)
+    except (OSError, ValueError) as e:
+        print(f"Warning: {config_path}: {e}")
+        return None
+
+    profiles = config.get('profiles', [config])
+    if not profiles:
+        return None
+    wanted = profile_id or config.get('active_profile')
+    for profile in profiles:
+        if profile.get('id') == wanted:
+            return profile
+    if profile_id:
+        print(f"Warning: no profile '{profile_id}', using '{profiles[0].get('id', 'default')}'")
+    return profiles[0]
+
+
 class EVSimulator:
     """Enhanced EV Simulator with ultra-smooth realistic behavior"""
     
-    def __init__(self, config_path='../config/vehicle.json'):
-        # Load vehicle configuration
-        try:
-            with open(config_path, 'r') as f:
-                config = json.load(f)
-                self.battery_capacity = config['battery_capacity_kwh']
-                self.max_charge_power = config.get('max_charge_power_kw', 150)
-                self.max_regen_power = config.get('max_regen_power_kw', 100)
-        except:
+    def __init__(self, config_path='../config/vehicle.json', profile_id=None):
+        # Load vehicle configuration: the same profile the cluster picks
+        # (active_profile, or --profile), so SoC and range agree with it
+        profile = load_vehicle_profile(config_path, profile_id)
+        if profile is None:
             print("Warning: Could not load vehicle.json, using defaults")
-            self.battery_capacity = 65.0
-            self.max_charge_power = 150
-            self.max_regen_power = 100
+            profile = {}
+        self.profile_id = profile.get('id', 'default')
+        self.battery_capacity = profile.get('battery_capacity_kwh', 65.0)
+        self.max_charge_power = profile.get('max_charge_power_kw', 150)
+        self.max_regen_power = profile.get('max_regen_power_kw', 100)
         
         # Determine vehicle type
-        self.vehicle_type = VehicleType.FOUR_WHEELER if self.battery_capacity > 10 else VehicleType.TWO_WHEELER
+        if 'vehicle_type' in profile:
+            self.vehicle_type = VehicleType.TWO_WHEELER if profile['vehicle_type'] == '2W' else VehicleType.FOUR_WHEELER
+        else:
+            self.vehicle_type = VehicleType.FOUR_WHEELER if self.battery_capacity > 10 else VehicleType.TWO_WHEELER
         
         # Initialize physics engine
         self.physics = PhysicsEngine(self.vehicle_type, self.battery_capacity)
@@ -899,7 +924,6 @@ class EVSimulator:
             'lat': round(self.lat, 6),
             'lon': round(self.lon, 6),
             'heading': round(self.heading, 1),
-            'next_turn_dist': "500m",
             # Auto-computed warning flags from physical state
             'bms_warning': self.battery_temp > 45 or self.soc < 5 or self.soh < 75,
             'hv_warning': self.hv_fault,
@@ -954,6 +978,7 @@ class SimulatorController:
         
         # Send data
         data = self.simulator.get_data()
+        data["ts"] = int(time.time() * 1000)  # Send time, lets the cluster de-jitter
         json_data = json.dumps(data).encode()
         try:
             self.sock.sendto(json_data, self.dest_addr)
@@ -971,6 +996,27 @@ class SimulatorController:
             return f"{self.current_scenario_name} - {int(elapsed)}s"
 
 
+def build_scenarios():
+    """All scenarios by display name; None marks a menu separator"""
+    return {
+        "City Commute": CityCommuteScenario(),
+        "Highway Cruise": HighwayCruiseScenario(),
+        "Eco Mode": EcoModeScenario(),
+        "Spirited Drive": SpiritedDriveScenario(),
+        "Mixed Urban/Highway": MixedUrbanHighwayScenario(),
+        "AC Charge (Level 1)": ChargingScenario(1.4),
+        "AC Charge (Level 2)": ChargingScenario(7.2),
+        "DC Fast Charge": ChargingScenario(150.0),
+        "─── Edge Cases ───": None,
+        "Aggressive Driver": AggressiveDriverScenario(),
+        "Battery Overheat": BatteryOverheatScenario(),
+        "Motor Overheat": MotorOverheatScenario(),
+        "Degraded Battery": DegradedBatteryScenario(),
+        "Critical Low Battery": CriticalLowBatteryScenario(),
+        "HV System Fault": HVSystemFaultScenario(),
+    }
+
+
 class SimulatorGUI:
     """Tkinter GUI for scenario control"""
     
@@ -981,23 +1027,7 @@ class SimulatorGUI:
         self.root.geometry("550x450")
         
         # Scenario definitions
-        self.scenarios = {
-            "City Commute": CityCommuteScenario(),
-            "Highway Cruise": HighwayCruiseScenario(),
-            "Eco Mode": EcoModeScenario(),
-            "Spirited Drive": SpiritedDriveScenario(),
-            "Mixed Urban/Highway": MixedUrbanHighwayScenario(),
-            "AC Charge (Level 1)": ChargingScenario(1.4),
-            "AC Charge (Level 2)": ChargingScenario(7.2),
-            "DC Fast Charge": ChargingScenario(150.0),
-            "─── Edge Cases ───": None,
-            "Aggressive Driver": AggressiveDriverScenario(),
-            "Battery Overheat": BatteryOverheatScenario(),
-            "Motor Overheat": MotorOverheatScenario(),
-            "Degraded Battery": DegradedBatteryScenario(),
-            "Critical Low Battery": CriticalLowBatteryScenario(),
-            "HV System Fault": HVSystemFaultScenario(),
-        }
+        self.scenarios = build_scenarios()
         
         self._create_widgets()
         
@@ -1181,23 +1211,82 @@ def simulation_loop(controller):
         time.sleep(0.2)
 
 
+def run_headless(controller, names, park_seconds, dt=0.2):
+    """Play scenarios back to back without the GUI, in real time.
+
+    After each one the vehicle rolls to a stop and is switched off
+    (ready = False) for park_seconds, so the cluster's trip detector
+    closes one trip per scenario.
+    """
+    scenarios = build_scenarios()
+    sim = controller.simulator
+
+    def step():
+        controller.update_and_send(dt)
+        time.sleep(dt)
+
+    for name in names:
+        scenario = scenarios.get(name)
+        if scenario is None:
+            print(f"Unknown scenario: {name}")
+            sys.exit(1)
+
+        print(f"Replaying {name} ({scenario.duration}s)...")
+        sim.ready = True
+        controller.start_scenario(scenario)
+        while not scenario.is_complete():
+            step()
+
+        controller.stop()
+        sim.charging = False
+        while sim.speed > 0:
+            step()
+
+        print(f"  {sim.trip_distance:.2f} km so far, parked for {park_seconds}s")
+        sim.ready = False
+        for _ in range(int(park_seconds / dt)):
+            step()
+    sim.ready = True
+
+
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="EV drive simulator, sends vehicle data to the cluster over UDP")
+    parser.add_argument("--scenario", action="append", metavar="NAME",
+                        help="Replay this scenario without the GUI (repeatable, played in order)")
+    parser.add_argument("--park", type=float, default=150.0, metavar="SECONDS",
+                        help="Time switched off after each replayed scenario (default 150)")
+    parser.add_argument("--list-scenarios", action="store_true", help="Print the scenario names and exit")
+    parser.add_argument("--profile", metavar="ID",
+                        help="Vehicle profile from config/vehicle.json (default: its active_profile)")
+    args = parser.parse_args()
+
+    if args.list_scenarios:
+        for name, scenario in build_scenarios().items():
+            if scenario is not None:
+                print(f"{name} ({scenario.duration}s) - {scenario.description}")
+        sys.exit(0)
+
     print("=" * 65)
     print("EV Drive Simulator - Ultra-Smooth Realistic Behavior")
     print("=" * 65)
     
     # Initialize components
-    simulator = EVSimulator()
+    simulator = EVSimulator(profile_id=args.profile)
     sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
     dest_addr = ('localhost', 5555)
     controller = SimulatorController(simulator, sock, dest_addr)
     
-    print(f"\nVehicle Type: {simulator.vehicle_type.value}")
+    print(f"\nVehicle Profile: {simulator.profile_id}")
+    print(f"Vehicle Type: {simulator.vehicle_type.value}")
     print(f"Battery Capacity: {simulator.battery_capacity} kWh")
     print(f"Max Power: {simulator.physics.max_power} kW")
     print(f"Update Rate: 200ms (5 Hz) for smooth transitions")
     print(f"\nSending data to localhost:5555...")
     
+    if args.scenario:
+        run_headless(controller, args.scenario, args.park)
+        sys.exit(0)
+
     # Start simulation thread
     sim_thread = threading.Thread(target=simulation_loop, args=(controller,), daemon=True)
     sim_thread.start()
@@ -0,0 +1,145 @@
+// ev-iconatlas: build-time icon packer.
+// Rasterizes SVG icons at the target pixel size into one PNG and writes the
+// index header the IconAtlasProvider compiles against, so the cluster loads a
+// single pre-decoded atlas at startup instead of parsing SVGs.
+//
+//   ev-iconatlas --size 48 --scale 1 --png iconatlas.png --header iconatlas_index.h a.svg b.svg ...
+//
+// Icon names are the file base names.
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QSvgRenderer>
+#include <QTextStream>
+#include <QVector>
+#include <algorithm>
+
+static const int kAtlasWidth = 512;
+static const int kPadding = 2;      // Transparent texels between icons; linear filtering never bleeds
+
+struct Icon {
+    QString name;
+    QImage image;
+    QPoint position;
+};
+
+int main(int argc, char *argv[])
+{
+    // Painting only, no windows; works on headless build machines
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption sizeOption("size", "Icon height in logical pixels.", "px", "48");
+    parser.addOption(sizeOption);
+    QCommandLineOption scaleOption("scale", "Device pixel ratio of the target display.", "ratio", "1");
+    parser.addOption(scaleOption);
+    QCommandLineOption pngOption("png", "Atlas image to write.", "file");
+    parser.addOption(pngOption);
+    QCommandLineOption headerOption("header", "Index header to write.", "file");
+    parser.addOption(headerOption);
+    parser.addPositionalArgument("svg", "Icons to pack.", "svg...");
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty() || !parser.isSet(pngOption) || !parser.isSet(headerOption)) {
+        parser.showHelp(1);
+    }
+
+    const double scale = parser.value(scaleOption).toDouble();
+    const int height = qRound(parser.value(sizeOption).toInt() * scale);
+    if (height <= 0) {
+        qWarning() << "Invalid --size/--scale";
+        return 1;
+    }
+
+    QVector<Icon> icons;
+    for (const QString &file : files) {
+        QSvgRenderer renderer(file);
+        if (!renderer.isValid()) {
+            qWarning() << "Cannot parse" << file;
+            return 1;
+        }
+
+        // Height is fixed, width follows the view box
+        const QRectF viewBox = renderer.viewBoxF();
+        const int width = qMax(1, qRound(height * viewBox.width() / viewBox.height()));
+        QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        renderer.render(&painter, QRectF(0, 0, width, height));
+        painter.end();
+
+        icons.append(Icon { QFileInfo(file).completeBaseName(), image, QPoint() });
+    }
+
+    // Shelf packing, tallest first; all icons share a height today but the view box decides
+    QVector<Icon *> order;
+    for (Icon &icon : icons) order.append(&icon);
+    std::sort(order.begin(), order.end(), [](const Icon *a, const Icon *b) {
+        return a->image.height() > b->image.height();
+    });
+    int x = kPadding, y = kPadding, shelfHeight = 0;
+    for (Icon *icon : order) {
+        if (x + icon->image.width() + kPadding > kAtlasWidth) {
+            x = kPadding;
+            y += shelfHeight + kPadding;
+            shelfHeight = 0;
+        }
+        if (icon->image.width() + 2 * kPadding > kAtlasWidth) {
+            qWarning() << icon->name << "is wider than the atlas";
+            return 1;
+        }
+        icon->position = QPoint(x, y);
+        x += icon->image.width() + kPadding;
+        shelfHeight = qMax(shelfHeight, icon->image.height());
+    }
+
+    QImage atlas(kAtlasWidth, y + shelfHeight + kPadding, QImage::Format_ARGB32_Premultiplied);
+    atlas.fill(Qt::transparent);
+    QPainter painter(&atlas);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const Icon &icon : icons) {
+        painter.drawImage(icon.position, icon.image);
+    }
+    painter.end();
+
+    if (!atlas.save(parser.value(pngOption), "PNG")) {
+        qWarning() << "Cannot write" << parser.value(pngOption);
+        return 1;
+    }
+
+    QString header;
+    QTextStream out(&header);
+    out << "// Generated by ev-iconatlas from assets/icons - do not edit\n"
+        << "#ifndef ICONATLAS_INDEX_H\n"
+        << "#define ICONATLAS_INDEX_H\n\n"
+        << "struct IconAtlasEntry {\n"
+        << "    const char *name;\n"
+        << "    int x, y, width, height;    // Atlas pixels\n"
+        << "};\n\n"
+        << "static const char *const kIconAtlasPath = \":/iconatlas.png\";\n"
+        << "static const double kIconAtlasScale = " << scale << ";\n\n"
+        << "static const IconAtlasEntry kIconAtlasEntries[] = {\n";
+    for (const Icon &icon : icons) {
+        out << "    { \"" << icon.name << "\", " << icon.position.x() << ", " << icon.position.y()
+            << ", " << icon.image.width() << ", " << icon.image.height() << " },\n";
+    }
+    out << "};\n\n"
+        << "#endif // ICONATLAS_INDEX_H\n";
+    out.flush();
+
+    QFile headerFile(parser.value(headerOption));
+    if (!headerFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot write" << headerFile.fileName();
+        return 1;
+    }
+    headerFile.write(header.toUtf8());
+    return 0;
+}
@@ -0,0 +1,616 @@
+// ev-routegraph: offline routing graph builder.
+// Reads an OpenStreetMap XML extract, keeps the drivable roads, costs every
+// road segment in battery energy for the given vehicle and contracts the graph
+// into a contraction hierarchy that RouteGraph memory-maps on the device.
+//
+//   ev-routegraph --mass 1800 --regen-efficiency 0.65 region.osm route.graph
+//
+// Elevation comes from "ele" tags on nodes (add them from a terrain model
+// before preprocessing); without any, roads are costed as flat.
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QXmlStreamReader>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+#include "routegraphformat.h"
+
+using namespace RouteGraphFormat;
+
+static const double kGravity = 9.81;
+static const double kAirDensity = 1.2;
+static const int kWitnessSettleLimit = 500;     // Searches giving up add a shortcut, never drop one
+static const quint32 kNoNode = std::numeric_limits<quint32>::max();
+
+struct Vehicle {
+    double massKg;
+    double dragArea;            // Cd * A, m^2
+    double rollingResistance;
+    double driveEfficiency;     // Battery to wheel
+    double regenEfficiency;     // Wheel to battery
+    double auxiliaryWatts;      // Drawn for as long as the drive takes
+};
+
+struct OsmNode {
+    double latitude;
+    double longitude;
+    float elevation;            // NaN if untagged
+    int uses = 0;               // Occurrences in drivable ways
+};
+
+struct OsmWay {
+    std::vector<int> nodes;     // Indices into the node table
+    QByteArray name;
+    float speedKmh;
+    bool forward;
+    bool backward;
+};
+
+struct RoadSegment {
+    quint32 from;
+    quint32 to;
+    quint32 firstPoint;
+    quint32 pointCount;
+    quint32 nameOffset;
+    float lengthMetres;
+    float speedKmh;
+    bool forward;
+    bool backward;
+};
+
+struct Arc {
+    quint32 node;
+    float cost;
+    quint32 detail;
+    quint32 flags;
+};
+
+static double distanceMetres(double latitudeA, double longitudeA, double latitudeB, double longitudeB)
+{
+    const double phiA = qDegreesToRadians(latitudeA);
+    const double phiB = qDegreesToRadians(latitudeB);
+    const double dPhi = phiB - phiA;
+    const double dLambda = qDegreesToRadians(longitudeB - longitudeA);
+    const double h = std::sin(dPhi / 2) * std::sin(dPhi / 2)
+        + std::cos(phiA) * std::cos(phiB) * std::sin(dLambda / 2) * std::sin(dLambda / 2);
+    return 2.0 * 6371000.0 * std::asin(std::sqrt(qMin(1.0, h)));
+}
+
+// Typical free-flow speed when a road has no usable maxspeed; 0 = not drivable
+static float classSpeedKmh(const QByteArray &highway)
+{
+    static const QHash<QByteArray, float> speeds {
+        { "motorway", 100 }, { "motorway_link", 60 },
+        { "trunk", 80 }, { "trunk_link", 50 },
+        { "primary", 60 }, { "primary_link", 40 },
+        { "secondary", 50 }, { "secondary_link", 40 },
+        { "tertiary", 40 }, { "tertiary_link", 30 },
+        { "unclassified", 30 }, { "road", 30 }, { "residential", 30 },
+        { "living_street", 10 }, { "service", 20 },
+    };
+    return speeds.value(highway, 0.0f);
+}
+
+static float parseMaxSpeed(const QByteArray &value)
+{
+    if (value == "walk") return 7.0f;
+    if (value == "none") return 130.0f;
+    const QList<QByteArray> parts = value.simplified().split(' ');
+    bool ok = false;
+    const float speed = parts.value(0).toFloat(&ok);
+    if (!ok || speed <= 0.0f) return 0.0f;
+    return parts.value(1) == "mph" ? speed * 1.609f : speed;
+}
+
+static bool readOsm(const QString &path, std::vector<OsmNode> *nodes, std::vector<OsmWay> *ways)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open" << path << file.errorString();
+        return false;
+    }
+
+    QHash<qint64, int> nodeIndex;
+    QXmlStreamReader xml(&file);
+    OsmWay way;
+    std::vector<qint64> wayRefs;
+    QHash<QByteArray, QByteArray> tags;
+    enum { None, InNode, InWay } element = None;
+
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = xml.readNext();
+        if (token == QXmlStreamReader::StartElement) {
+            const QStringView name = xml.name();
+            const QXmlStreamAttributes attributes = xml.attributes();
+            if (name == u"node") {
+                element = InNode;
+                nodeIndex.insert(attributes.value("id").toLongLong(), int(nodes->size()));
+                nodes->push_back(OsmNode { attributes.value("lat").toDouble(),
+                                           attributes.value("lon").toDouble(), NAN });
+            } else if (name == u"way") {
+                element = InWay;
+                wayRefs.clear();
+                tags.clear();
+            } else if (name == u"nd" && element == InWay) {
+                wayRefs.push_back(attributes.value("ref").toLongLong());
+            } else if (name == u"tag") {
+                const QByteArray key = attributes.value("k").toUtf8();
+                const QByteArray value = attributes.value("v").toUtf8();
+                if (element == InNode && key == "ele") {
+                    bool ok = false;
+                    const float elevation = value.toFloat(&ok);
+                    if (ok) nodes->back().elevation = elevation;
+                } else if (element == InWay) {
+                    tags.insert(key, value);
+                }
+            } else if (name == u"relation") {
+                element = None;
+            }
+        } else if (token == QXmlStreamReader::EndElement) {
+            if (xml.name() == u"way" && element == InWay) {
+                element = None;
+                const QByteArray highway = tags.value("highway");
+                const float classSpeed = classSpeedKmh(highway);
+                const QByteArray access = tags.value("motor_vehicle", tags.value("access"));
+                if (classSpeed <= 0.0f || access == "no" || access == "private" || wayRefs.size() < 2) continue;
+
+                way.nodes.clear();
+                for (qint64 ref : wayRefs) {
+                    const auto it = nodeIndex.constFind(ref);
+                    if (it != nodeIndex.constEnd()) way.nodes.push_back(it.value());
+                }
+                if (way.nodes.size() < 2) continue;
+
+                const float maxSpeed = parseMaxSpeed(tags.value("maxspeed"));
+                way.speedKmh = maxSpeed > 0.0f ? maxSpeed : classSpeed;
+                way.name = tags.value("name", tags.value("ref"));
+
+                const QByteArray oneway = tags.value("oneway");
+                const bool impliedOneway = tags.value("junction") == "roundabout" || highway == "motorway";
+                const bool reverse = oneway == "-1" || oneway == "reverse";
+                const bool oneDirection = reverse || oneway == "yes" || oneway == "true" || oneway == "1"
+                    || (impliedOneway && oneway != "no");
+                way.forward = !reverse;
+                way.backward = !oneDirection || reverse;
+                for (int index : way.nodes) (*nodes)[index].uses++;
+                ways->push_back(way);
+            } else if (xml.name() == u"node") {
+                element = None;
+            }
+        }
+    }
+    if (xml.hasError()) {
+        qWarning() << "OSM parse error in" << path << "line" << xml.lineNumber() << xml.errorString();
+        return false;
+    }
+    return true;
+}
+
+// Dynamic graph the hierarchy is built on; contracted nodes drop out of it
+class Contractor
+{
+public:
+    Contractor(quint32 nodeCount)
+        : m_out(nodeCount), m_in(nodeCount), m_upward(nodeCount),
+          m_contracted(nodeCount, false), m_deletedNeighbours(nodeCount, 0), m_level(nodeCount, 0),
+          m_distance(nodeCount, std::numeric_limits<float>::infinity())
+    {
+    }
+
+    // Keeps only the cheapest arc between two nodes; false if the existing one was cheaper
+    bool addArc(quint32 from, quint32 to, float cost, quint32 detail, quint32 flags)
+    {
+        for (Arc &arc : m_out[from]) {
+            if (arc.node != to) continue;
+            if (arc.cost <= cost) return false;
+            arc = Arc { to, cost, detail, flags };
+            for (Arc &reverse : m_in[to]) {
+                if (reverse.node == from) reverse = Arc { from, cost, detail, flags };
+            }
+            return true;
+        }
+        m_out[from].push_back(Arc { to, cost, detail, flags });
+        m_in[to].push_back(Arc { from, cost, detail, flags });
+        return true;
+    }
+
+    // Returns the node ranks; upward(node) then holds the node's hierarchy edges
+    std::vector<quint32> contract()
+    {
+        const quint32 nodeCount = quint32(m_out.size());
+        using Entry = std::pair<int, quint32>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        for (quint32 node = 0; node < nodeCount; ++node) queue.push(Entry(priority(node), node));
+
+        std::vector<quint32> rank(nodeCount, 0);
+        quint32 nextRank = 0;
+        while (!queue.empty()) {
+            const quint32 node = queue.top().second;
+            queue.pop();
+            if (m_contracted[node]) continue;
+
+            // Lazy update: contract only if still the cheapest after recomputing
+            const int current = priority(node);
+            if (!queue.empty() && current > queue.top().first) {
+                queue.push(Entry(current, node));
+                continue;
+            }
+
+            shortcuts(node, true);
+            rank[node] = nextRank++;
+            m_contracted[node] = true;
+
+            // Everything still attached ranks higher: these are the node's upward edges
+            for (const Arc &arc : m_out[node]) {
+                m_upward[node].push_back(Edge { arc.node, arc.cost, arc.detail, arc.flags | Forward });
+                detach(m_in[arc.node], node);
+                touch(arc.node, node);
+            }
+            for (const Arc &arc : m_in[node]) {
+                m_upward[node].push_back(Edge { arc.node, arc.cost, arc.detail, arc.flags | Backward });
+                detach(m_out[arc.node], node);
+                touch(arc.node, node);
+            }
+            m_out[node] = std::vector<Arc>();
+            m_in[node] = std::vector<Arc>();
+
+            if (nextRank % 10000 == 0) qDebug() << "Contracted" << nextRank << "of" << nodeCount << "nodes";
+        }
+        return rank;
+    }
+
+    const std::vector<Edge> &upward(quint32 node) const { return m_upward[node]; }
+    quint32 shortcutCount() const { return m_shortcutCount; }
+
+private:
+    int priority(quint32 node)
+    {
+        const int edgeDifference = shortcuts(node, false) - int(m_out[node].size() + m_in[node].size());
+        return 2 * edgeDifference + m_deletedNeighbours[node] + m_level[node];
+    }
+
+    // Shortcuts needed to contract node; added to the graph if apply
+    int shortcuts(quint32 node, bool apply)
+    {
+        int count = 0;
+        for (const Arc &in : m_in[node]) {
+            float maxCost = -1.0f;
+            for (const Arc &out : m_out[node]) {
+                if (out.node != in.node) maxCost = qMax(maxCost, in.cost + out.cost);
+            }
+            if (maxCost < 0.0f) continue;   // Nowhere to go on from in.node
+
+            witnessSearch(in.node, node, maxCost);
+            for (const Arc &out : m_out[node]) {
+                if (out.node == in.node) continue;
+                const float cost = in.cost + out.cost;
+                if (m_distance[out.node] <= cost) continue;     // A path around node is no worse
+                count++;
+                if (apply && addArc(in.node, out.node, cost, node, Shortcut)) m_shortcutCount++;
+            }
+        }
+        return count;
+    }
+
+    // Bounded Dijkstra from source that avoids skip; leaves distances in m_distance
+    void witnessSearch(quint32 source, quint32 skip, float maxCost)
+    {
+        for (quint32 node : m_touched) m_distance[node] = std::numeric_limits<float>::infinity();
+        m_touched.clear();
+
+        using Entry = std::pair<float, quint32>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        m_distance[source] = 0.0f;
+        m_touched.push_back(source);
+        queue.push(Entry(0.0f, source));
+
+        int settled = 0;
+        while (!queue.empty() && settled < kWitnessSettleLimit) {
+            const auto [distance, node] = queue.top();
+            queue.pop();
+            if (distance > m_distance[node]) continue;
+            if (distance > maxCost) break;
+            settled++;
+
+            for (const Arc &arc : m_out[node]) {
+                if (arc.node == skip) continue;
+                const float candidate = distance + arc.cost;
+                if (candidate < m_distance[arc.node]) {
+                    if (std::isinf(m_distance[arc.node])) m_touched.push_back(arc.node);
+                    m_distance[arc.node] = candidate;
+                    queue.push(Entry(candidate, arc.node));
+                }
+            }
+        }
+    }
+
+    static void detach(std::vector<Arc> &arcs, quint32 node)
+    {
+        arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [node](const Arc &arc) {
+            return arc.node == node;
+        }), arcs.end());
+    }
+
+    void touch(quint32 neighbour, quint32 contracted)
+    {
+        m_deletedNeighbours[neighbour]++;
+        m_level[neighbour] = qMax(m_level[neighbour], m_level[contracted] + 1);
+    }
+
+    std::vector<std::vector<Arc>> m_out;
+    std::vector<std::vector<Arc>> m_in;
+    std::vector<std::vector<Edge>> m_upward;
+    std::vector<bool> m_contracted;
+    std::vector<int> m_deletedNeighbours;
+    std::vector<int> m_level;
+    std::vector<float> m_distance;
+    std::vector<quint32> m_touched;
+    quint32 m_shortcutCount = 0;
+};
+
+// Battery energy in Wh to drive a segment in one direction
+static double segmentEnergyWh(const Vehicle &vehicle, double lengthMetres, double speedKmh, double climbMetres)
+{
+    const double speed = speedKmh / 3.6;
+    const double wheelJoules = vehicle.rollingResistance * vehicle.massKg * kGravity * lengthMetres
+        + 0.5 * kAirDensity * vehicle.dragArea * speed * speed * lengthMetres
+        + vehicle.massKg * kGravity * climbMetres;
+    const double batteryJoules = wheelJoules > 0.0
+        ? wheelJoules / vehicle.driveEfficiency
+        : wheelJoules * vehicle.regenEfficiency;
+    return (batteryJoules + vehicle.auxiliaryWatts * lengthMetres / speed) / 3600.0;
+}
+
+template <typename T>
+static void writeSection(QFile &file, const std::vector<T> &values)
+{
+    file.write(reinterpret_cast<const char *>(values.data()), qint64(values.size() * sizeof(T)));
+    static const char padding[8] = {};
+    file.write(padding, qint64(aligned(file.pos()) - quint64(file.pos())));
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption massOption("mass", "Vehicle mass with driver in kg.", "kg", "1800");
+    parser.addOption(massOption);
+    QCommandLineOption dragAreaOption("drag-area", "Drag coefficient times frontal area in m^2.", "m2", "0.62");
+    parser.addOption(dragAreaOption);
+    QCommandLineOption rollingOption("rolling-resistance", "Tyre rolling resistance coefficient.", "crr", "0.010");
+    parser.addOption(rollingOption);
+    QCommandLineOption driveEfficiencyOption("drive-efficiency", "Battery to wheel efficiency.", "ratio", "0.88");
+    parser.addOption(driveEfficiencyOption);
+    QCommandLineOption regenEfficiencyOption("regen-efficiency", "Wheel to battery efficiency when braking.", "ratio", "0.65");
+    parser.addOption(regenEfficiencyOption);
+    QCommandLineOption auxiliaryOption("auxiliary-power", "Constant auxiliary load in kW.", "kw", "0.5");
+    parser.addOption(auxiliaryOption);
+    QCommandLineOption gridCellOption("grid-cell", "Nearest-junction index cell size in degrees.", "degrees", "0.005");
+    parser.addOption(gridCellOption);
+    parser.addPositionalArgument("osm", "OpenStreetMap XML extract.");
+    parser.addPositionalArgument("graph", "Routing graph to write.");
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) parser.showHelp(1);
+
+    const Vehicle vehicle {
+        parser.value(massOption).toDouble(),
+        parser.value(dragAreaOption).toDouble(),
+        parser.value(rollingOption).toDouble(),
+        parser.value(driveEfficiencyOption).toDouble(),
+        parser.value(regenEfficiencyOption).toDouble(),
+        parser.value(auxiliaryOption).toDouble() * 1000.0,
+    };
+    const double gridCell = parser.value(gridCellOption).toDouble();
+    if (vehicle.massKg <= 0.0 || vehicle.driveEfficiency <= 0.0 || vehicle.driveEfficiency > 1.0
+        || vehicle.regenEfficiency < 0.0 || vehicle.regenEfficiency > 1.0 || gridCell <= 0.0) {
+        qWarning() << "Invalid vehicle or grid parameters";
+        return 1;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<OsmNode> osmNodes;
+    std::vector<OsmWay> ways;
+    if (!readOsm(arguments[0], &osmNodes, &ways)) return 1;
+    qDebug() << "Read" << osmNodes.size() << "nodes," << ways.size() << "drivable ways in" << timer.elapsed() << "ms";
+
+    // Junctions: shared nodes, way ends and surveyed heights; the rest is geometry
+    std::vector<quint32> junctionOf(osmNodes.size(), kNoNode);
+    std::vector<Node> nodes;
+    auto junction = [&](int index) {
+        if (junctionOf[index] == kNoNode) {
+            const OsmNode &osm = osmNodes[index];
+            junctionOf[index] = quint32(nodes.size());
+            nodes.push_back(Node { qint32(qRound(osm.latitude * 1e6)), qint32(qRound(osm.longitude * 1e6)),
+                                   osm.elevation, 0, 0 });
+        }
+        return junctionOf[index];
+    };
+
+    std::vector<RoadSegment> segments;
+    std::vector<Point> points;
+    QByteArray names(1, '\0');
+    QHash<QByteArray, quint32> nameOffsets { { QByteArray(), 0 } };
+    for (const OsmWay &way : ways) {
+        quint32 nameOffset = nameOffsets.value(way.name, kNoNode);
+        if (nameOffset == kNoNode) {
+            nameOffset = quint32(names.size());
+            nameOffsets.insert(way.name, nameOffset);
+            names.append(way.name).append('\0');
+        }
+
+        size_t start = 0;
+        double length = 0.0;
+        for (size_t i = 1; i < way.nodes.size(); ++i) {
+            const OsmNode &previous = osmNodes[way.nodes[i - 1]];
+            const OsmNode &current = osmNodes[way.nodes[i]];
+            length += distanceMetres(previous.latitude, previous.longitude, current.latitude, current.longitude);
+
+            const bool last = i + 1 == way.nodes.size();
+            if (!last && current.uses < 2 && std::isnan(current.elevation)) continue;
+
+            const quint32 from = junction(way.nodes[start]);
+            const quint32 to = junction(way.nodes[i]);
+            if (from != to && length > 0.0) {
+                RoadSegment segment { from, to, quint32(points.size()), quint32(i - start + 1), nameOffset,
+                                      float(length), way.speedKmh, way.forward, way.backward };
+                for (size_t j = start; j <= i; ++j) {
+                    const OsmNode &osm = osmNodes[way.nodes[j]];
+                    points.push_back(Point { qint32(qRound(osm.latitude * 1e6)), qint32(qRound(osm.longitude * 1e6)) });
+                }
+                nodes[from].degree++;
+                nodes[to].degree++;
+                segments.push_back(segment);
+            }
+            start = i;
+            length = 0.0;
+        }
+    }
+    if (segments.empty()) {
+        qWarning() << "No drivable roads in" << arguments[0];
+        return 1;
+    }
+
+    // Untagged junctions take the height of the nearest tagged one along the roads
+    std::vector<std::vector<quint32>> neighbours(nodes.size());
+    for (const RoadSegment &segment : segments) {
+        neighbours[segment.from].push_back(segment.to);
+        neighbours[segment.to].push_back(segment.from);
+    }
+    std::vector<quint32> frontier;
+    for (quint32 node = 0; node < nodes.size(); ++node) {
+        if (!std::isnan(nodes[node].elevation)) frontier.push_back(node);
+    }
+    const size_t surveyed = frontier.size();
+    for (size_t i = 0; i < frontier.size(); ++i) {
+        for (quint32 neighbour : neighbours[frontier[i]]) {
+            if (!std::isnan(nodes[neighbour].elevation)) continue;
+            nodes[neighbour].elevation = nodes[frontier[i]].elevation;
+            frontier.push_back(neighbour);
+        }
+    }
+    for (Node &node : nodes) {
+        if (std::isnan(node.elevation)) node.elevation = 0.0f;
+    }
+
+    // Energy costs, shifted by the regen potential of each end so none is negative
+    const double potentialPerMetre = vehicle.regenEfficiency * vehicle.massKg * kGravity / 3600.0;
+    Contractor contractor(quint32(nodes.size()));
+    for (quint32 index = 0; index < segments.size(); ++index) {
+        const RoadSegment &segment = segments[index];
+        const double climb = nodes[segment.to].elevation - nodes[segment.from].elevation;
+        if (segment.forward) {
+            const double cost = segmentEnergyWh(vehicle, segment.lengthMetres, segment.speedKmh, climb)
+                - potentialPerMetre * climb;
+            contractor.addArc(segment.from, segment.to, float(qMax(0.0, cost)), index, 0);
+        }
+        if (segment.backward) {
+            const double cost = segmentEnergyWh(vehicle, segment.lengthMetres, segment.speedKmh, -climb)
+                + potentialPerMetre * climb;
+            contractor.addArc(segment.to, segment.from, float(qMax(0.0, cost)), index, Reversed);
+        }
+    }
+
+    const qint64 contractStart = timer.elapsed();
+    contractor.contract();
+    qDebug() << "Contracted" << nodes.size() << "junctions," << contractor.shortcutCount()
+             << "shortcuts in" << timer.elapsed() - contractStart << "ms";
+
+    std::vector<Edge> edges;
+    for (quint32 node = 0; node < nodes.size(); ++node) {
+        nodes[node].firstEdge = quint32(edges.size());
+        const std::vector<Edge> &upward = contractor.upward(node);
+        edges.insert(edges.end(), upward.begin(), upward.end());
+    }
+    nodes.push_back(Node { 0, 0, 0.0f, quint32(edges.size()), 0 });
+
+    // Nearest-junction grid, counting sort by cell
+    double minLatitude = 90.0, minLongitude = 180.0, maxLatitude = -90.0, maxLongitude = -180.0;
+    for (size_t node = 0; node + 1 < nodes.size(); ++node) {
+        minLatitude = qMin(minLatitude, nodes[node].latitudeE6 / 1e6);
+        maxLatitude = qMax(maxLatitude, nodes[node].latitudeE6 / 1e6);
+        minLongitude = qMin(minLongitude, nodes[node].longitudeE6 / 1e6);
+        maxLongitude = qMax(maxLongitude, nodes[node].longitudeE6 / 1e6);
+    }
+    const quint32 columns = quint32((maxLongitude - minLongitude) / gridCell) + 1;
+    const quint32 rows = quint32((maxLatitude - minLatitude) / gridCell) + 1;
+    auto cellOf = [&](const Node &node) {
+        const quint32 column = quint32((node.longitudeE6 / 1e6 - minLongitude) / gridCell);
+        const quint32 row = quint32((node.latitudeE6 / 1e6 - minLatitude) / gridCell);
+        return qMin(row, rows - 1) * columns + qMin(column, columns - 1);
+    };
+    std::vector<quint32> cellStart(size_t(columns) * rows + 1, 0);
+    for (size_t node = 0; node + 1 < nodes.size(); ++node) cellStart[cellOf(nodes[node]) + 1]++;
+    for (size_t cell = 1; cell < cellStart.size(); ++cell) cellStart[cell] += cellStart[cell - 1];
+    std::vector<quint32> cellNodes(nodes.size() - 1);
+    std::vector<quint32> fill(cellStart.begin(), cellStart.end() - 1);
+    for (quint32 node = 0; node + 1 < nodes.size(); ++node) cellNodes[fill[cellOf(nodes[node])]++] = node;
+
+    std::vector<Segment> fileSegments;
+    fileSegments.reserve(segments.size());
+    for (const RoadSegment &segment : segments) {
+        fileSegments.push_back(Segment { segment.firstPoint, segment.pointCount, segment.nameOffset,
+                                         segment.lengthMetres, segment.speedKmh });
+    }
+    const std::vector<char> nameBytes(names.begin(), names.end());
+
+    Header header {};
+    header.magic = Magic;
+    header.version = Version;
+    header.nodeCount = quint32(nodes.size() - 1);
+    header.edgeCount = quint32(edges.size());
+    header.segmentCount = quint32(fileSegments.size());
+    header.pointCount = quint32(points.size());
+    header.nameBytes = quint32(nameBytes.size());
+    header.gridColumns = columns;
+    header.gridRows = rows;
+    header.gridCellDegrees = float(gridCell);
+    header.gridLatitude = minLatitude;
+    header.gridLongitude = minLongitude;
+    header.vehicleMassKg = float(vehicle.massKg);
+    header.regenEfficiency = float(vehicle.regenEfficiency);
+    header.nodesOffset = aligned(sizeof(Header));
+    header.edgesOffset = aligned(header.nodesOffset + nodes.size() * sizeof(Node));
+    header.segmentsOffset = aligned(header.edgesOffset + edges.size() * sizeof(Edge));
+    header.pointsOffset = aligned(header.segmentsOffset + fileSegments.size() * sizeof(Segment));
+    header.gridOffset = aligned(header.pointsOffset + points.size() * sizeof(Point));
+    header.gridNodesOffset = aligned(header.gridOffset + cellStart.size() * sizeof(quint32));
+    header.namesOffset = aligned(header.gridNodesOffset + cellNodes.size() * sizeof(quint32));
+    header.fileSize = aligned(header.namesOffset + nameBytes.size());
+
+    QFile output(arguments[1]);
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot write" << arguments[1] << output.errorString();
+        return 1;
+    }
+    writeSection(output, std::vector<Header> { header });
+    writeSection(output, nodes);
+    writeSection(output, edges);
+    writeSection(output, fileSegments);
+    writeSection(output, points);
+    writeSection(output, cellStart);
+    writeSection(output, cellNodes);
+    writeSection(output, nameBytes);
+    if (quint64(output.pos()) != header.fileSize) {
+        qWarning() << "Short write to" << arguments[1] << output.errorString();
+        return 1;
+    }
+
+    qDebug() << "Wrote" << arguments[1] << ":" << header.nodeCount << "junctions (" << surveyed
+             << "with elevation )," << header.edgeCount << "hierarchy edges," << header.segmentCount
+             << "road segments," << header.fileSize / 1024 << "KiB in" << timer.elapsed() << "ms";
+    return 0;
+}
@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+UDS ECU stub for exercising the cluster's ISO-TP/UDS client without hardware.
+
+Answers on a SocketCAN interface (normally vcan0) as the BMS ECU, using the
+kernel's CAN_ISOTP sockets for the transport:
+
+    sudo modprobe vcan can-isotp
+    sudo ip link add dev vcan0 type vcan && sudo ip link set up vcan0
+    python3 uds_ecu_stub.py vcan0
+    ./ev-cluster --can socketcan:vcan0 --uds-probe
+
+Supported services: DiagnosticSessionControl (0x10), TesterPresent (0x3E),
+ReadDataByIdentifier (0x22: VIN 0xF190, cell voltages 0x0100) and
+ReadDTCInformation (0x19 0x02). Everything else gets NRC 0x11.
+"""
+
+import argparse
+import socket
+import struct
+import time
+
+BMS_REQUEST_ID = 0x7E4
+BMS_RESPONSE_ID = 0x7EC
+
+VIN = b"MAT12345EV0000042"
+CELL_COUNT = 96
+
+# 3-byte DTC + status (0x09 = testFailed | confirmedDTC)
+DTCS = [
+    (0x0A8000, 0x09),   # P0A80 replace hybrid/EV battery pack
+    (0x0AFA00, 0x08),   # P0AFA battery system voltage low
+]
+
+
+def cell_voltages():
+    """96 cells, big-endian millivolts - long enough to need ~28 consecutive frames."""
+    data = bytearray()
+    for i in range(CELL_COUNT):
+        millivolts = 3700 + (i * 7) % 40
+        data += struct.pack(">H", millivolts)
+    return bytes(data)
+
+
+def negative(service, nrc):
+    return bytes([0x7F, service, nrc])
+
+
+def handle(request):
+    service = request[0]
+
+    if service == 0x10 and len(request) >= 2:
+        return bytes([0x50, request[1], 0x00, 0x32, 0x01, 0xF4])
+
+    if service == 0x3E:
+        return bytes([0x7E, 0x00])
+
+    if service == 0x22 and len(request) >= 3:
+        did = (request[1] << 8) | request[2]
+        if did == 0xF190:
+            return bytes([0x62, request[1], request[2]]) + VIN
+        if did == 0x0100:
+            return bytes([0x62, request[1], request[2]]) + cell_voltages()
+        return negative(service, 0x31)   # requestOutOfRange
+
+    if service == 0x19 and len(request) >= 3 and request[1] == 0x02:
+        mask = request[2]
+        body = bytearray([0x59, 0x02, 0xFF])
+        for code, status in DTCS:
+            if status & mask:
+                body += code.to_bytes(3, "big") + bytes([status])
+        return bytes(body)
+
+    return negative(service, 0x11)       # serviceNotSupported
+
+
+def main():
+    parser = argparse.ArgumentParser(description="UDS ECU stub on a vcan interface")
+    parser.add_argument("interface", nargs="?", default="vcan0")
+    parser.add_argument("--slow", action="store_true",
+                        help="answer DTC requests with 'response pending' (NRC 0x78) first")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_CAN, socket.SOCK_DGRAM, socket.CAN_ISOTP)
+    # Address tuple is (interface, rx_id, tx_id) from the stub's point of view
+    sock.bind((args.interface, BMS_REQUEST_ID, BMS_RESPONSE_ID))
+    print(f"UDS stub listening on {args.interface} "
+          f"(request 0x{BMS_REQUEST_ID:03X}, response 0x{BMS_RESPONSE_ID:03X})")
+
+    while True:
+        request = sock.recv(4095)
+        if not request:
+            continue
+        print("<-", request.hex(" "))
+
+        if args.slow and request[0] == 0x19:
+            sock.send(negative(0x19, 0x78))
+            time.sleep(2.0)
+
+        response = handle(request)
+        sock.send(response)
+        print("->", response[:16].hex(" "), "..." if len(response) > 16 else "")
+
+
+if __name__ == "__main__":
+    main()